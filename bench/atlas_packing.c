@@ -0,0 +1,133 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+/* ===============================================================
+ *
+ *                      FONT ATLAS PACKING BENCHMARK
+ *
+ * ===============================================================*/
+/* Bakes the fonts of `extra_font/` with every `nk_font_atlas.packing` mode
+ * and prints the texture size, the share of the texture covered by glyphs
+ * (`util`) and the share of the texture up to the lowest glyph (`raw`).
+ * Glyph areas include the one pixel padding. Sets are all fonts at one
+ * size each, all fonts at six sizes and the latter plus ProggyClean with
+ * the chinese glyph ranges. Glyphs are also checked for overlaps. */
+enum set {ONE_SIZE, SIX_SIZES, WITH_CJK, SET_COUNT};
+
+static const char *files[] = {
+    "Cousine-Regular.ttf", "DroidSans.ttf", "Karla-Regular.ttf",
+    "ProggyClean.ttf", "ProggyTiny.ttf", "Raleway-Bold.ttf", "Roboto-Bold.ttf",
+    "Roboto-Light.ttf", "Roboto-Regular.ttf", "kenvector_future.ttf",
+    "kenvector_future_thin.ttf"
+};
+static const float sizes[] = {10, 14, 18, 24, 32, 48};
+
+static int
+add_fonts(struct nk_font_atlas *atlas, enum set set)
+{
+    int i, j;
+    nk_font_atlas_begin(atlas);
+    if (set == WITH_CJK) {
+        struct nk_font_config config = nk_font_config(0);
+        config.range = nk_font_chinese_glyph_ranges();
+        nk_font_atlas_add_default(atlas, 13, &config);
+    }
+    for (i = 0; i < (int)NK_LEN(files); ++i) {
+        char path[256];
+        sprintf(path, "../extra_font/%s", files[i]);
+        for (j = 0; j < ((set == ONE_SIZE) ? 1: (int)NK_LEN(sizes)); ++j) {
+            struct nk_font_config config = nk_font_config(0);
+            float size = (set == ONE_SIZE) ? (float)(16 + 4 * i): sizes[j];
+            config.oversample_h = (j % 2) ? 1: 3;
+            if (!nk_font_atlas_add_from_file(atlas, path, size, &config)) {
+                fprintf(stderr, "failed to load font %s\n", path);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int
+count_overlaps(const struct nk_recti *rects, int count)
+{
+    int i, j, overlaps = 0;
+    for (i = 0; i < count; ++i) {
+        const struct nk_recti *a = &rects[i];
+        for (j = i + 1; j < count; ++j) {
+            const struct nk_recti *b = &rects[j];
+            overlaps += (a->x < b->x + b->w && b->x < a->x + a->w &&
+                a->y < b->y + b->h && b->y < a->y + a->h);
+        }
+    }
+    return overlaps;
+}
+
+int main(void)
+{
+    static const char *set_names[] = {"1 size", "6 sizes", "+ CJK"};
+    static const char *mode_names[] = {"default", "skyline", "maxrects", "best"};
+    int set, mode, failed = 0;
+
+    printf("%-8s %-9s %10s %7s %7s %9s %9s\n",
+        "fonts", "packing", "texture", "util", "raw", "bake ms", "overlaps");
+    for (set = 0; set < SET_COUNT; ++set) {
+        for (mode = NK_FONT_ATLAS_PACK_DEFAULT; mode <= NK_FONT_ATLAS_PACK_BEST; ++mode) {
+            struct nk_font_atlas atlas;
+            struct nk_recti *rects;
+            double used = 0, ms;
+            int i, w, h, count = 0, used_height = 0, overlaps;
+            clock_t start;
+
+            nk_font_atlas_init_default(&atlas);
+            atlas.packing = (enum nk_font_atlas_packing)mode;
+            if (!add_fonts(&atlas, (enum set)set)) return 1;
+            start = clock();
+            if (!nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_ALPHA8)) {
+                fprintf(stderr, "failed to bake atlas\n");
+                return 1;
+            }
+            ms = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+            /* glyph rects in pixels including padding plus the cursor rect */
+            rects = (struct nk_recti*)malloc(sizeof(struct nk_recti) * (size_t)(atlas.glyph_count + 1));
+            if (!rects) return 1;
+            for (i = 0; i < atlas.glyph_count; ++i) {
+                const struct nk_font_glyph *g = &atlas.glyphs[i];
+                int x0 = (int)(g->u0 * (float)w + 0.5f), y0 = (int)(g->v0 * (float)h + 0.5f);
+                int x1 = (int)(g->u1 * (float)w + 0.5f), y1 = (int)(g->v1 * (float)h + 0.5f);
+                if (x1 <= x0 || y1 <= y0) continue;
+                rects[count].x = (short)x0;
+                rects[count].y = (short)y0;
+                rects[count].w = (short)(x1 - x0);
+                rects[count].h = (short)(y1 - y0);
+                count++;
+                used += (double)(x1 - x0 + 1) * (double)(y1 - y0 + 1);
+                used_height = NK_MAX(used_height, y1 + 1);
+            }
+            rects[count++] = atlas.custom;
+            overlaps = count_overlaps(rects, count);
+            failed |= (overlaps != 0);
+
+            printf("%-8s %-9s %5dx%-5d %6.1f%% %6.1f%% %9.1f %9d\n",
+                set_names[set], mode_names[mode], w, h,
+                100.0 * used / ((double)w * (double)h),
+                100.0 * used / ((double)w * (double)used_height), ms, overlaps);
+            free(rects);
+            nk_font_atlas_end(&atlas, nk_handle_id(0), 0);
+            nk_font_atlas_clear(&atlas);
+        }
+    }
+    return failed;
+}
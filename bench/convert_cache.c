@@ -0,0 +1,161 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_STANDARD_VARARGS
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+#define UNUSED(a) (void)a
+#define MIN(a,b) ((a) < (b) ? (a) : (b))
+#define MAX(a,b) ((a) < (b) ? (b) : (a))
+#define LEN(a) (sizeof(a)/sizeof(a)[0])
+
+#include "../demo/overview.c"
+#include "../demo/node_editor.c"
+
+/* ===============================================================
+ *
+ *                      CONVERT CACHE BENCHMARK
+ *
+ * ===============================================================*/
+/* Builds a static UI out of the overview and node editor demos plus a few
+ * chart windows and times `nk_convert` with and without
+ * `NK_CONVERT_CACHE_WINDOWS`. Input never changes, so after the first frame
+ * every window can be replayed from the cache. */
+#define FRAMES 2000
+
+struct vertex {
+    float position[2];
+    float uv[2];
+    nk_byte col[4];
+};
+
+static void
+ui(struct nk_context *ctx)
+{
+    int i;
+    overview(ctx);
+    node_editor(ctx);
+    for (i = 0; i < 6; ++i) {
+        char name[16];
+        sprintf(name, "Chart %d", i);
+        if (nk_begin(ctx, name, nk_rect(420 + (float)(i % 3) * 210, 10 + (float)(i / 3) * 210, 200, 200),
+            NK_WINDOW_BORDER|NK_WINDOW_TITLE)) {
+            int j;
+            nk_layout_row_dynamic(ctx, 140, 1);
+            if (nk_chart_begin(ctx, NK_CHART_LINES, 64, -1.0f, 1.0f)) {
+                for (j = 0; j < 64; ++j)
+                    nk_chart_push(ctx, (float)sin((float)j * 0.2f + (float)i));
+                nk_chart_end(ctx);
+            }
+        }
+        nk_end(ctx);
+    }
+}
+
+static double
+run(struct nk_context *ctx, const struct nk_convert_config *config,
+    struct nk_buffer *cmds, struct nk_buffer *verts, struct nk_buffer *idx)
+{
+    clock_t convert = 0;
+    int frame;
+    for (frame = 0; frame < FRAMES; ++frame) {
+        clock_t start;
+        nk_input_begin(ctx);
+        nk_input_end(ctx);
+        ui(ctx);
+        nk_buffer_clear(cmds);
+        nk_buffer_clear(verts);
+        nk_buffer_clear(idx);
+        start = clock();
+        nk_convert(ctx, cmds, verts, idx, config);
+        convert += clock() - start;
+        nk_clear(ctx);
+    }
+    return (double)convert / CLOCKS_PER_SEC * 1e6 / FRAMES;
+}
+
+int main(void)
+{
+    static const struct nk_draw_vertex_layout_element layout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+    struct nk_font_atlas atlas;
+    struct nk_font *font;
+    struct nk_context ctx;
+    struct nk_convert_config config;
+    struct nk_buffer cmds[2], verts[2], idx[2];
+    double plain, cached;
+    int w, h, i, same;
+
+    nk_font_atlas_init_default(&atlas);
+    nk_font_atlas_begin(&atlas);
+    font = nk_font_atlas_add_default(&atlas, 13, 0);
+    nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
+    nk_font_atlas_end(&atlas, nk_handle_id(1), &config.null);
+    nk_init_default(&ctx, &font->handle);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_init_default(&cmds[i]);
+        nk_buffer_init_default(&verts[i]);
+        nk_buffer_init_default(&idx[i]);
+    }
+
+    config.vertex_layout = layout;
+    config.vertex_size = sizeof(struct vertex);
+    config.vertex_alignment = NK_ALIGNOF(struct vertex);
+    config.circle_segment_count = 22;
+    config.curve_segment_count = 22;
+    config.arc_segment_count = 22;
+    config.global_alpha = 1.0f;
+    config.shape_AA = NK_ANTI_ALIASING_ON;
+    config.line_AA = NK_ANTI_ALIASING_ON;
+    config.flags = 0;
+    config.parallel_for = 0;
+    config.parallel_userdata = nk_handle_ptr(0);
+
+    plain = run(&ctx, &config, &cmds[0], &verts[0], &idx[0]);
+    config.flags = NK_CONVERT_CACHE_WINDOWS;
+    cached = run(&ctx, &config, &cmds[1], &verts[1], &idx[1]);
+
+    /* both paths have to produce the same output for the last frame */
+    ui(&ctx);
+    for (i = 0; i < 2; ++i) {
+        config.flags = i ? NK_CONVERT_CACHE_WINDOWS: 0;
+        nk_buffer_clear(&cmds[i]);
+        nk_buffer_clear(&verts[i]);
+        nk_buffer_clear(&idx[i]);
+        nk_convert(&ctx, &cmds[i], &verts[i], &idx[i], &config);
+    }
+    same = verts[0].allocated == verts[1].allocated && idx[0].allocated == idx[1].allocated &&
+        !memcmp(verts[0].memory.ptr, verts[1].memory.ptr, verts[0].allocated) &&
+        !memcmp(idx[0].memory.ptr, idx[1].memory.ptr, idx[0].allocated);
+
+    printf("vertices %lu indices %lu\n", (unsigned long)(verts[0].allocated / sizeof(struct vertex)),
+        (unsigned long)(idx[0].allocated / sizeof(nk_draw_index)));
+    printf("nk_convert %.1f us, cached %.1f us (%.1fx), output %s\n",
+        plain, cached, plain / cached, same ? "identical": "DIFFERENT");
+
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_free(&cmds[i]);
+        nk_buffer_free(&verts[i]);
+        nk_buffer_free(&idx[i]);
+    }
+    nk_free(&ctx);
+    nk_font_atlas_clear(&atlas);
+    return !same;
+}
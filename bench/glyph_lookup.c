@@ -0,0 +1,206 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+/* ===============================================================
+ *
+ *                      GLYPH LOOKUP BENCHMARK
+ *
+ * ===============================================================*/
+/* Measures text widths of latin, CJK and mixed strings with the default
+ * font baked for the chinese glyph ranges, for the same ranges merged from
+ * several configs and for a subset of common CJK characters given as many
+ * short ranges. Both columns measure text exactly like the font's width
+ * callback and only differ in the glyph search: `lookup` calls
+ * `nk_font_find_glyph`, `linear` walks all configs and recounts their
+ * ranges like `nk_font_find_glyph` used to. Pass a TTF file to measure a
+ * font with actual CJK glyphs instead of the default font. */
+#define TEXT_LEN 4096
+#define REPEAT 400
+#define SUBSET_RANGES 1024
+#define SUBSET_STRIDE 20
+#define SUBSET_WIDTH 5
+
+typedef const struct nk_font_glyph*(*find_glyph_f)(struct nk_font*, nk_rune);
+
+static const struct nk_font_glyph*
+find_glyph_linear(struct nk_font *font, nk_rune unicode)
+{
+    const struct nk_font_config *iter = font->config;
+    int total_glyphs = 0;
+    do {
+        const nk_rune *range = iter->range;
+        int i, count = 0;
+        while (range[count*2]) count++;
+        for (i = 0; i < count; ++i) {
+            nk_rune f = range[(i*2)+0];
+            nk_rune t = range[(i*2)+1];
+            if (unicode >= f && unicode <= t)
+                return &font->glyphs[(nk_rune)total_glyphs + (unicode - f)];
+            total_glyphs += (int)(t - f) + 1;
+        }
+    } while ((iter = iter->n) != font->config);
+    return font->fallback;
+}
+
+static float
+find_kerning(const struct nk_font *font, nk_rune first, nk_rune second)
+{
+    nk_uint i;
+    if (!font->kerning || !first || !second) return 0;
+    i = nk_font_kerning_hash(first, second) & font->kerning_mask;
+    while (font->kerning[i].first) {
+        if (font->kerning[i].first == first && font->kerning[i].second == second)
+            return font->kerning[i].advance;
+        i = (i + 1) & font->kerning_mask;
+    }
+    return 0;
+}
+
+static float
+text_width(struct nk_font *font, find_glyph_f find, const char *text, int len)
+{
+    float scale = font->handle.height / font->info.height;
+    float width = 0;
+    nk_rune unicode, prev;
+    int text_len, glyph_len;
+
+    glyph_len = text_len = nk_utf_decode(text, &unicode, len);
+    while (text_len <= len && glyph_len) {
+        if (unicode == NK_UTF_INVALID) break;
+        width += find(font, unicode)->xadvance * scale;
+        prev = unicode;
+        glyph_len = nk_utf_decode(text + text_len, &unicode, len - text_len);
+        text_len += glyph_len;
+        if (font->kerning && glyph_len && unicode != NK_UTF_INVALID)
+            width += find_kerning(font, prev, unicode) * scale;
+    }
+    return width;
+}
+
+static int
+make_text(char *text, int cjk_percent)
+{
+    static const nk_rune cjk[] = {0x3041, 0x30FF, 0x4E00, 0x9FAF};
+    int len = 0;
+    while (len < TEXT_LEN - 4) {
+        nk_rune unicode;
+        if (rand() % 100 < cjk_percent) {
+            /* mostly han characters that are part of the subset font */
+            if (rand() % 8) {
+                unicode = cjk[2] + (nk_rune)(rand() % SUBSET_RANGES) * SUBSET_STRIDE;
+                unicode += (nk_rune)(rand() % SUBSET_WIDTH);
+            } else unicode = cjk[0] + (nk_rune)rand() % (cjk[1] - cjk[0] + 1);
+        } else unicode = (nk_rune)(32 + rand() % 95);
+        len += nk_utf_encode(unicode, text + len, TEXT_LEN - len);
+    }
+    return len;
+}
+
+static struct nk_font*
+add_font(struct nk_font_atlas *atlas, const char *path, struct nk_font_config *config)
+{
+    if (path) return nk_font_atlas_add_from_file(atlas, path, 16, config);
+    return nk_font_atlas_add_default(atlas, 16, config);
+}
+
+static int
+run(const char *name, struct nk_font *font)
+{
+    static const char *names[] = {"latin", "mixed", "cjk"};
+    static const int percent[] = {0, 30, 100};
+    static char text[TEXT_LEN];
+    int i, k, failed = 0;
+
+    srand(1);
+    for (i = 0; i < 3; ++i) {
+        int len = make_text(text, percent[i]);
+        volatile float sink = 0;
+        double fast, slow;
+        clock_t start;
+        float a, b;
+
+        start = clock();
+        for (k = 0; k < REPEAT; ++k)
+            sink += text_width(font, nk_font_find_glyph, text, len);
+        fast = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+        start = clock();
+        for (k = 0; k < REPEAT; ++k)
+            sink += text_width(font, find_glyph_linear, text, len);
+        slow = (double)(clock() - start) / CLOCKS_PER_SEC * 1000.0;
+
+        a = font->handle.width(font->handle.userdata, font->handle.height, text, len);
+        b = text_width(font, find_glyph_linear, text, len);
+        failed |= (a != b);
+        printf("%-7s %-6s %12.1f %12.1f %7.2fx%s\n", name, names[i], fast, slow,
+            slow / fast, (a != b) ? " DIFFERENT": "");
+        (void)sink;
+    }
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    static const nk_rune latin[] = {0x0020, 0x00FF, 0};
+    static const nk_rune symbols[] = {0x2000, 0x206F, 0x2190, 0x21FF, 0x25A0, 0x25FF, 0};
+    static const nk_rune kana[] = {0x3000, 0x30FF, 0x31F0, 0x31FF, 0xFF00, 0xFFEF, 0};
+    static const nk_rune han[] = {0x4E00, 0x9FAF, 0};
+    static nk_rune subset[SUBSET_RANGES*2 + 6];
+    const char *path = (argc > 1) ? argv[1]: 0;
+    struct nk_font_atlas atlas;
+    struct nk_font_config config;
+    struct nk_font *single, *merged, *sparse;
+    int i, w, h, failed = 0;
+
+    subset[0] = 0x0020; subset[1] = 0x00FF;
+    subset[2] = 0x3000; subset[3] = 0x30FF;
+    for (i = 0; i < SUBSET_RANGES; ++i) {
+        subset[4+i*2] = 0x4E00 + (nk_rune)(i * SUBSET_STRIDE);
+        subset[5+i*2] = subset[4+i*2] + SUBSET_WIDTH - 1;
+    }
+
+    nk_font_atlas_init_default(&atlas);
+    nk_font_atlas_begin(&atlas);
+    config = nk_font_config(0);
+    config.range = nk_font_chinese_glyph_ranges();
+    single = add_font(&atlas, path, &config);
+
+    config = nk_font_config(0);
+    config.range = latin;
+    merged = add_font(&atlas, path, &config);
+    config.merge_mode = nk_true;
+    config.range = symbols;
+    add_font(&atlas, path, &config);
+    config.range = kana;
+    add_font(&atlas, path, &config);
+    config.range = han;
+    add_font(&atlas, path, &config);
+
+    config = nk_font_config(0);
+    config.range = subset;
+    sparse = add_font(&atlas, path, &config);
+    if (!single || !merged || !sparse) {
+        fprintf(stderr, "failed to load font %s\n", path);
+        return 1;
+    }
+    nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_ALPHA8);
+    nk_font_atlas_end(&atlas, nk_handle_id(0), 0);
+
+    printf("%-7s %-6s %12s %12s %8s\n", "font", "text", "lookup ms", "linear ms", "speedup");
+    failed |= run("single", single);
+    failed |= run("merged", merged);
+    failed |= run("subset", sparse);
+    nk_font_atlas_clear(&atlas);
+    return failed;
+}
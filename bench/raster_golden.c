@@ -0,0 +1,161 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_IMPLEMENTATION
+#ifndef NUKLEAR_HEADER
+#define NUKLEAR_HEADER "../nuklear.h"
+#endif
+#include NUKLEAR_HEADER
+
+/* ===============================================================
+ *
+ *                      GLYPH RASTERIZER GOLDEN IMAGE
+ *
+ * ===============================================================*/
+/* Bakes an alpha atlas of ProggyClean with the chinese glyph ranges, a few
+ * fonts of `extra_font/` at small and large sizes with different
+ * oversampling and optionally a CJK font given on the command line. `write`
+ * stores the atlas as PGM image, `check` compares it with a stored one and
+ * fails if the size differs or any pixel differs by more than one level.
+ *
+ * Write the golden image with the scalar build, or with a build against an
+ * older nuklear.h by defining `NUKLEAR_HEADER`, and check the build with
+ * `NK_INCLUDE_SIMD` against it:
+ *
+ *      bin/raster_golden write golden.pgm [cjk.ttf]
+ *      bin/raster_golden_simd check golden.pgm [cjk.ttf]
+ */
+#define MAX_DIFFERENCE 1
+
+static const nk_rune cjk_subset[] = {
+    0x3000, 0x30FF, /* CJK punctuation, hiragana, katakana */
+    0x4E00, 0x5DFF, /* first 4096 CJK ideographs */
+    0
+};
+
+static const void*
+bake(struct nk_font_atlas *atlas, const char *cjk, int *w, int *h)
+{
+    static const char *fonts[] = {"Roboto-Regular.ttf", "DroidSans.ttf", "Cousine-Regular.ttf"};
+    static const float sizes[] = {9.5f, 14, 24, 48, 100};
+    struct nk_font_config config;
+    int i, j;
+
+    nk_font_atlas_init_default(atlas);
+    nk_font_atlas_begin(atlas);
+    config = nk_font_config(0);
+    config.range = nk_font_chinese_glyph_ranges();
+    nk_font_atlas_add_default(atlas, 13, &config);
+    nk_font_atlas_add_default(atlas, 26, 0);
+    for (i = 0; i < (int)NK_LEN(fonts); ++i) {
+        for (j = 0; j < (int)NK_LEN(sizes); ++j) {
+            char path[256];
+            config = nk_font_config(0);
+            config.oversample_h = (unsigned char)(1 + (i + j) % 3);
+            config.oversample_v = (unsigned char)(1 + (i * j) % 2);
+            sprintf(path, "../extra_font/%s", fonts[i]);
+            if (!nk_font_atlas_add_from_file(atlas, path, sizes[j], &config)) {
+                fprintf(stderr, "failed to load font %s\n", path);
+                return 0;
+            }
+        }
+    }
+    if (cjk) {
+        config = nk_font_config(0);
+        config.range = nk_font_chinese_glyph_ranges();
+        if (!nk_font_atlas_add_from_file(atlas, cjk, 16, &config)) {
+            fprintf(stderr, "failed to load font %s\n", cjk);
+            return 0;
+        }
+        config.range = cjk_subset;
+        config.oversample_h = 1;
+        nk_font_atlas_add_from_file(atlas, cjk, 40, &config);
+    }
+    return nk_font_atlas_bake(atlas, w, h, NK_FONT_ATLAS_ALPHA8);
+}
+
+static int
+write_image(const char *path, const unsigned char *pixels, int w, int h)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return 0;
+    fprintf(fp, "P5\n%d %d\n255\n", w, h);
+    fwrite(pixels, 1, (size_t)w * (size_t)h, fp);
+    fclose(fp);
+    return 1;
+}
+
+static unsigned char*
+read_image(const char *path, int *w, int *h)
+{
+    unsigned char *pixels;
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return 0;
+    if (fscanf(fp, "P5 %d %d 255", w, h) != 2 || fgetc(fp) == EOF) {
+        fclose(fp);
+        return 0;
+    }
+    pixels = (unsigned char*)malloc((size_t)*w * (size_t)*h);
+    if (pixels && fread(pixels, 1, (size_t)*w * (size_t)*h, fp) != (size_t)*w * (size_t)*h) {
+        free(pixels);
+        pixels = 0;
+    }
+    fclose(fp);
+    return pixels;
+}
+
+int main(int argc, char **argv)
+{
+    struct nk_font_atlas atlas;
+    const unsigned char *pixels;
+    unsigned char *golden;
+    int w, h, gw, gh, i, result = 0;
+    int differences = 0, max_difference = 0;
+
+    if (argc < 3 || (strcmp(argv[1], "write") && strcmp(argv[1], "check"))) {
+        fprintf(stderr, "usage: %s write|check image.pgm [cjk.ttf]\n", argv[0]);
+        return 2;
+    }
+    pixels = (const unsigned char*)bake(&atlas, (argc > 3) ? argv[3]: 0, &w, &h);
+    if (!pixels) return 2;
+
+    if (!strcmp(argv[1], "write")) {
+        if (!write_image(argv[2], pixels, w, h)) {
+            fprintf(stderr, "failed to write %s\n", argv[2]);
+            result = 2;
+        } else printf("%dx%d atlas written to %s\n", w, h, argv[2]);
+        nk_font_atlas_clear(&atlas);
+        return result;
+    }
+
+    golden = read_image(argv[2], &gw, &gh);
+    if (!golden) {
+        fprintf(stderr, "failed to read %s\n", argv[2]);
+        nk_font_atlas_clear(&atlas);
+        return 2;
+    }
+    if (gw != w || gh != h) {
+        printf("FAILED: atlas is %dx%d, golden image is %dx%d\n", w, h, gw, gh);
+        result = 1;
+    } else {
+        for (i = 0; i < w * h; ++i) {
+            int d = abs((int)pixels[i] - (int)golden[i]);
+            differences += (d != 0);
+            if (d > max_difference) max_difference = d;
+        }
+        result = (max_difference > MAX_DIFFERENCE);
+        printf("%s: %dx%d atlas, %d pixels differ, maximum difference %d\n",
+            result ? "FAILED": "OK", w, h, differences, max_difference);
+    }
+    free(golden);
+    nk_font_atlas_clear(&atlas);
+    return result;
+}
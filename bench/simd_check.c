@@ -0,0 +1,144 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ===============================================================
+ *
+ *                  SCALAR VS. SSE2 TESSELLATION CHECK
+ *
+ * ===============================================================*/
+/* Compares the anti-aliased polyline and convex fill tessellation of the
+ * scalar code with the SSE2 code enabled by `NK_INCLUDE_SIMD` on random
+ * polylines. This file is compiled three times: once as the scalar and
+ * once as the SSE2 tessellator, each with a private copy of nuklear, and
+ * once with `SIMD_CHECK_MAIN` for the program comparing both outputs. */
+enum shape {OPEN_LINE, CLOSED_LINE, CONVEX_FILL, SHAPE_COUNT};
+size_t tessellate_scalar(const float *xy, unsigned count, enum shape type,
+    float thickness, unsigned char *out, size_t size);
+size_t tessellate_simd(const float *xy, unsigned count, enum shape type,
+    float thickness, unsigned char *out, size_t size);
+
+#ifndef SIMD_CHECK_MAIN
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+#ifdef NK_INCLUDE_SIMD
+#ifndef NK_SSE2
+#error "NK_INCLUDE_SIMD has no effect on this target"
+#endif
+#define TESSELLATE tessellate_simd
+#else
+#define TESSELLATE tessellate_scalar
+#endif
+
+struct vertex {
+    float position[2];
+    float uv[2];
+    nk_byte col[4];
+};
+
+size_t
+TESSELLATE(const float *xy, unsigned count, enum shape type, float thickness,
+    unsigned char *out, size_t size)
+{
+    static const struct nk_draw_vertex_layout_element layout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+    static nk_byte cmd_memory[64*1024];
+    struct nk_convert_config config;
+    struct nk_draw_list list;
+    struct nk_buffer cmds, verts, idx;
+    const struct nk_color color = nk_rgba(40, 200, 120, 220);
+    unsigned i;
+
+    nk_zero_struct(config);
+    config.vertex_layout = layout;
+    config.vertex_size = sizeof(struct vertex);
+    config.vertex_alignment = NK_ALIGNOF(struct vertex);
+    config.global_alpha = 1.0f;
+    config.shape_AA = NK_ANTI_ALIASING_ON;
+    config.line_AA = NK_ANTI_ALIASING_ON;
+
+    nk_buffer_init_fixed(&cmds, cmd_memory, sizeof(cmd_memory));
+    nk_buffer_init_fixed(&verts, out, size / 2);
+    nk_buffer_init_fixed(&idx, out + size / 2, size / 2);
+    nk_draw_list_init(&list);
+    nk_draw_list_setup(&list, &config, &cmds, &verts, &idx,
+        NK_ANTI_ALIASING_ON, NK_ANTI_ALIASING_ON);
+    for (i = 0; i < count; ++i)
+        nk_draw_list_path_line_to(&list, nk_vec2(xy[i*2+0], xy[i*2+1]));
+    if (type == CONVEX_FILL)
+        nk_draw_list_path_fill(&list, color);
+    else nk_draw_list_path_stroke(&list, color, (type == CLOSED_LINE) ?
+        NK_STROKE_CLOSED: NK_STROKE_OPEN, thickness);
+    if (verts.needed > verts.allocated || idx.needed > idx.allocated)
+        return 0;
+
+    /* pack indices directly behind the vertices */
+    memmove(out + verts.allocated, idx.memory.ptr, idx.allocated);
+    return verts.allocated + idx.allocated;
+}
+#else
+
+#define MAX_POINTS 1024
+#define OUTPUT_SIZE (4*1024*1024)
+
+static float
+random_float(float range)
+{
+    return ((float)rand() / (float)RAND_MAX - 0.5f) * range;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *names[] = {"open line", "closed line", "convex fill"};
+    static float xy[MAX_POINTS*2];
+    unsigned char *a = (unsigned char*)malloc(OUTPUT_SIZE);
+    unsigned char *b = (unsigned char*)malloc(OUTPUT_SIZE);
+    int runs = (argc > 1) ? atoi(argv[1]): 20000;
+    int run, failed = 0, checked[SHAPE_COUNT] = {0};
+
+    if (!a || !b) return 1;
+    srand(1);
+    for (run = 0; run < runs; ++run) {
+        enum shape type = (enum shape)(run % SHAPE_COUNT);
+        unsigned count = 3 + (unsigned)rand() % (MAX_POINTS - 3);
+        float range = (run % 7 == 0) ? 1e6f: (run % 5 == 0) ? 1e-3f: 2000.0f;
+        float thickness = (run % 2) ? 1.0f: 0.5f + (float)(rand() % 64) * 0.25f;
+        size_t size_a, size_b;
+        unsigned i;
+
+        for (i = 0; i < count; ++i) {
+            if (i && rand() % 16 == 0) {
+                /* repeated points give zero length segments */
+                xy[i*2+0] = xy[i*2-2];
+                xy[i*2+1] = xy[i*2-1];
+            } else {
+                xy[i*2+0] = random_float(range);
+                xy[i*2+1] = random_float(range);
+            }
+        }
+        size_a = tessellate_scalar(xy, count, type, thickness, a, OUTPUT_SIZE);
+        size_b = tessellate_simd(xy, count, type, thickness, b, OUTPUT_SIZE);
+        if (!size_a || size_a != size_b || memcmp(a, b, size_a)) {
+            printf("%s with %u points (run %d) differs\n", names[type], count, run);
+            failed++;
+        }
+        checked[type]++;
+    }
+    for (run = 0; run < SHAPE_COUNT; ++run)
+        printf("%-12s %6d polylines\n", names[run], checked[run]);
+    printf("%s\n", failed ? "FAILED": "scalar and SSE2 output identical");
+    free(a);
+    free(b);
+    return failed != 0;
+}
+#endif
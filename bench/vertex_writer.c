@@ -0,0 +1,140 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+/* ===============================================================
+ *
+ *                      VERTEX WRITER BENCHMARK
+ *
+ * ===============================================================*/
+/* Times the draw list for anti-aliased polylines and text with the common
+ * float2 position, float2 uv and R8G8B8A8 color layout. `packed` is the
+ * writer selected by `nk_draw_list_setup` for this layout and `generic`
+ * forces the old path walking the vertex layout for every vertex by
+ * clearing `vertex_packed`. Both have to write the same bytes. */
+#define POINTS 4096
+#define LINES 256
+#define REPEAT 200
+
+struct vertex {
+    float position[2];
+    float uv[2];
+    nk_byte col[4];
+};
+
+enum bench_case {POLYLINE, TEXT};
+
+static struct nk_vec2 points[POINTS];
+static const char *line = "The quick brown fox jumps over the lazy dog 0123456789";
+
+static void
+draw(struct nk_draw_list *list, enum bench_case type, const struct nk_user_font *font)
+{
+    int i;
+    if (type == POLYLINE) {
+        for (i = 0; i < POINTS; ++i)
+            nk_draw_list_path_line_to(list, points[i]);
+        nk_draw_list_path_stroke(list, nk_rgb(200,120,40), NK_STROKE_OPEN, 1.5f);
+        return;
+    }
+    for (i = 0; i < LINES; ++i)
+        nk_draw_list_add_text(list, font, nk_rect(4, (float)i * 14, 800, 14),
+            line, (int)strlen(line), font->height, nk_rgb(230,230,230));
+}
+
+static double
+run(const struct nk_convert_config *config, enum bench_case type,
+    const struct nk_user_font *font, int packed, struct nk_buffer *verts,
+    struct nk_buffer *cmds, struct nk_buffer *idx)
+{
+    clock_t start = clock();
+    int i;
+    for (i = 0; i < REPEAT; ++i) {
+        struct nk_draw_list list;
+        nk_buffer_clear(cmds);
+        nk_buffer_clear(verts);
+        nk_buffer_clear(idx);
+        nk_draw_list_init(&list);
+        nk_draw_list_setup(&list, config, cmds, verts, idx,
+            NK_ANTI_ALIASING_ON, NK_ANTI_ALIASING_ON);
+        if (!packed) list.vertex_packed = nk_false;
+        draw(&list, type, font);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / REPEAT;
+}
+
+int main(void)
+{
+    static const struct nk_draw_vertex_layout_element layout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+    static const char *names[] = {"aa polyline", "text"};
+    struct nk_font_atlas atlas;
+    struct nk_font *font;
+    struct nk_convert_config config;
+    struct nk_buffer cmds, verts[2], idx[2];
+    int w, h, i, type, failed = 0;
+
+    for (i = 0; i < POINTS; ++i) {
+        points[i].x = (float)i * 0.25f;
+        points[i].y = 300.0f + 200.0f * (float)sin((float)i * 0.05f);
+    }
+    nk_font_atlas_init_default(&atlas);
+    nk_font_atlas_begin(&atlas);
+    font = nk_font_atlas_add_default(&atlas, 13, 0);
+    nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
+    nk_font_atlas_end(&atlas, nk_handle_id(1), &config.null);
+
+    config.vertex_layout = layout;
+    config.vertex_size = sizeof(struct vertex);
+    config.vertex_alignment = NK_ALIGNOF(struct vertex);
+    config.circle_segment_count = 22;
+    config.curve_segment_count = 22;
+    config.arc_segment_count = 22;
+    config.global_alpha = 1.0f;
+    config.shape_AA = NK_ANTI_ALIASING_ON;
+    config.line_AA = NK_ANTI_ALIASING_ON;
+    config.flags = 0;
+    config.parallel_for = 0;
+    config.parallel_userdata = nk_handle_ptr(0);
+
+    nk_buffer_init_default(&cmds);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_init_default(&verts[i]);
+        nk_buffer_init_default(&idx[i]);
+    }
+    printf("%-12s %10s %12s %12s %8s\n", "case", "vertices", "generic us", "packed us", "speedup");
+    for (type = POLYLINE; type <= TEXT; ++type) {
+        double generic = run(&config, (enum bench_case)type, &font->handle, 0, &verts[0], &cmds, &idx[0]);
+        double packed = run(&config, (enum bench_case)type, &font->handle, 1, &verts[1], &cmds, &idx[1]);
+        int same = verts[0].allocated == verts[1].allocated &&
+            !memcmp(verts[0].memory.ptr, verts[1].memory.ptr, verts[0].allocated);
+        printf("%-12s %10lu %12.1f %12.1f %7.2fx%s\n", names[type],
+            (unsigned long)(verts[0].allocated / sizeof(struct vertex)),
+            generic, packed, generic / packed, same ? "": " DIFFERENT");
+        failed |= !same;
+    }
+    nk_buffer_free(&cmds);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_free(&verts[i]);
+        nk_buffer_free(&idx[i]);
+    }
+    nk_font_atlas_clear(&atlas);
+    return failed;
+}
@@ -0,0 +1,116 @@
+/* nuklear - public domain */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#define NK_PRIVATE
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_STANDARD_VARARGS
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_IMPLEMENTATION
+#include "../nuklear.h"
+
+/* ===============================================================
+ *
+ *                      WINDOW LOOKUP BENCHMARK
+ *
+ * ===============================================================*/
+/* Measures name based window lookups for 10, 100 and 1000 live windows.
+ * `index` is `nk_window_find` going through the context window index and
+ * `list` walks the window list the way `nk_find_window` used to. `frame`
+ * is one full frame of `nk_begin`/`nk_end` for every window. */
+static float
+text_width(nk_handle handle, float height, const char *text, int len)
+{
+    (void)handle; (void)text;
+    return height * 0.5f * (float)len;
+}
+
+static struct nk_window*
+find_window_list(struct nk_context *ctx, const char *name)
+{
+    nk_hash hash = nk_murmur_hash(name, (int)nk_strlen(name), NK_WINDOW_TITLE);
+    struct nk_window *iter = ctx->begin;
+    while (iter) {
+        if (iter->name == hash) {
+            int max_len = nk_strlen(iter->name_string);
+            if (!nk_stricmpn(iter->name_string, name, max_len))
+                return iter;
+        }
+        iter = iter->next;
+    }
+    return 0;
+}
+
+static double
+elapsed(clock_t start, long count)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 / (double)count;
+}
+
+static void
+frame(struct nk_context *ctx, char (*names)[16], int count)
+{
+    int i;
+    for (i = 0; i < count; ++i) {
+        if (nk_begin(ctx, names[i], nk_rect((float)(i % 40) * 10, (float)(i / 40) * 10, 120, 80), 0)) {
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label(ctx, "x", NK_TEXT_LEFT);
+        }
+        nk_end(ctx);
+    }
+}
+
+int main(void)
+{
+    static const int counts[] = {10, 100, 1000};
+    static char names[1000][16];
+    struct nk_user_font font;
+    int n, i;
+
+    nk_zero_struct(font);
+    font.height = 13;
+    font.width = text_width;
+    for (i = 0; i < 1000; ++i)
+        sprintf(names[i], "window%d", i);
+
+    printf("%8s %12s %12s %12s\n", "windows", "index ns", "list ns", "frame us");
+    for (n = 0; n < 3; ++n) {
+        struct nk_context ctx;
+        int count = counts[n];
+        long lookups = 4000000L, frames = 20000L / count + 10, k;
+        double index_ns, list_ns, frame_us;
+        volatile void *sink = 0;
+        clock_t start;
+
+        nk_init_default(&ctx, &font);
+        frame(&ctx, names, count);
+        nk_clear(&ctx);
+        frame(&ctx, names, count);
+
+        start = clock();
+        for (k = 0; k < lookups; ++k)
+            sink = nk_window_find(&ctx, names[k % count]);
+        index_ns = elapsed(start, lookups);
+
+        start = clock();
+        for (k = 0; k < lookups / count + 1000; ++k)
+            sink = find_window_list(&ctx, names[k % count]);
+        list_ns = elapsed(start, lookups / count + 1000);
+        nk_clear(&ctx);
+
+        start = clock();
+        for (k = 0; k < frames; ++k) {
+            frame(&ctx, names, count);
+            nk_clear(&ctx);
+        }
+        frame_us = elapsed(start, frames) / 1000.0;
+        printf("%8d %12.1f %12.1f %12.1f\n", count, index_ns, list_ns, frame_us);
+        (void)sink;
+        nk_free(&ctx);
+    }
+    return 0;
+}
@@ -179,8 +179,9 @@ nk_d3d9_render(enum nk_anti_aliasing AA)
 
             NK_ASSERT(sizeof(nk_draw_index) == sizeof(NK_UINT16));
             hr = IDirect3DDevice9_DrawIndexedPrimitiveUP(d3d9.device, D3DPT_TRIANGLELIST,
-                0, vertex_count, cmd->elem_count/3, offset, D3DFMT_INDEX16,
-                nk_buffer_memory_const(&vbuf), sizeof(struct nk_d3d9_vertex));
+                0, vertex_count - cmd->vertex_offset, cmd->elem_count/3, offset, D3DFMT_INDEX16,
+                (const struct nk_d3d9_vertex *)nk_buffer_memory_const(&vbuf) + cmd->vertex_offset,
+                sizeof(struct nk_d3d9_vertex));
             NK_ASSERT(SUCCEEDED(hr));
             offset += cmd->elem_count;
         }
@@ -66,7 +66,9 @@ struct nk_glfw_device {
     GLint attrib_col;
     GLint uniform_tex;
     GLint uniform_proj;
+    GLint uniform_sdf;
     GLuint font_tex;
+    int font_sdf;
 };
 
 struct nk_glfw_vertex {
@@ -118,11 +120,17 @@ nk_glfw3_device_create(void)
         NK_SHADER_VERSION
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main(){\n"
-        "   Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "   vec4 color = texture(Texture, Frag_UV.st);\n"
+        "   if (Sdf != 0) {\n"
+        "       float width = max(0.7 * fwidth(color.a), 0.001);\n"
+        "       color.a = smoothstep(0.5 - width, 0.5 + width, color.a);\n"
+        "   }\n"
+        "   Out_Color = Frag_Color * color;\n"
         "}\n";
 
     struct nk_glfw_device *dev = &glfw.ogl;
@@ -146,6 +154,7 @@ nk_glfw3_device_create(void)
 
     dev->uniform_tex = glGetUniformLocation(dev->prog, "Texture");
     dev->uniform_proj = glGetUniformLocation(dev->prog, "ProjMtx");
+    dev->uniform_sdf = glGetUniformLocation(dev->prog, "Sdf");
     dev->attrib_pos = glGetAttribLocation(dev->prog, "Position");
     dev->attrib_uv = glGetAttribLocation(dev->prog, "TexCoord");
     dev->attrib_col = glGetAttribLocation(dev->prog, "Color");
@@ -286,12 +295,15 @@ nk_glfw3_render(enum nk_anti_aliasing AA, int max_vertex_buffer, int max_element
         {
             if (!cmd->elem_count) continue;
             glBindTexture(GL_TEXTURE_2D, (GLuint)cmd->texture.id);
+            glUniform1i(dev->uniform_sdf, dev->font_sdf && (GLuint)cmd->texture.id == dev->font_tex);
             glScissor(
                 (GLint)(cmd->clip_rect.x * glfw.fb_scale.x),
                 (GLint)((glfw.height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h)) * glfw.fb_scale.y),
                 (GLint)(cmd->clip_rect.w * glfw.fb_scale.x),
                 (GLint)(cmd->clip_rect.h * glfw.fb_scale.y));
-            glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+            /* indices of a command are relative to its first vertex */
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->elem_count,
+                GL_UNSIGNED_SHORT, offset, (GLint)cmd->vertex_offset);
             offset += cmd->elem_count;
         }
         nk_clear(&glfw.ctx);
@@ -394,7 +406,12 @@ NK_API void
 nk_glfw3_font_stash_end(void)
 {
     const void *image; int w, h;
+    struct nk_font_config *config;
     image = nk_font_atlas_bake(&glfw.atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
+    /* atlas with distance field fonts is drawn with the SDF shader path */
+    glfw.ogl.font_sdf = 0;
+    for (config = glfw.atlas.config; config; config = config->next)
+        glfw.ogl.font_sdf |= config->sdf;
     nk_glfw3_device_upload_atlas(image, w, h);
     nk_font_atlas_end(&glfw.atlas, nk_handle_id((int)glfw.ogl.font_tex), &glfw.ogl.null);
     if (glfw.atlas.default_font)
@@ -442,7 +442,9 @@ nk_glfw3_render(enum nk_anti_aliasing AA)
                 (GLint)((glfw.height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h)) * glfw.fb_scale.y),
                 (GLint)(cmd->clip_rect.w * glfw.fb_scale.x),
                 (GLint)(cmd->clip_rect.h * glfw.fb_scale.y));
-            glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+            /* indices of a command are relative to its first vertex */
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->elem_count,
+                GL_UNSIGNED_SHORT, offset, (GLint)cmd->vertex_offset);
             offset += cmd->elem_count;
         }
         nk_clear(&glfw.ctx);
@@ -271,7 +271,9 @@ nk_sdl_render(enum nk_anti_aliasing AA, int max_vertex_buffer, int max_element_b
                 (GLint)((height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h)) * scale.y),
                 (GLint)(cmd->clip_rect.w * scale.x),
                 (GLint)(cmd->clip_rect.h * scale.y));
-            glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+            /* indices of a command are relative to its first vertex */
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->elem_count,
+                GL_UNSIGNED_SHORT, offset, (GLint)cmd->vertex_offset);
             offset += cmd->elem_count;
         }
         nk_clear(&sdl.ctx);
@@ -131,17 +131,17 @@ nk_sfml_render(enum nk_anti_aliasing AA)
         nk_buffer_init_default(&ebuf);
         nk_convert(&sfml.ctx, &dev->cmds, &vbuf, &ebuf, &config);
 
-        /* setup vertex buffer pointer */
-        const void* vertices = nk_buffer_memory_const(&vbuf);
-        glVertexPointer(2, GL_FLOAT, vs, (const void*)((const nk_byte*)vertices + vp));
-        glTexCoordPointer(2, GL_FLOAT, vs, (const void*)((const nk_byte*)vertices + vt));
-        glColorPointer(4, GL_UNSIGNED_BYTE, vs, (const void*)((const nk_byte*)vertices + vc));
-
         /* iterate over and execute each draw command */
+        const nk_byte* vertices = (const nk_byte*)nk_buffer_memory_const(&vbuf);
         offset = (const nk_draw_index*)nk_buffer_memory_const(&ebuf);
         nk_draw_foreach(cmd, &sfml.ctx, &dev->cmds)
         {
             if(!cmd->elem_count) continue;
+            /* indices of a command are relative to its first vertex */
+            const nk_byte* base = vertices + cmd->vertex_offset * (size_t)vs;
+            glVertexPointer(2, GL_FLOAT, vs, (const void*)(base + vp));
+            glTexCoordPointer(2, GL_FLOAT, vs, (const void*)(base + vt));
+            glColorPointer(4, GL_UNSIGNED_BYTE, vs, (const void*)(base + vc));
             glBindTexture(GL_TEXTURE_2D, (GLuint)cmd->texture.id);
             glScissor(
                 (GLint)(cmd->clip_rect.x),
@@ -275,7 +275,9 @@ nk_sfml_render(enum nk_anti_aliasing AA, int max_vertex_buffer, int max_element_
                 (GLint)((window_height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h))),
                 (GLint)(cmd->clip_rect.w),
                 (GLint)(cmd->clip_rect.h));
-            glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+            /* indices of a command are relative to its first vertex */
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->elem_count,
+                GL_UNSIGNED_SHORT, offset, (GLint)cmd->vertex_offset);
             offset += cmd->elem_count;
         }
         nk_clear(&sfml.ctx);
@@ -70,6 +70,8 @@ typedef void(*nkglDeleteBuffers)(GLsizei, GLuint*);
 typedef void (*nkglGenVertexArrays)(GLsizei, GLuint*);
 typedef void (*nkglBindVertexArray)(GLuint);
 typedef void (*nkglDeleteVertexArrays)(GLsizei, const GLuint*);
+/* GL_ARB_draw_elements_base_vertex */
+typedef void(*nkglDrawElementsBaseVertex)(GLenum, GLsizei, GLenum, const GLvoid*, GLint);
 /* GL_ARB_vertex_program / GL_ARB_fragment_program */
 typedef void(*nkglVertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const GLvoid*);
 typedef void(*nkglEnableVertexAttribArray)(GLuint);
@@ -108,6 +110,7 @@ static nkglDeleteBuffers glDeleteBuffers;
 static nkglGenVertexArrays glGenVertexArrays;
 static nkglBindVertexArray glBindVertexArray;
 static nkglDeleteVertexArrays glDeleteVertexArrays;
+static nkglDrawElementsBaseVertex glDrawElementsBaseVertex;
 static nkglVertexAttribPointer glVertexAttribPointer;
 static nkglEnableVertexAttribArray glEnableVertexAttribArray;
 static nkglDisableVertexAttribArray glDisableVertexAttribArray;
@@ -156,6 +159,7 @@ struct opengl_info {
     int glsl_available;
     int vertex_buffer_obj_available;
     int vertex_array_obj_available;
+    int draw_base_vertex_available;
     int map_buffer_range_available;
     int fragment_program_available;
     int frame_buffer_object_available;
@@ -332,6 +336,11 @@ nk_load_opengl(struct opengl_info *gl)
         glBindVertexArray = GL_EXT(glBindVertexArray);
         glDeleteVertexArrays = GL_EXT(glDeleteVertexArrays);
     }
+    gl->draw_base_vertex_available = nk_x11_check_extension(gl, "GL_ARB_draw_elements_base_vertex");
+    if (gl->draw_base_vertex_available) {
+        /* GL_ARB_draw_elements_base_vertex */
+        glDrawElementsBaseVertex = GL_EXT(glDrawElementsBaseVertex);
+    }
     gl->frame_buffer_object_available = nk_x11_check_extension(gl, "GL_ARB_framebuffer_object");
     if (gl->frame_buffer_object_available) {
         /* GL_ARB_framebuffer_object */
@@ -349,6 +358,10 @@ nk_load_opengl(struct opengl_info *gl)
         fprintf(stdout, "[GL] Error: GL_ARB_vertex_array_object is not available!\n");
         failed = nk_true;
     }
+    if (!gl->draw_base_vertex_available) {
+        fprintf(stdout, "[GL] Error: GL_ARB_draw_elements_base_vertex is not available!\n");
+        failed = nk_true;
+    }
     if (!gl->frame_buffer_object_available) {
         fprintf(stdout, "[GL] Error: GL_ARB_framebuffer_object is not available!\n");
         failed = nk_true;
@@ -562,7 +575,9 @@ nk_x11_render(enum nk_anti_aliasing AA, int max_vertex_buffer, int max_element_b
                 (GLint)((height - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h))),
                 (GLint)(cmd->clip_rect.w),
                 (GLint)(cmd->clip_rect.h));
-            glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+            /* indices of a command are relative to its first vertex */
+            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->elem_count,
+                GL_UNSIGNED_SHORT, offset, (GLint)cmd->vertex_offset);
             offset += cmd->elem_count;
         }
         nk_clear(&x11.ctx);
@@ -238,13 +238,14 @@ main(void)
         #endif
         /* ----------------------------------------- */
 
-        /* Draw framebuffer */
-        nk_rawfb_render(rawfb, nk_rgb(30,30,30), 1);
+        /* Draw framebuffer: only areas which changed are redrawn */
+        {int count;
+        const struct nk_rect *damage;
+        damage = nk_rawfb_render_damage(rawfb, nk_rgb(30,30,30), &count);
 
         /* Emulate framebuffer */
-        XClearWindow(xw.dpy, xw.win);
-        nk_xlib_render(xw.win);
-        XFlush(xw.dpy);
+        nk_xlib_render_damage(xw.win, damage, count);
+        XFlush(xw.dpy);}
 
         /* Timing */
         dt = timestamp() - started;
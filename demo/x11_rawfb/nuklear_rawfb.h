@@ -43,6 +43,7 @@ rawfb_pl;
 /* All functions are thread-safe */
 NK_API struct rawfb_context *nk_rawfb_init(void *fb, void *tex_mem, const unsigned int w, const unsigned int h, const unsigned int pitch, const rawfb_pl pl);
 NK_API void                  nk_rawfb_render(const struct rawfb_context *rawfb, const struct nk_color clear, const unsigned char enable_clear);
+NK_API const struct nk_rect *nk_rawfb_render_damage(struct rawfb_context *rawfb, const struct nk_color clear, int *count);
 NK_API void                  nk_rawfb_shutdown(struct rawfb_context *rawfb);
 NK_API void                  nk_rawfb_resize_fb(struct rawfb_context *rawfb, void *fb, const unsigned int w, const unsigned int h, const unsigned int pitch, const rawfb_pl pl);
 
@@ -64,9 +65,12 @@ struct rawfb_image {
 struct rawfb_context {
     struct nk_context ctx;
     struct nk_rect scissors;
+    struct nk_rect clip;
     struct rawfb_image fb;
     struct rawfb_image font_tex;
     struct nk_font_atlas atlas;
+    struct nk_rect damage[NK_DAMAGE_MAX];
+    unsigned char redraw;
 };
 
 #ifndef MIN
@@ -182,7 +186,7 @@ nk_rawfb_img_setpixel(const struct rawfb_image *img,
         ptr = img->pixels + (img->pitch * y0);
 	pixel = (unsigned int *)ptr;
 
-        if (img->format == NK_FONT_ATLAS_ALPHA8) {
+        if (img->format == NK_FONT_ATLAS_ALPHA8 || img->format == NK_FONT_ATLAS_R8) {
             ptr[x0] = col.a;
         } else {
 	    pixel[x0] = c;
@@ -200,7 +204,7 @@ nk_rawfb_img_getpixel(const struct rawfb_image *img, const int x0, const int y0)
     if (y0 < img->h && y0 >= 0 && x0 >= 0 && x0 < img->w) {
         ptr = img->pixels + (img->pitch * y0);
 
-        if (img->format == NK_FONT_ATLAS_ALPHA8) {
+        if (img->format == NK_FONT_ATLAS_ALPHA8 || img->format == NK_FONT_ATLAS_R8) {
             col.a = ptr[x0];
             col.b = col.g = col.r = 0xff;
         } else {
@@ -233,10 +237,11 @@ nk_rawfb_scissor(struct rawfb_context *rawfb,
                  const float w,
                  const float h)
 {
-    rawfb->scissors.x = MIN(MAX(x, 0), rawfb->fb.w);
-    rawfb->scissors.y = MIN(MAX(y, 0), rawfb->fb.h);
-    rawfb->scissors.w = MIN(MAX(w + x, 0), rawfb->fb.w);
-    rawfb->scissors.h = MIN(MAX(h + y, 0), rawfb->fb.h);
+    /* clip is (x0, y0, x1, y1) same as scissors */
+    rawfb->scissors.x = MIN(MAX(x, rawfb->clip.x), rawfb->clip.w);
+    rawfb->scissors.y = MIN(MAX(y, rawfb->clip.y), rawfb->clip.h);
+    rawfb->scissors.w = MIN(MAX(w + x, rawfb->clip.x), rawfb->clip.w);
+    rawfb->scissors.h = MIN(MAX(h + y, rawfb->clip.y), rawfb->clip.h);
 }
 
 static void
@@ -627,6 +632,9 @@ nk_rawfb_draw_rect_multi_color(const struct rawfb_context *rawfb,
 
     for (i=0; i<h; i++) {
 	for (j=0; j<w; j++) {
+	    if (x+j < rawfb->scissors.x || x+j >= rawfb->scissors.w ||
+		y+i < rawfb->scissors.y || y+i >= rawfb->scissors.h)
+		continue;
 	    if (i==0) {
 		nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, edge_t[j]);
 	    } else if (i==h-1) {
@@ -856,11 +864,17 @@ nk_rawfb_init(void *fb, void *tex_mem, const unsigned int w, const unsigned int
 
     switch(rawfb->font_tex.format) {
     case NK_FONT_ATLAS_ALPHA8:
+    case NK_FONT_ATLAS_R8:
         rawfb->font_tex.pitch = rawfb->font_tex.w * 1;
         break;
     case NK_FONT_ATLAS_RGBA32:
         rawfb->font_tex.pitch = rawfb->font_tex.w * 4;
         break;
+    default:
+        /* compressed atlases cannot be sampled in software */
+        NK_ASSERT(0);
+        free(rawfb);
+        return NULL;
     };
     /* Store the font texture in tex scratch memory */
     memcpy(rawfb->font_tex.pixels, tex, rawfb->font_tex.pitch * rawfb->font_tex.h);
@@ -868,6 +882,8 @@ nk_rawfb_init(void *fb, void *tex_mem, const unsigned int w, const unsigned int
     if (rawfb->atlas.default_font)
         nk_style_set_font(&rawfb->ctx, &rawfb->atlas.default_font->handle);
     nk_style_load_all_cursors(&rawfb->ctx, rawfb->atlas.cursors);
+    rawfb->clip = nk_rect(0, 0, rawfb->fb.w, rawfb->fb.h);
+    rawfb->redraw = 1;
     nk_rawfb_scissor(rawfb, 0, 0, rawfb->fb.w, rawfb->fb.h);
     return rawfb;
 }
@@ -887,7 +903,7 @@ nk_rawfb_stretch_image(const struct rawfb_image *dst,
     /* Simple nearest filtering rescaling */
     /* TODO: use bilinear filter */
     for (j = 0; j < (short)dst_rect->h; j++) {
-        for (i = 0; i < (short)dst_rect->w; i++) {
+        for (i = 0; i < (short)dst_rect->w; i++, xoff += xinc) {
             if (dst_scissors) {
                 if (i + (int)(dst_rect->x + 0.5f) < dst_scissors->x || i + (int)(dst_rect->x + 0.5f) >= dst_scissors->w)
                     continue;
@@ -902,7 +918,6 @@ nk_rawfb_stretch_image(const struct rawfb_image *dst,
 		col.b = fg->b;
 	    }
             nk_rawfb_img_blendpixel(dst, i + (int)(dst_rect->x + 0.5f), j + (int)(dst_rect->y + 0.5f), col);
-            xoff += xinc;
         }
         xoff = src_rect->x;
         yoff += yinc;
@@ -1033,17 +1048,14 @@ nk_rawfb_resize_fb(struct rawfb_context *rawfb,
     rawfb->fb.pixels = fb;
     rawfb->fb.pitch = pitch;
     rawfb->fb.pl = pl;
+    rawfb->clip = nk_rect(0, 0, w, h);
+    rawfb->redraw = 1;
 }
 
-NK_API void
-nk_rawfb_render(const struct rawfb_context *rawfb,
-                const struct nk_color clear,
-                const unsigned char enable_clear)
+static void
+nk_rawfb_draw_commands(const struct rawfb_context *rawfb)
 {
     const struct nk_command *cmd;
-    if (enable_clear)
-        nk_rawfb_clear(rawfb, clear);
-
     nk_foreach(cmd, (struct nk_context*)&rawfb->ctx) {
         switch (cmd->type) {
         case NK_COMMAND_NOP: break;
@@ -1122,7 +1134,57 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         } break;
         default: break;
         }
-    } nk_clear((struct nk_context*)&rawfb->ctx);
+    }
+}
+
+NK_API void
+nk_rawfb_render(const struct rawfb_context *rawfb,
+                const struct nk_color clear,
+                const unsigned char enable_clear)
+{
+    if (enable_clear)
+        nk_rawfb_clear(rawfb, clear);
+    nk_rawfb_draw_commands(rawfb);
+    nk_clear((struct nk_context*)&rawfb->ctx);
+}
+
+NK_API const struct nk_rect*
+nk_rawfb_render_damage(struct rawfb_context *rawfb,
+                       const struct nk_color clear,
+                       int *count)
+{
+    /* Only clears and redraws the areas which changed since the last
+     * frame. Returns the updated rectangles which have to be blitted. */
+    const struct nk_rect *damage;
+    int i, n, num = 0;
+
+    damage = nk_frame_damage(&rawfb->ctx, &n);
+    if (rawfb->redraw) {
+        /* framebuffer content is unknown so redraw everything */
+        damage = &rawfb->clip;
+        rawfb->redraw = 0;
+        n = 1;
+    }
+    for (i = 0; i < n; ++i) {
+        int x0 = MAX((int)damage[i].x, 0);
+        int y0 = MAX((int)damage[i].y, 0);
+        int x1 = MIN((int)(damage[i].x + damage[i].w + 1.0f), rawfb->fb.w);
+        int y1 = MIN((int)(damage[i].y + damage[i].h + 1.0f), rawfb->fb.h);
+        if (x0 >= x1 || y0 >= y1) continue;
+        rawfb->damage[num++] = nk_rect(x0, y0, x1 - x0, y1 - y0);
+    }
+    for (i = 0; i < num; ++i) {
+        const struct nk_rect *r = &rawfb->damage[i];
+        rawfb->clip = nk_rect(r->x, r->y, r->x + r->w, r->y + r->h);
+        nk_rawfb_scissor(rawfb, r->x, r->y, r->w, r->h);
+        nk_rawfb_fill_rect(rawfb, r->x, r->y, r->w, r->h, 0, clear);
+        nk_rawfb_draw_commands(rawfb);
+    }
+    rawfb->clip = nk_rect(0, 0, rawfb->fb.w, rawfb->fb.h);
+    nk_rawfb_scissor(rawfb, 0, 0, rawfb->fb.w, rawfb->fb.h);
+    nk_clear(&rawfb->ctx);
+    *count = num;
+    return rawfb->damage;
 }
 #endif
 
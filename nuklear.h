@@ -103,16 +103,20 @@
 /// NK_INCLUDE_FONT_BAKING          | Defining this adds `stb_truetype` and `stb_rect_pack` implementation to this library and provides font baking and rendering. If you already have font handling or do not want to use this font handler you don't have to define it.
 /// NK_INCLUDE_DEFAULT_FONT         | Defining this adds the default font: ProggyClean.ttf into this library which can be loaded into a font atlas and allows using this library without having a truetype font
 /// NK_INCLUDE_COMMAND_USERDATA     | Defining this adds a userdata pointer into each command. Can be useful for example if you want to provide custom shaders depending on the used widget. Can be combined with the style structures.
+/// NK_INCLUDE_GLYPH_ADVANCE        | Defining this adds the optional `advance` callback to `nk_user_font`, which returns the advance of a single glyph and lets text clamping add up advances instead of measuring every prefix. Since it is used whenever it is not NULL, `nk_user_font` has to be zero initialized.
 /// NK_BUTTON_TRIGGER_ON_RELEASE    | Different platforms require button clicks occurring either on buttons being pressed (up to down) or released (down to up). By default this library will react on buttons being pressed, but if you define this it will only trigger if a button is released.
 /// NK_ZERO_COMMAND_MEMORY          | Defining this will zero out memory for each drawing command added to a drawing queue (inside nk_command_buffer_push). Zeroing command memory is very useful for fast checking (using memcmp) if command buffers are equal and avoid drawing frames when nothing on screen has changed since previous frame.
 /// NK_UINT_DRAW_INDEX              | Defining this will set the size of vertex index elements when using NK_VERTEX_BUFFER_OUTPUT to 32bit instead of the default of 16bit
 /// NK_KEYSTATE_BASED_INPUT         | Define this if your backend uses key state for each frame rather than key press/release events
+/// NK_INCLUDE_SIMD                 | If defined and the target supports SSE2 it will include header `<emmintrin.h>` and compute normals of anti-aliased lines and shapes for two points at once as well as the coverage of four pixels at once when rasterizing font glyphs. Normals are identical to the scalar code. Glyph coverage sums the same values in a different order and may differ from the scalar code by one level (1 LSB).
+/// NK_INCLUDE_FILE_MAPPING        | If defined it will include the platform headers for memory mapped files (`<sys/mman.h>` or `<windows.h>`) and provide `nk_font_atlas_add_from_file_mapped`, which keeps TTF files mapped read-only instead of loading them into allocator memory.
 ///
 /// !!! WARNING
 ///     The following flags will pull in the standard C library:
 ///     - NK_INCLUDE_DEFAULT_ALLOCATOR
 ///     - NK_INCLUDE_STANDARD_IO
 ///     - NK_INCLUDE_STANDARD_VARARGS
+///     - NK_INCLUDE_FILE_MAPPING
 ///
 /// !!! WARNING
 ///     The following flags if defined need to be defined for both header and implementation:
@@ -124,6 +128,8 @@
 ///     - NK_INCLUDE_DEFAULT_FONT
 ///     - NK_INCLUDE_STANDARD_VARARGS
 ///     - NK_INCLUDE_COMMAND_USERDATA
+///     - NK_INCLUDE_GLYPH_ADVANCE
+///     - NK_INCLUDE_FILE_MAPPING
 ///     - NK_UINT_DRAW_INDEX
 ///
 /// ### Constants
@@ -132,12 +138,17 @@
 /// NK_BUFFER_DEFAULT_INITIAL_SIZE  | Initial buffer size allocated by all buffers while using the default allocator functions included by defining NK_INCLUDE_DEFAULT_ALLOCATOR. If you don't want to allocate the default 4k memory then redefine it.
 /// NK_MAX_NUMBER_BUFFER            | Maximum buffer size for the conversion buffer between float and string Under normal circumstances this should be more than sufficient.
 /// NK_INPUT_MAX                    | Defines the max number of bytes which can be added as text input in one frame. Under normal circumstances this should be more than sufficient.
+/// NK_DAMAGE_MAX                   | Maximum number of damage rectangles returned by `nk_frame_damage`. Additional damaged regions get merged into existing rectangles.
+/// NK_POOL_MAX_CAPACITY            | Maximum number of windows, panels or tables inside a single page of a dynamic context pool. Pages start at 16 elements and double with each new page up to this size.
+/// NK_FONT_LOOKUP_MAX              | Number of codepoints starting at zero whose glyphs are looked up by a direct table inside each `nk_font`. Glyphs above are found by binary search over the font's codepoint ranges. Defaults to the Latin-1 block.
 ///
 /// !!! WARNING
 ///     The following constants if defined need to be defined for both header and implementation:
 ///     - NK_MAX_NUMBER_BUFFER
 ///     - NK_BUFFER_DEFAULT_INITIAL_SIZE
 ///     - NK_INPUT_MAX
+///     - NK_DAMAGE_MAX
+///     - NK_FONT_LOOKUP_MAX
 ///
 /// ### Dependencies
 /// Function    | Description
@@ -239,6 +250,12 @@ extern "C" {
 #ifndef NK_MAX_NUMBER_BUFFER
   #define NK_MAX_NUMBER_BUFFER 64
 #endif
+#ifndef NK_DAMAGE_MAX
+  #define NK_DAMAGE_MAX 16
+#endif
+#ifndef NK_FONT_LOOKUP_MAX
+  #define NK_FONT_LOOKUP_MAX 256
+#endif
 #ifndef NK_SCROLLBAR_HIDING_TIMEOUT
   #define NK_SCROLLBAR_HIDING_TIMEOUT 4.0f
 #endif
@@ -484,6 +501,8 @@ typedef void (*nk_plugin_free)(nk_handle, void *old);
 typedef int(*nk_plugin_filter)(const struct nk_text_edit*, nk_rune unicode);
 typedef void(*nk_plugin_paste)(nk_handle, struct nk_text_edit*);
 typedef void(*nk_plugin_copy)(nk_handle, const char*, int len);
+typedef void(*nk_plugin_job)(void *job, int index);
+typedef void(*nk_plugin_parallel_for)(nk_handle, nk_plugin_job, void *job, int count);
 
 struct nk_allocator {
     nk_handle userdata;
@@ -542,6 +561,12 @@ enum nk_symbol_type {
 /// __nk_init_custom__  | Initializes context from two buffers. One for draw commands the other for window/panel/table allocations
 /// __nk_clear__        | Called at the end of the frame to reset and prepare the context for the next frame
 /// __nk_free__         | Shutdown and free all memory allocated inside the context
+/// __nk_shrink__       | Gives memory of unused windows, panels and tables back to the allocator
+/// __nk_double_buffer__| Keeps the previous frame readable while the next one is built
+/// __nk_chunked_commands__| Lets the command buffer grow without copying commands
+/// __nk_memory_stats__ | Returns command and page memory statistics collected over the last frames
+/// __nk_memory_stats_reset__| Restarts collecting memory statistics
+/// __nk_memory_assert_on_overflow__| Asserts as soon as a window runs out of memory
 /// __nk_set_user_data__| Utility function to pass user data to draw command
  */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -651,6 +676,146 @@ NK_API void nk_clear(struct nk_context*);
 /// __ctx__     | Must point to a previously initialized `nk_context` struct
 */
 NK_API void nk_free(struct nk_context*);
+/*/// #### nk_shrink
+/// Windows, panels and tables are allocated in pages which start small and
+/// double in size up to `NK_POOL_MAX_CAPACITY`. Freed elements are reused
+/// most recently freed first but are otherwise kept for the lifetime of the
+/// context. This call gives every page without any element in use back to
+/// the allocator, for example after a burst of popups or combo boxes has been
+/// closed. Window and table lookup indices that grew during such a burst and
+/// are less than a quarter full are rebuilt at a fitting size, so they do not
+/// keep their pages alive. Best called after `nk_clear`.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_size nk_shrink(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+///
+/// Returns the number of bytes released. Always 0 for contexts with fixed
+/// memory from `nk_init_fixed` or a fixed pool passed to `nk_init_custom`
+*/
+NK_API nk_size nk_shrink(struct nk_context*);
+/*/// #### nk_double_buffer
+/// Lets the context alternate between two command buffers. `nk_clear` then
+/// keeps the commands of the finished frame untouched in one buffer while the
+/// next frame is built into the other one. The finished frame is returned by
+/// `nk_frame_previous` and can be iterated with `nk_frame_foreach` or converted
+/// with `nk_convert_frame` on a render thread without any locks, as long as
+/// the render thread is done with it before the next call to `nk_clear` and
+/// the fonts used are thread-safe (see `nk_convert_frame`).
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_double_buffer(struct nk_context *ctx, struct nk_buffer *memory);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a context initialized by `nk_init_default`, `nk_init` or `nk_init_custom`
+/// __memory__  | Optional second command buffer owned by the context from now on. If NULL a dynamic buffer of the same size and allocator as the context command buffer is created
+///
+/// Returns `true(1)` on success or `false(0)` for contexts created by
+/// `nk_init_fixed`, which keep their window memory inside the command buffer
+*/
+NK_API int nk_double_buffer(struct nk_context*, struct nk_buffer *memory);
+/*/// #### nk_chunked_commands
+/// Turns the dynamic command buffer of a context into a chunked one (see
+/// `nk_buffer_init_chunked`). Once the buffer is full, draw commands continue in
+/// a newly allocated chunk instead of copying all commands of the frame into
+/// a bigger block. `nk__next` and all other command iteration follow chunks
+/// on their own. Contexts from `nk_init_custom` can pass a chunked buffer
+/// directly instead.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_chunked_commands(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a context initialized by `nk_init_default`, `nk_init` or `nk_init_custom`
+///
+/// Returns `true(1)` on success or `false(0)` if the command buffer is fixed
+/// or holds windows at its back as for `nk_init_fixed`
+*/
+NK_API int nk_chunked_commands(struct nk_context*);
+/*/// #### nk_memory_stats
+/// Returns how much memory the context used over all frames since it was
+/// initialized or `nk_memory_stats_reset` was called. Frames are recorded by
+/// `nk_clear`, so the numbers always describe finished frames. Especially useful
+/// to size the memory block passed to `nk_init_fixed`: run the UI through all
+/// its states with either a dynamic or a big fixed context and use
+/// `suggested_fixed_size` afterwards.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_stats(const struct nk_context *ctx, struct nk_memory_stats *stats);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+/// __stats__   | Must point to a `nk_memory_stats` struct to fill
+///
+/// Field                   | Description
+/// ------------------------|---------------------------------------------------
+/// __command_bytes__       | Draw command memory used by the last finished frame
+/// __command_peak__        | Most draw command memory used by any frame
+/// __command_needed__      | Most draw command memory asked for by any frame including allocations which failed
+/// __page_elements__       | Window, panel and table slots taken from the pool or the back of the command buffer
+/// __page_elements_free__  | Number of those slots currently on the free list
+/// __page_elements_peak__  | Most slots taken at the end of any frame
+/// __largest_window__      | Name of the window with the most draw commands in the last frame or NULL
+/// __largest_window_bytes__| Draw command memory of that window including its popups
+/// __suggested_fixed_size__| Smallest memory block for `nk_init_fixed` which would have held every frame so far
+/// __overflows__           | Number of times a window or the overlay ran out of memory
+/// __overflow_window__     | Name of the first window which ran out of memory or NULL
+/// __frames__              | Number of recorded frames
+*/
+struct nk_memory_stats {
+    nk_size command_bytes;
+    nk_size command_peak;
+    nk_size command_needed;
+    unsigned int page_elements;
+    unsigned int page_elements_free;
+    unsigned int page_elements_peak;
+    const char *largest_window;
+    nk_size largest_window_bytes;
+    nk_size suggested_fixed_size;
+    unsigned int overflows;
+    const char *overflow_window;
+    unsigned int frames;
+};
+NK_API void nk_memory_stats(const struct nk_context*, struct nk_memory_stats*);
+/*/// #### nk_memory_stats_reset
+/// Drops all peaks and overflows collected so far. Slots currently taken by
+/// windows, panels and tables stay counted.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_stats_reset(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+*/
+NK_API void nk_memory_stats_reset(struct nk_context*);
+/*/// #### nk_memory_assert_on_overflow
+/// Running out of memory normally just drops the draw commands or widgets
+/// which did not fit. If enabled `NK_ASSERT` triggers at the end of the first
+/// window running out of memory instead. The window name is already stored
+/// in `nk_memory_stats` at that point.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_assert_on_overflow(struct nk_context *ctx, int enable);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+/// __enable__  | `true(1)` to assert on overflow, `false(0)` to silently drop
+*/
+NK_API void nk_memory_assert_on_overflow(struct nk_context*, int enable);
 #ifdef NK_INCLUDE_COMMAND_USERDATA
 /*/// #### nk_set_user_data
 /// Sets the currently passed userdata passed down into each draw command.
@@ -1133,7 +1298,12 @@ NK_API void nk_input_end(struct nk_context*);
 /// __nk__begin__       | Returns the first draw command in the context draw command list to be drawn
 /// __nk__next__        | Increments the draw command iterator to the next command inside the context draw command list
 /// __nk_foreach__      | Iterates over each draw command inside the context draw command list
+/// __nk_frame_is_dirty__| Returns if the draw command list changed since the last frame
+/// __nk_frame_damage__ | Returns all screen areas which changed since the last frame
+/// __nk_frame_previous__| Returns a read-only view of the previous frame of a double buffered context
+/// __nk_frame_foreach__| Iterates over each draw command of such a frame
 /// __nk_convert__      | Converts from the abstract draw commands list into a hardware accessible vertex format
+/// __nk_convert_frame__| Converts the draw commands of such a frame into a caller owned draw list
 /// __nk_draw_begin__   | Returns the first vertex command in the context vertex draw list to be executed
 /// __nk__draw_next__   | Increments the vertex command iterator to the next command inside the context vertex command list
 /// __nk__draw_end__    | Returns the end of the vertex draw list
@@ -1147,6 +1317,9 @@ enum nk_convert_result {
     NK_CONVERT_VERTEX_BUFFER_FULL = NK_FLAG(2),
     NK_CONVERT_ELEMENT_BUFFER_FULL = NK_FLAG(3)
 };
+enum nk_convert_flags {
+    NK_CONVERT_CACHE_WINDOWS = NK_FLAG(0) /* reuse vertices of windows whose draw commands did not change */
+};
 struct nk_draw_null_texture {
     nk_handle texture; /* texture handle to a texture with a white pixel */
     struct nk_vec2 uv; /* coordinates to a white pixel in the texture  */
@@ -1162,6 +1335,9 @@ struct nk_convert_config {
     const struct nk_draw_vertex_layout_element *vertex_layout; /* describes the vertex output format and packing */
     nk_size vertex_size; /* sizeof one vertex for vertex packing */
     nk_size vertex_alignment; /* vertex alignment: Can be obtained by NK_ALIGNOF */
+    nk_flags flags; /* combination of nk_convert_flags: defaults to 0 */
+    nk_plugin_parallel_for parallel_for; /* optional: runs jobs on other threads and returns once all are done */
+    nk_handle parallel_userdata; /* userdata passed to `parallel_for` */
 };
 /*/// #### nk__begin
 /// Returns a draw command list iterator to iterate all draw
@@ -1208,6 +1384,90 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
 /// Iterates over each draw command inside the context draw command list
 */
 #define nk_foreach(c, ctx) for((c) = nk__begin(ctx); (c) != 0; (c) = nk__next(ctx,c))
+/*/// #### nk_frame_previous
+/// Returns a read-only view of the draw commands of the frame finished by the
+/// last `nk_clear` of a double buffered context (see `nk_double_buffer`). The
+/// view stays valid until the next call to `nk_clear` and only refers to
+/// command memory, so it can be handed to another thread.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// struct nk_frame nk_frame_previous(const struct nk_context*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a double buffered `nk_context` struct
+///
+/// Returns the previous frame or an empty frame if the context is not double buffered
+*/
+struct nk_frame {
+    const void *memory; /* command memory of the frame */
+    const struct nk_buffer_chunk *chunk; /* additional memory of a chunked command buffer */
+    nk_size begin; /* offset of the first command */
+    nk_size end; /* offset behind the last command */
+};
+NK_API struct nk_frame nk_frame_previous(const struct nk_context*);
+/*/// #### nk__frame_begin
+/// Returns the first draw command of a frame returned by `nk_frame_previous`
+/// or NULL if the frame is empty
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_command* nk__frame_begin(const struct nk_frame*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+NK_API const struct nk_command* nk__frame_begin(const struct nk_frame*);
+/*/// #### nk__frame_next
+/// Returns the draw command after `cmd` inside a frame or NULL at its end
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_command* nk__frame_next(const struct nk_frame*, const struct nk_command*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+NK_API const struct nk_command* nk__frame_next(const struct nk_frame*, const struct nk_command*);
+/*/// #### nk_frame_foreach
+/// Iterates over each draw command of a frame returned by `nk_frame_previous`
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// #define nk_frame_foreach(c, frame)
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#define nk_frame_foreach(c, f) for((c) = nk__frame_begin(f); (c) != 0; (c) = nk__frame_next(f,c))
+/*/// #### nk_frame_is_dirty
+/// Returns if the draw command list of the current frame differs from the
+/// one of the last frame. Each command buffer keeps a running hash over its
+/// commands which is compared once the frame is built. Can be used to skip rendering
+/// completely while the UI is idle.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_frame_is_dirty(struct nk_context*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+///
+/// Returns `true(1)` if anything will be drawn differently than last frame or `false(0)` otherwise
+*/
+NK_API int nk_frame_is_dirty(struct nk_context*);
+/*/// #### nk_frame_damage
+/// Returns the screen areas which have to be redrawn to update the last frame
+/// into the current one. A window is damaged if its draw commands or its
+/// z-order changed, in which case both its old and new area are returned.
+/// Software renderers can clear and redraw the commands clipped to each
+/// rectangle instead of the whole screen.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_rect* nk_frame_damage(struct nk_context*, int *count);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+/// __count__   | Must point to an integer receiving the number of rectangles
+///
+/// Returns up to `NK_DAMAGE_MAX` damage rectangles
+*/
+NK_API const struct nk_rect* nk_frame_damage(struct nk_context*, int *count);
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 /*/// #### nk_convert
 /// Converts all internal draw commands into vertex draw commands and fills
@@ -1237,8 +1497,66 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
 /// NK_CONVERT_COMMAND_BUFFER_FULL  | The provided buffer for storing draw commands is full or failed to allocate more memory
 /// NK_CONVERT_VERTEX_BUFFER_FULL   | The provided buffer for storing vertices is full or failed to allocate more memory
 /// NK_CONVERT_ELEMENT_BUFFER_FULL  | The provided buffer for storing indicies is full or failed to allocate more memory
+///
+/// With the default 16-bit `nk_draw_index` a new draw command is started once the
+/// vertices of the current one cannot be addressed anymore. Its indices are relative
+/// to `nk_draw_command.vertex_offset`, so backends have to add it to each index,
+/// for example as base vertex of `glDrawElementsBaseVertex` or `DrawIndexed`. It
+/// stays zero as long as a frame has less than 65535 vertices and is always zero
+/// if `NK_UINT_DRAW_INDEX` is defined.
+///
+/// Setting `NK_CONVERT_CACHE_WINDOWS` in `nk_convert_config.flags` keeps a copy of
+/// the generated vertices, indices and draw commands for each window. Windows whose
+/// draw commands did not change since the last frame (see `nk_window_is_dirty`)
+/// are copied from that cache instead of being tessellated again. The output is
+/// identical to the uncached path. The cache is allocated with the context
+/// allocator, so it is not used for contexts created by `nk_init_fixed`. Images
+/// and fonts are compared by handle, so clear the flag for one frame if you
+/// update texture contents or font glyphs without changing the handle. Windows
+/// drawing text with a font of an atlas baked by `nk_font_atlas_bake_dynamic`
+/// are never cached, since its glyphs can move whenever the atlas is full.
+///
+/// If `nk_convert_config.parallel_for` is set, windows are tessellated on their
+/// own by jobs and then copied into the output buffers with rebased indices.
+/// The callback has to call the given job for every index from 0 to `count`-1,
+/// using any number of threads, and return after all jobs finished. Custom
+/// draw callbacks are still called on the calling thread. Jobs allocate from
+/// the context allocator and query fonts concurrently, so both have to be
+/// thread-safe. Looking up glyphs of a dynamic font atlas modifies the atlas,
+/// so windows drawing text with one are converted on the calling thread
+/// after all jobs finished. Like the window cache this requires a context
+/// with a dynamic command buffer and produces the same output as the serial
+/// path.
 */
 NK_API nk_flags nk_convert(struct nk_context*, struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
+/*/// #### nk_convert_frame
+/// Converts the draw commands of a frame returned by `nk_frame_previous` like
+/// `nk_convert` but into a caller owned draw list instead of the one inside the
+/// context. Nothing of the context is touched, so it can run on a render
+/// thread while the next frame is built. The window cache and
+/// `parallel_for` of the config are not used. Text commands still call the
+/// `query` callback of their font, so on a render thread it runs
+/// concurrently with text measuring on the thread building the next frame
+/// and has to be thread-safe against it. Fonts of an atlas baked by
+/// `nk_font_atlas_bake_dynamic` are not, and are rejected by an assert.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_flags nk_convert_frame(const struct nk_frame*, struct nk_draw_list*, struct nk_buffer *cmds,
+///     struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __frame__   | Must point to a frame returned by `nk_frame_previous`
+/// __list__    | Must point to a draw list initialized with `nk_draw_list_init`. Iterate the result with `nk_draw_list_foreach`
+/// __cmds__    | Must point to a previously initialized buffer to hold converted vertex draw commands
+/// __vertices__| Must point to a previously initialized buffer to hold all produced vertices
+/// __elements__| Must point to a previously initialized buffer to hold all produced vertex indices
+/// __config__  | Must point to a filled out `nk_config` struct to configure the conversion process
+///
+/// Returns one of enum nk_convert_result error codes
+*/
+NK_API nk_flags nk_convert_frame(const struct nk_frame*, struct nk_draw_list*, struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
 /*/// #### nk__draw_begin
 /// Returns a draw vertex command buffer iterator to iterate over the vertex draw command buffer
 ///
@@ -1407,6 +1725,8 @@ NK_API const struct nk_draw_command* nk__draw_next(const struct nk_draw_command*
 /// nk_window_is_collapsed              | Returns if the window with given name is currently minimized/collapsed
 /// nk_window_is_closed                 | Returns if the currently processed window was closed
 /// nk_window_is_hidden                 | Returns if the currently processed window was hidden
+/// nk_window_is_dirty                  | Returns if the draw commands of a window changed since the last frame
+/// nk_window_get_command_bytes         | Returns the draw command memory used by a window in its last finished frame
 /// nk_window_is_active                 | Same as nk_window_has_focus for some reason
 /// nk_window_is_hovered                | Returns if the currently processed window is currently being hovered by mouse
 /// nk_window_is_any_hovered            | Return if any window currently hovered
@@ -1809,6 +2129,38 @@ NK_API int nk_window_is_closed(struct nk_context*, const char*);
 /// Returns `true(1)` if current window is hidden or `false(0)` window not found or visible
 */
 NK_API int nk_window_is_hidden(struct nk_context*, const char*);
+/*/// #### nk_window_is_dirty
+/// Returns if the draw commands of the window with given name differ from
+/// the ones of the last frame. Has to be called after all windows have been
+/// processed, same as `nk__begin`. Commands are compared by content, so
+/// images and custom callbacks only compare their handles, not what they draw.
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_window_is_dirty(struct nk_context *ctx, const char *name);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+/// __name__    | Identifier of window you want to check if it changed
+///
+/// Returns `true(1)` if window changed or was not found or `false(0)` if it draws the same as last frame
+*/
+NK_API int nk_window_is_dirty(struct nk_context*, const char*);
+/*/// #### nk_window_get_command_bytes
+/// Returns how much draw command memory the window with given name used the
+/// last time `nk_end` was called for it, including all its popups.
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_size nk_window_get_command_bytes(struct nk_context *ctx, const char *name);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct
+/// __name__    | Identifier of window you want the memory usage of
+///
+/// Returns the number of bytes or 0 if the window was not found or is hidden
+*/
+NK_API nk_size nk_window_get_command_bytes(struct nk_context*, const char*);
 /*/// #### nk_window_is_active
 /// Same as nk_window_has_focus for some reason
 /// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
@@ -3774,7 +4126,7 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
             return text_width;
         }
 
-        struct nk_user_font font;
+        struct nk_user_font font = {0};
         font.userdata.ptr = &your_font_class_or_struct;
         font.height = your_font_height;
         font.width = your_text_width_calculation;
@@ -3782,6 +4134,20 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
         struct nk_context ctx;
         nk_init_default(&ctx, &font);
 
+    If the width of a string is always the sum of the advances of its glyphs
+    and `NK_INCLUDE_GLYPH_ADVANCE` is defined, the font can also provide the
+    advance of a single glyph. Text clamping then adds up advances instead of
+    measuring every prefix of the text. The callback is used whenever it is
+    not NULL, so zero the struct as above before filling it in. Fonts baked
+    by the font atlas do this without the define unless they use kerning.
+
+        float your_glyph_advance(nk_handle handle, float height, nk_rune codepoint)
+        {
+            your_font_type *type = handle.ptr;
+            return ...;
+        }
+        font.advance = your_glyph_advance;
+
     2.) Using your own implementation with vertex buffer output
     --------------------------------------------------------------
     While the first approach works fine if you don't want to use the optional
@@ -3812,7 +4178,7 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
             glyph.offset.y = ...;
         }
 
-        struct nk_user_font font;
+        struct nk_user_font font = {0};
         font.userdata.ptr = &your_font_class_or_struct;
         font.height = your_font_height;
         font.width = your_text_width_calculation;
@@ -3891,9 +4257,134 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
         cfg.coord_type = NK_COORD_PIXEL;
         nk_font *font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 13, &cfg);
 
+    Fonts with a lot of glyphs like `nk_font_chinese_glyph_ranges` take a long
+    time to bake and require a huge texture. Calling `nk_font_atlas_bake_dynamic`
+    instead of `nk_font_atlas_bake` creates an empty texture of fixed size and
+    rasterizes each glyph the first time it is looked up. If the texture is full
+    glyphs that were not used in the current frame get evicted. Since the image
+    keeps changing it is not freed by `nk_font_atlas_end` and the ttf memory
+    blocks are kept alive by `nk_font_atlas_cleanup`. After each `nk_convert`
+    (or your own text drawing) call `nk_font_atlas_dirty` to get the
+    region of the image that changed and upload it before drawing. This call
+    also marks the end of a frame for glyph eviction. Since every glyph lookup
+    can modify the atlas, all text of a dynamic atlas has to be measured and
+    converted on one thread. `nk_convert` does not hand windows using it to
+    `parallel_for` jobs and `nk_convert_frame` cannot be used with it.
+
+        const void* img = nk_font_atlas_bake_dynamic(&atlas, 1024, 1024, NK_FONT_ATLAS_ALPHA8);
+        nk_font_atlas_end(&atlas, nk_handle_id(texture), &null);
+        while (1) {
+            struct nk_recti dirty;
+            nk_convert(&ctx, &cmds, &vertices, &elements, &config);
+            img = nk_font_atlas_dirty(&atlas, &dirty);
+            if (dirty.w && dirty.h)
+                your_texture_update(texture, img, dirty.x, dirty.y, dirty.w, dirty.h);
+        }
+
+    Baking all glyphs up front can also be spread over multiple threads by
+    calling `nk_font_atlas_bake_parallel` with a `nk_plugin_parallel_for`
+    callback like the one in `nk_convert_config`. Glyphs are packed on the
+    calling thread and then rendered by jobs, each into its own rectangle, so
+    the image is identical to the one returned by `nk_font_atlas_bake`. The
+    callback has to call the given job for every index from 0 to `count`-1 and
+    return after all jobs finished. Jobs allocate from the temporary atlas
+    allocator so it has to be thread-safe.
+
+        const void* img = nk_font_atlas_bake_parallel(&atlas, &w, &h,
+            NK_FONT_ATLAS_RGBA32, your_parallel_for, nk_handle_ptr(your_pool));
+
+    To skip baking on the next start the result can be stored with
+    `nk_font_atlas_save` after baking and before `nk_font_atlas_end` or
+    `nk_font_atlas_cleanup`. The call returns the number of bytes required and
+    only writes the blob if `size` is big enough. The blob holds the image, font
+    metrics, glyphs and the custom cursor rectangle and is keyed by a hash of
+    all added ttf files and font configs. It is only valid for the same
+    version and build of nuklear.
+
+    After adding the same fonts again `nk_font_atlas_load` can be called
+    instead of `nk_font_atlas_bake`. It returns 0 if the blob does not match
+    the added fonts or format, in which case you have to bake again. Otherwise
+    the returned image points into the given memory, which therefore only has
+    to stay valid until it is uploaded, so a memory mapped file works fine.
+
+        nk_font_atlas_begin(&atlas);
+        font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 13, 0);
+        img = nk_font_atlas_load(&atlas, blob, blob_size, &w, &h, NK_FONT_ATLAS_RGBA32);
+        if (!img) {
+            img = nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
+            blob_size = nk_font_atlas_save(&atlas, 0, 0);
+            blob = malloc(blob_size);
+            nk_font_atlas_save(&atlas, blob, blob_size);
+            your_write_file(blob, blob_size);
+        }
+        your_upload_texture(img, w, h);
+        nk_font_atlas_end(&atlas, nk_handle_id(texture), 0);
+
+    Setting `nk_font_config.sdf` bakes a signed distance field of each glyph
+    instead of its coverage. The outline maps to alpha 0.5 and the field
+    reaches `nk_font_config.sdf_spread` pixels to both sides, which also grows
+    each glyph by that border. Oversampling is ignored for these fonts. Glyph
+    metrics are always scaled by the requested height, so a copy of
+    `font->handle` with another `height` draws the same glyphs at a different
+    size without baking again. The renderer has to turn the field back into
+    coverage, for example with `smoothstep(0.5 - w, 0.5 + w, alpha)` and `w`
+    taken from `fwidth(alpha)` in the fragment shader (see the glfw_opengl3
+    demo). Since the shader is usually picked by texture, all fonts inside
+    one atlas should use the same mode.
+
+        struct nk_font_config cfg = nk_font_config(32);
+        cfg.sdf = nk_true;
+        font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 32, &cfg);
+        ...
+        struct nk_user_font small = font->handle;
+        small.height = 12;
+        nk_style_set_font(ctx, &small);
+
+    Besides `NK_FONT_ATLAS_RGBA32` with white color and coverage in alpha,
+    the image can be baked with one byte per pixel for single channel
+    textures. `NK_FONT_ATLAS_ALPHA8` and `NK_FONT_ATLAS_R8` produce the same
+    bytes but R8 is meant to be uploaded as red channel texture and sampled
+    as (1,1,1,r), for example with a `GL_TEXTURE_SWIZZLE_RGBA` of
+    (`GL_ONE`,`GL_ONE`,`GL_ONE`,`GL_RED`), so the white pixel of the null
+    texture stays white. `NK_FONT_ATLAS_BC4` compresses the R8 image into
+    BC4/RGTC1 blocks of 8 bytes per 4x4 pixels, which can be uploaded with
+    `glCompressedTexImage2D` and `GL_COMPRESSED_RED_RGTC1` and sampled the same
+    way. Fully transparent and opaque pixels stay exact while anti-aliased
+    edges are quantized to 8 levels per block. BC4 is not supported by
+    `nk_font_atlas_bake_dynamic`.
+
+    `nk_font_atlas_add_from_file` reads the whole TTF file into memory of the
+    permanent allocator, which for large CJK fonts means several megabytes of
+    heap per font. With `NK_INCLUDE_FILE_MAPPING` defined
+    `nk_font_atlas_add_from_file_mapped` instead maps the file read-only and
+    bakes straight from the mapping, so only the pages of the glyphs actually
+    used are read. The file is unmapped by `nk_font_atlas_cleanup` or
+    `nk_font_atlas_clear` and has to stay unchanged until then.
+
+        font = nk_font_atlas_add_from_file_mapped(&atlas, "Path/To/Your/CJK_Font.ttf", 13, &cfg);
+
+    By default glyphs are packed font by font into a texture of 512 or 1024
+    pixels width, which for sets of fonts with very different sizes often ends
+    up taller than necessary. Setting `nk_font_atlas.packing` after
+    `nk_font_atlas_init` to `NK_FONT_ATLAS_PACK_SKYLINE`,
+    `NK_FONT_ATLAS_PACK_MAXRECTS` or `NK_FONT_ATLAS_PACK_BEST` instead packs
+    the glyphs of all fonts together, tries all power of two widths between
+    256 and 4096 and keeps the smallest power of two texture. MaxRects usually
+    packs tightest but takes longer for large glyph sets.
+
+        nk_font_atlas_init_default(&atlas);
+        atlas.packing = NK_FONT_ATLAS_PACK_BEST;
+
+    Setting `nk_font_config.kerning` reads the kerning pairs of all baked
+    glyphs from the font's `kern` table into a hash table of the font. Text
+    widths and the glyph advance returned to the draw list then include the
+    kerning to the next glyph. Fonts that only store kerning in their `GPOS`
+    table are not kerned.
+
 */
 struct nk_user_font_glyph;
 typedef float(*nk_text_width_f)(nk_handle, float h, const char*, int len);
+typedef float(*nk_glyph_advance_f)(nk_handle, float h, nk_rune codepoint);
 typedef void(*nk_query_font_glyph_f)(nk_handle handle, float font_height,
                                     struct nk_user_font_glyph *glyph,
                                     nk_rune codepoint, nk_rune next_codepoint);
@@ -3924,6 +4415,11 @@ struct nk_user_font {
     nk_handle texture;
     /* texture handle to the used font atlas or texture */
 #endif
+#ifdef NK_INCLUDE_GLYPH_ADVANCE
+    nk_glyph_advance_f advance;
+    /* optional single glyph advance in pixel callback. Used whenever it is
+     * not NULL, so the struct has to be zero initialized */
+#endif
 };
 
 #ifdef NK_INCLUDE_FONT_BAKING
@@ -3958,13 +4454,20 @@ struct nk_font_config {
 
     unsigned char ttf_data_owned_by_atlas;
     /* used inside font atlas: default to: 0*/
+    unsigned char ttf_data_mapped;
+    /* used inside font atlas: TTF blob is a read-only file mapping */
     unsigned char merge_mode;
     /* merges this font into the last font */
     unsigned char pixel_snap;
     /* align every character to pixel boundary (if true set oversample (1,1)) */
     unsigned char oversample_v, oversample_h;
     /* rasterize at hight quality for sub-pixel position */
-    unsigned char padding[3];
+    unsigned char sdf;
+    /* bake a signed distance field usable at any scale instead of coverage */
+    unsigned char sdf_spread;
+    /* pixels the distance field reaches outside of each glyph: default to: 4 */
+    unsigned char kerning;
+    /* apply kerning pairs of the font's `kern` table between baked glyphs */
 
     float size;
     /* baked pixel height of the font */
@@ -3989,6 +4492,19 @@ struct nk_font_glyph {
     float u0, v0, u1, v1;
 };
 
+struct nk_font_kerning {
+    nk_rune first, second;
+    float advance;
+};
+
+struct nk_font_glyph_range {
+    nk_rune first, last;
+    /* inclusive codepoint range */
+    nk_rune glyph;
+    /* index of the glyph of `first` inside the font glyph array */
+};
+
+struct nk_font_cache;
 struct nk_font {
     struct nk_font *next;
     struct nk_user_font handle;
@@ -3999,17 +4515,42 @@ struct nk_font {
     nk_rune fallback_codepoint;
     nk_handle texture;
     struct nk_font_config *config;
+    const struct nk_font_glyph *lookup[NK_FONT_LOOKUP_MAX];
+    /* glyphs of codepoints below NK_FONT_LOOKUP_MAX or 0 if not baked */
+    struct nk_font_glyph_range *ranges;
+    int range_count;
+    /* disjoint codepoint ranges of all configs sorted by codepoint */
+    struct nk_font_cache *cache;
+    /* glyph cache of atlases baked by `nk_font_atlas_bake_dynamic` */
+    struct nk_font_kerning *kerning;
+    nk_uint kerning_mask;
+    /* hash table of kerning pairs with `kerning_mask`+1 slots or 0 if none */
 };
 
 enum nk_font_atlas_format {
     NK_FONT_ATLAS_ALPHA8,
-    NK_FONT_ATLAS_RGBA32
+    NK_FONT_ATLAS_RGBA32,
+    NK_FONT_ATLAS_R8,
+    NK_FONT_ATLAS_BC4
+};
+
+enum nk_font_atlas_packing {
+    NK_FONT_ATLAS_PACK_DEFAULT,
+    /* skyline bottom-left font by font into a width of 512 or 1024 */
+    NK_FONT_ATLAS_PACK_SKYLINE,
+    /* skyline best-fit over the glyphs of all fonts */
+    NK_FONT_ATLAS_PACK_MAXRECTS,
+    /* maximal rectangles bottom-left over the glyphs of all fonts */
+    NK_FONT_ATLAS_PACK_BEST
+    /* tries both SKYLINE and MAXRECTS and keeps the smaller texture */
 };
 
 struct nk_font_atlas {
     void *pixel;
     int tex_width;
     int tex_height;
+    enum nk_font_atlas_format format;
+    enum nk_font_atlas_packing packing;
 
     struct nk_allocator permanent;
     struct nk_allocator temporary;
@@ -4019,6 +4560,10 @@ struct nk_font_atlas {
 
     int glyph_count;
     struct nk_font_glyph *glyphs;
+    struct nk_font_glyph_range *glyph_ranges;
+    struct nk_font_kerning *kerning;
+    int kerning_count;
+    struct nk_font_cache *cache;
     struct nk_font *default_font;
     struct nk_font *fonts;
     struct nk_font_config *config;
@@ -4046,9 +4591,17 @@ NK_API struct nk_font* nk_font_atlas_add_from_memory(struct nk_font_atlas *atlas
 #ifdef NK_INCLUDE_STANDARD_IO
 NK_API struct nk_font* nk_font_atlas_add_from_file(struct nk_font_atlas *atlas, const char *file_path, float height, const struct nk_font_config*);
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_API struct nk_font* nk_font_atlas_add_from_file_mapped(struct nk_font_atlas *atlas, const char *file_path, float height, const struct nk_font_config*);
+#endif
 NK_API struct nk_font *nk_font_atlas_add_compressed(struct nk_font_atlas*, void *memory, nk_size size, float height, const struct nk_font_config*);
 NK_API struct nk_font* nk_font_atlas_add_compressed_base85(struct nk_font_atlas*, const char *data, float height, const struct nk_font_config *config);
 NK_API const void* nk_font_atlas_bake(struct nk_font_atlas*, int *width, int *height, enum nk_font_atlas_format);
+NK_API const void* nk_font_atlas_bake_parallel(struct nk_font_atlas*, int *width, int *height, enum nk_font_atlas_format, nk_plugin_parallel_for, nk_handle userdata);
+NK_API const void* nk_font_atlas_bake_dynamic(struct nk_font_atlas*, int width, int height, enum nk_font_atlas_format);
+NK_API const void* nk_font_atlas_dirty(struct nk_font_atlas*, struct nk_recti *region);
+NK_API nk_size nk_font_atlas_save(const struct nk_font_atlas*, void *memory, nk_size size);
+NK_API const void* nk_font_atlas_load(struct nk_font_atlas*, const void *memory, nk_size size, int *width, int *height, enum nk_font_atlas_format);
 NK_API void nk_font_atlas_end(struct nk_font_atlas*, nk_handle tex, struct nk_draw_null_texture*);
 NK_API const struct nk_font_glyph* nk_font_find_glyph(struct nk_font*, nk_rune unicode);
 NK_API void nk_font_atlas_cleanup(struct nk_font_atlas *atlas);
@@ -4088,6 +4641,30 @@ NK_API void nk_font_atlas_clear(struct nk_font_atlas*);
     NK_INCLUDE_DEFAULT_ALLOCATOR which uses the standard library memory
     allocation functions malloc and free and takes over complete control over
     memory in this library.
+
+    Dynamic buffers only grow by default, so a single frame with a huge table
+    keeps its memory around for the lifetime of the buffer. `nk_buffer_trim_policy`
+    lets a buffer give memory back instead. Each `nk_buffer_clear` then marks the
+    end of a frame: the high-water mark of the frame is merged into one decaying
+    over `frames` frames, and once that mark stayed below `threshold` times the
+    buffer size for `frames` frames in a row the buffer is replaced by a smaller
+    one. Works for the context command buffer `ctx->memory` as well as for the
+    command, vertex and element buffers passed to `nk_convert`:
+
+        nk_buffer_init_default(&vertices);
+        nk_buffer_trim_policy(&vertices, 120, 0.25f);
+        nk_buffer_trim_policy(&ctx.memory, 120, 0.25f);
+
+    Growing a dynamic buffer copies everything allocated so far into the new
+    memory block, which shows up as a frame time spike the first time a heavy
+    view is opened. Chunked buffers from `nk_buffer_init_chunked` instead
+    continue in a newly allocated chunk and never move existing allocations.
+    Offsets keep counting across chunks, so only code resolving offsets into
+    pointers has to know about them. This only fits the context command buffer,
+    which is never read as one contiguous block: allocations have to fit into
+    a single chunk, only the front of the buffer is available and
+    `nk_buffer_memory` just returns the first chunk. `nk_buffer_clear` replaces
+    all chunks by one block big enough for all of them.
 */
 struct nk_memory_status {
     void *memory;
@@ -4100,7 +4677,8 @@ struct nk_memory_status {
 
 enum nk_allocation_type {
     NK_BUFFER_FIXED,
-    NK_BUFFER_DYNAMIC
+    NK_BUFFER_DYNAMIC,
+    NK_BUFFER_CHUNKED
 };
 
 enum nk_buffer_allocation_type {
@@ -4115,6 +4693,14 @@ struct nk_buffer_marker {
 };
 
 struct nk_memory {void *ptr;nk_size size;};
+struct nk_buffer_chunk {
+    struct nk_buffer_chunk *next;
+    /* previously allocated chunk */
+    nk_size offset;
+    /* buffer offset of the first byte inside the chunk */
+    nk_size size;
+    /* number of bytes following the chunk header */
+};
 struct nk_buffer {
     struct nk_buffer_marker marker[NK_BUFFER_MAX];
     /* buffer marker to free a buffer to a certain offset */
@@ -4134,6 +4720,16 @@ struct nk_buffer {
     /* number of allocation calls */
     nk_size size;
     /* current size of the buffer */
+    nk_size trim_peak;
+    /* high-water mark of used memory decaying each frame */
+    unsigned int trim_frames;
+    /* frames to decay over and to stay below the threshold, 0 disables trimming */
+    unsigned int trim_count;
+    /* frames the high-water mark has stayed below the threshold so far */
+    float trim_threshold;
+    /* fraction of the memory block the high-water mark has to stay below */
+    struct nk_buffer_chunk *chunk;
+    /* newest chunk a chunked buffer continued in after `memory` was full */
 };
 
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -4141,11 +4737,13 @@ NK_API void nk_buffer_init_default(struct nk_buffer*);
 #endif
 NK_API void nk_buffer_init(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_init_fixed(struct nk_buffer*, void *memory, nk_size size);
+NK_API void nk_buffer_init_chunked(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_info(struct nk_memory_status*, struct nk_buffer*);
 NK_API void nk_buffer_push(struct nk_buffer*, enum nk_buffer_allocation_type type, const void *memory, nk_size size, nk_size align);
 NK_API void nk_buffer_mark(struct nk_buffer*, enum nk_buffer_allocation_type type);
 NK_API void nk_buffer_reset(struct nk_buffer*, enum nk_buffer_allocation_type type);
 NK_API void nk_buffer_clear(struct nk_buffer*);
+NK_API void nk_buffer_trim_policy(struct nk_buffer*, unsigned int frames, float threshold);
 NK_API void nk_buffer_free(struct nk_buffer*);
 NK_API void *nk_buffer_memory(struct nk_buffer*);
 NK_API const void *nk_buffer_memory_const(const struct nk_buffer*);
@@ -4565,6 +5163,7 @@ struct nk_command_buffer {
     int use_clipping;
     nk_handle userdata;
     nk_size begin, end, last;
+    nk_hash hash; /* running hash over all finished commands */
 };
 
 /* shape outlines */
@@ -4723,6 +5322,8 @@ struct nk_draw_command {
     /* current screen clipping rectangle */
     nk_handle texture;
     /* current texture to set */
+    unsigned int vertex_offset;
+    /* vertex referenced by index 0 of this draw batch */
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     nk_handle userdata;
 #endif
@@ -4748,6 +5349,12 @@ struct nk_draw_list {
     enum nk_anti_aliasing line_AA;
     enum nk_anti_aliasing shape_AA;
 
+    /* offsets for layouts of float position, float uv and R8G8B8A8 color */
+    int vertex_packed;
+    nk_size position_offset;
+    nk_size uv_offset;
+    nk_size color_offset;
+
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     nk_handle userdata;
 #endif
@@ -5349,6 +5956,7 @@ struct nk_panel {
 #endif
 
 struct nk_table;
+struct nk_table_slot;
 enum nk_window_flags {
     NK_WINDOW_PRIVATE       = NK_FLAG(11),
     NK_WINDOW_DYNAMIC       = NK_WINDOW_PRIVATE,
@@ -5405,6 +6013,25 @@ struct nk_property_state {
     int state;
 };
 
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+struct nk_vertex_cache {
+    /* vertex output of a window for nk_convert */
+    struct nk_buffer commands;
+    struct nk_buffer vertices;
+    struct nk_buffer elements;
+    nk_hash key;
+    int valid;
+    struct nk_rect clip_rect;
+    nk_size cmd_offset;
+    unsigned int cmd_count, vertex_count, element_count;
+
+    /* draw list state in front of the window in the last frame */
+    struct nk_draw_command enter;
+    struct nk_rect enter_clip;
+    int enter_valid;
+};
+#endif
+
 struct nk_window {
     unsigned int seq;
     nk_hash name;
@@ -5416,6 +6043,11 @@ struct nk_window {
     struct nk_command_buffer buffer;
     struct nk_panel *layout;
     float scrollbar_hiding_timer;
+    nk_hash draw_hash;
+    int dirty;
+    struct nk_rect draw_bounds;
+    struct nk_rect damage_bounds;
+    unsigned int damage_order;
 
     /* persistent widget state */
     struct nk_property_state property;
@@ -5425,6 +6057,12 @@ struct nk_window {
 
     struct nk_table *tables;
     unsigned int table_count;
+    struct nk_table_slot *table_index;
+    unsigned int table_index_size;
+    unsigned int table_index_count;
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    struct nk_vertex_cache vertex_cache;
+#endif
 
     /* window list hooks */
     struct nk_window *next;
@@ -5537,6 +6175,15 @@ struct nk_table {
     struct nk_table *next, *prev;
 };
 
+/* open addressing hash index over all `nk_table` pages of a window. Each
+ * slot references a value by table page and offset inside the page and is
+ * empty if `tbl` is null. */
+struct nk_table_slot {
+    struct nk_table *tbl;
+    nk_hash key;
+    nk_uint index;
+};
+
 union nk_page_data {
     struct nk_table tbl;
     struct nk_panel pan;
@@ -5551,6 +6198,7 @@ struct nk_page_element {
 
 struct nk_page {
     unsigned int size;
+    unsigned int capacity;
     struct nk_page *next;
     struct nk_page_element win[1];
 };
@@ -5566,6 +6214,13 @@ struct nk_pool {
     nk_size cap;
 };
 
+/* open addressing hash index of all windows inside the window list
+ * by name hash. Slot is empty if `win` is null. */
+struct nk_window_slot {
+    struct nk_window *win;
+    nk_hash name;
+};
+
 struct nk_context {
 /* public: can be accessed freely */
     struct nk_input input;
@@ -5593,6 +6248,25 @@ struct nk_context {
     struct nk_text_edit text_edit;
     /* draw buffer used for overlay drawing operation like cursor */
     struct nk_command_buffer overlay;
+    /* hash over all draw commands of the last build frame */
+    nk_hash frame_hash;
+    int frame_dirty;
+    nk_hash overlay_hash;
+    struct nk_rect overlay_bounds;
+    struct nk_rect damage[NK_DAMAGE_MAX];
+    int damage_count;
+    /* second command buffer holding the previous frame if double buffered */
+    struct nk_buffer memory_prev;
+    struct nk_frame frame;
+    int double_buffered;
+    /* memory statistics, failed allocations are tracked per frame */
+    struct nk_memory_stats stats;
+    nk_size memory_failed;
+    nk_size memory_failed_base;
+    nk_size pool_failed;
+    int memory_assert;
+    char overflow_window[NK_WINDOW_MAX_NAME];
+    char largest_window[NK_WINDOW_MAX_NAME];
 
     /* windows */
     int build;
@@ -5605,6 +6279,9 @@ struct nk_context {
     struct nk_page_element *freelist;
     unsigned int count;
     unsigned int seq;
+    struct nk_window_slot *window_index;
+    unsigned int window_index_size;
+    unsigned int window_index_count;
 };
 
 /* ==============================================================
@@ -5690,6 +6367,10 @@ template<typename T> struct nk_alignof{struct Big {T x; char c;}; enum {
 #define NK_POOL_DEFAULT_CAPACITY 16
 #endif
 
+#ifndef NK_POOL_MAX_CAPACITY
+#define NK_POOL_MAX_CAPACITY 256
+#endif
+
 #ifndef NK_DEFAULT_COMMAND_BUFFER_SIZE
 #define NK_DEFAULT_COMMAND_BUFFER_SIZE (4*1024)
 #endif
@@ -5708,6 +6389,21 @@ template<typename T> struct nk_alignof{struct Big {T x; char c;}; enum {
 #ifdef NK_INCLUDE_STANDARD_VARARGS
 #include <stdarg.h> /* valist, va_start, va_end, ... */
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+#ifdef _WIN32
+#include <windows.h> /* CreateFileMappingA, MapViewOfFile, ... */
+#else
+#include <sys/mman.h> /* mmap, munmap */
+#include <sys/stat.h> /* fstat */
+#include <fcntl.h> /* open */
+#include <unistd.h> /* close */
+#endif
+#endif
+#if defined(NK_INCLUDE_SIMD) && (defined(__SSE2__) || defined(_M_X64) ||\
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h> /* __m128, _mm_add_ps, ... */
+#define NK_SSE2
+#endif
 #ifndef NK_ASSERT
 #include <assert.h>
 #define NK_ASSERT(expr) assert(expr)
@@ -5802,6 +6498,7 @@ NK_LIB float nk_sin(float x);
 NK_LIB float nk_cos(float x);
 NK_LIB nk_uint nk_round_up_pow2(nk_uint v);
 NK_LIB struct nk_rect nk_shrink_rect(struct nk_rect r, float amount);
+NK_LIB struct nk_rect nk_merge_rect(struct nk_rect a, struct nk_rect b);
 NK_LIB struct nk_rect nk_pad_rect(struct nk_rect r, struct nk_vec2 pad);
 NK_LIB void nk_unify(struct nk_rect *clip, const struct nk_rect *a, float x0, float y0, float x1, float y1);
 NK_LIB double nk_pow(double x, int n);
@@ -5830,6 +6527,10 @@ NK_LIB int nk_strfmt(char *buf, int buf_size, const char *fmt, va_list args);
 #ifdef NK_INCLUDE_STANDARD_IO
 NK_LIB char *nk_file_load(const char* path, nk_size* siz, struct nk_allocator *alloc);
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_LIB void *nk_file_map(const char* path, nk_size* siz);
+NK_LIB void nk_file_unmap(void *memory, nk_size size);
+#endif
 
 /* buffer */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -5839,11 +6540,15 @@ NK_LIB void nk_mfree(nk_handle unused, void *ptr);
 NK_LIB void* nk_buffer_align(void *unaligned, nk_size align, nk_size *alignment, enum nk_buffer_allocation_type type);
 NK_LIB void* nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type, nk_size size, nk_size align);
 NK_LIB void* nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size);
+NK_LIB void* nk_buffer_at(const struct nk_buffer *b, nk_size offset);
+NK_LIB const void* nk_buffer_chunk_at(const void *memory, const struct nk_buffer_chunk *chunk, nk_size offset);
 
 /* draw */
 NK_LIB void nk_command_buffer_init(struct nk_command_buffer *cb, struct nk_buffer *b, enum nk_command_clipping clip);
 NK_LIB void nk_command_buffer_reset(struct nk_command_buffer *b);
 NK_LIB void* nk_command_buffer_push(struct nk_command_buffer* b, enum nk_command_type t, nk_size size);
+NK_LIB nk_hash nk_command_hash(nk_hash hash, const void *ptr, nk_size size);
+NK_LIB void nk_command_buffer_hash(struct nk_command_buffer *b, nk_size end);
 NK_LIB void nk_draw_symbol(struct nk_command_buffer *out, enum nk_symbol_type type, struct nk_rect content, struct nk_color background, struct nk_color foreground, float border_width, const struct nk_user_font *font);
 
 /* buffering */
@@ -5855,6 +6560,9 @@ NK_LIB void nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *b
 NK_LIB void nk_finish(struct nk_context *ctx, struct nk_window *w);
 NK_LIB void nk_build(struct nk_context *ctx);
 
+/* memory statistics */
+NK_LIB void nk_memory_check(struct nk_context *ctx, const char *name);
+
 /* text editor */
 NK_LIB void nk_textedit_clear_state(struct nk_text_edit *state, enum nk_text_edit_type type, nk_plugin_filter filter);
 NK_LIB void nk_textedit_click(struct nk_text_edit *state, float x, float y, const struct nk_user_font *font, float row_height);
@@ -5871,17 +6579,23 @@ NK_LIB void nk_remove_window(struct nk_context*, struct nk_window*);
 NK_LIB void nk_free_window(struct nk_context *ctx, struct nk_window *win);
 NK_LIB struct nk_window *nk_find_window(struct nk_context *ctx, nk_hash hash, const char *name);
 NK_LIB void nk_insert_window(struct nk_context *ctx, struct nk_window *win, enum nk_window_insert_location loc);
+NK_LIB void nk_window_index_free(struct nk_context *ctx);
+NK_LIB void nk_window_index_rebuild(struct nk_context *ctx);
 
 /* pool */
 NK_LIB void nk_pool_init(struct nk_pool *pool, struct nk_allocator *alloc, unsigned int capacity);
 NK_LIB void nk_pool_free(struct nk_pool *pool);
 NK_LIB void nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size);
 NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool);
+NK_LIB struct nk_page_element *nk_pool_alloc_range(struct nk_pool *pool, unsigned int count);
+NK_LIB nk_size nk_pool_shrink(struct nk_pool *pool, struct nk_page_element **freelist, unsigned int *released);
 
 /* page-element */
 NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx);
 NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem);
 NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem);
+NK_LIB struct nk_page_element* nk_create_page_elements(struct nk_context *ctx, unsigned int count);
+NK_LIB void nk_free_page_elements(struct nk_context *ctx, struct nk_page_element *elem, unsigned int count);
 
 /* table */
 NK_LIB struct nk_table* nk_create_table(struct nk_context *ctx);
@@ -5890,6 +6604,8 @@ NK_LIB void nk_free_table(struct nk_context *ctx, struct nk_table *tbl);
 NK_LIB void nk_push_table(struct nk_window *win, struct nk_table *tbl);
 NK_LIB nk_uint *nk_add_value(struct nk_context *ctx, struct nk_window *win, nk_hash name, nk_uint value);
 NK_LIB nk_uint *nk_find_value(struct nk_window *win, nk_hash name);
+NK_LIB void nk_table_index_rebuild(struct nk_context *ctx, struct nk_window *win);
+NK_LIB void nk_table_index_free(struct nk_context *ctx, struct nk_window *win);
 
 /* panel */
 NK_LIB void *nk_create_panel(struct nk_context *ctx);
@@ -6016,6 +6732,19 @@ NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_styl
 NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior);
 NK_LIB void nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant *variant, float inc_per_pixel, const enum nk_property_filter filter);
 
+#ifdef NK_INCLUDE_FONT_BAKING
+/* font */
+NK_LIB nk_glyph_advance_f nk_font_baked_advance(const struct nk_user_font *font);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+NK_LIB int nk_user_font_is_dynamic(const struct nk_user_font *font);
+#endif
+#endif
+
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+/* vertex */
+NK_LIB void nk_vertex_cache_free(struct nk_vertex_cache *cache);
+#endif
+
 #endif
 
 
@@ -6241,6 +6970,16 @@ nk_pad_rect(struct nk_rect r, struct nk_vec2 pad)
     r.h -= 2 * pad.y;
     return r;
 }
+NK_LIB struct nk_rect
+nk_merge_rect(struct nk_rect a, struct nk_rect b)
+{
+    struct nk_rect res;
+    res.x = NK_MIN(a.x, b.x);
+    res.y = NK_MIN(a.y, b.y);
+    res.w = NK_MAX(a.x + a.w, b.x + b.w) - res.x;
+    res.h = NK_MAX(a.y + a.h, b.y + b.h) - res.y;
+    return res;
+}
 NK_API struct nk_vec2
 nk_vec2(float x, float y)
 {
@@ -7328,6 +8067,78 @@ nk_file_load(const char* path, nk_size* siz, struct nk_allocator *alloc)
     return buf;
 }
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_LIB void*
+nk_file_map(const char* path, nk_size* siz)
+{
+    /* maps the whole file read-only into memory */
+    void *memory;
+#ifdef _WIN32
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+
+    NK_ASSERT(path);
+    NK_ASSERT(siz);
+    if (!path || !siz) return 0;
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) return 0;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+        (unsigned long long)size.QuadPart > (nk_size)-1) {
+        CloseHandle(file);
+        return 0;
+    }
+    mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    CloseHandle(file);
+    if (!mapping) return 0;
+    memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!memory) return 0;
+    *siz = (nk_size)size.QuadPart;
+#else
+    struct stat st;
+    int fd;
+
+    NK_ASSERT(path);
+    NK_ASSERT(siz);
+    if (!path || !siz) return 0;
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    memory = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return 0;
+    *siz = (nk_size)st.st_size;
+#endif
+    return memory;
+}
+NK_LIB void
+nk_file_unmap(void *memory, nk_size size)
+{
+    if (!memory) return;
+#ifdef _WIN32
+    NK_UNUSED(size);
+    UnmapViewOfFile(memory);
+#else
+    munmap(memory, (size_t)size);
+#endif
+}
+#endif
+NK_INTERN nk_glyph_advance_f
+nk_user_font_advance(const struct nk_user_font *font)
+{
+#ifdef NK_INCLUDE_GLYPH_ADVANCE
+    if (font->advance) return font->advance;
+#endif
+#ifdef NK_INCLUDE_FONT_BAKING
+    return nk_font_baked_advance(font);
+#else
+    return 0;
+#endif
+}
 NK_LIB int
 nk_text_clamp(const struct nk_user_font *font, const char *text,
     int text_len, float space, int *glyphs, float *text_width,
@@ -7345,12 +8156,20 @@ nk_text_clamp(const struct nk_user_font *font, const char *text,
     int sep_len = 0;
     int sep_g = 0;
     float sep_width = 0;
+    nk_glyph_advance_f advance = nk_user_font_advance(font);
     sep_count = NK_MAX(sep_count,0);
 
+    /* sum up glyph advances if provided instead of measuring each prefix.
+     * Invalid glyphs fall back to measuring since fonts may handle them
+     * differently than a single glyph */
     glyph_len = nk_utf_decode(text, &unicode, text_len);
     while (glyph_len && (width < space) && (len < text_len)) {
         len += glyph_len;
-        s = font->width(font->userdata, font->height, text, len);
+        if (advance && unicode == NK_UTF_INVALID)
+            advance = 0;
+        if (advance)
+            s = width + advance(font->userdata, font->height, unicode);
+        else s = font->width(font->userdata, font->height, text, len);
         for (i = 0; i < sep_count; ++i) {
             if (unicode != sep_list[i]) continue;
             sep_width = last_width = width;
@@ -8062,6 +8881,43 @@ nk_buffer_init_fixed(struct nk_buffer *b, void *m, nk_size size)
     b->memory.size = size;
     b->size = size;
 }
+NK_API void
+nk_buffer_init_chunked(struct nk_buffer *b, const struct nk_allocator *a,
+    nk_size size)
+{
+    nk_buffer_init(b, a, size);
+    if (!b || !b->memory.ptr) return;
+    b->type = NK_BUFFER_CHUNKED;
+}
+NK_LIB const void*
+nk_buffer_chunk_at(const void *memory, const struct nk_buffer_chunk *chunk,
+    nk_size offset)
+{
+    /* chunks are linked newest first and each one continues the offsets
+     * of the one before, so the first chunk starting in front of the
+     * offset contains it */
+    while (chunk && offset < chunk->offset)
+        chunk = chunk->next;
+    if (!chunk) return nk_ptr_add_const(void, memory, offset);
+    return nk_ptr_add_const(void, chunk + 1, offset - chunk->offset);
+}
+NK_LIB void*
+nk_buffer_at(const struct nk_buffer *b, nk_size offset)
+{
+    NK_ASSERT(b);
+    if (!b->chunk) return nk_ptr_add(void, b->memory.ptr, offset);
+    return (void*)nk_buffer_chunk_at(b->memory.ptr, b->chunk, offset);
+}
+NK_INTERN void
+nk_buffer_free_chunks(struct nk_buffer *b, nk_size offset)
+{
+    /* frees all chunks starting at or behind the offset */
+    while (b->chunk && b->chunk->offset >= offset) {
+        struct nk_buffer_chunk *next = b->chunk->next;
+        b->pool.free(b->pool.userdata, b->chunk);
+        b->chunk = next;
+    }
+}
 NK_LIB void*
 nk_buffer_align(void *unaligned,
     nk_size align, nk_size *alignment,
@@ -8130,6 +8986,46 @@ nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size)
     }
     return temp;
 }
+NK_INTERN void*
+nk_buffer_alloc_chunked(struct nk_buffer *b, nk_size size, nk_size align)
+{
+    struct nk_buffer_chunk *chunk = b->chunk;
+    nk_size begin = (chunk) ? chunk->offset: 0;
+    nk_size capacity = (chunk) ? chunk->size: b->memory.size;
+    nk_size alignment;
+    void *unaligned;
+    void *memory;
+
+    unaligned = nk_buffer_at(b, b->allocated);
+    memory = nk_buffer_align(unaligned, align, &alignment, NK_BUFFER_FRONT);
+    if (b->allocated - begin + alignment + size > capacity) {
+        /* continue in a new chunk instead of moving everything allocated
+         * so far. Its offsets start where the next allocation would have
+         * been placed, so offsets computed up front by the caller hold */
+        struct nk_buffer_chunk *iter;
+        nk_size total = b->memory.size;
+        NK_ASSERT(b->pool.alloc && b->pool.free);
+        if (!b->pool.alloc || !b->pool.free) return 0;
+        for (iter = b->chunk; iter; iter = iter->next)
+            total += iter->size;
+        capacity = (nk_size)((float)total * (b->grow_factor - 1.0f));
+        capacity = NK_MAX(capacity, size + align);
+        chunk = (struct nk_buffer_chunk*)b->pool.alloc(b->pool.userdata, 0,
+            sizeof(struct nk_buffer_chunk) + capacity);
+        NK_ASSERT(chunk);
+        if (!chunk) return 0;
+        chunk->next = b->chunk;
+        chunk->offset = b->allocated + alignment;
+        chunk->size = capacity;
+        b->chunk = chunk;
+        memory = chunk + 1;
+        NK_ASSERT(!align || NK_ALIGN_PTR(memory, align) == memory);
+    }
+    b->allocated += size + alignment;
+    b->needed += alignment;
+    b->calls++;
+    return memory;
+}
 NK_LIB void*
 nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     nk_size size, nk_size align)
@@ -8143,6 +9039,12 @@ nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     NK_ASSERT(size);
     if (!b || !size) return 0;
     b->needed += size;
+    if (b->type == NK_BUFFER_CHUNKED) {
+        /* back allocations would have to move on every new chunk */
+        NK_ASSERT(type == NK_BUFFER_FRONT);
+        if (type != NK_BUFFER_FRONT) return 0;
+        return nk_buffer_alloc_chunked(b, size, align);
+    }
 
     /* calculate total size with needed alignment + size */
     if (type == NK_BUFFER_FRONT)
@@ -8205,6 +9107,11 @@ nk_buffer_reset(struct nk_buffer *buffer, enum nk_buffer_allocation_type type)
 {
     NK_ASSERT(buffer);
     if (!buffer) return;
+    if (buffer->trim_frames) {
+        /* memory released before the end of the frame still counts */
+        nk_size used = buffer->allocated + (buffer->memory.size - buffer->size);
+        buffer->trim_peak = NK_MAX(buffer->trim_peak, used);
+    }
     if (type == NK_BUFFER_BACK) {
         /* reset back buffer either back to marker or empty */
         buffer->needed -= (buffer->memory.size - buffer->marker[type].offset);
@@ -8219,17 +9126,81 @@ nk_buffer_reset(struct nk_buffer *buffer, enum nk_buffer_allocation_type type)
             buffer->allocated = buffer->marker[type].offset;
         else buffer->allocated = 0;
         buffer->marker[type].active = nk_false;
+        if (buffer->type == NK_BUFFER_CHUNKED)
+            nk_buffer_free_chunks(buffer, buffer->allocated);
     }
 }
-NK_API void
-nk_buffer_clear(struct nk_buffer *b)
+NK_INTERN void
+nk_buffer_trim(struct nk_buffer *b)
 {
-    NK_ASSERT(b);
-    if (!b) return;
-    b->allocated = 0;
-    b->size = b->memory.size;
-    b->calls = 0;
-    b->needed = 0;
+    nk_size used = b->allocated + (b->memory.size - b->size);
+    nk_size capacity;
+    void *memory;
+
+    b->trim_peak -= b->trim_peak / b->trim_frames;
+    b->trim_peak = NK_MAX(b->trim_peak, used);
+    if ((float)b->trim_peak >= (float)b->memory.size * b->trim_threshold) {
+        b->trim_count = 0;
+        return;
+    }
+    if (++b->trim_count < b->trim_frames) return;
+    b->trim_count = 0;
+
+    /* buffer is about to be cleared so nothing has to be copied. Twice the
+     * high-water mark leaves room to grow back without reallocating */
+    capacity = (nk_size)nk_round_up_pow2((nk_uint)b->trim_peak) * 2;
+    capacity = NK_MAX(capacity, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    if (capacity >= b->memory.size) return;
+    memory = b->pool.alloc(b->pool.userdata, 0, capacity);
+    if (!memory) return;
+    b->pool.free(b->pool.userdata, b->memory.ptr);
+    b->memory.ptr = memory;
+    b->memory.size = capacity;
+}
+NK_API void
+nk_buffer_trim_policy(struct nk_buffer *b, unsigned int frames,
+    float threshold)
+{
+    NK_ASSERT(b);
+    NK_ASSERT(threshold > 0.0f && threshold <= 1.0f);
+    if (!b) return;
+    b->trim_frames = frames;
+    b->trim_threshold = NK_CLAMP(0.0f, threshold, 1.0f);
+    b->trim_count = 0;
+    b->trim_peak = b->allocated + (b->memory.size - b->size);
+}
+NK_INTERN void
+nk_buffer_merge_chunks(struct nk_buffer *b)
+{
+    /* buffer is about to be cleared so nothing has to be copied and the
+     * next frame of the same size fits into a single block again */
+    struct nk_buffer_chunk *iter;
+    nk_size capacity = b->memory.size;
+    void *memory;
+    for (iter = b->chunk; iter; iter = iter->next)
+        capacity += iter->size;
+    nk_buffer_free_chunks(b, 0);
+    memory = b->pool.alloc(b->pool.userdata, 0, capacity);
+    if (!memory) return;
+    b->pool.free(b->pool.userdata, b->memory.ptr);
+    b->memory.ptr = memory;
+    b->memory.size = capacity;
+    b->size = capacity;
+}
+NK_API void
+nk_buffer_clear(struct nk_buffer *b)
+{
+    NK_ASSERT(b);
+    if (!b) return;
+    if (b->chunk)
+        nk_buffer_merge_chunks(b);
+    if (b->trim_frames && b->type != NK_BUFFER_FIXED &&
+        b->pool.alloc && b->pool.free)
+        nk_buffer_trim(b);
+    b->allocated = 0;
+    b->size = b->memory.size;
+    b->calls = 0;
+    b->needed = 0;
 }
 NK_API void
 nk_buffer_free(struct nk_buffer *b)
@@ -8239,6 +9210,7 @@ nk_buffer_free(struct nk_buffer *b)
     if (b->type == NK_BUFFER_FIXED) return;
     if (!b->pool.free) return;
     NK_ASSERT(b->pool.free);
+    nk_buffer_free_chunks(b, 0);
     b->pool.free(b->pool.userdata, b->memory.ptr);
 }
 NK_API void
@@ -8748,6 +9720,7 @@ nk_command_buffer_init(struct nk_command_buffer *cb,
     cb->begin = b->allocated;
     cb->end = b->allocated;
     cb->last = b->allocated;
+    cb->hash = 0;
 }
 NK_LIB void
 nk_command_buffer_reset(struct nk_command_buffer *b)
@@ -8757,11 +9730,46 @@ nk_command_buffer_reset(struct nk_command_buffer *b)
     b->begin = 0;
     b->end = 0;
     b->last = 0;
+    b->hash = 0;
     b->clip = nk_null_rect;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     b->userdata.ptr = 0;
 #endif
 }
+NK_LIB nk_hash
+nk_command_hash(nk_hash hash, const void *ptr, nk_size size)
+{
+    const nk_byte *data = (const nk_byte*)ptr;
+    nk_uint word;
+    while (size >= sizeof(word)) {
+        NK_MEMCPY(&word, data, sizeof(word));
+        hash = (hash ^ word) * 16777619u;
+        hash ^= hash >> 16;
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    while (size--) {
+        hash = (hash ^ *data++) * 16777619u;
+        hash ^= hash >> 16;
+    }
+    return hash;
+}
+NK_LIB void
+nk_command_buffer_hash(struct nk_command_buffer *b, nk_size end)
+{
+    /* folds the last command into the buffer hash. The `next` offset
+     * is skipped since it depends on everything drawn before. */
+    const struct nk_command *cmd;
+    NK_ASSERT(b);
+    NK_ASSERT(b->base);
+    NK_ASSERT(end >= b->last + sizeof(*cmd));
+    cmd = (const struct nk_command*)nk_buffer_at(b->base, b->last);
+    b->hash = nk_command_hash(b->hash, &cmd->type, sizeof(cmd->type));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    b->hash = nk_command_hash(b->hash, &cmd->userdata, sizeof(cmd->userdata));
+#endif
+    b->hash = nk_command_hash(b->hash, cmd + 1, end - b->last - sizeof(*cmd));
+}
 NK_LIB void*
 nk_command_buffer_push(struct nk_command_buffer* b,
     enum nk_command_type t, nk_size size)
@@ -8769,22 +9777,31 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_command);
     struct nk_command *cmd;
     nk_size alignment;
+    nk_size prev_end;
     void *unaligned;
     void *memory;
 
     NK_ASSERT(b);
     NK_ASSERT(b->base);
     if (!b) return 0;
+    prev_end = b->base->allocated;
     cmd = (struct nk_command*)nk_buffer_alloc(b->base,NK_BUFFER_FRONT,size,align);
     if (!cmd) return 0;
 
+    /* previous command is complete so add it to the buffer hash */
+    if (b->end != b->begin)
+        nk_command_buffer_hash(b, prev_end);
+
     /* make sure the offset to the next command is aligned */
-    b->last = (nk_size)((nk_byte*)cmd - (nk_byte*)b->base->memory.ptr);
+    b->last = b->base->allocated - size;
     unaligned = (nk_byte*)cmd + size;
     memory = NK_ALIGN_PTR(unaligned, align);
     alignment = (nk_size)((nk_byte*)memory - (nk_byte*)unaligned);
 #ifdef NK_ZERO_COMMAND_MEMORY
     NK_MEMSET(cmd, 0, size + alignment);
+#else
+    /* padding is hashed as well so it has to be deterministic */
+    NK_MEMSET(cmd, 0, size);
 #endif
 
     cmd->type = t;
@@ -9232,6 +10249,34 @@ nk_draw_list_init(struct nk_draw_list *list)
         list->circle_vtx[i].y = (float)NK_SIN(a);
     }
 }
+NK_INTERN void
+nk_draw_list_setup_layout(struct nk_draw_list *list)
+{
+    /* detect the layout used by most backends once instead of walking
+     * the layout description for every vertex */
+    const struct nk_draw_vertex_layout_element *it = list->config.vertex_layout;
+    int found = 0;
+    list->vertex_packed = nk_false;
+    if (!it) return;
+    for (; it->attribute != NK_VERTEX_ATTRIBUTE_COUNT && it->format != NK_FORMAT_COUNT; ++it) {
+        switch (it->attribute) {
+        case NK_VERTEX_POSITION:
+            if (it->format != NK_FORMAT_FLOAT || (found & 1)) return;
+            list->position_offset = it->offset;
+            found |= 1; break;
+        case NK_VERTEX_TEXCOORD:
+            if (it->format != NK_FORMAT_FLOAT || (found & 2)) return;
+            list->uv_offset = it->offset;
+            found |= 2; break;
+        case NK_VERTEX_COLOR:
+            if (it->format != NK_FORMAT_R8G8B8A8 || (found & 4)) return;
+            list->color_offset = it->offset;
+            found |= 4; break;
+        default: return;
+        }
+    }
+    list->vertex_packed = (found == 7);
+}
 NK_API void
 nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *config,
     struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements,
@@ -9259,6 +10304,7 @@ nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *
     canvas->cmd_offset = 0;
     canvas->cmd_count = 0;
     canvas->path_count = 0;
+    nk_draw_list_setup_layout(canvas);
 }
 NK_API const struct nk_draw_command*
 nk__draw_list_begin(const struct nk_draw_list *canvas, const struct nk_buffer *buffer)
@@ -9340,14 +10386,30 @@ nk_draw_list_path_last(struct nk_draw_list *list)
     return *point;
 }
 NK_INTERN struct nk_draw_command*
+nk_draw_list_command_last(struct nk_draw_list *list)
+{
+    void *memory;
+    nk_size size;
+    struct nk_draw_command *cmd;
+    NK_ASSERT(list->cmd_count);
+
+    memory = nk_buffer_memory(list->buffer);
+    size = nk_buffer_total(list->buffer);
+    cmd = nk_ptr_add(struct nk_draw_command, memory, size - list->cmd_offset);
+    return (cmd - (list->cmd_count-1));
+}
+NK_INTERN struct nk_draw_command*
 nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     nk_handle texture)
 {
     NK_STORAGE const nk_size cmd_align = NK_ALIGNOF(struct nk_draw_command);
     NK_STORAGE const nk_size cmd_size = sizeof(struct nk_draw_command);
     struct nk_draw_command *cmd;
+    unsigned int vertex_offset = 0;
 
     NK_ASSERT(list);
+    if (list->cmd_count)
+        vertex_offset = nk_draw_list_command_last(list)->vertex_offset;
     cmd = (struct nk_draw_command*)
         nk_buffer_alloc(list->buffer, NK_BUFFER_BACK, cmd_size, cmd_align);
 
@@ -9362,6 +10424,7 @@ nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     cmd->elem_count = 0;
     cmd->clip_rect = clip;
     cmd->texture = texture;
+    cmd->vertex_offset = vertex_offset;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     cmd->userdata = list->userdata;
 #endif
@@ -9370,19 +10433,6 @@ nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     list->clip_rect = clip;
     return cmd;
 }
-NK_INTERN struct nk_draw_command*
-nk_draw_list_command_last(struct nk_draw_list *list)
-{
-    void *memory;
-    nk_size size;
-    struct nk_draw_command *cmd;
-    NK_ASSERT(list->cmd_count);
-
-    memory = nk_buffer_memory(list->buffer);
-    size = nk_buffer_total(list->buffer);
-    cmd = nk_ptr_add(struct nk_draw_command, memory, size - list->cmd_offset);
-    return (cmd - (list->cmd_count-1));
-}
 NK_INTERN void
 nk_draw_list_add_clip(struct nk_draw_list *list, struct nk_rect rect)
 {
@@ -9431,24 +10481,54 @@ nk_draw_list_alloc_vertices(struct nk_draw_list *list, nk_size count)
     void *vtx;
     NK_ASSERT(list);
     if (!list) return 0;
+    if (sizeof(nk_draw_index) == 2 && list->cmd_count) {
+        /* start a new draw command based at the current vertex if the new
+         * vertices cannot be reached by 16-bit indices from the last one */
+        struct nk_draw_command *cmd = nk_draw_list_command_last(list);
+        if (list->vertex_count + count - cmd->vertex_offset >= NK_USHORT_MAX) {
+            if (cmd->elem_count) {
+            #ifdef NK_INCLUDE_COMMAND_USERDATA
+                nk_handle userdata = list->userdata;
+                list->userdata = cmd->userdata;
+            #endif
+                cmd = nk_draw_list_push_command(list, cmd->clip_rect, cmd->texture);
+            #ifdef NK_INCLUDE_COMMAND_USERDATA
+                list->userdata = userdata;
+            #endif
+                if (!cmd) return 0;
+            }
+            cmd->vertex_offset = list->vertex_count;
+        }
+    }
     vtx = nk_buffer_alloc(list->vertices, NK_BUFFER_FRONT,
         list->config.vertex_size*count, list->config.vertex_alignment);
     if (!vtx) return 0;
     list->vertex_count += (unsigned int)count;
 
-    /* This assert triggers because your are drawing a lot of stuff and nuklear
-     * defined `nk_draw_index` as `nk_ushort` to safe space be default.
+    /* This assert triggers because a single primitive needs more vertices
+     * than can be addressed by `nk_draw_index`, which nuklear defines as
+     * `nk_ushort` to safe space by default. Larger frames are split into
+     * multiple draw commands automatically (see `nk_draw_command.vertex_offset`).
      *
-     * So you reached the maximum number of indicies or rather vertexes.
-     * To solve this issue please change typdef `nk_draw_index` to `nk_uint`
-     * and don't forget to specify the new element size in your drawing
-     * backend (OpenGL, DirectX, ...). For example in OpenGL for `glDrawElements`
-     * instead of specifing `GL_UNSIGNED_SHORT` you have to define `GL_UNSIGNED_INT`.
-     * Sorry for the inconvenience. */
-    if(sizeof(nk_draw_index)==2) NK_ASSERT((list->vertex_count < NK_USHORT_MAX &&
+     * To solve this issue please define `NK_UINT_DRAW_INDEX` and don't forget
+     * to specify the new element size in your drawing backend (OpenGL, DirectX, ...).
+     * For example in OpenGL for `glDrawElements` instead of specifing
+     * `GL_UNSIGNED_SHORT` you have to define `GL_UNSIGNED_INT`. */
+    if(sizeof(nk_draw_index)==2 && list->cmd_count) NK_ASSERT((list->vertex_count -
+        nk_draw_list_command_last(list)->vertex_offset < NK_USHORT_MAX &&
         "To many verticies for 16-bit vertex indicies. Please read comment above on how to solve this problem"));
     return vtx;
 }
+NK_INTERN nk_size
+nk_draw_list_vertex_index(struct nk_draw_list *list, nk_size count)
+{
+    /* index of the first of the last `count` allocated vertices
+     * relative to the vertex offset of the current draw command */
+    nk_size index = list->vertex_count - count;
+    if (list->cmd_count)
+        index -= nk_draw_list_command_last(list)->vertex_offset;
+    return index;
+}
 NK_INTERN nk_draw_index*
 nk_draw_list_alloc_elements(struct nk_draw_list *list, nk_size count)
 {
@@ -9604,11 +10684,24 @@ nk_draw_vertex_element(void *dst, const float *values, int value_count,
     }
 }
 NK_INTERN void*
-nk_draw_vertex(void *dst, const struct nk_convert_config *config,
+nk_draw_vertex(void *dst, const struct nk_draw_list *list,
     struct nk_vec2 pos, struct nk_vec2 uv, struct nk_colorf color)
 {
-    void *result = (void*)((char*)dst + config->vertex_size);
-    const struct nk_draw_vertex_layout_element *elem_iter = config->vertex_layout;
+    void *result = (void*)((char*)dst + list->config.vertex_size);
+    const struct nk_draw_vertex_layout_element *elem_iter = list->config.vertex_layout;
+    if (list->vertex_packed) {
+        struct nk_color col;
+        float val[4];
+        val[0] = NK_SATURATE(color.r);
+        val[1] = NK_SATURATE(color.g);
+        val[2] = NK_SATURATE(color.b);
+        val[3] = NK_SATURATE(color.a);
+        col = nk_rgba_fv(val);
+        NK_MEMCPY((char*)dst + list->position_offset, &pos, sizeof(pos));
+        NK_MEMCPY((char*)dst + list->uv_offset, &uv, sizeof(uv));
+        NK_MEMCPY((char*)dst + list->color_offset, &col, sizeof(col));
+        return result;
+    }
     while (!nk_draw_vertex_layout_element_is_end_of_layout(elem_iter)) {
         void *address = (void*)((char*)dst + elem_iter->offset);
         switch (elem_iter->attribute) {
@@ -9622,6 +10715,88 @@ nk_draw_vertex(void *dst, const struct nk_convert_config *config,
     }
     return result;
 }
+NK_INTERN void
+nk_draw_list_normals(struct nk_vec2 *normals, const struct nk_vec2 *points,
+    nk_size count, nk_size points_count)
+{
+    /* normal of the segment from point i to point i+1 (wrapping around) */
+    nk_size i1 = 0;
+#ifdef NK_SSE2
+    const __m128 sign = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    for (; i1 + 1 < count && i1 + 2 < points_count; i1 += 2) {
+        __m128 a = _mm_loadu_ps(&points[i1].x);
+        __m128 b = _mm_loadu_ps(&points[i1+1].x);
+        __m128 diff = _mm_sub_ps(b, a);
+        __m128 sqr = _mm_mul_ps(diff, diff);
+        __m128 len = _mm_add_ps(sqr, _mm_shuffle_ps(sqr, sqr, _MM_SHUFFLE(2,3,0,1)));
+        __m128 x2 = _mm_mul_ps(len, _mm_set1_ps(0.5f));
+        __m128 mask = _mm_cmpneq_ps(len, _mm_setzero_ps());
+        __m128 inv = _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(0x5f375A84),
+            _mm_srli_epi32(_mm_castps_si128(len), 1)));
+
+        /* same steps as nk_inv_sqrt */
+        inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(1.5f),
+            _mm_mul_ps(_mm_mul_ps(x2, inv), inv)));
+        inv = _mm_or_ps(_mm_and_ps(mask, inv), _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+        diff = _mm_mul_ps(diff, inv);
+        diff = _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2,3,0,1));
+        _mm_storeu_ps(&normals[i1].x, _mm_xor_ps(diff, sign));
+    }
+#endif
+    for (; i1 < count; ++i1) {
+        const nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
+        struct nk_vec2 diff = nk_vec2_sub(points[i2], points[i1]);
+        float len;
+
+        /* vec2 inverted length  */
+        len = nk_vec2_len_sqr(diff);
+        if (len != 0.0f)
+            len = nk_inv_sqrt(len);
+        else len = 1.0f;
+
+        diff = nk_vec2_muls(diff, len);
+        normals[i1].x = diff.y;
+        normals[i1].y = -diff.x;
+    }
+}
+NK_INTERN struct nk_vec2
+nk_draw_list_miter(struct nk_vec2 n0, struct nk_vec2 n1)
+{
+    /* average normals */
+    struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(n0, n1), 0.5f);
+    float dmr2 = dm.x * dm.x + dm.y * dm.y;
+    if (dmr2 > 0.000001f) {
+        float scale = 1.0f/dmr2;
+        scale = NK_MIN(100.0f, scale);
+        dm = nk_vec2_muls(dm, scale);
+    }
+    return dm;
+}
+NK_INTERN void
+nk_draw_list_miters(struct nk_vec2 *normals, nk_size points_count, int closed)
+{
+    /* replace each normal with the averaged normal of the point at the
+     * start of its segment. Runs backwards to work in place. */
+    nk_size i = points_count - 1;
+    struct nk_vec2 first = normals[0];
+    if (closed) first = nk_draw_list_miter(normals[points_count-1], normals[0]);
+#ifdef NK_SSE2
+    for (; i >= 2; i -= 2) {
+        __m128 n0 = _mm_loadu_ps(&normals[i-2].x);
+        __m128 n1 = _mm_loadu_ps(&normals[i-1].x);
+        __m128 dm = _mm_mul_ps(_mm_add_ps(n0, n1), _mm_set1_ps(0.5f));
+        __m128 sqr = _mm_mul_ps(dm, dm);
+        __m128 dmr2 = _mm_add_ps(sqr, _mm_shuffle_ps(sqr, sqr, _MM_SHUFFLE(2,3,0,1)));
+        __m128 mask = _mm_cmpgt_ps(dmr2, _mm_set1_ps(0.000001f));
+        __m128 scale = _mm_min_ps(_mm_set1_ps(100.0f), _mm_div_ps(_mm_set1_ps(1.0f), dmr2));
+        dm = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm, scale)), _mm_andnot_ps(mask, dm));
+        _mm_storeu_ps(&normals[i-1].x, dm);
+    }
+#endif
+    for (; i > 0; --i)
+        normals[i] = nk_draw_list_miter(normals[i-1], normals[i]);
+    normals[0] = first;
+}
 NK_API void
 nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *points,
     const unsigned int points_count, struct nk_color color, enum nk_draw_list_stroke closed,
@@ -9657,7 +10832,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         /* allocate vertices and elements  */
         nk_size i1 = 0;
         nk_size vertex_offset;
-        nk_size index = list->vertex_count;
+        nk_size index;
 
         const nk_size idx_count = (thick_line) ?  (count * 18) : (count * 12);
         const nk_size vtx_count = (thick_line) ? (points_count * 4): (points_count *3);
@@ -9668,6 +10843,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         nk_size size;
         struct nk_vec2 *normals, *temp;
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
 
         /* temporary allocate normals + points */
         vertex_offset = (nk_size)((nk_byte*)vtx - (nk_byte*)list->vertices->memory.ptr);
@@ -9681,22 +10857,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         vtx = (void*)((nk_byte*)list->vertices->memory.ptr + vertex_offset);
 
         /* calculate normals */
-        for (i1 = 0; i1 < count; ++i1) {
-            const nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
-            struct nk_vec2 diff = nk_vec2_sub(points[i2], points[i1]);
-            float len;
-
-            /* vec2 inverted length  */
-            len = nk_vec2_len_sqr(diff);
-            if (len != 0.0f)
-                len = nk_inv_sqrt(len);
-            else len = 1.0f;
-
-            diff = nk_vec2_muls(diff, len);
-            normals[i1].x = diff.y;
-            normals[i1].y = -diff.x;
-        }
-
+        nk_draw_list_normals(normals, points, count, points_count);
         if (!closed)
             normals[points_count-1] = normals[points_count-2];
 
@@ -9710,25 +10871,16 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 temp[(points_count-1) * 2 + 0] = nk_vec2_add(points[points_count-1], d);
                 temp[(points_count-1) * 2 + 1] = nk_vec2_sub(points[points_count-1], d);
             }
+            nk_draw_list_miters(normals, points_count, closed);
 
             /* fill elements */
             idx1 = index;
             for (i1 = 0; i1 < count; i1++) {
                 struct nk_vec2 dm;
-                float dmr2;
                 nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
                 nk_size idx2 = ((i1+1) == points_count) ? index: (idx1 + 3);
 
-                /* average normals */
-                dm = nk_vec2_muls(nk_vec2_add(normals[i1], normals[i2]), 0.5f);
-                dmr2 = dm.x * dm.x + dm.y* dm.y;
-                if (dmr2 > 0.000001f) {
-                    float scale = 1.0f/dmr2;
-                    scale = NK_MIN(100.0f, scale);
-                    dm = nk_vec2_muls(dm, scale);
-                }
-
-                dm = nk_vec2_muls(dm, AA_SIZE);
+                dm = nk_vec2_muls(normals[i2], AA_SIZE);
                 temp[i2*2+0] = nk_vec2_add(points[i2], dm);
                 temp[i2*2+1] = nk_vec2_sub(points[i2], dm);
 
@@ -9745,9 +10897,9 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             /* fill vertices */
             for (i = 0; i < points_count; ++i) {
                 const struct nk_vec2 uv = list->config.null.uv;
-                vtx = nk_draw_vertex(vtx, &list->config, points[i], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*2+0], uv, col_trans);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*2+1], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, points[i], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*2+0], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*2+1], uv, col_trans);
             }
         } else {
             nk_size idx1, i;
@@ -9769,6 +10921,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 temp[(points_count-1)*4+2] = nk_vec2_sub(points[points_count-1], d2);
                 temp[(points_count-1)*4+3] = nk_vec2_sub(points[points_count-1], d1);
             }
+            nk_draw_list_miters(normals, points_count, closed);
 
             /* add all elements */
             idx1 = index;
@@ -9776,15 +10929,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 struct nk_vec2 dm_out, dm_in;
                 const nk_size i2 = ((i1+1) == points_count) ? 0: (i1 + 1);
                 nk_size idx2 = ((i1+1) == points_count) ? index: (idx1 + 4);
-
-                /* average normals */
-                struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(normals[i1], normals[i2]), 0.5f);
-                float dmr2 = dm.x * dm.x + dm.y* dm.y;
-                if (dmr2 > 0.000001f) {
-                    float scale = 1.0f/dmr2;
-                    scale = NK_MIN(100.0f, scale);
-                    dm = nk_vec2_muls(dm, scale);
-                }
+                const struct nk_vec2 dm = normals[i2];
 
                 dm_out = nk_vec2_muls(dm, ((half_inner_thickness) + AA_SIZE));
                 dm_in = nk_vec2_muls(dm, half_inner_thickness);
@@ -9810,10 +10955,10 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             /* add vertices */
             for (i = 0; i < points_count; ++i) {
                 const struct nk_vec2 uv = list->config.null.uv;
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+0], uv, col_trans);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+1], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+2], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+3], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+0], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+1], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+2], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+3], uv, col_trans);
             }
         }
         /* free temporary normals + points */
@@ -9821,12 +10966,13 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
     } else {
         /* NON ANTI-ALIASED STROKE */
         nk_size i1 = 0;
-        nk_size idx = list->vertex_count;
+        nk_size idx;
         const nk_size idx_count = count * 6;
         const nk_size vtx_count = count * 4;
         void *vtx = nk_draw_list_alloc_vertices(list, vtx_count);
         nk_draw_index *ids = nk_draw_list_alloc_elements(list, idx_count);
         if (!vtx || !ids) return;
+        idx = nk_draw_list_vertex_index(list, vtx_count);
 
         for (i1 = 0; i1 < count; ++i1) {
             float dx, dy;
@@ -9848,10 +10994,10 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             dx = diff.x * (thickness * 0.5f);
             dy = diff.y * (thickness * 0.5f);
 
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p1.x + dy, p1.y - dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p2.x + dy, p2.y - dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p2.x - dy, p2.y + dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p1.x - dy, p1.y + dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p1.x + dy, p1.y - dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p2.x + dy, p2.y - dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p2.x - dy, p2.y + dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p1.x - dy, p1.y + dx), uv, col);
 
             ids[0] = (nk_draw_index)(idx+0); ids[1] = (nk_draw_index)(idx+1);
             ids[2] = (nk_draw_index)(idx+2); ids[3] = (nk_draw_index)(idx+0);
@@ -9891,7 +11037,7 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
 
         const float AA_SIZE = 1.0f;
         nk_size vertex_offset = 0;
-        nk_size index = list->vertex_count;
+        nk_size index;
 
         const nk_size idx_count = (points_count-2)*3 + points_count*6;
         const nk_size vtx_count = (points_count*2);
@@ -9901,9 +11047,12 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
 
         nk_size size = 0;
         struct nk_vec2 *normals = 0;
-        unsigned int vtx_inner_idx = (unsigned int)(index + 0);
-        unsigned int vtx_outer_idx = (unsigned int)(index + 1);
+        unsigned int vtx_inner_idx;
+        unsigned int vtx_outer_idx;
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
+        vtx_inner_idx = (unsigned int)(index + 0);
+        vtx_outer_idx = (unsigned int)(index + 1);
 
         /* temporary allocate normals */
         vertex_offset = (nk_size)((nk_byte*)vtx - (nk_byte*)list->vertices->memory.ptr);
@@ -9922,39 +11071,17 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
         }
 
         /* compute normals */
-        for (i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++) {
-            struct nk_vec2 p0 = points[i0];
-            struct nk_vec2 p1 = points[i1];
-            struct nk_vec2 diff = nk_vec2_sub(p1, p0);
-
-            /* vec2 inverted length  */
-            float len = nk_vec2_len_sqr(diff);
-            if (len != 0.0f)
-                len = nk_inv_sqrt(len);
-            else len = 1.0f;
-            diff = nk_vec2_muls(diff, len);
-
-            normals[i0].x = diff.y;
-            normals[i0].y = -diff.x;
-        }
+        nk_draw_list_normals(normals, points, points_count, points_count);
+        nk_draw_list_miters(normals, points_count, nk_true);
 
         /* add vertices + indexes */
         for (i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++) {
             const struct nk_vec2 uv = list->config.null.uv;
-            struct nk_vec2 n0 = normals[i0];
-            struct nk_vec2 n1 = normals[i1];
-            struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(n0, n1), 0.5f);
-            float dmr2 = dm.x*dm.x + dm.y*dm.y;
-            if (dmr2 > 0.000001f) {
-                float scale = 1.0f / dmr2;
-                scale = NK_MIN(scale, 100.0f);
-                dm = nk_vec2_muls(dm, scale);
-            }
-            dm = nk_vec2_muls(dm, AA_SIZE * 0.5f);
+            const struct nk_vec2 dm = nk_vec2_muls(normals[i1], AA_SIZE * 0.5f);
 
             /* add vertices */
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2_sub(points[i1], dm), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2_add(points[i1], dm), uv, col_trans);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2_sub(points[i1], dm), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2_add(points[i1], dm), uv, col_trans);
 
             /* add indexes */
             ids[0] = (nk_draw_index)(vtx_inner_idx+(i1<<1));
@@ -9969,15 +11096,16 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
         nk_buffer_reset(list->vertices, NK_BUFFER_FRONT);
     } else {
         nk_size i = 0;
-        nk_size index = list->vertex_count;
+        nk_size index;
         const nk_size idx_count = (points_count-2)*3;
         const nk_size vtx_count = points_count;
         void *vtx = nk_draw_list_alloc_vertices(list, vtx_count);
         nk_draw_index *ids = nk_draw_list_alloc_elements(list, idx_count);
 
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
         for (i = 0; i < vtx_count; ++i)
-            vtx = nk_draw_vertex(vtx, &list->config, points[i], list->config.null.uv, col);
+            vtx = nk_draw_vertex(vtx, list, points[i], list->config.null.uv, col);
         for (i = 2; i < points_count; ++i) {
             ids[0] = (nk_draw_index)index;
             ids[1] = (nk_draw_index)(index+ i - 1);
@@ -10210,19 +11338,19 @@ nk_draw_list_fill_rect_multi_color(struct nk_draw_list *list, struct nk_rect rec
     if (!list) return;
 
     nk_draw_list_push_image(list, list->config.null.texture);
-    index = (nk_draw_index)list->vertex_count;
     vtx = nk_draw_list_alloc_vertices(list, 4);
     idx = nk_draw_list_alloc_elements(list, 6);
     if (!vtx || !idx) return;
+    index = (nk_draw_index)nk_draw_list_vertex_index(list, 4);
 
     idx[0] = (nk_draw_index)(index+0); idx[1] = (nk_draw_index)(index+1);
     idx[2] = (nk_draw_index)(index+2); idx[3] = (nk_draw_index)(index+0);
     idx[4] = (nk_draw_index)(index+2); idx[5] = (nk_draw_index)(index+3);
 
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x, rect.y), list->config.null.uv, col_left);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x + rect.w, rect.y), list->config.null.uv, col_top);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x + rect.w, rect.y + rect.h), list->config.null.uv, col_right);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x, rect.y + rect.h), list->config.null.uv, col_bottom);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x, rect.y), list->config.null.uv, col_left);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x + rect.w, rect.y), list->config.null.uv, col_top);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x + rect.w, rect.y + rect.h), list->config.null.uv, col_right);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x, rect.y + rect.h), list->config.null.uv, col_bottom);
 }
 NK_API void
 nk_draw_list_fill_triangle(struct nk_draw_list *list, struct nk_vec2 a,
@@ -10302,19 +11430,19 @@ nk_draw_list_push_rect_uv(struct nk_draw_list *list, struct nk_vec2 a,
     b = nk_vec2(c.x, a.y);
     d = nk_vec2(a.x, c.y);
 
-    index = (nk_draw_index)list->vertex_count;
     vtx = nk_draw_list_alloc_vertices(list, 4);
     idx = nk_draw_list_alloc_elements(list, 6);
     if (!vtx || !idx) return;
+    index = (nk_draw_index)nk_draw_list_vertex_index(list, 4);
 
     idx[0] = (nk_draw_index)(index+0); idx[1] = (nk_draw_index)(index+1);
     idx[2] = (nk_draw_index)(index+2); idx[3] = (nk_draw_index)(index+0);
     idx[4] = (nk_draw_index)(index+2); idx[5] = (nk_draw_index)(index+3);
 
-    vtx = nk_draw_vertex(vtx, &list->config, a, uva, col);
-    vtx = nk_draw_vertex(vtx, &list->config, b, uvb, col);
-    vtx = nk_draw_vertex(vtx, &list->config, c, uvc, col);
-    vtx = nk_draw_vertex(vtx, &list->config, d, uvd, col);
+    vtx = nk_draw_vertex(vtx, list, a, uva, col);
+    vtx = nk_draw_vertex(vtx, list, b, uvb, col);
+    vtx = nk_draw_vertex(vtx, list, c, uvc, col);
+    vtx = nk_draw_vertex(vtx, list, d, uvd, col);
 }
 NK_API void
 nk_draw_list_add_image(struct nk_draw_list *list, struct nk_image texture,
@@ -10387,6 +11515,536 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
         unicode = next;
     }
 }
+NK_INTERN void
+nk_convert_command(struct nk_draw_list *list, const struct nk_command *cmd,
+    const struct nk_convert_config *config)
+{
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    list->userdata = cmd->userdata;
+#endif
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        nk_draw_list_add_clip(list, nk_rect(s->x, s->y, s->w, s->h));
+    } break;
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        nk_draw_list_stroke_line(list, nk_vec2(l->begin.x, l->begin.y),
+            nk_vec2(l->end.x, l->end.y), l->color, l->line_thickness);
+    } break;
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        nk_draw_list_stroke_curve(list, nk_vec2(q->begin.x, q->begin.y),
+            nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
+            q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
+            config->curve_segment_count, q->line_thickness);
+    } break;
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        nk_draw_list_stroke_rect(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->color, (float)r->rounding, r->line_thickness);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        nk_draw_list_fill_rect(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->color, (float)r->rounding);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        nk_draw_list_fill_rect_multi_color(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->left, r->top, r->right, r->bottom);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        nk_draw_list_stroke_circle(list, nk_vec2((float)c->x + (float)c->w/2,
+            (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
+            config->circle_segment_count, c->line_thickness);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
+        nk_draw_list_fill_circle(list, nk_vec2((float)c->x + (float)c->w/2,
+            (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
+            config->circle_segment_count);
+    } break;
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
+        nk_draw_list_path_line_to(list, nk_vec2(c->cx, c->cy));
+        nk_draw_list_path_arc_to(list, nk_vec2(c->cx, c->cy), c->r,
+            c->a[0], c->a[1], config->arc_segment_count);
+        nk_draw_list_path_stroke(list, c->color, NK_STROKE_CLOSED, c->line_thickness);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
+        nk_draw_list_path_line_to(list, nk_vec2(c->cx, c->cy));
+        nk_draw_list_path_arc_to(list, nk_vec2(c->cx, c->cy), c->r,
+            c->a[0], c->a[1], config->arc_segment_count);
+        nk_draw_list_path_fill(list, c->color);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        nk_draw_list_stroke_triangle(list, nk_vec2(t->a.x, t->a.y),
+            nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color,
+            t->line_thickness);
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        nk_draw_list_fill_triangle(list, nk_vec2(t->a.x, t->a.y),
+            nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color);
+    } break;
+    case NK_COMMAND_POLYGON: {
+        int i;
+        const struct nk_command_polygon*p = (const struct nk_command_polygon*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_stroke(list, p->color, NK_STROKE_CLOSED, p->line_thickness);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        int i;
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_fill(list, p->color);
+    } break;
+    case NK_COMMAND_POLYLINE: {
+        int i;
+        const struct nk_command_polyline *p = (const struct nk_command_polyline*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_stroke(list, p->color, NK_STROKE_OPEN, p->line_thickness);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        nk_draw_list_add_text(list, t->font, nk_rect(t->x, t->y, t->w, t->h),
+            t->string, t->length, t->height, t->foreground);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        nk_draw_list_add_image(list, i->img, nk_rect(i->x, i->y, i->w, i->h), i->col);
+    } break;
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        c->callback(list, c->x, c->y, c->w, c->h, c->callback_data);
+    } break;
+    default: break;
+    }
+}
+NK_INTERN nk_hash
+nk_convert_config_hash(const struct nk_convert_config *config)
+{
+    const struct nk_draw_vertex_layout_element *it;
+    nk_hash hash = 0;
+    hash = nk_command_hash(hash, &config->global_alpha, sizeof(config->global_alpha));
+    hash = nk_command_hash(hash, &config->line_AA, sizeof(config->line_AA));
+    hash = nk_command_hash(hash, &config->shape_AA, sizeof(config->shape_AA));
+    hash = nk_command_hash(hash, &config->circle_segment_count, sizeof(config->circle_segment_count));
+    hash = nk_command_hash(hash, &config->arc_segment_count, sizeof(config->arc_segment_count));
+    hash = nk_command_hash(hash, &config->curve_segment_count, sizeof(config->curve_segment_count));
+    hash = nk_command_hash(hash, &config->null.texture, sizeof(config->null.texture));
+    hash = nk_command_hash(hash, &config->null.uv, sizeof(config->null.uv));
+    hash = nk_command_hash(hash, &config->vertex_size, sizeof(config->vertex_size));
+    hash = nk_command_hash(hash, &config->vertex_alignment, sizeof(config->vertex_alignment));
+    for (it = config->vertex_layout; !nk_draw_vertex_layout_element_is_end_of_layout(it); ++it) {
+        hash = nk_command_hash(hash, &it->attribute, sizeof(it->attribute));
+        hash = nk_command_hash(hash, &it->format, sizeof(it->format));
+        hash = nk_command_hash(hash, &it->offset, sizeof(it->offset));
+    }
+    return hash;
+}
+NK_LIB void
+nk_vertex_cache_free(struct nk_vertex_cache *cache)
+{
+    NK_ASSERT(cache);
+    if (!cache) return;
+    nk_buffer_free(&cache->commands);
+    nk_buffer_free(&cache->vertices);
+    nk_buffer_free(&cache->elements);
+    nk_zero(cache, sizeof(*cache));
+}
+NK_INTERN void
+nk_vertex_cache_begin(struct nk_vertex_cache *cache, const struct nk_allocator *alloc)
+{
+    cache->valid = nk_false;
+    if (!cache->commands.memory.ptr) {
+        nk_buffer_init(&cache->commands, alloc, 1024);
+        nk_buffer_init(&cache->vertices, alloc, 4*1024);
+        nk_buffer_init(&cache->elements, alloc, 1024);
+    } else {
+        nk_buffer_clear(&cache->commands);
+        nk_buffer_clear(&cache->vertices);
+        nk_buffer_clear(&cache->elements);
+    }
+}
+NK_INTERN nk_hash
+nk_vertex_cache_key(const struct nk_window *win, nk_hash config_hash,
+    const struct nk_draw_command *last, struct nk_rect clip)
+{
+    /* converting a window continues the last draw command if possible,
+     * so the state of the draw list is part of the key */
+    nk_size size = win->buffer.last - win->buffer.begin;
+    int empty = last ? (last->elem_count == 0): -1;
+    nk_hash hash = nk_command_hash(win->buffer.hash, &config_hash, sizeof(config_hash));
+    hash = nk_command_hash(hash, &size, sizeof(size));
+    hash = nk_command_hash(hash, &clip, sizeof(clip));
+    hash = nk_command_hash(hash, &empty, sizeof(empty));
+    if (last) {
+        hash = nk_command_hash(hash, &last->clip_rect, sizeof(last->clip_rect));
+        hash = nk_command_hash(hash, &last->texture, sizeof(last->texture));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+        hash = nk_command_hash(hash, &last->userdata, sizeof(last->userdata));
+#endif
+    }
+    return hash;
+}
+NK_INTERN int
+nk_vertex_cache_skip(const struct nk_context *ctx, const struct nk_window *win)
+{
+    /* same windows `nk_build` links into the draw command list */
+    return win->buffer.last == win->buffer.begin || (win->flags & NK_WINDOW_HIDDEN) ||
+        win->seq != ctx->seq;
+}
+NK_INTERN int
+nk_convert_dynamic_text(const struct nk_command *cmd)
+{
+    /* text of a dynamic font atlas rasterizes glyphs into the shared atlas
+     * cache and may evict glyphs other windows were converted with */
+#ifdef NK_INCLUDE_FONT_BAKING
+    return cmd->type == NK_COMMAND_TEXT &&
+        nk_user_font_is_dynamic(((const struct nk_command_text*)cmd)->font);
+#else
+    NK_UNUSED(cmd);
+    return nk_false;
+#endif
+}
+NK_INTERN int
+nk_vertex_cache_serial(struct nk_context *ctx, const struct nk_window *win)
+{
+    /* visits the same commands as `nk_vertex_cache_convert` */
+    const struct nk_command *cmd, *first, *last;
+    first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+    last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+    for (cmd = first; cmd != last; cmd = nk__next(ctx, cmd)) {
+        if (!cmd || cmd->type == NK_COMMAND_CUSTOM) return nk_false;
+        if (nk_convert_dynamic_text(cmd)) return nk_true;
+        if (cmd->next < win->buffer.begin || cmd->next > win->buffer.last)
+            return nk_false;
+    }
+    return nk_convert_dynamic_text(cmd);
+}
+NK_INTERN void
+nk_vertex_cache_end(struct nk_vertex_cache *cache, struct nk_draw_list *list,
+    unsigned int cmd_count, unsigned int elem_count, unsigned int vertex_count,
+    unsigned int element_count)
+{
+    struct nk_draw_command *cmds;
+    struct nk_buffer *buffer = list->buffer;
+    nk_size vertex_size;
+
+    cache->cmd_count = list->cmd_count - cmd_count + (cmd_count ? 1: 0);
+    cache->vertex_count = list->vertex_count - vertex_count;
+    cache->element_count = list->element_count - element_count;
+    cache->clip_rect = list->clip_rect;
+    if (!cache->cmd_count) return;
+
+    /* only keep complete output */
+    vertex_size = cache->vertex_count * list->config.vertex_size;
+    if (buffer->needed > buffer->allocated + (buffer->memory.size - buffer->size) ||
+        list->vertices->needed > list->vertices->allocated ||
+        list->elements->needed > list->elements->allocated ||
+        list->vertices->allocated < vertex_size)
+        return;
+
+    /* indices have to be relative to the first cached vertex */
+    cmds = nk_draw_list_command_last(list) + (cache->cmd_count - 1);
+    if (cmds->vertex_offset || nk_draw_list_command_last(list)->vertex_offset)
+        return;
+
+    /* the continued draw command only stores the number of added elements */
+    if (cmd_count) cmds->elem_count -= elem_count;
+    cache->cmd_offset = (nk_size)((nk_byte*)cmds - (nk_byte*)buffer->memory.ptr);
+    cache->valid = nk_true;
+}
+NK_INTERN void
+nk_vertex_cache_replay(struct nk_draw_list *list, const struct nk_vertex_cache *cache)
+{
+    const struct nk_draw_command *cmds;
+    const nk_draw_index *ids;
+    struct nk_draw_command *dst;
+    nk_draw_index *elements;
+    unsigned int i = 0, base, vertex_offset = 0;
+    nk_size size;
+    void *vtx;
+
+    /* draw commands are stored back to front like in the draw list */
+    cmds = nk_ptr_add_const(struct nk_draw_command, cache->commands.memory.ptr, cache->cmd_offset);
+    if (list->cmd_count) {
+        unsigned int count;
+        dst = nk_draw_list_command_last(list);
+        count = dst->elem_count;
+        vertex_offset = dst->vertex_offset;
+        *dst = cmds[0];
+        dst->elem_count += count;
+        dst->vertex_offset = vertex_offset;
+        i = 1;
+    }
+    for (; i < cache->cmd_count; ++i) {
+        const struct nk_draw_command *src = cmds - i;
+        dst = nk_draw_list_push_command(list, src->clip_rect, src->texture);
+        if (!dst) return;
+        *dst = *src;
+        dst->vertex_offset = vertex_offset;
+    }
+    list->clip_rect = cache->clip_rect;
+
+    base = list->vertex_count - vertex_offset;
+    if (cache->vertex_count) {
+        size = cache->vertex_count * list->config.vertex_size;
+        vtx = nk_draw_list_alloc_vertices(list, cache->vertex_count);
+        if (!vtx) return;
+        NK_MEMCPY(vtx, nk_ptr_add_const(nk_byte, cache->vertices.memory.ptr,
+            cache->vertices.allocated - size), size);
+    }
+    if (cache->element_count) {
+        /* rebase indices onto the first vertex of this frame's copy */
+        size = cache->element_count * sizeof(nk_draw_index);
+        elements = (nk_draw_index*)nk_buffer_alloc(list->elements, NK_BUFFER_FRONT,
+            size, NK_ALIGNOF(nk_draw_index));
+        if (!elements) return;
+        ids = nk_ptr_add_const(nk_draw_index, cache->elements.memory.ptr,
+            cache->elements.allocated - size);
+        for (i = 0; i < cache->element_count; ++i)
+            elements[i] = (nk_draw_index)(ids[i] + base);
+        list->element_count += cache->element_count;
+    }
+}
+NK_INTERN int
+nk_vertex_cache_fits(struct nk_draw_list *list, const struct nk_vertex_cache *cache)
+{
+    /* replayed vertices have to be reachable from the current draw command */
+    unsigned int vertex_offset = 0;
+    if (sizeof(nk_draw_index) != 2) return nk_true;
+    if (list->cmd_count)
+        vertex_offset = nk_draw_list_command_last(list)->vertex_offset;
+    return list->vertex_count - vertex_offset + cache->vertex_count < NK_USHORT_MAX;
+}
+NK_INTERN void
+nk_vertex_cache_store(struct nk_vertex_cache *cache, struct nk_draw_list *list,
+    const struct nk_allocator *alloc, unsigned int cmd_count, unsigned int elem_count,
+    unsigned int vertex_count, unsigned int element_count)
+{
+    struct nk_draw_list copy;
+    struct nk_draw_command *cmds;
+    const nk_draw_index *ids;
+    nk_draw_index *elements;
+    unsigned int i, n, base = 0;
+    nk_size size;
+    void *memory;
+
+    /* copy the window's part of the draw list into the cache buffers */
+    nk_vertex_cache_begin(cache, alloc);
+    copy = *list;
+    copy.buffer = &cache->commands;
+    copy.vertices = &cache->vertices;
+    copy.elements = &cache->elements;
+    copy.cmd_count = 0;
+    copy.vertex_count = 0;
+    copy.element_count = 0;
+
+    n = list->cmd_count - cmd_count + (cmd_count ? 1: 0);
+    if (n) {
+        memory = nk_buffer_alloc(copy.buffer, NK_BUFFER_BACK,
+            sizeof(struct nk_draw_command) * n, NK_ALIGNOF(struct nk_draw_command));
+        if (!memory) return;
+        NK_MEMCPY(memory, nk_draw_list_command_last(list), sizeof(struct nk_draw_command) * n);
+        copy.cmd_count = n;
+
+        /* windows split into multiple vertex ranges are not cached */
+        cmds = (struct nk_draw_command*)memory;
+        base = cmds[n-1].vertex_offset;
+        for (i = 0; i < n; ++i) {
+            if (cmds[i].vertex_offset != base) return;
+            cmds[i].vertex_offset = 0;
+        }
+        copy.cmd_offset = (nk_size)(nk_buffer_total(copy.buffer) -
+            (nk_size)((nk_byte*)memory - (nk_byte*)nk_buffer_memory(copy.buffer)));
+        copy.cmd_offset -= sizeof(struct nk_draw_command) * (n - 1);
+    }
+    if (list->vertex_count - vertex_count) {
+        n = list->vertex_count - vertex_count;
+        size = n * list->config.vertex_size;
+        memory = nk_draw_list_alloc_vertices(&copy, n);
+        if (!memory) return;
+        NK_MEMCPY(memory, nk_ptr_add_const(nk_byte, list->vertices->memory.ptr,
+            list->vertices->allocated - size), size);
+    }
+    if (list->element_count - element_count) {
+        n = list->element_count - element_count;
+        size = n * sizeof(nk_draw_index);
+        elements = (nk_draw_index*)nk_buffer_alloc(copy.elements, NK_BUFFER_FRONT,
+            size, NK_ALIGNOF(nk_draw_index));
+        if (!elements) return;
+        ids = nk_ptr_add_const(nk_draw_index, list->elements->memory.ptr,
+            list->elements->allocated - size);
+        for (i = 0; i < n; ++i)
+            elements[i] = (nk_draw_index)(ids[i] - (vertex_count - base));
+        copy.element_count = n;
+    }
+    if (list->vertices->needed > list->vertices->allocated ||
+        list->elements->needed > list->elements->allocated) return;
+    nk_vertex_cache_end(cache, &copy, cmd_count ? 1: 0, elem_count, 0, 0);
+}
+NK_INTERN void
+nk_vertex_cache_convert(struct nk_context *ctx, struct nk_window *win,
+    const struct nk_convert_config *config, nk_hash config_hash)
+{
+    struct nk_vertex_cache *cache = &win->vertex_cache;
+    const struct nk_command *cmd, *first, *last;
+    struct nk_draw_command *head = 0;
+    unsigned int elem_count = 0;
+    struct nk_draw_list list;
+
+    nk_vertex_cache_begin(cache, &ctx->memory.pool);
+    nk_draw_list_init(&list);
+    nk_draw_list_setup(&list, config, &cache->commands, &cache->vertices,
+        &cache->elements, config->line_AA, config->shape_AA);
+
+    /* start from the draw list state in front of the window last frame */
+    if (cache->enter_valid) {
+        head = nk_draw_list_push_command(&list, cache->enter.clip_rect, cache->enter.texture);
+        if (!head) return;
+        *head = cache->enter;
+        head->vertex_offset = 0;
+        elem_count = head->elem_count;
+    }
+    list.clip_rect = cache->enter_clip;
+    cache->key = nk_vertex_cache_key(win, config_hash, head, list.clip_rect);
+
+    first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+    last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+    for (cmd = first; cmd != last; cmd = nk__next(ctx, cmd)) {
+        /* custom callbacks are only ever called from `nk_convert` itself */
+        if (!cmd || cmd->type == NK_COMMAND_CUSTOM) return;
+        nk_convert_command(&list, cmd, config);
+        if (cmd->next < win->buffer.begin || cmd->next > win->buffer.last)
+            return;
+    }
+    if (cmd->type == NK_COMMAND_CUSTOM) return;
+    nk_convert_command(&list, cmd, config);
+    nk_vertex_cache_end(cache, &list, head ? 1: 0, elem_count, 0, 0);
+}
+struct nk_convert_jobs {
+    struct nk_context *ctx;
+    const struct nk_convert_config *config;
+    struct nk_window **windows;
+    nk_hash config_hash;
+};
+NK_INTERN void
+nk_convert_job(void *data, int index)
+{
+    struct nk_convert_jobs *jobs = (struct nk_convert_jobs*)data;
+    NK_ASSERT(jobs);
+    nk_vertex_cache_convert(jobs->ctx, jobs->windows[index],
+        jobs->config, jobs->config_hash);
+}
+NK_INTERN void
+nk_convert_parallel(struct nk_context *ctx, const struct nk_convert_config *config,
+    nk_hash config_hash)
+{
+    struct nk_convert_jobs jobs;
+    struct nk_window *win;
+    int count = 0;
+
+    /* convert windows into their cache with the draw list state they saw
+     * last frame. Windows with a different state are converted again
+     * while the output is assembled in `nk_convert_cached`. */
+    jobs.windows = (struct nk_window**)ctx->memory.pool.alloc(
+        ctx->memory.pool.userdata, 0, sizeof(struct nk_window*) * ctx->count);
+    if (!jobs.windows) return;
+    for (win = ctx->begin; win; win = win->next) {
+        struct nk_vertex_cache *cache = &win->vertex_cache;
+        if (nk_vertex_cache_skip(ctx, win)) continue;
+        if (cache->valid && cache->key == nk_vertex_cache_key(win, config_hash,
+            cache->enter_valid ? &cache->enter: 0, cache->enter_clip))
+            continue;
+        /* left to the serial pass in `nk_convert_cached` */
+        if (nk_vertex_cache_serial(ctx, win)) continue;
+        jobs.windows[count++] = win;
+    }
+    jobs.ctx = ctx;
+    jobs.config = config;
+    jobs.config_hash = config_hash;
+    if (count > 1)
+        config->parallel_for(config->parallel_userdata, nk_convert_job, &jobs, count);
+    ctx->memory.pool.free(ctx->memory.pool.userdata, jobs.windows);
+}
+NK_INTERN void
+nk_convert_cached(struct nk_context *ctx, const struct nk_convert_config *config,
+    nk_hash config_hash, int store)
+{
+    struct nk_draw_list *list = &ctx->draw_list;
+    const struct nk_command *cmd;
+    struct nk_window *win;
+
+    cmd = nk__begin(ctx);
+    for (win = ctx->begin; win && cmd; win = win->next) {
+        struct nk_vertex_cache *cache = &win->vertex_cache;
+        unsigned int cmd_count, elem_count, vertex_count, element_count;
+        const struct nk_command *first, *last;
+        struct nk_draw_command *prev;
+        int cacheable = nk_true;
+        nk_hash key;
+
+        if (nk_vertex_cache_skip(ctx, win)) continue;
+        /* draw command list has to visit windows in list order */
+        first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+        last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+        if (cmd != first) break;
+
+        prev = list->cmd_count ? nk_draw_list_command_last(list): 0;
+        key = nk_vertex_cache_key(win, config_hash, prev, list->clip_rect);
+        cache->enter_valid = (prev != 0);
+        if (prev) cache->enter = *prev;
+        cache->enter_clip = list->clip_rect;
+        if (cache->valid && cache->key == key && nk_vertex_cache_fits(list, cache)) {
+            nk_vertex_cache_replay(list, cache);
+            cmd = nk__next(ctx, last);
+            continue;
+        }
+
+        /* convert window and keep the result for the next frame */
+        cache->valid = nk_false;
+        cmd_count = list->cmd_count;
+        elem_count = prev ? prev->elem_count: 0;
+        vertex_count = list->vertex_count;
+        element_count = list->element_count;
+        while (cmd) {
+            nk_size next = cmd->next;
+            cacheable = cacheable && (cmd->type != NK_COMMAND_CUSTOM) &&
+                !nk_convert_dynamic_text(cmd);
+            nk_convert_command(list, cmd, config);
+            if (cmd == last) break;
+            cmd = nk__next(ctx, cmd);
+            /* a popup closing the window leaves the window's range */
+            if (cmd && (next < win->buffer.begin || next > win->buffer.last)) break;
+        }
+        if (cmd != last) break;
+        cmd = nk__next(ctx, cmd);
+        if (store && cacheable) {
+            nk_vertex_cache_store(cache, list, &ctx->memory.pool,
+                cmd_count, elem_count, vertex_count, element_count);
+            cache->key = key;
+        }
+    }
+    /* popups and overlay are always converted */
+    for (; cmd; cmd = nk__next(ctx, cmd))
+        nk_convert_command(list, cmd, config);
+}
 NK_API nk_flags
 nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
     struct nk_buffer *vertices, struct nk_buffer *elements,
@@ -10406,131 +12064,61 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 
     nk_draw_list_setup(&ctx->draw_list, config, cmds, vertices, elements,
         config->line_AA, config->shape_AA);
-    nk_foreach(cmd, ctx)
-    {
-#ifdef NK_INCLUDE_COMMAND_USERDATA
-        ctx->draw_list.userdata = cmd->userdata;
-#endif
-        switch (cmd->type) {
-        case NK_COMMAND_NOP: break;
-        case NK_COMMAND_SCISSOR: {
-            const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
-            nk_draw_list_add_clip(&ctx->draw_list, nk_rect(s->x, s->y, s->w, s->h));
-        } break;
-        case NK_COMMAND_LINE: {
-            const struct nk_command_line *l = (const struct nk_command_line*)cmd;
-            nk_draw_list_stroke_line(&ctx->draw_list, nk_vec2(l->begin.x, l->begin.y),
-                nk_vec2(l->end.x, l->end.y), l->color, l->line_thickness);
-        } break;
-        case NK_COMMAND_CURVE: {
-            const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
-            nk_draw_list_stroke_curve(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
-                nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
-                q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
-                config->curve_segment_count, q->line_thickness);
-        } break;
-        case NK_COMMAND_RECT: {
-            const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
-            nk_draw_list_stroke_rect(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->color, (float)r->rounding, r->line_thickness);
-        } break;
-        case NK_COMMAND_RECT_FILLED: {
-            const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
-            nk_draw_list_fill_rect(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->color, (float)r->rounding);
-        } break;
-        case NK_COMMAND_RECT_MULTI_COLOR: {
-            const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
-            nk_draw_list_fill_rect_multi_color(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->left, r->top, r->right, r->bottom);
-        } break;
-        case NK_COMMAND_CIRCLE: {
-            const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
-            nk_draw_list_stroke_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
-                (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count, c->line_thickness);
-        } break;
-        case NK_COMMAND_CIRCLE_FILLED: {
-            const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
-            nk_draw_list_fill_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
-                (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count);
-        } break;
-        case NK_COMMAND_ARC: {
-            const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
-            nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
-            nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
-            nk_draw_list_path_stroke(&ctx->draw_list, c->color, NK_STROKE_CLOSED, c->line_thickness);
-        } break;
-        case NK_COMMAND_ARC_FILLED: {
-            const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
-            nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
-            nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
-            nk_draw_list_path_fill(&ctx->draw_list, c->color);
-        } break;
-        case NK_COMMAND_TRIANGLE: {
-            const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
-            nk_draw_list_stroke_triangle(&ctx->draw_list, nk_vec2(t->a.x, t->a.y),
-                nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color,
-                t->line_thickness);
-        } break;
-        case NK_COMMAND_TRIANGLE_FILLED: {
-            const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
-            nk_draw_list_fill_triangle(&ctx->draw_list, nk_vec2(t->a.x, t->a.y),
-                nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color);
-        } break;
-        case NK_COMMAND_POLYGON: {
-            int i;
-            const struct nk_command_polygon*p = (const struct nk_command_polygon*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_stroke(&ctx->draw_list, p->color, NK_STROKE_CLOSED, p->line_thickness);
-        } break;
-        case NK_COMMAND_POLYGON_FILLED: {
-            int i;
-            const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_fill(&ctx->draw_list, p->color);
-        } break;
-        case NK_COMMAND_POLYLINE: {
-            int i;
-            const struct nk_command_polyline *p = (const struct nk_command_polyline*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_stroke(&ctx->draw_list, p->color, NK_STROKE_OPEN, p->line_thickness);
-        } break;
-        case NK_COMMAND_TEXT: {
-            const struct nk_command_text *t = (const struct nk_command_text*)cmd;
-            nk_draw_list_add_text(&ctx->draw_list, t->font, nk_rect(t->x, t->y, t->w, t->h),
-                t->string, t->length, t->height, t->foreground);
-        } break;
-        case NK_COMMAND_IMAGE: {
-            const struct nk_command_image *i = (const struct nk_command_image*)cmd;
-            nk_draw_list_add_image(&ctx->draw_list, i->img, nk_rect(i->x, i->y, i->w, i->h), i->col);
-        } break;
-        case NK_COMMAND_CUSTOM: {
-            const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
-            c->callback(&ctx->draw_list, c->x, c->y, c->w, c->h, c->callback_data);
-        } break;
-        default: break;
+    if (((config->flags & NK_CONVERT_CACHE_WINDOWS) || config->parallel_for) &&
+        ctx->memory.type != NK_BUFFER_FIXED && (!config->vertex_alignment ||
+        !(config->vertex_size % config->vertex_alignment)) && nk__begin(ctx)) {
+        /* per window output requires tightly packed vertices */
+        nk_hash config_hash = nk_convert_config_hash(config);
+        if (!(config->flags & NK_CONVERT_CACHE_WINDOWS)) {
+            struct nk_window *win;
+            for (win = ctx->begin; win; win = win->next)
+                win->vertex_cache.valid = nk_false;
         }
-    }
+        if (config->parallel_for)
+            nk_convert_parallel(ctx, config, config_hash);
+        nk_convert_cached(ctx, config, config_hash,
+            config->flags & NK_CONVERT_CACHE_WINDOWS);
+    } else nk_foreach(cmd, ctx)
+        nk_convert_command(&ctx->draw_list, cmd, config);
     res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
     res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
     res |= (elements->needed > elements->allocated) ? NK_CONVERT_ELEMENT_BUFFER_FULL: 0;
     return res;
 }
-NK_API const struct nk_draw_command*
-nk__draw_begin(const struct nk_context *ctx,
+NK_API nk_flags
+nk_convert_frame(const struct nk_frame *frame, struct nk_draw_list *list,
+    struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements,
+    const struct nk_convert_config *config)
+{
+    /* only touches the frame and the given draw list and buffers, so it can
+     * run on another thread while the context builds the next frame */
+    nk_flags res = NK_CONVERT_SUCCESS;
+    const struct nk_command *cmd;
+    NK_ASSERT(frame);
+    NK_ASSERT(list);
+    NK_ASSERT(cmds);
+    NK_ASSERT(vertices);
+    NK_ASSERT(elements);
+    NK_ASSERT(config);
+    NK_ASSERT(config->vertex_layout);
+    NK_ASSERT(config->vertex_size);
+    if (!frame || !list || !cmds || !vertices || !elements || !config || !config->vertex_layout)
+        return NK_CONVERT_INVALID_PARAM;
+
+    nk_draw_list_setup(list, config, cmds, vertices, elements,
+        config->line_AA, config->shape_AA);
+    nk_frame_foreach(cmd, frame) {
+        /* dynamic font atlases are modified by the context's thread */
+        NK_ASSERT(!nk_convert_dynamic_text(cmd));
+        nk_convert_command(list, cmd, config);
+    }
+    res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
+    res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
+    res |= (elements->needed > elements->allocated) ? NK_CONVERT_ELEMENT_BUFFER_FULL: 0;
+    return res;
+}
+NK_API const struct nk_draw_command*
+nk__draw_begin(const struct nk_context *ctx,
     const struct nk_buffer *buffer)
 {
     return nk__draw_list_begin(&ctx->draw_list, buffer);
@@ -10920,6 +12508,142 @@ nk_rp_pack_rects(struct nk_rp_context *context, struct nk_rp_rect *rects, int nu
         rects[i].was_packed = !(rects[i].x == NK_RP__MAXVAL && rects[i].y == NK_RP__MAXVAL);
 }
 
+/* maximal rectangles packer keeping a list of all maximal free rectangles
+ * and placing each rect bottom-left into one of them (Jukka Jylanki 2010) */
+struct nk_rp_free_rect {
+    int x, y, w, h;
+};
+struct nk_rp_maxrects {
+    struct nk_allocator alloc;
+    struct nk_rp_free_rect *free_rects;
+    int count, capacity;
+};
+NK_INTERN int
+nk_rp_maxrects_init(struct nk_rp_maxrects *mr, int width, int height,
+    struct nk_allocator *alloc)
+{
+    nk_zero_struct(*mr);
+    mr->alloc = *alloc;
+    mr->capacity = 256;
+    mr->free_rects = (struct nk_rp_free_rect*)alloc->alloc(alloc->userdata, 0,
+        sizeof(struct nk_rp_free_rect) * (nk_size)mr->capacity);
+    if (!mr->free_rects) return nk_false;
+    mr->free_rects[0].x = mr->free_rects[0].y = 0;
+    mr->free_rects[0].w = width;
+    mr->free_rects[0].h = height;
+    mr->count = 1;
+    return nk_true;
+}
+NK_INTERN void
+nk_rp_maxrects_cleanup(struct nk_rp_maxrects *mr)
+{
+    if (mr->free_rects)
+        mr->alloc.free(mr->alloc.userdata, mr->free_rects);
+    mr->free_rects = 0;
+}
+NK_INTERN int
+nk_rp_maxrects_push(struct nk_rp_maxrects *mr, int x, int y, int w, int h)
+{
+    struct nk_rp_free_rect *r;
+    if (mr->count == mr->capacity) {
+        struct nk_rp_free_rect *rects = (struct nk_rp_free_rect*)
+            mr->alloc.alloc(mr->alloc.userdata, 0, sizeof(struct nk_rp_free_rect) *
+                (nk_size)mr->capacity * 2);
+        if (!rects) return nk_false;
+        NK_MEMCPY(rects, mr->free_rects, sizeof(struct nk_rp_free_rect) * (nk_size)mr->count);
+        mr->alloc.free(mr->alloc.userdata, mr->free_rects);
+        mr->free_rects = rects;
+        mr->capacity *= 2;
+    }
+    r = &mr->free_rects[mr->count++];
+    r->x = x; r->y = y;
+    r->w = w; r->h = h;
+    return nk_true;
+}
+NK_INTERN int
+nk_rp_maxrects_contains(const struct nk_rp_free_rect *a, const struct nk_rp_free_rect *b)
+{
+    return b->x >= a->x && b->y >= a->y &&
+        b->x + b->w <= a->x + a->w && b->y + b->h <= a->y + a->h;
+}
+NK_INTERN int
+nk_rp_maxrects_insert(struct nk_rp_maxrects *mr, int w, int h, int *x, int *y)
+{
+    int i, j, n, best = -1;
+    int best_top = 0, best_x = 0;
+
+    /* bottom-left: lowest resulting top edge, then leftmost position */
+    for (i = 0; i < mr->count; ++i) {
+        const struct nk_rp_free_rect *f = &mr->free_rects[i];
+        if (f->w < w || f->h < h) continue;
+        if (best < 0 || f->y + h < best_top || (f->y + h == best_top && f->x < best_x)) {
+            best = i;
+            best_top = f->y + h;
+            best_x = f->x;
+        }
+    }
+    if (best < 0) return nk_false;
+    *x = mr->free_rects[best].x;
+    *y = mr->free_rects[best].y;
+
+    /* split all free rects overlapping the placed rect into the up to four
+     * maximal rects around it. Removed rects are marked by a zero width */
+    n = mr->count;
+    for (i = 0; i < n; ++i) {
+        struct nk_rp_free_rect f = mr->free_rects[i];
+        if (!f.w || *x >= f.x + f.w || *x + w <= f.x || *y >= f.y + f.h || *y + h <= f.y)
+            continue;
+        mr->free_rects[i].w = 0;
+        if (*x > f.x && !nk_rp_maxrects_push(mr, f.x, f.y, *x - f.x, f.h))
+            return nk_false;
+        if (*x + w < f.x + f.w && !nk_rp_maxrects_push(mr, *x + w, f.y, f.x + f.w - (*x + w), f.h))
+            return nk_false;
+        if (*y > f.y && !nk_rp_maxrects_push(mr, f.x, f.y, f.w, *y - f.y))
+            return nk_false;
+        if (*y + h < f.y + f.h && !nk_rp_maxrects_push(mr, f.x, *y + h, f.w, f.y + f.h - (*y + h)))
+            return nk_false;
+    }
+    /* only new rects can be contained in another one since the old ones
+     * were maximal before and new rects are parts of removed old ones */
+    for (i = n; i < mr->count; ++i) {
+        for (j = 0; j < mr->count; ++j) {
+            if (i == j || !mr->free_rects[j].w) continue;
+            if (nk_rp_maxrects_contains(&mr->free_rects[j], &mr->free_rects[i])) {
+                mr->free_rects[i].w = 0;
+                break;
+            }
+        }
+    }
+    for (i = 0, j = 0; i < mr->count; ++i) {
+        if (mr->free_rects[i].w)
+            mr->free_rects[j++] = mr->free_rects[i];
+    }
+    mr->count = j;
+    return nk_true;
+}
+NK_INTERN int
+nk_rp_maxrects_pack_rects(struct nk_rp_maxrects *mr, struct nk_rp_rect *rects, int num_rects)
+{
+    int i, all_packed = nk_true;
+    for (i=0; i < num_rects; ++i)
+        rects[i].was_packed = i;
+    nk_rp_qsort(rects, (unsigned)num_rects, nk_rect_height_compare);
+    for (i=0; i < num_rects; ++i) {
+        int x, y;
+        if (all_packed && nk_rp_maxrects_insert(mr, rects[i].w, rects[i].h, &x, &y)) {
+            rects[i].x = (nk_rp_coord)x;
+            rects[i].y = (nk_rp_coord)y;
+        } else {
+            rects[i].x = rects[i].y = NK_RP__MAXVAL;
+            all_packed = nk_false;
+        }
+    }
+    nk_rp_qsort(rects, (unsigned)num_rects, nk_rect_original_order);
+    for (i=0; i < num_rects; ++i)
+        rects[i].was_packed = !(rects[i].x == NK_RP__MAXVAL && rects[i].y == NK_RP__MAXVAL);
+    return all_packed;
+}
+
 /*
  * ==============================================================
  *
@@ -10959,6 +12683,8 @@ struct nk_tt_pack_range {
     struct nk_tt_packedchar *chardata_for_range; /* output */
     unsigned char h_oversample, v_oversample;
     /* don't set these, they're used internally */
+    unsigned char sdf_spread;
+    /* if non-zero, glyphs are rendered as distance fields with this border */
 };
 
 struct nk_tt_pack_context {
@@ -10997,16 +12723,6 @@ struct nk_tt__bitmap{
    unsigned char *pixels;
 };
 
-struct nk_tt__hheap_chunk {
-    struct nk_tt__hheap_chunk *next;
-};
-struct nk_tt__hheap {
-    struct nk_allocator alloc;
-    struct nk_tt__hheap_chunk *head;
-    void   *first_free;
-    int    num_remaining_in_head_chunk;
-};
-
 struct nk_tt__edge {
     float x0,y0, x1,y1;
     int invert;
@@ -11555,6 +13271,19 @@ nk_tt_GetGlyphHMetrics(const struct nk_tt_fontinfo *info, int glyph_index,
             *leftSideBearing = nk_ttSHORT(info->data + info->hmtx + 4*numOfLongHorMetrics + 2*(glyph_index - numOfLongHorMetrics));
     }
 }
+NK_INTERN int
+nk_tt_GetKerningPairs(const struct nk_tt_fontinfo *info, const nk_byte **pairs)
+{
+    /* returns the number of 6 byte (left, right, value) glyph pairs of the
+     * first `kern` subtable. Only horizontal format 0 tables are supported */
+    const nk_byte *data = info->data + info->kern;
+    *pairs = 0;
+    if (!info->kern) return 0;
+    if (nk_ttUSHORT(data+2) < 1) return 0; /* number of tables */
+    if (nk_ttUSHORT(data+8) != 1) return 0; /* horizontal flag, format 0 */
+    *pairs = data + 18;
+    return nk_ttUSHORT(data+10);
+}
 NK_INTERN void
 nk_tt_GetFontVMetrics(const struct nk_tt_fontinfo *info,
     int *ascent, int *descent, int *lineGap)
@@ -11609,53 +13338,12 @@ nk_tt_GetGlyphBitmapBox(const struct nk_tt_fontinfo *font, int glyph,
 /*-------------------------------------------------------------
  *                          Rasterizer
  * --------------------------------------------------------------*/
-NK_INTERN void*
-nk_tt__hheap_alloc(struct nk_tt__hheap *hh, nk_size size)
-{
-    if (hh->first_free) {
-        void *p = hh->first_free;
-        hh->first_free = * (void **) p;
-        return p;
-    } else {
-        if (hh->num_remaining_in_head_chunk == 0) {
-            int count = (size < 32 ? 2000 : size < 128 ? 800 : 100);
-            struct nk_tt__hheap_chunk *c = (struct nk_tt__hheap_chunk *)
-                hh->alloc.alloc(hh->alloc.userdata, 0,
-                sizeof(struct nk_tt__hheap_chunk) + size * (nk_size)count);
-            if (c == 0) return 0;
-            c->next = hh->head;
-            hh->head = c;
-            hh->num_remaining_in_head_chunk = count;
-        }
-        --hh->num_remaining_in_head_chunk;
-        return (char *) (hh->head) + size * (nk_size)hh->num_remaining_in_head_chunk;
-    }
-}
-NK_INTERN void
-nk_tt__hheap_free(struct nk_tt__hheap *hh, void *p)
-{
-    *(void **) p = hh->first_free;
-    hh->first_free = p;
-}
-NK_INTERN void
-nk_tt__hheap_cleanup(struct nk_tt__hheap *hh)
-{
-    struct nk_tt__hheap_chunk *c = hh->head;
-    while (c) {
-        struct nk_tt__hheap_chunk *n = c->next;
-        hh->alloc.free(hh->alloc.userdata, c);
-        c = n;
-    }
-}
 NK_INTERN struct nk_tt__active_edge*
-nk_tt__new_active(struct nk_tt__hheap *hh, struct nk_tt__edge *e,
+nk_tt__new_active(struct nk_tt__active_edge *z, struct nk_tt__edge *e,
     int off_x, float start_point)
 {
-    struct nk_tt__active_edge *z = (struct nk_tt__active_edge *)
-        nk_tt__hheap_alloc(hh, sizeof(*z));
     float dxdy = (e->x1 - e->x0) / (e->y1 - e->y0);
     /*STBTT_assert(e->y0 <= start_point); */
-    if (!z) return z;
     z->fdx = dxdy;
     z->fdy = (dxdy != 0) ? (1/dxdy): 0;
     z->fx = e->x0 + dxdy * (start_point - e->y0);
@@ -11860,24 +13548,76 @@ nk_tt__fill_active_edges_new(float *scanline, float *scanline_fill, int len,
     }
 }
 NK_INTERN void
+nk_tt__accumulate_scanline(unsigned char *pixels, float *scanline,
+    float *scanline2, int w)
+{
+    /* prefix sum the fill deltas, add the partial coverage and convert to
+     * 8-bit coverage. Both buffers are cleared on the way for the next row */
+    float sum = 0;
+    int i = 0;
+#ifdef NK_SSE2
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 carry = _mm_setzero_ps();
+    for (; i + 4 <= w; i += 4) {
+        __m128 s = _mm_loadu_ps(scanline2 + i);
+        __m128 k;
+        __m128i m;
+        int packed;
+        s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 4)));
+        s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 8)));
+        s = _mm_add_ps(s, carry);
+        carry = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3,3,3,3));
+
+        k = _mm_andnot_ps(sign, _mm_add_ps(_mm_loadu_ps(scanline + i), s));
+        k = _mm_add_ps(_mm_mul_ps(k, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+        m = _mm_cvttps_epi32(k);
+        m = _mm_packs_epi32(m, m);
+        m = _mm_packus_epi16(m, m);
+        packed = _mm_cvtsi128_si32(m);
+        pixels[i+0] = (unsigned char)(packed & 0xFF);
+        pixels[i+1] = (unsigned char)((packed >> 8) & 0xFF);
+        pixels[i+2] = (unsigned char)((packed >> 16) & 0xFF);
+        pixels[i+3] = (unsigned char)((packed >> 24) & 0xFF);
+        _mm_storeu_ps(scanline + i, zero);
+        _mm_storeu_ps(scanline2 + i, zero);
+    }
+    _mm_store_ss(&sum, carry);
+#endif
+    for (; i < w; ++i) {
+        float k;
+        int m;
+        sum += scanline2[i];
+        k = scanline[i] + sum;
+        k = (float) NK_ABS(k) * 255.0f + 0.5f;
+        m = (int) k;
+        if (m > 255) m = 255;
+        pixels[i] = (unsigned char) m;
+        scanline[i] = 0;
+        scanline2[i] = 0;
+    }
+    scanline2[w] = 0;
+}
+NK_INTERN void
 nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *e,
-    int n, int vsubsample, int off_x, int off_y, struct nk_allocator *alloc)
+    int n, struct nk_tt__active_edge *pool, int vsubsample, int off_x, int off_y,
+    struct nk_allocator *alloc)
 {
-    /* directly AA rasterize edges w/o supersampling */
-    struct nk_tt__hheap hh;
+    /* directly AA rasterize edges w/o supersampling. Every edge becomes
+     * active at most once, so `pool` holds room for all `n` of them and
+     * active edges are bump allocated from it instead of freed one by one */
     struct nk_tt__active_edge *active = 0;
-    int y,j=0, i;
+    int y,j=0;
     float scanline_data[129], *scanline, *scanline2;
 
     NK_UNUSED(vsubsample);
-    nk_zero_struct(hh);
-    hh.alloc = *alloc;
-
     if (result->w > 64)
         scanline = (float *) alloc->alloc(alloc->userdata,0, (nk_size)(result->w*2+1) * sizeof(float));
     else scanline = scanline_data;
+    if (!scanline) return;
 
     scanline2 = scanline + result->w;
+    NK_MEMSET(scanline, 0, (nk_size)(result->w*2+1)*sizeof(scanline[0]));
     y = off_y;
     e[n].y0 = (float) (off_y + result->h) + 1;
 
@@ -11888,9 +13628,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         float scan_y_bottom = (float)y + 1.0f;
         struct nk_tt__active_edge **step = &active;
 
-        NK_MEMSET(scanline , 0, (nk_size)result->w*sizeof(scanline[0]));
-        NK_MEMSET(scanline2, 0, (nk_size)(result->w+1)*sizeof(scanline[0]));
-
         /* update all active edges; */
         /* remove all active edges that terminate before the top of this scanline */
         while (*step) {
@@ -11899,7 +13636,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
                 *step = z->next; /* delete from list */
                 NK_ASSERT(z->direction);
                 z->direction = 0;
-                nk_tt__hheap_free(&hh, z);
             } else {
                 step = &((*step)->next); /* advance through list */
             }
@@ -11908,13 +13644,11 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         /* insert all edges that start before the bottom of this scanline */
         while (e->y0 <= scan_y_bottom) {
             if (e->y0 != e->y1) {
-                struct nk_tt__active_edge *z = nk_tt__new_active(&hh, e, off_x, scan_y_top);
-                if (z != 0) {
-                    NK_ASSERT(z->ey >= scan_y_top);
-                    /* insert at front */
-                    z->next = active;
-                    active = z;
-                }
+                struct nk_tt__active_edge *z = nk_tt__new_active(pool++, e, off_x, scan_y_top);
+                NK_ASSERT(z->ey >= scan_y_top);
+                /* insert at front */
+                z->next = active;
+                active = z;
             }
             ++e;
         }
@@ -11922,20 +13656,9 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         /* now process all active edges */
         if (active)
             nk_tt__fill_active_edges_new(scanline, scanline2+1, result->w, active, scan_y_top);
+        nk_tt__accumulate_scanline(result->pixels + j*result->stride,
+            scanline, scanline2, result->w);
 
-        {
-            float sum = 0;
-            for (i=0; i < result->w; ++i) {
-                float k;
-                int m;
-                sum += scanline2[i];
-                k = scanline[i] + sum;
-                k = (float) NK_ABS(k) * 255.0f + 0.5f;
-                m = (int) k;
-                if (m > 255) m = 255;
-                result->pixels[j*result->stride + i] = (unsigned char) m;
-            }
-        }
         /* advance all the edges */
         step = &active;
         while (*step) {
@@ -11946,7 +13669,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         ++y;
         ++j;
     }
-    nk_tt__hheap_cleanup(&hh);
     if (scanline != scanline_data)
         alloc->free(alloc->userdata, scanline);
 }
@@ -12049,6 +13771,7 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     struct nk_allocator *alloc)
 {
     float y_scale_inv = invert ? -scale_y : scale_y;
+    struct nk_tt__active_edge *pool;
     struct nk_tt__edge *e;
     int n,i,j,k,m;
     int vsubsample = 1;
@@ -12059,9 +13782,12 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     for (i=0; i < windings; ++i)
         n += wcount[i];
 
-    e = (struct nk_tt__edge*)
-       alloc->alloc(alloc->userdata, 0,(sizeof(*e) * (nk_size)(n+1)));
-    if (e == 0) return;
+    /* active edges for the rasterizer share the allocation, ahead of the
+     * edge list to keep their pointers aligned */
+    pool = (struct nk_tt__active_edge*)
+       alloc->alloc(alloc->userdata, 0, sizeof(*pool) * (nk_size)n + sizeof(*e) * (nk_size)(n+1));
+    if (pool == 0) return;
+    e = (struct nk_tt__edge*)(void*)(pool + n);
     n = 0;
 
     m=0;
@@ -12094,8 +13820,8 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     /*STBTT_sort(e, n, sizeof(e[0]), nk_tt__edge_compare); */
     nk_tt__sort_edges(e, n);
     /* now, traverse the scanlines and find the intersections on each scanline, use xor winding rule */
-    nk_tt__rasterize_sorted_edges(result, e, n, vsubsample, off_x, off_y, alloc);
-    alloc->free(alloc->userdata, e);
+    nk_tt__rasterize_sorted_edges(result, e, n, pool, vsubsample, off_x, off_y, alloc);
+    alloc->free(alloc->userdata, pool);
 }
 NK_INTERN void
 nk_tt__add_point(struct nk_tt__point *points, int n, float x, float y)
@@ -12251,6 +13977,87 @@ nk_tt_MakeGlyphBitmapSubpixel(const struct nk_tt_fontinfo *info, unsigned char *
             shift_x, shift_y, ix0,iy0, 1, alloc);
     alloc->free(alloc->userdata, vertices);
 }
+NK_INTERN void
+nk_tt_MakeGlyphSDF(const struct nk_tt_fontinfo *info, unsigned char *output,
+    int out_w, int out_h, int out_stride, float scale, int spread, int glyph,
+    struct nk_allocator *alloc)
+{
+    /* signed distance to the flattened glyph outline. The outline itself
+     * maps to 127.5 and values grow by 127.5/spread per pixel towards the
+     * inside of the glyph. The bitmap has a border of `spread` pixels
+     * around the glyph box. */
+    int ix0,iy0;
+    int x, y, i, c;
+    int contour_count = 0;
+    int *contour_lengths = 0;
+    struct nk_tt__point *points = 0;
+    struct nk_tt_vertex *vertices;
+    int num_verts = nk_tt_GetGlyphShape(info, alloc, glyph, &vertices);
+    float max_dist = (float)spread + 1.0f;
+    float dist_scale = 127.5f / (float)spread;
+
+    nk_tt_GetGlyphBitmapBox(info, glyph, scale, scale, &ix0,&iy0,0,0);
+    if (num_verts > 0)
+        points = nk_tt_FlattenCurves(vertices, num_verts, 0.35f / scale,
+            &contour_lengths, &contour_count, alloc);
+    if (points) {
+        /* move outline into bitmap space */
+        int n = 0;
+        for (c = 0; c < contour_count; ++c)
+            n += contour_lengths[c];
+        for (i = 0; i < n; ++i) {
+            points[i].x = points[i].x * scale - (float)(ix0 - spread);
+            points[i].y = -points[i].y * scale - (float)(iy0 - spread);
+        }
+    }
+    for (y = 0; y < out_h; ++y) {
+        unsigned char *row = output + y * out_stride;
+        for (x = 0; x < out_w; ++x) {
+            float px = (float)x + 0.5f;
+            float py = (float)y + 0.5f;
+            float min_dist = max_dist * max_dist;
+            float dist, value;
+            int winding = 0;
+            int start = 0;
+
+            for (c = 0; points && c < contour_count; ++c) {
+                const struct nk_tt__point *p = points + start;
+                int n = contour_lengths[c];
+                for (i = 0; i < n; ++i) {
+                    const struct nk_tt__point *a = &p[(i) ? i-1: n-1];
+                    const struct nk_tt__point *b = &p[i];
+                    float dx = b->x - a->x, dy = b->y - a->y;
+                    float len = dx*dx + dy*dy;
+                    float t = 0, ex, ey;
+
+                    /* non-zero winding rule for the inside test */
+                    if ((a->y <= py) != (b->y <= py)) {
+                        float cx = a->x + (py - a->y) / dy * dx;
+                        if (cx > px) winding += (dy > 0) ? 1: -1;
+                    }
+                    /* squared distance to the closest point on the edge */
+                    if (len > 0) {
+                        t = ((px - a->x) * dx + (py - a->y) * dy) / len;
+                        t = NK_CLAMP(0.0f, t, 1.0f);
+                    }
+                    ex = a->x + t * dx - px;
+                    ey = a->y + t * dy - py;
+                    min_dist = NK_MIN(min_dist, ex*ex + ey*ey);
+                }
+                start += n;
+            }
+            dist = (min_dist > 0) ? NK_SQRT(min_dist): 0;
+            if (!winding) dist = -dist;
+            value = 127.5f + dist * dist_scale;
+            row[x] = (unsigned char)NK_CLAMP(0.0f, value + 0.5f, 255.0f);
+        }
+    }
+    if (points) {
+        alloc->free(alloc->userdata, contour_lengths);
+        alloc->free(alloc->userdata, points);
+    }
+    alloc->free(alloc->userdata, vertices);
+}
 
 /*-------------------------------------------------------------
  *                          Bitmap baking
@@ -12467,92 +14274,97 @@ nk_tt_PackFontRangesGatherRects(struct nk_tt_pack_context *spc,
                 scale * (float)spc->v_oversample, 0,0, &x0,&y0,&x1,&y1);
             rects[k].w = (nk_rp_coord) (x1-x0 + spc->padding + (int)spc->h_oversample-1);
             rects[k].h = (nk_rp_coord) (y1-y0 + spc->padding + (int)spc->v_oversample-1);
+            rects[k].w = (nk_rp_coord) (rects[k].w + 2 * ranges[i].sdf_spread);
+            rects[k].h = (nk_rp_coord) (rects[k].h + 2 * ranges[i].sdf_spread);
             ++k;
         }
     }
     return k;
 }
+NK_INTERN void
+nk_tt_PackFontRangeRenderGlyph(struct nk_tt_pack_context *spc,
+    struct nk_tt_fontinfo *info, struct nk_tt_pack_range *range, int j,
+    float scale, struct nk_rp_rect *r, struct nk_allocator *alloc)
+{
+    /* renders a single packed glyph of a range into its own rectangle.
+     * Only the rectangle and the packed char of the glyph are written
+     * so different glyphs can be rendered concurrently. */
+    struct nk_tt_packedchar *bc = &range->chardata_for_range[j];
+    int h_oversample = (int)range->h_oversample;
+    int v_oversample = (int)range->v_oversample;
+    float recip_h = 1.0f / (float)h_oversample;
+    float recip_v = 1.0f / (float)v_oversample;
+    float sub_x = nk_tt__oversample_shift(h_oversample);
+    float sub_y = nk_tt__oversample_shift(v_oversample);
+    int advance, lsb, x0,y0,x1,y1;
+    int codepoint = range->first_unicode_codepoint_in_range ?
+        range->first_unicode_codepoint_in_range + j :
+        range->array_of_unicode_codepoints[j];
+    int glyph = nk_tt_FindGlyphIndex(info, codepoint);
+    nk_rp_coord pad = (nk_rp_coord) spc->padding;
+
+    /* pad on left and top */
+    r->x = (nk_rp_coord)((int)r->x + (int)pad);
+    r->y = (nk_rp_coord)((int)r->y + (int)pad);
+    r->w = (nk_rp_coord)((int)r->w - (int)pad);
+    r->h = (nk_rp_coord)((int)r->h - (int)pad);
+
+    nk_tt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
+    nk_tt_GetGlyphBitmapBox(info, glyph, scale * (float)h_oversample,
+            (scale * (float)v_oversample), &x0,&y0,&x1,&y1);
+    if (range->sdf_spread) {
+        /* distance fields are never oversampled */
+        nk_tt_MakeGlyphSDF(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, scale, range->sdf_spread, glyph, alloc);
+        x0 -= range->sdf_spread;
+        y0 -= range->sdf_spread;
+    } else nk_tt_MakeGlyphBitmapSubpixel(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
+        (int)(r->w - h_oversample+1), (int)(r->h - v_oversample+1),
+        spc->stride_in_bytes, scale * (float)h_oversample,
+        scale * (float)v_oversample, 0,0, glyph, alloc);
+
+    if (h_oversample > 1)
+       nk_tt__h_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, h_oversample);
+
+    if (v_oversample > 1)
+       nk_tt__v_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, v_oversample);
+
+    bc->x0       = (nk_ushort)  r->x;
+    bc->y0       = (nk_ushort)  r->y;
+    bc->x1       = (nk_ushort) (r->x + r->w);
+    bc->y1       = (nk_ushort) (r->y + r->h);
+    bc->xadvance = scale * (float)advance;
+    bc->xoff     = (float)  x0 * recip_h + sub_x;
+    bc->yoff     = (float)  y0 * recip_v + sub_y;
+    bc->xoff2    = ((float)x0 + r->w) * recip_h + sub_x;
+    bc->yoff2    = ((float)y0 + r->h) * recip_v + sub_y;
+}
 NK_INTERN int
 nk_tt_PackFontRangesRenderIntoRects(struct nk_tt_pack_context *spc,
     struct nk_tt_fontinfo *info, struct nk_tt_pack_range *ranges,
     int num_ranges, struct nk_rp_rect *rects, struct nk_allocator *alloc)
 {
     int i,j,k, return_value = 1;
-    /* save current values */
-    int old_h_over = (int)spc->h_oversample;
-    int old_v_over = (int)spc->v_oversample;
     /* rects array must be big enough to accommodate all characters in the given ranges */
 
     k = 0;
     for (i=0; i < num_ranges; ++i)
     {
         float fh = ranges[i].font_size;
-        float recip_h,recip_v,sub_x,sub_y;
         float scale = fh > 0 ? nk_tt_ScaleForPixelHeight(info, fh):
             nk_tt_ScaleForMappingEmToPixels(info, -fh);
 
-        spc->h_oversample = ranges[i].h_oversample;
-        spc->v_oversample = ranges[i].v_oversample;
-
-        recip_h = 1.0f / (float)spc->h_oversample;
-        recip_v = 1.0f / (float)spc->v_oversample;
-
-        sub_x = nk_tt__oversample_shift((int)spc->h_oversample);
-        sub_y = nk_tt__oversample_shift((int)spc->v_oversample);
-
         for (j=0; j < ranges[i].num_chars; ++j)
         {
             struct nk_rp_rect *r = &rects[k];
             if (r->was_packed)
-            {
-                struct nk_tt_packedchar *bc = &ranges[i].chardata_for_range[j];
-                int advance, lsb, x0,y0,x1,y1;
-                int codepoint = ranges[i].first_unicode_codepoint_in_range ?
-                    ranges[i].first_unicode_codepoint_in_range + j :
-                    ranges[i].array_of_unicode_codepoints[j];
-                int glyph = nk_tt_FindGlyphIndex(info, codepoint);
-                nk_rp_coord pad = (nk_rp_coord) spc->padding;
-
-                /* pad on left and top */
-                r->x = (nk_rp_coord)((int)r->x + (int)pad);
-                r->y = (nk_rp_coord)((int)r->y + (int)pad);
-                r->w = (nk_rp_coord)((int)r->w - (int)pad);
-                r->h = (nk_rp_coord)((int)r->h - (int)pad);
-
-                nk_tt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
-                nk_tt_GetGlyphBitmapBox(info, glyph, scale * (float)spc->h_oversample,
-                        (scale * (float)spc->v_oversample), &x0,&y0,&x1,&y1);
-                nk_tt_MakeGlyphBitmapSubpixel(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                    (int)(r->w - spc->h_oversample+1), (int)(r->h - spc->v_oversample+1),
-                    spc->stride_in_bytes, scale * (float)spc->h_oversample,
-                    scale * (float)spc->v_oversample, 0,0, glyph, alloc);
-
-                if (spc->h_oversample > 1)
-                   nk_tt__h_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                        r->w, r->h, spc->stride_in_bytes, (int)spc->h_oversample);
-
-                if (spc->v_oversample > 1)
-                   nk_tt__v_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                        r->w, r->h, spc->stride_in_bytes, (int)spc->v_oversample);
-
-                bc->x0       = (nk_ushort)  r->x;
-                bc->y0       = (nk_ushort)  r->y;
-                bc->x1       = (nk_ushort) (r->x + r->w);
-                bc->y1       = (nk_ushort) (r->y + r->h);
-                bc->xadvance = scale * (float)advance;
-                bc->xoff     = (float)  x0 * recip_h + sub_x;
-                bc->yoff     = (float)  y0 * recip_v + sub_y;
-                bc->xoff2    = ((float)x0 + r->w) * recip_h + sub_x;
-                bc->yoff2    = ((float)y0 + r->h) * recip_v + sub_y;
-            } else {
-                return_value = 0; /* if any fail, report failure */
-            }
+                nk_tt_PackFontRangeRenderGlyph(spc, info, &ranges[i], j, scale, r, alloc);
+            else return_value = 0; /* if any fail, report failure */
             ++k;
         }
     }
-    /* restore original values */
-    spc->h_oversample = (unsigned int)old_h_over;
-    spc->v_oversample = (unsigned int)old_v_over;
     return return_value;
 }
 NK_INTERN void
@@ -12596,6 +14408,7 @@ struct nk_font_bake_data {
     struct nk_rp_rect *rects;
     struct nk_tt_pack_range *ranges;
     nk_rune range_count;
+    int rect_count;
 };
 
 struct nk_font_baker {
@@ -12725,11 +14538,47 @@ nk_font_baker(void *memory, int glyph_count, int count, struct nk_allocator *all
     baker->alloc = *alloc;
     return baker;
 }
+#define NK_FONT_ATLAS_PACK_MIN_WIDTH 256
+#define NK_FONT_ATLAS_PACK_MAX_WIDTH 4096
+NK_INTERN int
+nk_font_bake_pack_rects(struct nk_rp_rect *custom, struct nk_rp_rect *rects,
+    int count, int width, int height, enum nk_font_atlas_packing packing,
+    struct nk_allocator *alloc)
+{
+    /* packs the custom rect and then all glyph rects of all fonts at once
+     * into a `width` wide area and returns the used height or -1 if not
+     * everything fits */
+    int i, used = 0, packed;
+    if (packing == NK_FONT_ATLAS_PACK_MAXRECTS) {
+        struct nk_rp_maxrects mr;
+        if (!nk_rp_maxrects_init(&mr, width-1, height-1, alloc)) return -1;
+        packed = !custom || nk_rp_maxrects_pack_rects(&mr, custom, 1);
+        packed = packed && nk_rp_maxrects_pack_rects(&mr, rects, count);
+        nk_rp_maxrects_cleanup(&mr);
+    } else {
+        struct nk_tt_pack_context spc;
+        struct nk_rp_context *context;
+        if (!nk_tt_PackBegin(&spc, 0, width, height, 0, 1, alloc)) return -1;
+        context = (struct nk_rp_context*)spc.pack_info;
+        context->heuristic = NK_RP_HEURISTIC_Skyline_BF_sortHeight;
+        if (custom) nk_rp_pack_rects(context, custom, 1);
+        nk_rp_pack_rects(context, rects, count);
+        nk_tt_PackEnd(&spc, alloc);
+        packed = !custom || custom->was_packed;
+        for (i = 0; i < count && packed; ++i)
+            packed = rects[i].was_packed;
+    }
+    if (!packed) return -1;
+    if (custom) used = custom->y + custom->h;
+    for (i = 0; i < count; ++i)
+        used = NK_MAX(used, rects[i].y + rects[i].h);
+    return used;
+}
 NK_INTERN int
 nk_font_bake_pack(struct nk_font_baker *baker,
     nk_size *image_memory, int *width, int *height, struct nk_recti *custom,
     const struct nk_font_config *config_list, int count,
-    struct nk_allocator *alloc)
+    enum nk_font_atlas_packing packing, struct nk_allocator *alloc)
 {
     NK_STORAGE const nk_size max_height = 1024 * 32;
     const struct nk_font_config *config_iter, *it;
@@ -12768,25 +14617,9 @@ nk_font_bake_pack(struct nk_font_baker *baker,
         int range_n = 0;
         int rect_n = 0;
         int char_n = 0;
+        struct nk_rp_rect custom_space;
 
-        if (custom) {
-            /* pack custom user data first so it will be in the upper left corner*/
-            struct nk_rp_rect custom_space;
-            nk_zero(&custom_space, sizeof(custom_space));
-            custom_space.w = (nk_rp_coord)(custom->w);
-            custom_space.h = (nk_rp_coord)(custom->h);
-
-            nk_tt_PackSetOversampling(&baker->spc, 1, 1);
-            nk_rp_pack_rects((struct nk_rp_context*)baker->spc.pack_info, &custom_space, 1);
-            *height = NK_MAX(*height, (int)(custom_space.y + custom_space.h));
-
-            custom->x = (short)custom_space.x;
-            custom->y = (short)custom_space.y;
-            custom->w = (short)custom_space.w;
-            custom->h = (short)custom_space.h;
-        }
-
-        /* first font pass: pack all glyphs */
+        /* first font pass: gather the rects of all glyphs */
         for (input_i = 0, config_iter = config_list; input_i < count && config_iter;
             config_iter = config_iter->next) {
             it = config_iter;
@@ -12813,36 +14646,159 @@ nk_font_bake_pack(struct nk_font_baker *baker,
                     tmp->ranges[i].first_unicode_codepoint_in_range = (int)in_range[0];
                     tmp->ranges[i].num_chars = (int)(in_range[1]- in_range[0]) + 1;
                     tmp->ranges[i].chardata_for_range = baker->packed_chars + char_n;
+                    tmp->ranges[i].sdf_spread = (unsigned char)(cfg->sdf ? NK_MAX(cfg->sdf_spread, 1): 0);
                     char_n += tmp->ranges[i].num_chars;
                 }
 
                 /* pack */
                 tmp->rects = baker->rects + rect_n;
                 rect_n += glyph_count;
-                nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
+                if (cfg->sdf) nk_tt_PackSetOversampling(&baker->spc, 1, 1);
+                else nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
                 n = nk_tt_PackFontRangesGatherRects(&baker->spc, &tmp->info,
                     tmp->ranges, (int)tmp->range_count, tmp->rects);
-                nk_rp_pack_rects((struct nk_rp_context*)baker->spc.pack_info, tmp->rects, (int)n);
-
-                /* texture height */
-                for (i = 0; i < n; ++i) {
-                    if (tmp->rects[i].was_packed)
-                        *height = NK_MAX(*height, tmp->rects[i].y + tmp->rects[i].h);
-                }
+                tmp->rect_count = n;
             } while ((it = it->n) != config_iter);
         }
         NK_ASSERT(rect_n == total_glyph_count);
         NK_ASSERT(char_n == total_glyph_count);
         NK_ASSERT(range_n == total_range_count);
+
+        /* pack custom user data first so it will be in the upper left corner*/
+        nk_zero(&custom_space, sizeof(custom_space));
+        if (custom) {
+            custom_space.w = (nk_rp_coord)(custom->w);
+            custom_space.h = (nk_rp_coord)(custom->h);
+        }
+        if (packing == NK_FONT_ATLAS_PACK_DEFAULT) {
+            /* skyline bottom-left font by font into a fixed width */
+            struct nk_rp_context *context = (struct nk_rp_context*)baker->spc.pack_info;
+            if (custom) {
+                nk_rp_pack_rects(context, &custom_space, 1);
+                *height = NK_MAX(*height, (int)(custom_space.y + custom_space.h));
+            }
+            for (input_i = 0; input_i < count; ++input_i) {
+                struct nk_font_bake_data *tmp = &baker->build[input_i];
+                nk_rp_pack_rects(context, tmp->rects, tmp->rect_count);
+                for (i = 0; i < tmp->rect_count; ++i) {
+                    if (tmp->rects[i].was_packed)
+                        *height = NK_MAX(*height, tmp->rects[i].y + tmp->rects[i].h);
+                }
+            }
+        } else {
+            /* try every heuristic and power of two width and keep the one
+             * with the smallest power of two texture, preferring squares */
+            NK_STORAGE const enum nk_font_atlas_packing heuristics[] = {
+                NK_FONT_ATLAS_PACK_SKYLINE, NK_FONT_ATLAS_PACK_MAXRECTS
+            };
+            struct nk_rp_rect *custom_rect = (custom) ? &custom_space: 0;
+            enum nk_font_atlas_packing best = NK_FONT_ATLAS_PACK_DEFAULT;
+            nk_size best_area = 0, best_used = 0, rect_area;
+            int best_width = 0, best_height = 0;
+            int h, w, j;
+
+            rect_area = (nk_size)custom_space.w * (nk_size)custom_space.h;
+            for (i = 0; i < total_glyph_count; ++i)
+                rect_area += (nk_size)baker->rects[i].w * (nk_size)baker->rects[i].h;
+            for (i = 0; i < (int)NK_LEN(heuristics); ++i) {
+                if (packing != NK_FONT_ATLAS_PACK_BEST && packing != heuristics[i])
+                    continue;
+                for (w = NK_FONT_ATLAS_PACK_MIN_WIDTH; w <= NK_FONT_ATLAS_PACK_MAX_WIDTH; w *= 2) {
+                    nk_size area, used;
+                    /* skip widths that cannot beat the best texture even
+                     * if packed without any gaps */
+                    j = (int)((rect_area + (nk_size)w - 1) / (nk_size)w);
+                    if (j > (int)max_height || (best_width &&
+                        (nk_size)w * nk_round_up_pow2((nk_uint)j) > best_area))
+                        continue;
+                    h = nk_font_bake_pack_rects(custom_rect, baker->rects,
+                        total_glyph_count, w, (int)max_height, heuristics[i], alloc);
+                    if (h < 0) continue;
+                    used = (nk_size)w * (nk_size)h;
+                    h = (int)nk_round_up_pow2((nk_uint)h);
+                    area = (nk_size)w * (nk_size)h;
+                    if (!best_width || area < best_area || (area == best_area &&
+                        (w + h < best_width + best_height ||
+                        (w + h == best_width + best_height && used < best_used)))) {
+                        best = heuristics[i];
+                        best_area = area;
+                        best_used = used;
+                        best_width = w;
+                        best_height = h;
+                    }
+                }
+            }
+            if (!best_width) {
+                nk_tt_PackEnd(&baker->spc, alloc);
+                return nk_false;
+            }
+            *width = best_width;
+            baker->spc.width = best_width;
+            baker->spc.stride_in_bytes = best_width;
+            *height = nk_font_bake_pack_rects(custom_rect, baker->rects,
+                total_glyph_count, best_width, (int)max_height, best, alloc);
+            if (*height < 0) {
+                nk_tt_PackEnd(&baker->spc, alloc);
+                return nk_false;
+            }
+        }
+        if (custom) {
+            custom->x = (short)custom_space.x;
+            custom->y = (short)custom_space.y;
+            custom->w = (short)custom_space.w;
+            custom->h = (short)custom_space.h;
+        }
     }
     *height = (int)nk_round_up_pow2((nk_uint)*height);
     *image_memory = (nk_size)(*width) * (nk_size)(*height);
     return nk_true;
 }
+#define NK_FONT_BAKE_JOB_GLYPHS 64
+struct nk_font_bake_jobs {
+    struct nk_font_baker *baker;
+    int font_count;
+};
+NK_INTERN void
+nk_font_bake_job(void *data, int index)
+{
+    /* renders the packed glyphs `index * NK_FONT_BAKE_JOB_GLYPHS` up to
+     * the next job. Rects and packed chars of all fonts are stored one
+     * after another in the order of fonts and ranges. */
+    struct nk_font_bake_jobs *jobs = (struct nk_font_bake_jobs*)data;
+    struct nk_font_baker *baker = jobs->baker;
+    int begin = index * NK_FONT_BAKE_JOB_GLYPHS;
+    int end = begin + NK_FONT_BAKE_JOB_GLYPHS;
+    int font_i, range_i, k = 0;
+
+    for (font_i = 0; font_i < jobs->font_count && k < end; ++font_i) {
+        struct nk_font_bake_data *tmp = &baker->build[font_i];
+        for (range_i = 0; range_i < (int)tmp->range_count && k < end; ++range_i) {
+            struct nk_tt_pack_range *range = &tmp->ranges[range_i];
+            float fh = range->font_size;
+            float scale;
+            int j;
+
+            if (k + range->num_chars <= begin) {
+                k += range->num_chars;
+                continue;
+            }
+            scale = fh > 0 ? nk_tt_ScaleForPixelHeight(&tmp->info, fh):
+                nk_tt_ScaleForMappingEmToPixels(&tmp->info, -fh);
+            for (j = NK_MAX(begin - k, 0); j < range->num_chars && k + j < end; ++j) {
+                struct nk_rp_rect *r = &baker->rects[k + j];
+                if (!r->was_packed) continue;
+                nk_tt_PackFontRangeRenderGlyph(&baker->spc, &tmp->info,
+                    range, j, scale, r, &baker->alloc);
+            }
+            k += range->num_chars;
+        }
+    }
+}
 NK_INTERN void
 nk_font_bake(struct nk_font_baker *baker, void *image_memory, int width, int height,
     struct nk_font_glyph *glyphs, int glyphs_count,
-    const struct nk_font_config *config_list, int font_count)
+    const struct nk_font_config *config_list, int font_count,
+    nk_plugin_parallel_for parallel_for, nk_handle parallel_userdata)
 {
     int input_i = 0;
     nk_rune glyph_n = 0;
@@ -12864,15 +14820,22 @@ nk_font_bake(struct nk_font_baker *baker, void *image_memory, int width, int hei
     nk_zero(image_memory, (nk_size)((nk_size)width * (nk_size)height));
     baker->spc.pixels = (unsigned char*)image_memory;
     baker->spc.height = (int)height;
-    for (input_i = 0, config_iter = config_list; input_i < font_count && config_iter;
-        config_iter = config_iter->next) {
-        it = config_iter;
-        do {const struct nk_font_config *cfg = it;
-            struct nk_font_bake_data *tmp = &baker->build[input_i++];
-            nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
-            nk_tt_PackFontRangesRenderIntoRects(&baker->spc, &tmp->info, tmp->ranges,
-                (int)tmp->range_count, tmp->rects, &baker->alloc);
-        } while ((it = it->n) != config_iter);
+    if (parallel_for && glyphs_count > NK_FONT_BAKE_JOB_GLYPHS) {
+        /* every glyph is rendered into its own packed rect */
+        struct nk_font_bake_jobs jobs;
+        jobs.baker = baker;
+        jobs.font_count = font_count;
+        parallel_for(parallel_userdata, nk_font_bake_job, &jobs,
+            (glyphs_count + NK_FONT_BAKE_JOB_GLYPHS - 1) / NK_FONT_BAKE_JOB_GLYPHS);
+    } else {
+        for (input_i = 0, config_iter = config_list; input_i < font_count && config_iter;
+            config_iter = config_iter->next) {
+            it = config_iter;
+            do {struct nk_font_bake_data *tmp = &baker->build[input_i++];
+                nk_tt_PackFontRangesRenderIntoRects(&baker->spc, &tmp->info, tmp->ranges,
+                    (int)tmp->range_count, tmp->rects, &baker->alloc);
+            } while ((it = it->n) != config_iter);
+        }
     } nk_tt_PackEnd(&baker->spc, &baker->alloc);
 
     /* third pass: setup font and glyphs */
@@ -12999,16 +14962,107 @@ nk_font_bake_convert(void *out_memory, int img_width, int img_height,
     for (n = (int)(img_width * img_height); n > 0; n--)
         *dst++ = ((nk_rune)(*src++) << 24) | 0x00FFFFFF;
 }
+NK_INTERN void
+nk_font_bake_compress(void *out_memory, int img_width, int img_height,
+    const void *in_memory)
+{
+    /* BC4 (RGTC1) compression of an alpha8 image into 8 byte blocks of 4x4
+     * pixels. Each block uses its minimum and maximum as endpoints so fully
+     * transparent and opaque pixels, like the white pixel, stay exact. */
+    int bx, by, x, y;
+    nk_byte *dst;
+    const nk_byte *src;
+
+    NK_ASSERT(out_memory);
+    NK_ASSERT(in_memory);
+    NK_ASSERT(img_width % 4 == 0);
+    NK_ASSERT(img_height % 4 == 0);
+    if (!out_memory || !in_memory || !img_height || !img_width) return;
+
+    dst = (nk_byte*)out_memory;
+    src = (const nk_byte*)in_memory;
+    for (by = 0; by < img_height; by += 4) {
+        for (bx = 0; bx < img_width; bx += 4) {
+            nk_byte lo = 255, hi = 0;
+            nk_uint bits[2] = {0,0};
+            for (y = 0; y < 4; ++y) {
+                const nk_byte *row = src + (by + y) * img_width + bx;
+                for (x = 0; x < 4; ++x) {
+                    lo = NK_MIN(lo, row[x]);
+                    hi = NK_MAX(hi, row[x]);
+                }
+            }
+            for (y = 0; y < 4; ++y) {
+                const nk_byte *row = src + (by + y) * img_width + bx;
+                for (x = 0; x < 4; ++x) {
+                    /* level 0 is `lo` and 7 is `hi`. Index 0 and 1 are the
+                     * endpoints and index 2-7 are levels 6 down to 1 */
+                    int bit = (y * 4 + x) * 3;
+                    nk_uint index = 0;
+                    if (hi > lo) {
+                        int level = ((row[x] - lo) * 14 + (hi - lo)) / ((hi - lo) * 2);
+                        index = (level == 7) ? 0: (level == 0) ? 1: (nk_uint)(8 - level);
+                    }
+                    bits[bit / 24] |= index << (bit % 24);
+                }
+            }
+            dst[0] = hi;
+            dst[1] = lo;
+            dst[2] = (nk_byte)(bits[0] & 0xFF);
+            dst[3] = (nk_byte)((bits[0] >> 8) & 0xFF);
+            dst[4] = (nk_byte)((bits[0] >> 16) & 0xFF);
+            dst[5] = (nk_byte)(bits[1] & 0xFF);
+            dst[6] = (nk_byte)((bits[1] >> 8) & 0xFF);
+            dst[7] = (nk_byte)((bits[1] >> 16) & 0xFF);
+            dst += 8;
+        }
+    }
+}
+NK_INTERN nk_size
+nk_font_bake_image_size(int img_width, int img_height, enum nk_font_atlas_format fmt)
+{
+    nk_size pixels = (nk_size)img_width * (nk_size)img_height;
+    switch (fmt) {
+    case NK_FONT_ATLAS_RGBA32: return pixels * 4;
+    case NK_FONT_ATLAS_BC4: return pixels / 2;
+    default: return pixels;
+    }
+}
 
 /* -------------------------------------------------------------
  *
  *                          FONT
  *
  * --------------------------------------------------------------*/
+NK_INTERN const struct nk_font_glyph *nk_font_cache_glyph(struct nk_font_cache*, const struct nk_font_glyph*);
+
+NK_INTERN nk_uint
+nk_font_kerning_hash(nk_rune first, nk_rune second)
+{
+    nk_uint hash = first * 0x9E3779B1u + second;
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+NK_INTERN float
+nk_font_find_kerning(const struct nk_font *font, nk_rune first, nk_rune second)
+{
+    nk_uint i;
+    if (!font->kerning || !first || !second) return 0;
+    i = nk_font_kerning_hash(first, second) & font->kerning_mask;
+    while (font->kerning[i].first) {
+        if (font->kerning[i].first == first && font->kerning[i].second == second)
+            return font->kerning[i].advance;
+        i = (i + 1) & font->kerning_mask;
+    }
+    return 0;
+}
 NK_INTERN float
 nk_font_text_width(nk_handle handle, float height, const char *text, int len)
 {
     nk_rune unicode;
+    nk_rune prev;
     int text_len  = 0;
     float text_width = 0;
     int glyph_len = 0;
@@ -13032,11 +15086,37 @@ nk_font_text_width(nk_handle handle, float height, const char *text, int len)
         text_width += g->xadvance * scale;
 
         /* offset next glyph */
+        prev = unicode;
         glyph_len = nk_utf_decode(text + text_len, &unicode, (int)len - text_len);
         text_len += glyph_len;
+        if (font->kerning && glyph_len && unicode != NK_UTF_INVALID)
+            text_width += nk_font_find_kerning(font, prev, unicode) * scale;
     }
     return text_width;
 }
+NK_INTERN float
+nk_font_glyph_advance(nk_handle handle, float height, nk_rune codepoint)
+{
+    const struct nk_font_glyph *g;
+    struct nk_font *font = (struct nk_font*)handle.ptr;
+    NK_ASSERT(font);
+    NK_ASSERT(font->glyphs);
+    if (!font || !font->glyphs)
+        return 0;
+    g = nk_font_find_glyph(font, codepoint);
+    return g->xadvance * (height/font->info.height);
+}
+NK_LIB nk_glyph_advance_f
+nk_font_baked_advance(const struct nk_user_font *font)
+{
+    /* glyph advances of a baked font add up to its text width unless
+     * kerning pairs are added in between */
+    const struct nk_font *f;
+    if (!font || font->width != nk_font_text_width)
+        return 0;
+    f = (const struct nk_font*)font->userdata.ptr;
+    return (f && !f->kerning) ? nk_font_glyph_advance: 0;
+}
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 NK_INTERN void
 nk_font_query_font_glyph(nk_handle handle, float height,
@@ -13047,7 +15127,6 @@ nk_font_query_font_glyph(nk_handle handle, float height,
     struct nk_font *font;
 
     NK_ASSERT(glyph);
-    NK_UNUSED(next_codepoint);
 
     font = (struct nk_font*)handle.ptr;
     NK_ASSERT(font);
@@ -13061,42 +15140,132 @@ nk_font_query_font_glyph(nk_handle handle, float height,
     glyph->height = (g->y1 - g->y0) * scale;
     glyph->offset = nk_vec2(g->x0 * scale, g->y0 * scale);
     glyph->xadvance = (g->xadvance * scale);
+    if (font->kerning)
+        glyph->xadvance += nk_font_find_kerning(font, codepoint, next_codepoint) * scale;
     glyph->uv[0] = nk_vec2(g->u0, g->v0);
     glyph->uv[1] = nk_vec2(g->u1, g->v1);
 }
 #endif
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+NK_LIB int
+nk_user_font_is_dynamic(const struct nk_user_font *font)
+{
+    /* looking up glyphs of a dynamic atlas rasterizes them into the shared
+     * cache, so it must not run concurrently with anything else */
+    const struct nk_font *f;
+    if (!font || font->width != nk_font_text_width)
+        return nk_false;
+    f = (const struct nk_font*)font->userdata.ptr;
+    return f && f->cache;
+}
+#endif
 NK_API const struct nk_font_glyph*
 nk_font_find_glyph(struct nk_font *font, nk_rune unicode)
 {
-    int i = 0;
-    int count;
-    int total_glyphs = 0;
     const struct nk_font_glyph *glyph = 0;
-    const struct nk_font_config *iter = 0;
+    const struct nk_font_glyph_range *range;
+    int begin, end;
 
     NK_ASSERT(font);
     NK_ASSERT(font->glyphs);
     NK_ASSERT(font->info.ranges);
     if (!font || !font->glyphs) return 0;
 
-    glyph = font->fallback;
-    iter = font->config;
-    do {count = nk_range_count(iter->range);
-        for (i = 0; i < count; ++i) {
-            nk_rune f = iter->range[(i*2)+0];
-            nk_rune t = iter->range[(i*2)+1];
-            int diff = (int)((t - f) + 1);
-            if (unicode >= f && unicode <= t)
-                return &font->glyphs[((nk_rune)total_glyphs + (unicode - f))];
-            total_glyphs += diff;
+    if (unicode < NK_FONT_LOOKUP_MAX) {
+        glyph = font->lookup[unicode];
+    } else {
+        /* find last range starting in front of or at the codepoint */
+        begin = 0;
+        end = font->range_count;
+        while (begin < end) {
+            int mid = begin + (end - begin) / 2;
+            if (font->ranges[mid].first <= unicode)
+                begin = mid + 1;
+            else end = mid;
         }
-    } while ((iter = iter->n) != font->config);
+        if (begin) {
+            range = &font->ranges[begin-1];
+            if (unicode <= range->last)
+                glyph = &font->glyphs[range->glyph + (unicode - range->first)];
+        }
+    }
+    if (!glyph)
+        glyph = font->fallback;
+    if (font->cache && glyph)
+        glyph = nk_font_cache_glyph(font->cache, glyph);
     return glyph;
 }
-NK_INTERN void
-nk_font_init(struct nk_font *font, float pixel_height,
-    nk_rune fallback_codepoint, struct nk_font_glyph *glyphs,
-    const struct nk_baked_font *baked_font, nk_handle atlas)
+NK_INTERN int
+nk_font_range_total(const struct nk_font_config *config)
+{
+    /* clipping overlapping ranges splits them at most at the bounds of
+     * the other ranges, so n ranges never end up as more than 2n */
+    int total = 0;
+    const struct nk_font_config *iter, *i;
+    for (iter = config; iter; iter = iter->next) {
+        i = iter;
+        do {total += nk_range_count(i->range);
+        } while ((i = i->n) != iter);
+    }
+    return total * 2;
+}
+NK_INTERN void
+nk_font_init_lookup(struct nk_font *font, struct nk_font_glyph_range *ranges)
+{
+    int i, j, count;
+    nk_rune glyph = 0;
+    const struct nk_font_config *iter;
+
+    NK_MEMSET(font->lookup, 0, sizeof(font->lookup));
+    font->ranges = ranges;
+    font->range_count = 0;
+
+    /* insert ranges in config order into a sorted list of disjoint ranges.
+     * Codepoints already covered by an earlier range keep its glyph, so only
+     * the uncovered parts of each range are added */
+    iter = font->config;
+    do {count = nk_range_count(iter->range);
+        for (i = 0; i < count; ++i) {
+            nk_rune first = iter->range[(i*2)+0];
+            nk_rune last = iter->range[(i*2)+1];
+            nk_rune c = first;
+            j = 0;
+            while (c <= last) {
+                nk_rune end = last;
+                int k;
+                while (j < font->range_count && ranges[j].last < c) ++j;
+                if (j < font->range_count && ranges[j].first <= c) {
+                    if (ranges[j].last >= last) break;
+                    c = ranges[j].last + 1;
+                    continue;
+                }
+                if (j < font->range_count && ranges[j].first <= last)
+                    end = ranges[j].first - 1;
+                for (k = font->range_count; k > j; --k)
+                    ranges[k] = ranges[k-1];
+                ranges[j].first = c;
+                ranges[j].last = end;
+                ranges[j].glyph = glyph + (c - first);
+                font->range_count++;
+                if (end == last) break;
+                c = end + 1;
+            }
+            glyph += (last - first) + 1;
+        }
+    } while ((iter = iter->n) != font->config);
+
+    for (i = 0; i < font->range_count; ++i) {
+        const struct nk_font_glyph_range *range = &ranges[i];
+        nk_rune c;
+        for (c = range->first; c <= range->last && c < NK_FONT_LOOKUP_MAX; ++c)
+            font->lookup[c] = &font->glyphs[range->glyph + (c - range->first)];
+    }
+}
+NK_INTERN void
+nk_font_init(struct nk_font *font, float pixel_height,
+    nk_rune fallback_codepoint, struct nk_font_glyph *glyphs,
+    struct nk_font_glyph_range *ranges, const struct nk_baked_font *baked_font,
+    nk_handle atlas)
 {
     struct nk_baked_font baked;
     NK_ASSERT(font);
@@ -13112,6 +15281,9 @@ nk_font_init(struct nk_font *font, float pixel_height,
     font->glyphs = &glyphs[baked_font->glyph_offset];
     font->texture = atlas;
     font->fallback_codepoint = fallback_codepoint;
+    font->kerning = 0;
+    font->kerning_mask = 0;
+    nk_font_init_lookup(font, ranges);
     font->fallback = nk_font_find_glyph(font, fallback_codepoint);
 
     font->handle.height = font->info.height * font->scale;
@@ -13418,6 +15590,288 @@ nk_decode_85(unsigned char* dst, const unsigned char* src)
  *                          FONT ATLAS
  *
  * --------------------------------------------------------------*/
+/*-------------------------------------------------------------
+ *                          Glyph cache
+ * --------------------------------------------------------------*/
+#define NK_FONT_CACHE_BANDS 4
+
+struct nk_font_cache_band {
+    struct nk_rp_context pack;
+    struct nk_rp_node *nodes;
+    int y, h;
+    unsigned int frame;
+    /* last frame a glyph inside the band was looked up */
+};
+struct nk_font_cache_font {
+    struct nk_tt_fontinfo info;
+    const struct nk_font_config *config;
+    int glyph_offset;
+};
+struct nk_font_cache {
+    struct nk_allocator alloc;
+    struct nk_font_cache_band bands[NK_FONT_CACHE_BANDS];
+    struct nk_font_cache_font *fonts;
+    int font_count;
+    struct nk_font_glyph *glyphs;
+    signed char *glyph_band;
+    /* band containing each glyph or -1 if it is not rasterized */
+    int glyph_count;
+    nk_byte *alpha;
+    nk_rune *rgba;
+    int width, height;
+    struct nk_recti custom;
+    struct nk_recti dirty;
+    unsigned int frame;
+};
+
+NK_INTERN void
+nk_font_cache_update(struct nk_font_cache *cache, int x, int y, int w, int h)
+{
+    struct nk_recti *dirty = &cache->dirty;
+    if (w <= 0 || h <= 0) return;
+    if (cache->rgba) {
+        /* keep the RGBA32 image in sync with the alpha image */
+        int i, j;
+        for (j = y; j < y + h; ++j) {
+            const nk_byte *src = cache->alpha + j * cache->width + x;
+            nk_rune *dst = cache->rgba + j * cache->width + x;
+            for (i = 0; i < w; ++i)
+                *dst++ = ((nk_rune)(*src++) << 24) | 0x00FFFFFF;
+        }
+    }
+    if (dirty->w && dirty->h) {
+        int x1 = NK_MAX(dirty->x + dirty->w, x + w);
+        int y1 = NK_MAX(dirty->y + dirty->h, y + h);
+        x = NK_MIN(dirty->x, x);
+        y = NK_MIN(dirty->y, y);
+        w = x1 - x;
+        h = y1 - y;
+    }
+    dirty->x = (short)x;
+    dirty->y = (short)y;
+    dirty->w = (short)w;
+    dirty->h = (short)h;
+}
+NK_INTERN void
+nk_font_cache_reset(struct nk_font_cache *cache, int index)
+{
+    int i = 0;
+    struct nk_font_cache_band *band = &cache->bands[index];
+
+    /* evict all glyphs inside the band */
+    nk_rp_init_target(&band->pack, cache->width-1, band->h-1, band->nodes, cache->width-1);
+    NK_MEMSET(cache->alpha + band->y * cache->width, 0, (nk_size)(cache->width * band->h));
+    for (i = 0; i < cache->glyph_count; ++i) {
+        if (cache->glyph_band[i] == index)
+            cache->glyph_band[i] = -1;
+    }
+    if (!index) {
+        /* custom data always stays in the upper left corner */
+        struct nk_rp_rect custom_space;
+        nk_zero(&custom_space, sizeof(custom_space));
+        custom_space.w = (nk_rp_coord)cache->custom.w;
+        custom_space.h = (nk_rp_coord)cache->custom.h;
+        nk_rp_pack_rects(&band->pack, &custom_space, 1);
+        cache->custom.x = (short)custom_space.x;
+        cache->custom.y = (short)custom_space.y;
+        nk_font_bake_custom_data(cache->alpha, cache->width, cache->height, cache->custom,
+            nk_custom_cursor_data, NK_CURSOR_DATA_W, NK_CURSOR_DATA_H, '.', 'X');
+    }
+    nk_font_cache_update(cache, 0, band->y, cache->width, band->h);
+}
+NK_INTERN int
+nk_font_cache_pack(struct nk_font_cache *cache, struct nk_rp_rect *rect)
+{
+    int i = 0;
+    int lru = -1;
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i) {
+        struct nk_font_cache_band *band = &cache->bands[i];
+        nk_rp_pack_rects(&band->pack, rect, 1);
+        if (rect->was_packed) return i;
+        if (band->frame != cache->frame && (lru < 0 || band->frame < cache->bands[lru].frame))
+            lru = i;
+    }
+    /* evict least recently used band not needed by the current frame */
+    if (lru < 0) return -1;
+    nk_font_cache_reset(cache, lru);
+    nk_rp_pack_rects(&cache->bands[lru].pack, rect, 1);
+    return (rect->was_packed) ? lru: -1;
+}
+NK_INTERN const struct nk_font_glyph*
+nk_font_cache_glyph(struct nk_font_cache *cache, const struct nk_font_glyph *glyph)
+{
+    int index, begin, end, band;
+    int advance, lsb, x0, y0, x1, y1;
+    int glyph_index, h_oversample, v_oversample, spread;
+    const struct nk_font_cache_font *font;
+    const struct nk_font_config *cfg;
+    struct nk_tt_packedchar pc;
+    struct nk_tt_aligned_quad q;
+    struct nk_rp_rect r;
+    struct nk_font_glyph *g;
+    float scale, recip_h, recip_v, dummy_x = 0, dummy_y = 0;
+
+    index = (int)(glyph - cache->glyphs);
+    NK_ASSERT(index >= 0 && index < cache->glyph_count);
+    if (cache->glyph_band[index] >= 0) {
+        cache->bands[cache->glyph_band[index]].frame = cache->frame;
+        return glyph;
+    }
+
+    /* find font config the glyph belongs to */
+    begin = 0;
+    end = cache->font_count;
+    while (end - begin > 1) {
+        int mid = begin + (end - begin) / 2;
+        if (cache->fonts[mid].glyph_offset <= index)
+            begin = mid;
+        else end = mid;
+    }
+    font = &cache->fonts[begin];
+    cfg = font->config;
+    g = &cache->glyphs[index];
+    h_oversample = NK_CLAMP(1, cfg->oversample_h, NK_TT_MAX_OVERSAMPLE);
+    v_oversample = NK_CLAMP(1, cfg->oversample_v, NK_TT_MAX_OVERSAMPLE);
+    spread = (cfg->sdf) ? NK_MAX(cfg->sdf_spread, 1): 0;
+    if (spread) h_oversample = v_oversample = 1;
+
+    /* allocate atlas space the same way `nk_font_bake_pack` does */
+    scale = nk_tt_ScaleForPixelHeight(&font->info, cfg->size);
+    glyph_index = nk_tt_FindGlyphIndex(&font->info, (int)g->codepoint);
+    nk_tt_GetGlyphHMetrics(&font->info, glyph_index, &advance, &lsb);
+    nk_tt_GetGlyphBitmapBoxSubpixel(&font->info, glyph_index, scale * (float)h_oversample,
+        scale * (float)v_oversample, 0,0, &x0,&y0,&x1,&y1);
+    nk_zero(&r, sizeof(r));
+    r.w = (nk_rp_coord)(x1-x0 + 1 + h_oversample-1 + 2*spread);
+    r.h = (nk_rp_coord)(y1-y0 + 1 + v_oversample-1 + 2*spread);
+    band = nk_font_cache_pack(cache, &r);
+    if (band < 0) {
+        /* atlas is full: keep metrics but do not draw anything */
+        g->xadvance = scale * (float)advance + cfg->spacing.x;
+        g->x0 = g->y0 = g->x1 = g->y1 = g->w = g->h = 0;
+        g->u0 = g->v0 = g->u1 = g->v1 = 0;
+        return g;
+    }
+
+    /* rasterize glyph like `nk_tt_PackFontRangesRenderIntoRects` */
+    r.x = (nk_rp_coord)(r.x + 1);
+    r.y = (nk_rp_coord)(r.y + 1 + cache->bands[band].y);
+    r.w = (nk_rp_coord)(r.w - 1);
+    r.h = (nk_rp_coord)(r.h - 1);
+    if (spread) {
+        nk_tt_MakeGlyphSDF(&font->info, cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, scale, spread, glyph_index, &cache->alloc);
+        x0 -= spread;
+        y0 -= spread;
+    } else nk_tt_MakeGlyphBitmapSubpixel(&font->info, cache->alpha + r.x + r.y * cache->width,
+        (int)(r.w - h_oversample + 1), (int)(r.h - v_oversample + 1), cache->width,
+        scale * (float)h_oversample, scale * (float)v_oversample, 0,0, glyph_index, &cache->alloc);
+    if (h_oversample > 1)
+        nk_tt__h_prefilter(cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, h_oversample);
+    if (v_oversample > 1)
+        nk_tt__v_prefilter(cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, v_oversample);
+    nk_font_cache_update(cache, r.x, r.y, r.w, r.h);
+
+    pc.x0 = (nk_ushort)r.x;
+    pc.y0 = (nk_ushort)r.y;
+    pc.x1 = (nk_ushort)(r.x + r.w);
+    pc.y1 = (nk_ushort)(r.y + r.h);
+    pc.xadvance = scale * (float)advance;
+    recip_h = 1.0f / (float)h_oversample;
+    recip_v = 1.0f / (float)v_oversample;
+    pc.xoff = (float)x0 * recip_h + nk_tt__oversample_shift(h_oversample);
+    pc.yoff = (float)y0 * recip_v + nk_tt__oversample_shift(v_oversample);
+    pc.xoff2 = ((float)x0 + r.w) * recip_h + nk_tt__oversample_shift(h_oversample);
+    pc.yoff2 = ((float)y0 + r.h) * recip_v + nk_tt__oversample_shift(v_oversample);
+    nk_tt_GetPackedQuad(&pc, cache->width, cache->height, 0, &dummy_x, &dummy_y, &q, 0);
+
+    /* fill glyph like `nk_font_bake` */
+    g->x0 = q.x0; g->y0 = q.y0;
+    g->x1 = q.x1; g->y1 = q.y1;
+    g->y0 += (cfg->font->ascent + 0.5f);
+    g->y1 += (cfg->font->ascent + 0.5f);
+    g->w = g->x1 - g->x0 + 0.5f;
+    g->h = g->y1 - g->y0;
+    if (cfg->coord_type == NK_COORD_PIXEL) {
+        g->u0 = q.s0 * (float)cache->width;
+        g->v0 = q.t0 * (float)cache->height;
+        g->u1 = q.s1 * (float)cache->width;
+        g->v1 = q.t1 * (float)cache->height;
+    } else {
+        g->u0 = q.s0;
+        g->v0 = q.t0;
+        g->u1 = q.s1;
+        g->v1 = q.t1;
+    }
+    g->xadvance = (pc.xadvance + cfg->spacing.x);
+    if (cfg->pixel_snap)
+        g->xadvance = (float)(int)(g->xadvance + 0.5f);
+
+    cache->glyph_band[index] = (signed char)band;
+    cache->bands[band].frame = cache->frame;
+    return g;
+}
+NK_INTERN void
+nk_font_cache_free(struct nk_font_atlas *atlas)
+{
+    struct nk_font_cache *cache = atlas->cache;
+    if (!cache) return;
+    if (atlas->pixel && (atlas->pixel == cache->alpha || atlas->pixel == cache->rgba))
+        atlas->pixel = 0;
+    if (cache->fonts) atlas->permanent.free(atlas->permanent.userdata, cache->fonts);
+    if (cache->glyph_band) atlas->permanent.free(atlas->permanent.userdata, cache->glyph_band);
+    if (cache->bands[0].nodes) atlas->permanent.free(atlas->permanent.userdata, cache->bands[0].nodes);
+    if (cache->alpha) atlas->permanent.free(atlas->permanent.userdata, cache->alpha);
+    if (cache->rgba) atlas->permanent.free(atlas->permanent.userdata, cache->rgba);
+    atlas->permanent.free(atlas->permanent.userdata, cache);
+    atlas->cache = 0;
+}
+NK_INTERN struct nk_font_cache*
+nk_font_cache_alloc(struct nk_font_atlas *atlas, int width, int height,
+    enum nk_font_atlas_format fmt)
+{
+    int i = 0;
+    nk_size size;
+    struct nk_font_cache *cache;
+    struct nk_allocator *alloc = &atlas->permanent;
+
+    cache = (struct nk_font_cache*)alloc->alloc(alloc->userdata,0, sizeof(struct nk_font_cache));
+    NK_ASSERT(cache);
+    if (!cache) return 0;
+    nk_zero(cache, sizeof(*cache));
+    atlas->cache = cache;
+    cache->alloc = atlas->temporary;
+    cache->width = width;
+    cache->height = height;
+    cache->frame = 1;
+    cache->font_count = atlas->font_num;
+    cache->glyph_count = atlas->glyph_count;
+
+    size = (nk_size)width * (nk_size)height;
+    cache->fonts = (struct nk_font_cache_font*)alloc->alloc(alloc->userdata,0,
+        sizeof(struct nk_font_cache_font) * (nk_size)atlas->font_num);
+    cache->glyph_band = (signed char*)alloc->alloc(alloc->userdata,0, (nk_size)atlas->glyph_count);
+    cache->bands[0].nodes = (struct nk_rp_node*)alloc->alloc(alloc->userdata,0,
+        sizeof(struct nk_rp_node) * (nk_size)(width-1) * NK_FONT_CACHE_BANDS);
+    cache->alpha = (nk_byte*)alloc->alloc(alloc->userdata,0, size);
+    if (fmt == NK_FONT_ATLAS_RGBA32)
+        cache->rgba = (nk_rune*)alloc->alloc(alloc->userdata,0, size * 4);
+    if (!cache->fonts || !cache->glyph_band || !cache->bands[0].nodes ||
+        !cache->alpha || (fmt == NK_FONT_ATLAS_RGBA32 && !cache->rgba)) {
+        nk_font_cache_free(atlas);
+        return 0;
+    }
+    /* split the image into horizontal bands which are evicted as a whole */
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i) {
+        struct nk_font_cache_band *band = &cache->bands[i];
+        band->nodes = cache->bands[0].nodes + (width-1) * i;
+        band->y = (height / NK_FONT_CACHE_BANDS) * i;
+        band->h = (i == NK_FONT_CACHE_BANDS-1) ? height - band->y: height / NK_FONT_CACHE_BANDS;
+    }
+    return cache;
+}
 NK_API struct nk_font_config
 nk_font_config(float pixel_height)
 {
@@ -13430,6 +15884,8 @@ nk_font_config(float pixel_height)
     cfg.oversample_h = 3;
     cfg.oversample_v = 1;
     cfg.pixel_snap = 0;
+    cfg.sdf = 0;
+    cfg.sdf_spread = 4;
     cfg.coord_type = NK_COORD_UV;
     cfg.spacing = nk_vec2(0,0);
     cfg.range = nk_font_default_glyph_ranges();
@@ -13484,10 +15940,20 @@ nk_font_atlas_begin(struct nk_font_atlas *atlas)
     NK_ASSERT(atlas->permanent.alloc && atlas->permanent.free);
     if (!atlas || !atlas->permanent.alloc || !atlas->permanent.free ||
         !atlas->temporary.alloc || !atlas->temporary.free) return;
+    nk_font_cache_free(atlas);
     if (atlas->glyphs) {
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
         atlas->glyphs = 0;
     }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
     if (atlas->pixel) {
         atlas->permanent.free(atlas->permanent.userdata, atlas->pixel);
         atlas->pixel = 0;
@@ -13576,6 +16042,7 @@ nk_font_atlas_add(struct nk_font_atlas *atlas, const struct nk_font_config *conf
         }
         NK_MEMCPY(cfg->ttf_blob, config->ttf_blob, cfg->ttf_size);
         cfg->ttf_data_owned_by_atlas = 1;
+        cfg->ttf_data_mapped = 0;
     }
     atlas->font_num++;
     return font;
@@ -13628,6 +16095,39 @@ nk_font_atlas_add_from_file(struct nk_font_atlas *atlas, const char *file_path,
     cfg.ttf_size = size;
     cfg.size = height;
     cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 0;
+    return nk_font_atlas_add(atlas, &cfg);
+}
+#endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_API struct nk_font*
+nk_font_atlas_add_from_file_mapped(struct nk_font_atlas *atlas, const char *file_path,
+    float height, const struct nk_font_config *config)
+{
+    nk_size size;
+    void *memory;
+    struct nk_font_config cfg;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+
+    /* the mapping is only unmapped by the atlas once its config is stored */
+    if (!atlas || !file_path || height <= 0.0f ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+    memory = nk_file_map(file_path, &size);
+    if (!memory) return 0;
+
+    cfg = (config) ? *config: nk_font_config(height);
+    cfg.ttf_blob = memory;
+    cfg.ttf_size = size;
+    cfg.size = height;
+    cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 1;
     return nk_font_atlas_add(atlas, &cfg);
 }
 #endif
@@ -13664,6 +16164,7 @@ nk_font_atlas_add_compressed(struct nk_font_atlas *atlas,
     cfg.ttf_size = decompressed_size;
     cfg.size = height;
     cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 0;
     return nk_font_atlas_add(atlas, &cfg);
 }
 NK_API struct nk_font*
@@ -13710,15 +16211,169 @@ nk_font_atlas_add_default(struct nk_font_atlas *atlas,
         nk_proggy_clean_ttf_compressed_data_base85, pixel_height, config);
 }
 #endif
+NK_INTERN void
+nk_font_atlas_init_cursors(struct nk_font_atlas *atlas, int width, int height)
+{
+    int i = 0;
+    NK_STORAGE const struct nk_vec2 nk_cursor_data[NK_CURSOR_COUNT][3] = {
+        /* Pos      Size        Offset */
+        {{ 0, 3},   {12,19},    { 0, 0}},
+        {{13, 0},   { 7,16},    { 4, 8}},
+        {{31, 0},   {23,23},    {11,11}},
+        {{21, 0},   { 9, 23},   { 5,11}},
+        {{55,18},   {23, 9},    {11, 5}},
+        {{73, 0},   {17,17},    { 9, 9}},
+        {{55, 0},   {17,17},    { 9, 9}}
+    };
+    for (i = 0; i < NK_CURSOR_COUNT; ++i) {
+        struct nk_cursor *cursor = &atlas->cursors[i];
+        cursor->img.w = (unsigned short)width;
+        cursor->img.h = (unsigned short)height;
+        cursor->img.region[0] = (unsigned short)(atlas->custom.x + nk_cursor_data[i][0].x);
+        cursor->img.region[1] = (unsigned short)(atlas->custom.y + nk_cursor_data[i][0].y);
+        cursor->img.region[2] = (unsigned short)nk_cursor_data[i][1].x;
+        cursor->img.region[3] = (unsigned short)nk_cursor_data[i][1].y;
+        cursor->size = nk_cursor_data[i][1];
+        cursor->offset = nk_cursor_data[i][2];
+    }
+}
+NK_INTERN int
+nk_font_kerning_collect(struct nk_font_atlas *atlas, const struct nk_font_config *cfg,
+    struct nk_font_kerning *table, nk_uint mask)
+{
+    /* counts or inserts all kerning pairs between codepoints of a config.
+     * Glyph indices of the `kern` table are mapped back to codepoints
+     * through a list of codepoints for each glyph index. */
+    struct nk_tt_fontinfo info;
+    const nk_rune *in_range;
+    const nk_byte *pairs;
+    int *glyph_first, *next;
+    nk_rune *codepoints;
+    int i, pair_count, count = 0, n = 0;
+    float scale;
+
+    if (!nk_tt_InitFont(&info, (const unsigned char*)cfg->ttf_blob, 0))
+        return 0;
+    pair_count = nk_tt_GetKerningPairs(&info, &pairs);
+    if (!pair_count || info.numGlyphs <= 0) return 0;
+    for (in_range = cfg->range; in_range[0] && in_range[1]; in_range += 2)
+        n += (int)(in_range[1] - in_range[0]) + 1;
+
+    glyph_first = (int*)atlas->temporary.alloc(atlas->temporary.userdata, 0,
+        sizeof(int) * (nk_size)info.numGlyphs + (sizeof(int) + sizeof(nk_rune)) * (nk_size)n);
+    if (!glyph_first) return -1;
+    next = glyph_first + info.numGlyphs;
+    codepoints = (nk_rune*)(next + n);
+    for (i = 0; i < info.numGlyphs; ++i)
+        glyph_first[i] = -1;
+
+    n = 0;
+    for (in_range = cfg->range; in_range[0] && in_range[1]; in_range += 2) {
+        nk_rune codepoint;
+        for (codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) {
+            int glyph = nk_tt_FindGlyphIndex(&info, (int)codepoint);
+            if (glyph <= 0 || glyph >= info.numGlyphs) continue;
+            codepoints[n] = codepoint;
+            next[n] = glyph_first[glyph];
+            glyph_first[glyph] = n++;
+        }
+    }
+
+    scale = nk_tt_ScaleForPixelHeight(&info, cfg->size);
+    for (i = 0; i < pair_count; ++i) {
+        const nk_byte *pair = pairs + i * 6;
+        int left = nk_ttUSHORT(pair);
+        int right = nk_ttUSHORT(pair+2);
+        float advance = scale * (float)nk_ttSHORT(pair+4);
+        int l, r;
+
+        if (left >= info.numGlyphs || right >= info.numGlyphs) continue;
+        if (cfg->pixel_snap) advance = (float)nk_ifloorf(advance + 0.5f);
+        if (advance == 0) continue;
+        for (l = glyph_first[left]; l >= 0; l = next[l]) {
+            for (r = glyph_first[right]; r >= 0; r = next[r]) {
+                nk_uint slot;
+                if (!table) {
+                    count++;
+                    continue;
+                }
+                /* first pair for a codepoint pair wins */
+                slot = nk_font_kerning_hash(codepoints[l], codepoints[r]) & mask;
+                while (table[slot].first && (table[slot].first != codepoints[l] ||
+                    table[slot].second != codepoints[r]))
+                    slot = (slot + 1) & mask;
+                if (table[slot].first) continue;
+                table[slot].first = codepoints[l];
+                table[slot].second = codepoints[r];
+                table[slot].advance = advance;
+                count++;
+            }
+        }
+    }
+    atlas->temporary.free(atlas->temporary.userdata, glyph_first);
+    return count;
+}
+NK_INTERN int
+nk_font_atlas_init_kerning(struct nk_font_atlas *atlas)
+{
+    /* builds one kerning table with twice as many slots as pairs for
+     * each font. Pairs of merged configs are added to their font. */
+    struct nk_font_config *config_iter, *it;
+    struct nk_font *font;
+    int pass, total = 0;
+
+    for (pass = 0; pass < 2; ++pass) {
+        struct nk_font_kerning *table = atlas->kerning;
+        for (font = atlas->fonts, config_iter = atlas->config; font && config_iter;
+            font = font->next, config_iter = config_iter->next) {
+            int count = 0;
+            nk_uint size = 1;
+            it = config_iter;
+            do {int n = 0;
+                if (it->kerning && it->ttf_blob) {
+                    n = nk_font_kerning_collect(atlas, it, (pass) ? table: 0,
+                        (pass) ? (nk_uint)font->kerning_mask: 0);
+                    if (n < 0) return nk_false;
+                }
+                count += n;
+            } while ((it = it->n) != config_iter);
+            if (!count) continue;
+            if (pass) {
+                font->kerning = table;
+                table += font->kerning_mask + 1;
+                continue;
+            }
+            /* size is a power of two for masking */
+            while (size < (nk_uint)count * 2) size <<= 1;
+            font->kerning_mask = size - 1;
+            total += (int)size;
+        }
+        if (pass || !total) break;
+        atlas->kerning = (struct nk_font_kerning*)atlas->permanent.alloc(
+            atlas->permanent.userdata, 0, sizeof(struct nk_font_kerning) * (nk_size)total);
+        NK_ASSERT(atlas->kerning);
+        if (!atlas->kerning) return nk_false;
+        nk_zero(atlas->kerning, sizeof(struct nk_font_kerning) * (nk_size)total);
+        atlas->kerning_count = total;
+    }
+    return nk_true;
+}
 NK_API const void*
 nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
     enum nk_font_atlas_format fmt)
 {
-    int i = 0;
+    return nk_font_atlas_bake_parallel(atlas, width, height, fmt, 0, nk_handle_ptr(0));
+}
+NK_API const void*
+nk_font_atlas_bake_parallel(struct nk_font_atlas *atlas, int *width, int *height,
+    enum nk_font_atlas_format fmt, nk_plugin_parallel_for parallel_for,
+    nk_handle parallel_userdata)
+{
     void *tmp = 0;
     nk_size tmp_size, img_size;
     struct nk_font *font_iter;
     struct nk_font_baker *baker;
+    struct nk_font_glyph_range *ranges;
 
     NK_ASSERT(atlas);
     NK_ASSERT(atlas->temporary.alloc);
@@ -13754,12 +16409,18 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
     NK_ASSERT(atlas->glyphs);
     if (!atlas->glyphs)
         goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
 
     /* pack all glyphs into a tight fit space */
     atlas->custom.w = (NK_CURSOR_DATA_W*2)+1;
     atlas->custom.h = NK_CURSOR_DATA_H + 1;
     if (!nk_font_bake_pack(baker, &img_size, width, height, &atlas->custom,
-        atlas->config, atlas->font_num, &atlas->temporary))
+        atlas->config, atlas->font_num, atlas->packing, &atlas->temporary))
         goto failed;
 
     /* allocate memory for the baked image font atlas */
@@ -13770,7 +16431,8 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
 
     /* bake glyphs and custom white pixel into image */
     nk_font_bake(baker, atlas->pixel, *width, *height,
-        atlas->glyphs, atlas->glyph_count, atlas->config, atlas->font_num);
+        atlas->glyphs, atlas->glyph_count, atlas->config, atlas->font_num,
+        parallel_for, parallel_userdata);
     nk_font_bake_custom_data(atlas->pixel, *width, *height, atlas->custom,
             nk_custom_cursor_data, NK_CURSOR_DATA_W, NK_CURSOR_DATA_H, '.', 'X');
 
@@ -13783,40 +16445,34 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
         nk_font_bake_convert(img_rgba, *width, *height, atlas->pixel);
         atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
         atlas->pixel = img_rgba;
+    } else if (fmt == NK_FONT_ATLAS_BC4) {
+        /* compress alpha8 image into 4x4 blocks */
+        void *img_bc4 = atlas->temporary.alloc(atlas->temporary.userdata,0,
+                            nk_font_bake_image_size(*width, *height, fmt));
+        NK_ASSERT(img_bc4);
+        if (!img_bc4) goto failed;
+        nk_font_bake_compress(img_bc4, *width, *height, atlas->pixel);
+        atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
+        atlas->pixel = img_bc4;
     }
     atlas->tex_width = *width;
     atlas->tex_height = *height;
+    atlas->format = fmt;
 
     /* initialize each font */
+    ranges = atlas->glyph_ranges;
     for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
         struct nk_font *font = font_iter;
         struct nk_font_config *config = font->config;
+        font->cache = 0;
         nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
-            config->font, nk_handle_ptr(0));
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
     }
+    if (!nk_font_atlas_init_kerning(atlas))
+        goto failed;
+    nk_font_atlas_init_cursors(atlas, *width, *height);
 
-    /* initialize each cursor */
-    {NK_STORAGE const struct nk_vec2 nk_cursor_data[NK_CURSOR_COUNT][3] = {
-        /* Pos      Size        Offset */
-        {{ 0, 3},   {12,19},    { 0, 0}},
-        {{13, 0},   { 7,16},    { 4, 8}},
-        {{31, 0},   {23,23},    {11,11}},
-        {{21, 0},   { 9, 23},   { 5,11}},
-        {{55,18},   {23, 9},    {11, 5}},
-        {{73, 0},   {17,17},    { 9, 9}},
-        {{55, 0},   {17,17},    { 9, 9}}
-    };
-    for (i = 0; i < NK_CURSOR_COUNT; ++i) {
-        struct nk_cursor *cursor = &atlas->cursors[i];
-        cursor->img.w = (unsigned short)*width;
-        cursor->img.h = (unsigned short)*height;
-        cursor->img.region[0] = (unsigned short)(atlas->custom.x + nk_cursor_data[i][0].x);
-        cursor->img.region[1] = (unsigned short)(atlas->custom.y + nk_cursor_data[i][0].y);
-        cursor->img.region[2] = (unsigned short)nk_cursor_data[i][1].x;
-        cursor->img.region[3] = (unsigned short)nk_cursor_data[i][1].y;
-        cursor->size = nk_cursor_data[i][1];
-        cursor->offset = nk_cursor_data[i][2];
-    }}
     /* free temporary memory */
     atlas->temporary.free(atlas->temporary.userdata, tmp);
     return atlas->pixel;
@@ -13828,12 +16484,448 @@ failed:
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
         atlas->glyphs = 0;
     }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
     if (atlas->pixel) {
         atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
         atlas->pixel = 0;
     }
     return 0;
 }
+NK_API const void*
+nk_font_atlas_bake_dynamic(struct nk_font_atlas *atlas, int width, int height,
+    enum nk_font_atlas_format fmt)
+{
+    int i = 0;
+    int glyph_n = 0;
+    nk_size tmp_size;
+    struct nk_font *font_iter;
+    struct nk_font_config *config_iter, *it;
+    struct nk_font_glyph_range *ranges;
+    struct nk_font_cache *cache;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+    NK_ASSERT(width > (NK_CURSOR_DATA_W*2)+2);
+    NK_ASSERT(height / NK_FONT_CACHE_BANDS > NK_CURSOR_DATA_H+2);
+    NK_ASSERT(fmt != NK_FONT_ATLAS_BC4);
+    if (!atlas || width <= (NK_CURSOR_DATA_W*2)+2 ||
+        height / NK_FONT_CACHE_BANDS <= NK_CURSOR_DATA_H+2 ||
+        fmt == NK_FONT_ATLAS_BC4 ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+
+#ifdef NK_INCLUDE_DEFAULT_FONT
+    /* no font added so just use default font */
+    if (!atlas->font_num)
+        atlas->default_font = nk_font_atlas_add_default(atlas, 13.0f, 0);
+#endif
+    NK_ASSERT(atlas->font_num);
+    if (!atlas->font_num) return 0;
+
+    /* allocate glyph memory for all fonts and the glyph cache */
+    nk_font_baker_memory(&tmp_size, &atlas->glyph_count, atlas->config, atlas->font_num);
+    atlas->glyphs = (struct nk_font_glyph*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph)*(nk_size)atlas->glyph_count);
+    NK_ASSERT(atlas->glyphs);
+    if (!atlas->glyphs)
+        goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
+    cache = nk_font_cache_alloc(atlas, width, height, fmt);
+    if (!cache)
+        goto failed;
+    cache->glyphs = atlas->glyphs;
+
+    /* setup fonts and glyph codepoints without rasterizing anything */
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {struct nk_font_cache_font *f = &cache->fonts[i++];
+            struct nk_baked_font *dst_font = it->font;
+            int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+            const nk_rune *in_range;
+            float font_scale;
+
+            if (!nk_tt_InitFont(&f->info, (const unsigned char*)it->ttf_blob, 0))
+                goto failed;
+            f->config = it;
+            f->glyph_offset = glyph_n;
+            if (!it->merge_mode) {
+                font_scale = nk_tt_ScaleForPixelHeight(&f->info, it->size);
+                nk_tt_GetFontVMetrics(&f->info, &unscaled_ascent, &unscaled_descent,
+                    &unscaled_line_gap);
+                dst_font->ranges = it->range;
+                dst_font->height = it->size;
+                dst_font->ascent = ((float)unscaled_ascent * font_scale);
+                dst_font->descent = ((float)unscaled_descent * font_scale);
+                dst_font->glyph_offset = (nk_rune)glyph_n;
+                dst_font->glyph_count = 0;
+            }
+            for (in_range = it->range; in_range[0] && in_range[1]; in_range += 2) {
+                nk_rune codepoint;
+                for (codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) {
+                    nk_zero(&atlas->glyphs[glyph_n], sizeof(struct nk_font_glyph));
+                    atlas->glyphs[glyph_n++].codepoint = codepoint;
+                }
+            }
+            dst_font->glyph_count += (nk_rune)(glyph_n - f->glyph_offset);
+        } while ((it = it->n) != config_iter);
+    }
+    NK_ASSERT(glyph_n == atlas->glyph_count);
+    for (i = 0; i < cache->glyph_count; ++i)
+        cache->glyph_band[i] = -1;
+
+    /* clear image and place custom data */
+    cache->custom.w = (NK_CURSOR_DATA_W*2)+1;
+    cache->custom.h = NK_CURSOR_DATA_H + 1;
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i)
+        nk_font_cache_reset(cache, i);
+    atlas->custom = cache->custom;
+    atlas->pixel = (cache->rgba) ? (void*)cache->rgba: (void*)cache->alpha;
+    atlas->tex_width = width;
+    atlas->tex_height = height;
+    atlas->format = fmt;
+
+    /* initialize each font */
+    ranges = atlas->glyph_ranges;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font *font = font_iter;
+        struct nk_font_config *config = font->config;
+        font->cache = cache;
+        nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
+    }
+    if (!nk_font_atlas_init_kerning(atlas))
+        goto failed;
+    nk_font_atlas_init_cursors(atlas, width, height);
+    return atlas->pixel;
+
+failed:
+    /* error so cleanup all memory */
+    nk_font_cache_free(atlas);
+    if (atlas->glyphs) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+        atlas->glyphs = 0;
+    }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
+    return 0;
+}
+NK_API const void*
+nk_font_atlas_dirty(struct nk_font_atlas *atlas, struct nk_recti *region)
+{
+    struct nk_font_cache *cache;
+    NK_ASSERT(atlas);
+    NK_ASSERT(region);
+    if (!atlas || !region) return 0;
+
+    nk_zero(region, sizeof(*region));
+    cache = atlas->cache;
+    if (!cache) return 0;
+
+    /* hand out changes and start a new frame */
+    *region = cache->dirty;
+    nk_zero(&cache->dirty, sizeof(cache->dirty));
+    cache->frame++;
+    return (cache->rgba) ? (const void*)cache->rgba: (const void*)cache->alpha;
+}
+#define NK_FONT_ATLAS_BLOB_MAGIC 0x41464B4E /* 'NKFA' */
+#define NK_FONT_ATLAS_BLOB_VERSION 2
+struct nk_font_atlas_blob {
+    nk_uint magic;
+    nk_uint version;
+    nk_hash key;
+    nk_uint format;
+    nk_uint glyph_size;
+    int width, height;
+    int font_count;
+    int glyph_count;
+    int kerning_count;
+    short custom[4];
+};
+struct nk_font_atlas_blob_font {
+    float height;
+    float ascent, descent;
+    nk_rune glyph_offset;
+    nk_rune glyph_count;
+    nk_uint kerning_size;
+};
+NK_INTERN int
+nk_font_atlas_key(const struct nk_font_atlas *atlas, nk_hash *key)
+{
+    const struct nk_font_config *config_iter, *it;
+    *key = NK_FONT_ATLAS_BLOB_VERSION;
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {int flags[8];
+            float values[3];
+            const nk_rune *range = it->range;
+
+            if (!it->ttf_blob || !range) return nk_false;
+            flags[0] = (int)it->merge_mode;
+            flags[1] = (int)it->pixel_snap;
+            flags[2] = (int)it->oversample_h;
+            flags[3] = (int)it->oversample_v;
+            flags[4] = (int)it->coord_type;
+            flags[5] = (int)it->sdf;
+            flags[6] = (int)it->sdf_spread;
+            flags[7] = (int)it->kerning;
+            values[0] = it->size;
+            values[1] = it->spacing.x;
+            values[2] = it->spacing.y;
+            while (range[0] && range[1]) range += 2;
+
+            *key = nk_murmur_hash(flags, (int)sizeof(flags), *key);
+            *key = nk_murmur_hash(values, (int)sizeof(values), *key);
+            *key = nk_murmur_hash(it->range, (int)((nk_size)(range - it->range) * sizeof(nk_rune)), *key);
+            *key = nk_murmur_hash(it->ttf_blob, (int)it->ttf_size, *key);
+        } while ((it = it->n) != config_iter);
+    }
+    return nk_true;
+}
+NK_INTERN nk_size
+nk_font_atlas_blob_size(const struct nk_font_atlas_blob *blob)
+{
+    nk_size size = sizeof(struct nk_font_atlas_blob);
+    size += (nk_size)blob->font_count * sizeof(struct nk_font_atlas_blob_font);
+    size += (nk_size)blob->glyph_count * sizeof(struct nk_font_glyph);
+    size += (nk_size)blob->kerning_count * sizeof(struct nk_font_kerning);
+    size += nk_font_bake_image_size(blob->width, blob->height,
+        (enum nk_font_atlas_format)blob->format);
+    return size;
+}
+NK_API nk_size
+nk_font_atlas_save(const struct nk_font_atlas *atlas, void *memory, nk_size size)
+{
+    struct nk_font_atlas_blob blob;
+    const struct nk_font *font_iter;
+    nk_byte *dst = (nk_byte*)memory;
+    nk_size blob_size;
+
+    NK_ASSERT(atlas);
+    if (!atlas || !atlas->pixel || atlas->cache || !atlas->glyphs)
+        return 0;
+
+    /* header */
+    nk_zero_struct(blob);
+    if (!nk_font_atlas_key(atlas, &blob.key))
+        return 0;
+    blob.magic = NK_FONT_ATLAS_BLOB_MAGIC;
+    blob.version = NK_FONT_ATLAS_BLOB_VERSION;
+    blob.format = (nk_uint)atlas->format;
+    blob.glyph_size = sizeof(struct nk_font_glyph);
+    blob.width = atlas->tex_width;
+    blob.height = atlas->tex_height;
+    blob.kerning_count = atlas->kerning_count;
+    blob.custom[0] = atlas->custom.x;
+    blob.custom[1] = atlas->custom.y;
+    blob.custom[2] = atlas->custom.w;
+    blob.custom[3] = atlas->custom.h;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        /* glyphs which are not inside the font are never filled out */
+        blob.font_count++;
+        blob.glyph_count = NK_MAX(blob.glyph_count,
+            (int)(font_iter->info.glyph_offset + font_iter->info.glyph_count));
+    }
+    blob_size = nk_font_atlas_blob_size(&blob);
+    if (!memory || size < blob_size)
+        return blob_size;
+
+    NK_MEMCPY(dst, &blob, sizeof(blob));
+    dst += sizeof(blob);
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        nk_zero_struct(font);
+        font.height = font_iter->info.height;
+        font.ascent = font_iter->info.ascent;
+        font.descent = font_iter->info.descent;
+        font.glyph_offset = font_iter->info.glyph_offset;
+        font.glyph_count = font_iter->info.glyph_count;
+        font.kerning_size = (font_iter->kerning) ? font_iter->kerning_mask + 1: 0;
+        NK_MEMCPY(dst, &font, sizeof(font));
+        dst += sizeof(font);
+    }
+    NK_MEMCPY(dst, atlas->glyphs, (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph));
+    dst += (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph);
+    NK_MEMCPY(dst, atlas->kerning, (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning));
+    dst += (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning);
+    NK_MEMCPY(dst, atlas->pixel, blob_size - (nk_size)(dst - (nk_byte*)memory));
+    return blob_size;
+}
+NK_API const void*
+nk_font_atlas_load(struct nk_font_atlas *atlas, const void *memory, nk_size size,
+    int *width, int *height, enum nk_font_atlas_format fmt)
+{
+    struct nk_font_atlas_blob blob;
+    struct nk_font_config *config_iter, *it;
+    struct nk_font_glyph_range *ranges;
+    struct nk_font *font_iter;
+    const nk_byte *src = (const nk_byte*)memory;
+    const nk_byte *fonts;
+    struct nk_font_kerning *kerning;
+    nk_hash key;
+    int font_count = 0;
+    int kerning_count = 0;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+    NK_ASSERT(width);
+    NK_ASSERT(height);
+    if (!atlas || !width || !height ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+    if (!memory || size < sizeof(blob))
+        return 0;
+
+#ifdef NK_INCLUDE_DEFAULT_FONT
+    /* no font added so just use default font */
+    if (!atlas->font_num)
+        atlas->default_font = nk_font_atlas_add_default(atlas, 13.0f, 0);
+#endif
+    NK_ASSERT(atlas->font_num);
+    if (!atlas->font_num) return 0;
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {if (!it->range) it->range = nk_font_default_glyph_ranges();
+        } while ((it = it->n) != config_iter);
+    }
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next)
+        font_count++;
+
+    /* make sure the blob was saved for the same fonts */
+    NK_MEMCPY(&blob, src, sizeof(blob));
+    src += sizeof(blob);
+    if (blob.magic != NK_FONT_ATLAS_BLOB_MAGIC ||
+        blob.version != NK_FONT_ATLAS_BLOB_VERSION ||
+        blob.format != (nk_uint)fmt ||
+        blob.glyph_size != sizeof(struct nk_font_glyph) ||
+        blob.font_count != font_count || blob.glyph_count < 0 ||
+        blob.kerning_count < 0 ||
+        blob.width <= 0 || blob.height <= 0 ||
+        size < nk_font_atlas_blob_size(&blob))
+        return 0;
+    if (!nk_font_atlas_key(atlas, &key) || key != blob.key)
+        return 0;
+
+    /* copy glyphs and font metrics */
+    atlas->glyph_count = blob.glyph_count;
+    atlas->glyphs = (struct nk_font_glyph*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph)*(nk_size)NK_MAX(atlas->glyph_count, 1));
+    NK_ASSERT(atlas->glyphs);
+    if (!atlas->glyphs)
+        goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
+    if (blob.kerning_count > 0) {
+        atlas->kerning = (struct nk_font_kerning*)atlas->permanent.alloc(
+            atlas->permanent.userdata,0, sizeof(struct nk_font_kerning)*(nk_size)blob.kerning_count);
+        NK_ASSERT(atlas->kerning);
+        if (!atlas->kerning)
+            goto failed;
+        atlas->kerning_count = blob.kerning_count;
+    }
+    fonts = src;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        struct nk_baked_font *dst_font = &font_iter->info;
+        NK_MEMCPY(&font, src, sizeof(font));
+        src += sizeof(font);
+        kerning_count += (int)font.kerning_size;
+        if ((int)(font.glyph_offset + font.glyph_count) > blob.glyph_count ||
+            (font.kerning_size & (font.kerning_size - 1)) || kerning_count > blob.kerning_count)
+            goto failed;
+        dst_font->ranges = font_iter->config->range;
+        dst_font->height = font.height;
+        dst_font->ascent = font.ascent;
+        dst_font->descent = font.descent;
+        dst_font->glyph_offset = font.glyph_offset;
+        dst_font->glyph_count = font.glyph_count;
+    }
+    NK_MEMCPY(atlas->glyphs, src, (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph));
+    src += (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph);
+    NK_MEMCPY(atlas->kerning, src, (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning));
+    src += (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning);
+
+    /* image is used directly from the blob */
+    atlas->pixel = 0;
+    atlas->tex_width = *width = blob.width;
+    atlas->tex_height = *height = blob.height;
+    atlas->format = fmt;
+    atlas->custom.x = blob.custom[0];
+    atlas->custom.y = blob.custom[1];
+    atlas->custom.w = blob.custom[2];
+    atlas->custom.h = blob.custom[3];
+
+    /* initialize each font */
+    ranges = atlas->glyph_ranges;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font *font = font_iter;
+        struct nk_font_config *config = font->config;
+        font->cache = 0;
+        nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
+    }
+    kerning = atlas->kerning;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        NK_MEMCPY(&font, fonts, sizeof(font));
+        fonts += sizeof(font);
+        if (!font.kerning_size) continue;
+        font_iter->kerning = kerning;
+        font_iter->kerning_mask = font.kerning_size - 1;
+        kerning += font.kerning_size;
+    }
+    nk_font_atlas_init_cursors(atlas, *width, *height);
+    return src;
+
+failed:
+    if (atlas->glyphs) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+        atlas->glyphs = 0;
+    }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
+    return 0;
+}
 NK_API void
 nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     struct nk_draw_null_texture *null)
@@ -13860,7 +16952,10 @@ nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     for (i = 0; i < NK_CURSOR_COUNT; ++i)
         atlas->cursors[i].img.handle = texture;
 
-    atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
+    /* image of a dynamic atlas is updated until `nk_font_atlas_clear` */
+    if (atlas->cache) return;
+    if (atlas->pixel)
+        atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
     atlas->pixel = 0;
     atlas->tex_width = 0;
     atlas->tex_height = 0;
@@ -13869,6 +16964,18 @@ nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     atlas->custom.w = 0;
     atlas->custom.h = 0;
 }
+NK_INTERN void
+nk_font_config_free_ttf(struct nk_font_atlas *atlas, struct nk_font_config *config)
+{
+    if (!config->ttf_blob) return;
+#ifdef NK_INCLUDE_FILE_MAPPING
+    if (config->ttf_data_mapped)
+        nk_file_unmap(config->ttf_blob, config->ttf_size);
+    else
+#endif
+    atlas->permanent.free(atlas->permanent.userdata, config->ttf_blob);
+    config->ttf_blob = 0;
+}
 NK_API void
 nk_font_atlas_cleanup(struct nk_font_atlas *atlas)
 {
@@ -13878,16 +16985,15 @@ nk_font_atlas_cleanup(struct nk_font_atlas *atlas)
     NK_ASSERT(atlas->permanent.alloc);
     NK_ASSERT(atlas->permanent.free);
     if (!atlas || !atlas->permanent.alloc || !atlas->permanent.free) return;
+    /* dynamic atlas still needs the ttf data to rasterize glyphs */
+    if (atlas->cache) return;
     if (atlas->config) {
         struct nk_font_config *iter;
         for (iter = atlas->config; iter; iter = iter->next) {
             struct nk_font_config *i;
-            for (i = iter->n; i != iter; i = i->n) {
-                atlas->permanent.free(atlas->permanent.userdata, i->ttf_blob);
-                i->ttf_blob = 0;
-            }
-            atlas->permanent.free(atlas->permanent.userdata, iter->ttf_blob);
-            iter->ttf_blob = 0;
+            for (i = iter->n; i != iter; i = i->n)
+                nk_font_config_free_ttf(atlas, i);
+            nk_font_config_free_ttf(atlas, iter);
         }
     }
 }
@@ -13907,13 +17013,11 @@ nk_font_atlas_clear(struct nk_font_atlas *atlas)
             struct nk_font_config *i, *n;
             for (i = iter->n; i != iter; i = n) {
                 n = i->n;
-                if (i->ttf_blob)
-                    atlas->permanent.free(atlas->permanent.userdata, i->ttf_blob);
+                nk_font_config_free_ttf(atlas, i);
                 atlas->permanent.free(atlas->permanent.userdata, i);
             }
             next = iter->next;
-            if (i->ttf_blob)
-                atlas->permanent.free(atlas->permanent.userdata, iter->ttf_blob);
+            nk_font_config_free_ttf(atlas, iter);
             atlas->permanent.free(atlas->permanent.userdata, iter);
         }
         atlas->config = 0;
@@ -13926,8 +17030,13 @@ nk_font_atlas_clear(struct nk_font_atlas *atlas)
         }
         atlas->fonts = 0;
     }
+    nk_font_cache_free(atlas);
     if (atlas->glyphs)
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+    if (atlas->glyph_ranges)
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+    if (atlas->kerning)
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
     nk_zero_struct(*atlas);
 }
 #endif
@@ -15033,37 +18142,217 @@ nk_init(struct nk_context *ctx, struct nk_allocator *alloc,
     ctx->use_pool = nk_true;
     return 1;
 }
-#ifdef NK_INCLUDE_COMMAND_USERDATA
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+NK_API void
+nk_set_user_data(struct nk_context *ctx, nk_handle handle)
+{
+    if (!ctx) return;
+    ctx->userdata = handle;
+    if (ctx->current)
+        ctx->current->buffer.userdata = handle;
+}
+#endif
+NK_API void
+nk_free(struct nk_context *ctx)
+{
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    struct nk_window *iter;
+#endif
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    for (iter = ctx->begin; iter; iter = iter->next)
+        nk_vertex_cache_free(&iter->vertex_cache);
+#endif
+    nk_buffer_free(&ctx->memory);
+    if (ctx->double_buffered)
+        nk_buffer_free(&ctx->memory_prev);
+    if (ctx->use_pool)
+        nk_pool_free(&ctx->pool);
+
+    nk_zero(&ctx->input, sizeof(ctx->input));
+    nk_zero(&ctx->style, sizeof(ctx->style));
+    nk_zero(&ctx->memory, sizeof(ctx->memory));
+    nk_zero(&ctx->memory_prev, sizeof(ctx->memory_prev));
+    nk_zero(&ctx->frame, sizeof(ctx->frame));
+    ctx->double_buffered = 0;
+
+    ctx->seq = 0;
+    ctx->build = 0;
+    ctx->begin = 0;
+    ctx->end = 0;
+    ctx->active = 0;
+    ctx->current = 0;
+    ctx->freelist = 0;
+    ctx->count = 0;
+    ctx->window_index = 0;
+    ctx->window_index_size = 0;
+    ctx->window_index_count = 0;
+}
+NK_API nk_size
+nk_shrink(struct nk_context *ctx)
+{
+    unsigned int released = 0;
+    int window_index;
+    struct nk_window *iter;
+    nk_size bytes;
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return 0;
+    if (ctx->pool.type == NK_BUFFER_FIXED) return 0;
+
+    /* indices sized for a burst of windows or tables keep the pages they
+     * were carved from alive, so free them if less than a quarter full
+     * and rebuild them at a fitting size after empty pages are gone */
+    window_index = ctx->window_index && ctx->window_index_size > 32 &&
+        ctx->window_index_count * 4 < ctx->window_index_size;
+    if (window_index)
+        nk_window_index_free(ctx);
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->table_index && iter->table_index_size > 64 &&
+            iter->table_index_count * 4 < iter->table_index_size)
+            nk_table_index_free(ctx, iter);
+    }
+    bytes = nk_pool_shrink(&ctx->pool, &ctx->freelist, &released);
+    ctx->stats.page_elements -= released;
+    if (window_index)
+        nk_window_index_rebuild(ctx);
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (!iter->table_index)
+            nk_table_index_rebuild(ctx, iter);
+    }
+    return bytes;
+}
+NK_API int
+nk_double_buffer(struct nk_context *ctx, struct nk_buffer *memory)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || ctx->double_buffered) return 0;
+    /* fixed contexts keep their pages at the back of the command buffer */
+    if (!ctx->use_pool) return 0;
+    if (memory) {
+        ctx->memory_prev = *memory;
+    } else if (ctx->memory.type != NK_BUFFER_FIXED && ctx->memory.memory.size) {
+        nk_buffer_init(&ctx->memory_prev, &ctx->memory.pool, ctx->memory.memory.size);
+        if (!ctx->memory_prev.memory.ptr) return 0;
+        ctx->memory_prev.type = ctx->memory.type;
+    } else return 0;
+    ctx->double_buffered = nk_true;
+    return 1;
+}
+NK_INTERN nk_size
+nk_memory_failed(const struct nk_context *ctx)
+{
+    /* `needed` also counts requests the buffer could not serve */
+    const struct nk_buffer *b = &ctx->memory;
+    nk_size used = b->allocated + (b->memory.size - b->size);
+    nk_size failed = (b->needed > used) ? b->needed - used: 0;
+    failed = (failed > ctx->memory_failed_base) ? failed - ctx->memory_failed_base: 0;
+    return failed + ctx->pool_failed;
+}
+NK_LIB void
+nk_memory_check(struct nk_context *ctx, const char *name)
+{
+    nk_size failed;
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    failed = nk_memory_failed(ctx);
+    if (failed <= ctx->memory_failed) return;
+    ctx->memory_failed = failed;
+    if (!ctx->stats.overflows++ && name) {
+        nk_size len = NK_MIN((nk_size)nk_strlen(name), NK_WINDOW_MAX_NAME-1);
+        NK_MEMCPY(ctx->overflow_window, name, len);
+        ctx->overflow_window[len] = 0;
+    }
+    NK_ASSERT(!ctx->memory_assert && "out of memory, see `overflow_window` of `nk_memory_stats`");
+}
+NK_INTERN void
+nk_memory_record(struct nk_context *ctx)
+{
+    struct nk_memory_stats *s = &ctx->stats;
+    const struct nk_window *iter;
+    nk_size needed;
+
+    /* catch anything that ran out of memory outside of windows */
+    nk_memory_check(ctx, 0);
+    s->frames++;
+    s->command_bytes = ctx->memory.allocated;
+    s->command_peak = NK_MAX(s->command_peak, s->command_bytes);
+    needed = ctx->memory.allocated + ctx->memory_failed;
+    s->command_needed = NK_MAX(s->command_needed, needed);
+    s->page_elements_peak = NK_MAX(s->page_elements_peak, s->page_elements);
+
+    s->largest_window_bytes = 0;
+    ctx->largest_window[0] = 0;
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        nk_size bytes = iter->buffer.end - iter->buffer.begin;
+        if (iter->seq != ctx->seq || (iter->flags & NK_WINDOW_HIDDEN) ||
+            bytes <= s->largest_window_bytes) continue;
+        s->largest_window_bytes = bytes;
+        NK_MEMCPY(ctx->largest_window, iter->name_string, NK_WINDOW_MAX_NAME);
+    }
+}
 NK_API void
-nk_set_user_data(struct nk_context *ctx, nk_handle handle)
+nk_memory_stats(const struct nk_context *ctx, struct nk_memory_stats *stats)
+{
+    const struct nk_page_element *iter;
+    NK_ASSERT(ctx);
+    NK_ASSERT(stats);
+    if (!ctx || !stats) return;
+
+    *stats = ctx->stats;
+    stats->page_elements_peak = NK_MAX(stats->page_elements_peak, stats->page_elements);
+    for (iter = ctx->freelist; iter; iter = iter->next)
+        stats->page_elements_free++;
+    stats->largest_window = (ctx->largest_window[0]) ? ctx->largest_window: 0;
+    stats->overflow_window = (ctx->overflow_window[0]) ? ctx->overflow_window: 0;
+    /* fixed contexts allocate commands from the front and page elements from
+     * the back of the same block, which might need one extra alignment step */
+    if (stats->frames) {
+        stats->suggested_fixed_size = stats->command_needed +
+            stats->page_elements_peak * sizeof(struct nk_page_element) +
+            NK_ALIGNOF(struct nk_page_element);
+    }
+}
+NK_API void
+nk_memory_stats_reset(struct nk_context *ctx)
 {
+    unsigned int page_elements;
+    NK_ASSERT(ctx);
     if (!ctx) return;
-    ctx->userdata = handle;
-    if (ctx->current)
-        ctx->current->buffer.userdata = handle;
+    page_elements = ctx->stats.page_elements;
+    nk_zero_struct(ctx->stats);
+    ctx->stats.page_elements = page_elements;
+    ctx->stats.page_elements_peak = page_elements;
+    ctx->overflow_window[0] = 0;
+    ctx->largest_window[0] = 0;
 }
-#endif
 NK_API void
-nk_free(struct nk_context *ctx)
+nk_memory_assert_on_overflow(struct nk_context *ctx, int enable)
 {
     NK_ASSERT(ctx);
     if (!ctx) return;
-    nk_buffer_free(&ctx->memory);
-    if (ctx->use_pool)
-        nk_pool_free(&ctx->pool);
-
-    nk_zero(&ctx->input, sizeof(ctx->input));
-    nk_zero(&ctx->style, sizeof(ctx->style));
-    nk_zero(&ctx->memory, sizeof(ctx->memory));
-
-    ctx->seq = 0;
-    ctx->build = 0;
-    ctx->begin = 0;
-    ctx->end = 0;
-    ctx->active = 0;
-    ctx->current = 0;
-    ctx->freelist = 0;
-    ctx->count = 0;
+    ctx->memory_assert = enable;
+}
+NK_API int
+nk_chunked_commands(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return 0;
+    if (ctx->memory.type == NK_BUFFER_FIXED) return 0;
+    /* existing memory simply becomes the first chunk */
+    ctx->memory.type = NK_BUFFER_CHUNKED;
+    if (ctx->double_buffered)
+        ctx->memory_prev.type = NK_BUFFER_CHUNKED;
+    return 1;
+}
+NK_INTERN struct nk_window*
+nk_first_drawn_window(struct nk_context *ctx)
+{
+    struct nk_window *iter = ctx->begin;
+    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
+        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
+        iter = iter->next;
+    return iter;
 }
 NK_API void
 nk_clear(struct nk_context *ctx)
@@ -15073,9 +18362,30 @@ nk_clear(struct nk_context *ctx)
     NK_ASSERT(ctx);
 
     if (!ctx) return;
+    nk_memory_record(ctx);
+    if (ctx->double_buffered) {
+        /* keep the finished frame untouched for `nk_frame_previous` and
+         * build the next frame into the other buffer */
+        const struct nk_command *cmd = nk__begin(ctx);
+        struct nk_buffer memory = ctx->memory;
+        ctx->frame.memory = memory.memory.ptr;
+        ctx->frame.chunk = memory.chunk;
+        ctx->frame.end = memory.allocated;
+        ctx->frame.begin = (cmd) ? nk_first_drawn_window(ctx)->buffer.begin: memory.allocated;
+        ctx->memory = ctx->memory_prev;
+        ctx->memory_prev = memory;
+        /* both buffers follow the trim policy set on `ctx->memory` */
+        ctx->memory.trim_frames = memory.trim_frames;
+        ctx->memory.trim_threshold = memory.trim_threshold;
+    }
     if (ctx->use_pool)
         nk_buffer_clear(&ctx->memory);
     else nk_buffer_reset(&ctx->memory, NK_BUFFER_FRONT);
+    /* failed requests of a fixed buffer stay in `needed` after a reset */
+    ctx->memory_failed = 0;
+    ctx->memory_failed_base = 0;
+    ctx->pool_failed = 0;
+    ctx->memory_failed_base = nk_memory_failed(ctx);
 
     ctx->build = 0;
     ctx->memory.calls = 0;
@@ -15099,8 +18409,10 @@ nk_clear(struct nk_context *ctx)
             iter == ctx->active) {
             ctx->active = iter->prev;
             ctx->end = iter->prev;
-            if (!ctx->end)
+            if (!ctx->end) {
                 ctx->begin = 0;
+                nk_window_index_free(ctx);
+            }
             if (ctx->active)
                 ctx->active->flags &= ~(unsigned)NK_WINDOW_ROM;
         }
@@ -15111,6 +18423,7 @@ nk_clear(struct nk_context *ctx)
         }
         /* remove unused window state tables */
         {struct nk_table *n, *it = iter->tables;
+        int removed = nk_false;
         while (it) {
             n = it->next;
             if (it->seq != ctx->seq) {
@@ -15119,8 +18432,11 @@ nk_clear(struct nk_context *ctx)
                 nk_free_table(ctx, it);
                 if (it == iter->tables)
                     iter->tables = n;
+                removed = nk_true;
             } it = n;
-        }}
+        }
+        if (removed && iter->table_index)
+            nk_table_index_rebuild(ctx, iter);}
         /* window itself is not used anymore so free */
         if (iter->seq != ctx->seq || iter->flags & NK_WINDOW_CLOSED) {
             next = iter->next;
@@ -15141,6 +18457,7 @@ nk_start_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
     buffer->end = buffer->begin;
     buffer->last = buffer->begin;
     buffer->clip = nk_null_rect;
+    buffer->hash = 0;
 }
 NK_LIB void
 nk_start(struct nk_context *ctx, struct nk_window *win)
@@ -15148,6 +18465,7 @@ nk_start(struct nk_context *ctx, struct nk_window *win)
     NK_ASSERT(ctx);
     NK_ASSERT(win);
     nk_start_buffer(ctx, &win->buffer);
+    win->draw_bounds = win->bounds;
 }
 NK_LIB void
 nk_start_popup(struct nk_context *ctx, struct nk_window *win)
@@ -15183,6 +18501,8 @@ nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
     NK_ASSERT(ctx);
     NK_ASSERT(buffer);
     if (!ctx || !buffer) return;
+    if (buffer->end != buffer->begin)
+        nk_command_buffer_hash(buffer, ctx->memory.allocated);
     buffer->end = ctx->memory.allocated;
 }
 NK_LIB void
@@ -15190,7 +18510,6 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
 {
     struct nk_popup_buffer *buf;
     struct nk_command *parent_last;
-    void *memory;
 
     NK_ASSERT(ctx);
     NK_ASSERT(win);
@@ -15199,22 +18518,98 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
     if (!win->popup.buf.active) return;
 
     buf = &win->popup.buf;
-    memory = ctx->memory.memory.ptr;
-    parent_last = nk_ptr_add(struct nk_command, memory, buf->parent);
+    parent_last = (struct nk_command*)nk_buffer_at(&ctx->memory, buf->parent);
     parent_last->next = buf->end;
 }
+NK_INTERN void
+nk_damage_add(struct nk_context *ctx, struct nk_rect r)
+{
+    int i;
+    float pad = ctx->style.window.border + 1.0f;
+    if (r.w <= 0 || r.h <= 0) return;
+    r.x -= pad; r.y -= pad;
+    r.w += 2 * pad; r.h += 2 * pad;
+
+    /* merge with every overlapping damage rectangle */
+    for (i = 0; i < ctx->damage_count;) {
+        struct nk_rect *d = &ctx->damage[i];
+        if (NK_INTERSECT(r.x, r.y, r.w, r.h, d->x, d->y, d->w, d->h)) {
+            r = nk_merge_rect(r, *d);
+            *d = ctx->damage[--ctx->damage_count];
+            i = 0;
+        } else i++;
+    }
+    if (ctx->damage_count < NK_DAMAGE_MAX) {
+        ctx->damage[ctx->damage_count++] = r;
+    } else {
+        /* out of rectangles so grow the one which grows the least */
+        int best = 0;
+        float best_growth = 0;
+        for (i = 0; i < ctx->damage_count; ++i) {
+            struct nk_rect *d = &ctx->damage[i];
+            struct nk_rect m = nk_merge_rect(r, *d);
+            float growth = m.w * m.h - d->w * d->h;
+            if (!i || growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        ctx->damage[best] = nk_merge_rect(r, ctx->damage[best]);
+    }
+}
+NK_INTERN void
+nk_build_hash(struct nk_context *ctx, struct nk_rect cursor)
+{
+    struct nk_window *it;
+    unsigned int order = 0;
+    nk_hash frame = 0;
+    nk_hash overlay = 0;
+
+    /* compare each window's draw commands against the last frame */
+    ctx->damage_count = 0;
+    for (it = ctx->begin; it; it = it->next) {
+        nk_hash hash = 0;
+        if (!(it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
+            it->seq != ctx->seq)) {
+            hash = it->buffer.hash;
+            frame = nk_command_hash(frame, &it->name, sizeof(it->name));
+            frame = nk_command_hash(frame, &hash, sizeof(hash));
+            order++;
+        }
+        it->dirty = (it->draw_hash != hash);
+        if (it->dirty || (hash && it->damage_order != order)) {
+            /* redraw old and new area on content or z-order change */
+            if (it->draw_hash) nk_damage_add(ctx, it->damage_bounds);
+            if (hash) nk_damage_add(ctx, it->draw_bounds);
+        }
+        it->draw_hash = hash;
+        it->damage_bounds = it->draw_bounds;
+        it->damage_order = order;
+    }
+    if (ctx->overlay.end != ctx->overlay.begin) {
+        overlay = ctx->overlay.hash;
+        frame = nk_command_hash(frame, &overlay, sizeof(overlay));
+    }
+    if (ctx->overlay_hash != overlay) {
+        if (ctx->overlay_hash) nk_damage_add(ctx, ctx->overlay_bounds);
+        if (overlay) nk_damage_add(ctx, cursor);
+    }
+    ctx->overlay_hash = overlay;
+    ctx->overlay_bounds = cursor;
+    ctx->frame_dirty = (ctx->frame_hash != frame);
+    ctx->frame_hash = frame;
+}
 NK_LIB void
 nk_build(struct nk_context *ctx)
 {
     struct nk_window *it = 0;
     struct nk_command *cmd = 0;
-    nk_byte *buffer = 0;
+    struct nk_rect mouse_bounds = {0,0,0,0};
 
     /* draw cursor overlay */
     if (!ctx->style.cursor_active)
         ctx->style.cursor_active = ctx->style.cursors[NK_CURSOR_ARROW];
     if (ctx->style.cursor_active && !ctx->input.mouse.grabbed && ctx->style.cursor_visible) {
-        struct nk_rect mouse_bounds;
         const struct nk_cursor *cursor = ctx->style.cursor_active;
         nk_command_buffer_init(&ctx->overlay, &ctx->memory, NK_CLIPPING_OFF);
         nk_start_buffer(ctx, &ctx->overlay);
@@ -15227,16 +18622,17 @@ nk_build(struct nk_context *ctx)
         nk_draw_image(&ctx->overlay, mouse_bounds, &cursor->img, nk_white);
         nk_finish_buffer(ctx, &ctx->overlay);
     }
+    nk_build_hash(ctx, mouse_bounds);
+
     /* build one big draw command list out of all window buffers */
     it = ctx->begin;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     while (it != 0) {
         struct nk_window *next = it->next;
         if (it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
             it->seq != ctx->seq)
             goto cont;
 
-        cmd = nk_ptr_add(struct nk_command, buffer, it->buffer.last);
+        cmd = (struct nk_command*)nk_buffer_at(&ctx->memory, it->buffer.last);
         while (next && ((next->buffer.last == next->buffer.begin) ||
             (next->flags & NK_WINDOW_HIDDEN) || next->seq != ctx->seq))
             next = next->next; /* skip empty command buffers */
@@ -15254,7 +18650,7 @@ nk_build(struct nk_context *ctx)
 
         buf = &it->popup.buf;
         cmd->next = buf->begin;
-        cmd = nk_ptr_add(struct nk_command, buffer, buf->last);
+        cmd = (struct nk_command*)nk_buffer_at(&ctx->memory, buf->last);
         buf->active = nk_false;
         skip: it = next;
     }
@@ -15269,36 +18665,76 @@ NK_API const struct nk_command*
 nk__begin(struct nk_context *ctx)
 {
     struct nk_window *iter;
-    nk_byte *buffer;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
     if (!ctx->count) return 0;
 
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     if (!ctx->build) {
         nk_build(ctx);
         ctx->build = nk_true;
     }
-    iter = ctx->begin;
-    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
-        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
-        iter = iter->next;
+    iter = nk_first_drawn_window(ctx);
     if (!iter) return 0;
-    return nk_ptr_add_const(struct nk_command, buffer, iter->buffer.begin);
+    return (const struct nk_command*)nk_buffer_at(&ctx->memory, iter->buffer.begin);
 }
 
+NK_API int
+nk_frame_is_dirty(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return 1;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    return ctx->frame_dirty;
+}
+NK_API const struct nk_rect*
+nk_frame_damage(struct nk_context *ctx, int *count)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(count);
+    if (!ctx || !count) return 0;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    *count = ctx->damage_count;
+    return ctx->damage;
+}
 NK_API const struct nk_command*
 nk__next(struct nk_context *ctx, const struct nk_command *cmd)
 {
-    nk_byte *buffer;
     const struct nk_command *next;
     NK_ASSERT(ctx);
     if (!ctx || !cmd || !ctx->count) return 0;
     if (cmd->next >= ctx->memory.allocated) return 0;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
-    next = nk_ptr_add_const(struct nk_command, buffer, cmd->next);
+    next = (const struct nk_command*)nk_buffer_at(&ctx->memory, cmd->next);
     return next;
 }
+NK_API struct nk_frame
+nk_frame_previous(const struct nk_context *ctx)
+{
+    struct nk_frame frame;
+    NK_ASSERT(ctx);
+    nk_zero_struct(frame);
+    if (!ctx || !ctx->double_buffered) return frame;
+    return ctx->frame;
+}
+NK_API const struct nk_command*
+nk__frame_begin(const struct nk_frame *frame)
+{
+    NK_ASSERT(frame);
+    if (!frame || !frame->memory || frame->begin >= frame->end) return 0;
+    return (const struct nk_command*)nk_buffer_chunk_at(frame->memory, frame->chunk, frame->begin);
+}
+NK_API const struct nk_command*
+nk__frame_next(const struct nk_frame *frame, const struct nk_command *cmd)
+{
+    NK_ASSERT(frame);
+    if (!frame || !cmd || cmd->next >= frame->end) return 0;
+    return (const struct nk_command*)nk_buffer_chunk_at(frame->memory, frame->chunk, cmd->next);
+}
 
 
 
@@ -15340,30 +18776,132 @@ nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size)
     if (size < sizeof(struct nk_page)) return;
     pool->capacity = (unsigned)(size - sizeof(struct nk_page)) / sizeof(struct nk_page_element);
     pool->pages = (struct nk_page*)memory;
+    pool->pages->size = 0;
+    pool->pages->capacity = pool->capacity;
+    pool->pages->next = 0;
     pool->type = NK_BUFFER_FIXED;
     pool->size = size;
 }
+NK_INTERN unsigned int
+nk_pool_page_capacity(const struct nk_pool *pool)
+{
+    /* each page doubles the last one so the number of allocations only
+     * grows logarithmically with the number of windows, panels and tables */
+    unsigned int capacity = pool->capacity;
+    if (pool->pages) {
+        unsigned int grown = NK_MIN(pool->pages->capacity, NK_POOL_MAX_CAPACITY/2) * 2;
+        capacity = NK_MAX(capacity, grown);
+    }
+    return capacity;
+}
+NK_INTERN struct nk_page*
+nk_pool_alloc_page(struct nk_pool *pool, unsigned int capacity)
+{
+    struct nk_page *page;
+    nk_size size = sizeof(struct nk_page);
+    size += capacity * sizeof(struct nk_page_element);
+    page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+    NK_ASSERT(page);
+    if (!page) return 0;
+    page->size = 0;
+    page->capacity = capacity;
+    page->next = 0;
+    pool->page_count++;
+    return page;
+}
 NK_LIB struct nk_page_element*
 nk_pool_alloc(struct nk_pool *pool)
 {
-    if (!pool->pages || pool->pages->size >= pool->capacity) {
+    if (!pool->pages || pool->pages->size >= pool->pages->capacity) {
         /* allocate new page */
         struct nk_page *page;
         if (pool->type == NK_BUFFER_FIXED) {
             NK_ASSERT(pool->pages);
             if (!pool->pages) return 0;
-            NK_ASSERT(pool->pages->size < pool->capacity);
+            NK_ASSERT(pool->pages->size < pool->pages->capacity);
             return 0;
         } else {
-            nk_size size = sizeof(struct nk_page);
-            size += NK_POOL_DEFAULT_CAPACITY * sizeof(union nk_page_data);
-            page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+            page = nk_pool_alloc_page(pool, nk_pool_page_capacity(pool));
+            if (!page) return 0;
             page->next = pool->pages;
             pool->pages = page;
-            page->size = 0;
         }
     } return &pool->pages->win[pool->pages->size++];
 }
+NK_LIB struct nk_page_element*
+nk_pool_alloc_range(struct nk_pool *pool, unsigned int count)
+{
+    struct nk_page_element *elem;
+    NK_ASSERT(count);
+    if (!count) return 0;
+    if (pool->pages && pool->pages->size + count <= pool->pages->capacity) {
+        /* enough space left inside current page */
+        elem = &pool->pages->win[pool->pages->size];
+        pool->pages->size += count;
+        return elem;
+    }
+    if (pool->type == NK_BUFFER_FIXED) {
+        return 0;
+    } else {
+        struct nk_page *page;
+        unsigned int capacity = nk_pool_page_capacity(pool);
+        page = nk_pool_alloc_page(pool, NK_MAX(count, capacity));
+        if (!page) return 0;
+        page->size = count;
+        if (pool->pages && count > capacity) {
+            /* oversized page is already full so link it behind the
+             * current page to keep using its remaining space */
+            page->next = pool->pages->next;
+            pool->pages->next = page;
+        } else {
+            page->next = pool->pages;
+            pool->pages = page;
+        }
+        return &page->win[0];
+    }
+}
+NK_LIB nk_size
+nk_pool_shrink(struct nk_pool *pool, struct nk_page_element **freelist,
+    unsigned int *released)
+{
+    struct nk_page **link;
+    nk_size bytes = 0;
+    NK_ASSERT(pool);
+    NK_ASSERT(freelist);
+    NK_ASSERT(released);
+    if (!pool || !freelist || !released) return 0;
+    if (pool->type == NK_BUFFER_FIXED) return 0;
+
+    link = &pool->pages;
+    while (*link) {
+        struct nk_page *page = *link;
+        const struct nk_page_element *begin = &page->win[0];
+        const struct nk_page_element *end = &page->win[page->size];
+        struct nk_page_element **it;
+        unsigned int unused = 0;
+
+        /* page can only be released if all its elements are free */
+        for (it = freelist; *it && unused < page->size; it = &(*it)->next)
+            if (*it >= begin && *it < end) unused++;
+        if (unused < page->size) {
+            link = &page->next;
+            continue;
+        }
+        /* unlink its elements without changing the order of the free list */
+        it = freelist;
+        while (*it) {
+            if (*it >= begin && *it < end)
+                *it = (*it)->next;
+            else it = &(*it)->next;
+        }
+        *link = page->next;
+        *released += page->size;
+        bytes += sizeof(struct nk_page) + page->capacity * sizeof(struct nk_page_element);
+        pool->page_count--;
+        pool->alloc.free(pool->alloc.userdata, page);
+    }
+    return bytes;
+}
 
 
 
@@ -15385,8 +18923,10 @@ nk_create_page_element(struct nk_context *ctx)
     } else if (ctx->use_pool) {
         /* allocate page element from memory pool */
         elem = nk_pool_alloc(&ctx->pool);
+        if (!elem) ctx->pool_failed += sizeof(struct nk_page_element);
         NK_ASSERT(elem);
         if (!elem) return 0;
+        ctx->stats.page_elements++;
     } else {
         /* allocate new page element from back of fixed size memory buffer */
         NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
@@ -15394,6 +18934,7 @@ nk_create_page_element(struct nk_context *ctx)
         elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size, align);
         NK_ASSERT(elem);
         if (!elem) return 0;
+        ctx->stats.page_elements++;
     }
     nk_zero_struct(*elem);
     elem->next = 0;
@@ -15423,9 +18964,72 @@ nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem)
     /* if possible remove last element from back of fixed memory buffer */
     {void *elem_end = (void*)(elem + 1);
     void *buffer_end = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
-    if (elem_end == buffer_end)
+    if (elem_end == buffer_end) {
         ctx->memory.size -= sizeof(struct nk_page_element);
-    else nk_link_page_element_into_freelist(ctx, elem);}
+        ctx->stats.page_elements--;
+    } else nk_link_page_element_into_freelist(ctx, elem);}
+}
+NK_INTERN struct nk_page_element*
+nk_unlink_page_element_range(struct nk_context *ctx, unsigned int count)
+{
+    /* `nk_free_page_elements` returns a block from first to last element,
+     * so a freed block shows up as a run of adjacent elements in descending
+     * order inside the free list. Runs never cross pages since each page
+     * starts with its header. */
+    struct nk_page_element **link = &ctx->freelist;
+    while (*link) {
+        struct nk_page_element **begin = link;
+        struct nk_page_element *iter = *link;
+        unsigned int run = 1;
+        while (run < count && iter->next && iter->next + 1 == iter) {
+            iter = iter->next;
+            run++;
+        }
+        if (run == count) {
+            *begin = iter->next;
+            return iter;
+        }
+        link = &iter->next;
+    }
+    return 0;
+}
+NK_LIB struct nk_page_element*
+nk_create_page_elements(struct nk_context *ctx, unsigned int count)
+{
+    /* allocates `count` page elements in one contiguous block. A block
+     * freed earlier is reused before the pool or memory buffer grows */
+    struct nk_page_element *elem;
+    elem = nk_unlink_page_element_range(ctx, count);
+    if (elem) {
+        nk_zero(elem, sizeof(struct nk_page_element) * count);
+        return elem;
+    }
+    if (ctx->use_pool) {
+        elem = nk_pool_alloc_range(&ctx->pool, count);
+        if (!elem) ctx->pool_failed += sizeof(struct nk_page_element) * count;
+    } else {
+        NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
+        NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+        elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size * count, align);
+    }
+    if (!elem) return 0;
+    ctx->stats.page_elements += count;
+    nk_zero(elem, sizeof(struct nk_page_element) * count);
+    return elem;
+}
+NK_LIB void
+nk_free_page_elements(struct nk_context *ctx, struct nk_page_element *elem,
+    unsigned int count)
+{
+    /* each element of the block is returned separately and can be
+     * reused for windows, panels and tables */
+    unsigned int i;
+    for (i = 0; i < count; ++i) {
+        /* list hooks were overwritten by block content */
+        elem[i].next = 0;
+        elem[i].prev = 0;
+        nk_free_page_element(ctx, &elem[i]);
+    }
 }
 
 
@@ -15483,6 +19087,87 @@ nk_remove_table(struct nk_window *win, struct nk_table *tbl)
     tbl->next = 0;
     tbl->prev = 0;
 }
+NK_INTERN unsigned int
+nk_table_index_elements(unsigned int slots)
+{
+    nk_size size = slots * sizeof(struct nk_table_slot);
+    return (unsigned int)((size + sizeof(struct nk_page_element)-1) / sizeof(struct nk_page_element));
+}
+NK_INTERN nk_uint
+nk_table_index_probe(nk_hash key, unsigned int size)
+{
+    /* scramble keys since groups store consecutive keys for scroll offsets */
+    nk_hash h = key * 2654435769u;
+    return (nk_uint)(h ^ (h >> 16)) & (size-1);
+}
+NK_INTERN void
+nk_table_index_insert(struct nk_window *win, struct nk_table *tbl, nk_uint index)
+{
+    nk_hash key = tbl->keys[index];
+    nk_uint mask = win->table_index_size-1;
+    nk_uint i = nk_table_index_probe(key, win->table_index_size);
+    while (win->table_index[i].tbl)
+        i = (i + 1) & mask;
+    win->table_index[i].tbl = tbl;
+    win->table_index[i].key = key;
+    win->table_index[i].index = index;
+    win->table_index_count++;
+}
+NK_LIB void
+nk_table_index_free(struct nk_context *ctx, struct nk_window *win)
+{
+    if (!win->table_index) return;
+    nk_free_page_elements(ctx, (struct nk_page_element*)(void*)win->table_index,
+        nk_table_index_elements(win->table_index_size));
+    win->table_index = 0;
+    win->table_index_size = 0;
+    win->table_index_count = 0;
+}
+NK_INTERN int
+nk_table_index_alloc(struct nk_context *ctx, struct nk_window *win,
+    unsigned int values)
+{
+    /* keep load factor below 3/4. An index that is still big enough is
+     * only cleared so removing and adding tables does not churn memory */
+    struct nk_page_element *elem;
+    unsigned int size = nk_round_up_pow2(NK_MAX(values + values/3 + 1, 64));
+    if (win->table_index && win->table_index_size >= size) {
+        nk_zero(win->table_index, win->table_index_size * sizeof(struct nk_table_slot));
+        win->table_index_count = 0;
+        return 1;
+    }
+    nk_table_index_free(ctx, win);
+    elem = nk_create_page_elements(ctx, nk_table_index_elements(size));
+    if (!elem) return 0;
+    win->table_index = (struct nk_table_slot*)(void*)elem;
+    win->table_index_size = size;
+    win->table_index_count = 0;
+    return 1;
+}
+NK_LIB void
+nk_table_index_rebuild(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_table *iter;
+    unsigned int values = 0;
+    NK_ASSERT(ctx);
+    NK_ASSERT(win);
+    if (!ctx || !win) return;
+
+    /* a single table page is searched linearly same as any window
+     * whose index could not be allocated because of missing memory.
+     * Once allocated the index is kept until the window is freed */
+    for (iter = win->tables; iter; iter = iter->next)
+        values += iter->size;
+    if (!win->table_index && (!win->tables || !win->tables->next))
+        return;
+    if (!nk_table_index_alloc(ctx, win, values))
+        return;
+    for (iter = win->tables; iter; iter = iter->next) {
+        unsigned int i = 0;
+        for (i = 0; i < iter->size; ++i)
+            nk_table_index_insert(win, iter, i);
+    }
+}
 NK_LIB nk_uint*
 nk_add_value(struct nk_context *ctx, struct nk_window *win,
             nk_hash name, nk_uint value)
@@ -15499,12 +19184,33 @@ nk_add_value(struct nk_context *ctx, struct nk_window *win,
     win->tables->seq = win->seq;
     win->tables->keys[win->tables->size] = name;
     win->tables->values[win->tables->size] = value;
-    return &win->tables->values[win->tables->size++];
+    if (win->table_index && (win->table_index_count+1)*4 <= win->table_index_size*3)
+        nk_table_index_insert(win, win->tables, win->tables->size++);
+    else {
+        /* build new or grow index */
+        win->tables->size++;
+        if (win->tables->next || win->table_index)
+            nk_table_index_rebuild(ctx, win);
+    }
+    return &win->tables->values[win->tables->size-1];
 }
 NK_LIB nk_uint*
 nk_find_value(struct nk_window *win, nk_hash name)
 {
     struct nk_table *iter = win->tables;
+    if (win->table_index) {
+        nk_uint mask = win->table_index_size-1;
+        nk_uint i = nk_table_index_probe(name, win->table_index_size);
+        while (win->table_index[i].tbl) {
+            struct nk_table_slot *slot = &win->table_index[i];
+            if (slot->key == name) {
+                slot->tbl->seq = win->seq;
+                return &slot->tbl->values[slot->index];
+            }
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
     while (iter) {
         unsigned int i = 0;
         unsigned int size = iter->size;
@@ -16082,7 +19788,16 @@ nk_panel_end(struct nk_context *ctx)
         if (layout->flags & NK_WINDOW_HIDDEN)
             nk_command_buffer_reset(&window->buffer);
         /* window is visible and not tab */
-        else nk_finish(ctx, window);
+        else {
+            window->draw_bounds = nk_merge_rect(window->draw_bounds, layout->bounds);
+            window->draw_bounds = nk_merge_rect(window->draw_bounds, window->bounds);
+            nk_finish(ctx, window);
+        }
+    } else if ((layout->type & NK_PANEL_SET_POPUP) && window->parent) {
+        /* popups are drawn into the parent's command buffer */
+        struct nk_window *parent = window->parent;
+        parent->draw_bounds = nk_merge_rect(parent->draw_bounds, layout->bounds);
+        parent->draw_bounds = nk_merge_rect(parent->draw_bounds, window->bounds);
     }
 
     /* NK_WINDOW_REMOVE_ROM flag was set so remove NK_WINDOW_ROM */
@@ -16154,6 +19869,10 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
     win->next = 0;
     win->prev = 0;
 
+    nk_table_index_free(ctx, win);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    nk_vertex_cache_free(&win->vertex_cache);
+#endif
     while (it) {
         /*free window state tables */
         struct nk_table *n = it->next;
@@ -16169,10 +19888,104 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
     nk_free_page_element(ctx, pe);}
 }
+NK_INTERN unsigned int
+nk_window_index_elements(unsigned int slots)
+{
+    nk_size size = slots * sizeof(struct nk_window_slot);
+    return (unsigned int)((size + sizeof(struct nk_page_element)-1) / sizeof(struct nk_page_element));
+}
+NK_INTERN void
+nk_window_index_insert(struct nk_context *ctx, struct nk_window *win)
+{
+    nk_uint mask = ctx->window_index_size-1;
+    nk_uint i = win->name & mask;
+    while (ctx->window_index[i].win)
+        i = (i + 1) & mask;
+    ctx->window_index[i].win = win;
+    ctx->window_index[i].name = win->name;
+    ctx->window_index_count++;
+}
+NK_INTERN int
+nk_window_index_slot(const struct nk_context *ctx, const struct nk_window *win)
+{
+    nk_uint mask = ctx->window_index_size-1;
+    nk_uint i = win->name & mask;
+    while (ctx->window_index[i].win) {
+        if (ctx->window_index[i].win == win)
+            return (int)i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+NK_LIB void
+nk_window_index_free(struct nk_context *ctx)
+{
+    if (!ctx->window_index) return;
+    nk_free_page_elements(ctx, (struct nk_page_element*)(void*)ctx->window_index,
+        nk_window_index_elements(ctx->window_index_size));
+    ctx->window_index = 0;
+    ctx->window_index_size = 0;
+    ctx->window_index_count = 0;
+}
+NK_LIB void
+nk_window_index_rebuild(struct nk_context *ctx)
+{
+    /* (re)allocates index with load factor below 3/4 and links all windows of
+     * the window list. Without memory windows are searched linearly. */
+    struct nk_page_element *elem;
+    struct nk_window *iter;
+    unsigned int size;
+
+    nk_window_index_free(ctx);
+    size = nk_round_up_pow2(NK_MAX(ctx->count + ctx->count/3 + 1, 32));
+    elem = nk_create_page_elements(ctx, nk_window_index_elements(size));
+    if (!elem) return;
+
+    ctx->window_index = (struct nk_window_slot*)(void*)elem;
+    ctx->window_index_size = size;
+    for (iter = ctx->begin; iter; iter = iter->next)
+        nk_window_index_insert(ctx, iter);
+}
+NK_INTERN void
+nk_window_index_remove(struct nk_context *ctx, struct nk_window *win)
+{
+    nk_uint i, j, k, mask;
+    int slot = nk_window_index_slot(ctx, win);
+    if (slot < 0) return;
+
+    /* backward shift deletion to keep probe sequences intact */
+    mask = ctx->window_index_size-1;
+    i = j = (nk_uint)slot;
+    ctx->window_index_count--;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!ctx->window_index[j].win) break;
+        k = ctx->window_index[j].name & mask;
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        ctx->window_index[i] = ctx->window_index[j];
+        i = j;
+    }
+    ctx->window_index[i].win = 0;
+    ctx->window_index[i].name = 0;
+}
 NK_LIB struct nk_window*
 nk_find_window(struct nk_context *ctx, nk_hash hash, const char *name)
 {
     struct nk_window *iter;
+    if (ctx->window_index) {
+        nk_uint mask = ctx->window_index_size-1;
+        nk_uint i = hash & mask;
+        while (ctx->window_index[i].win) {
+            if (ctx->window_index[i].name == hash) {
+                iter = ctx->window_index[i].win;
+                if (!nk_stricmpn(iter->name_string, name, nk_strlen(iter->name_string)))
+                    return iter;
+            }
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
     iter = ctx->begin;
     while (iter) {
         NK_ASSERT(iter != iter->next);
@@ -16194,12 +20007,17 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
     NK_ASSERT(win);
     if (!win || !ctx) return;
 
-    iter = ctx->begin;
-    while (iter) {
-        NK_ASSERT(iter != iter->next);
-        NK_ASSERT(iter != win);
-        if (iter == win) return;
-        iter = iter->next;
+    if (ctx->window_index) {
+        NK_ASSERT(nk_window_index_slot(ctx, win) < 0);
+        if (nk_window_index_slot(ctx, win) >= 0) return;
+    } else {
+        iter = ctx->begin;
+        while (iter) {
+            NK_ASSERT(iter != iter->next);
+            NK_ASSERT(iter != win);
+            if (iter == win) return;
+            iter = iter->next;
+        }
     }
 
     if (!ctx->begin) {
@@ -16208,11 +20026,20 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
         ctx->begin = win;
         ctx->end = win;
         ctx->count = 1;
+        if (ctx->window_index)
+            nk_window_index_insert(ctx, win);
+        else nk_window_index_rebuild(ctx);
         return;
     }
     if (loc == NK_INSERT_BACK) {
         struct nk_window *end;
         end = ctx->end;
+        if (ctx->window_index) {
+            /* windows behind a stale end get unlinked from the list */
+            struct nk_window *it;
+            for (it = end->next; it; it = it->next)
+                nk_window_index_remove(ctx, it);
+        }
         end->flags |= NK_WINDOW_ROM;
         end->next = win;
         win->prev = ctx->end;
@@ -16229,6 +20056,9 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
         ctx->begin->flags &= ~(nk_flags)NK_WINDOW_ROM;
     }
     ctx->count++;
+    if (ctx->window_index && (ctx->window_index_count+1)*4 <= ctx->window_index_size*3)
+        nk_window_index_insert(ctx, win);
+    else nk_window_index_rebuild(ctx);
 }
 NK_LIB void
 nk_remove_window(struct nk_context *ctx, struct nk_window *win)
@@ -16258,6 +20088,8 @@ nk_remove_window(struct nk_context *ctx, struct nk_window *win)
     win->next = 0;
     win->prev = 0;
     ctx->count--;
+    if (ctx->window_index)
+        nk_window_index_remove(ctx, win);
 }
 NK_API int
 nk_begin(struct nk_context *ctx, const char *title,
@@ -16292,9 +20124,14 @@ nk_begin_titled(struct nk_context *ctx, const char *name, const char *title,
         /* create new window */
         nk_size name_length = (nk_size)name_len;
         win = (struct nk_window*)nk_create_window(ctx);
+        if (!win) nk_memory_check(ctx, name);
         NK_ASSERT(win);
         if (!win) return 0;
 
+        win->name = name_hash;
+        name_length = NK_MIN(name_length, NK_WINDOW_MAX_NAME-1);
+        NK_MEMCPY(win->name_string, name, name_length);
+        win->name_string[name_length] = 0;
         if (flags & NK_WINDOW_BACKGROUND)
             nk_insert_window(ctx, win, NK_INSERT_FRONT);
         else nk_insert_window(ctx, win, NK_INSERT_BACK);
@@ -16302,10 +20139,6 @@ nk_begin_titled(struct nk_context *ctx, const char *name, const char *title,
 
         win->flags = flags;
         win->bounds = bounds;
-        win->name = name_hash;
-        name_length = NK_MIN(name_length, NK_WINDOW_MAX_NAME-1);
-        NK_MEMCPY(win->name_string, name, name_length);
-        win->name_string[name_length] = 0;
         win->popup.win = 0;
         if (!ctx->active)
             ctx->active = win;
@@ -16423,18 +20256,21 @@ NK_API void
 nk_end(struct nk_context *ctx)
 {
     struct nk_panel *layout;
+    const struct nk_window *win;
     NK_ASSERT(ctx);
     NK_ASSERT(ctx->current && "if this triggers you forgot to call `nk_begin`");
     if (!ctx || !ctx->current)
         return;
 
     layout = ctx->current->layout;
-    if (!layout || (layout->type == NK_PANEL_WINDOW && (ctx->current->flags & NK_WINDOW_HIDDEN))) {
-        ctx->current = 0;
-        return;
+    if (layout && (layout->type != NK_PANEL_WINDOW || !(ctx->current->flags & NK_WINDOW_HIDDEN))) {
+        nk_panel_end(ctx);
+        nk_free_panel(ctx, ctx->current->layout);
     }
-    nk_panel_end(ctx);
-    nk_free_panel(ctx, ctx->current->layout);
+    /* popups have no name and draw into their parent's command buffer */
+    win = ctx->current;
+    while (win->parent) win = win->parent;
+    nk_memory_check(ctx, win->name_string);
     ctx->current = 0;
 }
 NK_API struct nk_rect
@@ -16643,6 +20479,40 @@ nk_window_is_hidden(struct nk_context *ctx, const char *name)
     return (win->flags & NK_WINDOW_HIDDEN);
 }
 NK_API int
+nk_window_is_dirty(struct nk_context *ctx, const char *name)
+{
+    int title_len;
+    nk_hash title_hash;
+    struct nk_window *win;
+    NK_ASSERT(ctx);
+    if (!ctx) return 1;
+
+    title_len = (int)nk_strlen(name);
+    title_hash = nk_murmur_hash(name, (int)title_len, NK_WINDOW_TITLE);
+    win = nk_find_window(ctx, title_hash, name);
+    if (!win) return 1;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    return win->dirty;
+}
+NK_API nk_size
+nk_window_get_command_bytes(struct nk_context *ctx, const char *name)
+{
+    int title_len;
+    nk_hash title_hash;
+    struct nk_window *win;
+    NK_ASSERT(ctx);
+    if (!ctx) return 0;
+
+    title_len = (int)nk_strlen(name);
+    title_hash = nk_murmur_hash(name, (int)title_len, NK_WINDOW_TITLE);
+    win = nk_find_window(ctx, title_hash, name);
+    if (!win || (win->flags & NK_WINDOW_HIDDEN)) return 0;
+    return win->buffer.end - win->buffer.begin;
+}
+NK_API int
 nk_window_is_active(struct nk_context *ctx, const char *name)
 {
     int title_len;
@@ -25475,6 +29345,71 @@ nk_tooltipfv(struct nk_context *ctx, const char *fmt, va_list args)
 ///    - [yy]: Minor version with non-breaking API and library changes
 ///    - [zz]: Bug fix version with no direct changes to API
 ///
+/// - 2026/10/18 (4.25.1) - Resolve overlapping font glyph ranges into disjoint sorted
+///                        ranges
+/// - 2026/10/18 (4.25.0) - Replace nk_user_font_set_advance by NK_INCLUDE_GLYPH_ADVANCE
+/// - 2026/10/18 (4.24.3) - Let nk_shrink release pages held by oversized lookup indices
+/// - 2026/10/18 (4.24.2) - Document font thread safety for nk_convert_frame
+/// - 2026/10/18 (4.24.1) - Convert dynamic font atlas text on the calling thread
+/// - 2026/10/18 (4.24.0) - Moved the glyph advance callback to the end of `nk_user_font`
+///                        and made it only settable through `nk_user_font_set_advance`,
+///                        so fonts filled field by field without zeroing the struct
+///                        never call uninitialized memory. The font handling docs now
+///                        zero `nk_user_font` before filling it
+/// - 2026/10/18 (4.23.1) - Reuse the window table index and freed page element blocks
+///                        instead of growing memory when tables churn
+/// - 2026/10/18 (4.23.0) - Added chunked command buffers (`nk_buffer_init_chunked`,
+///                        `nk_chunked_commands`) which grow without copying draw
+///                        commands
+/// - 2026/10/18 (4.22.0) - Added `nk_buffer_trim_policy` to let dynamic buffers shrink
+///                        after their decaying high-water mark stays low
+/// - 2026/10/18 (4.21.0) - Pool pages now double in size and `nk_shrink` gives pages
+///                        without used windows, panels or tables back to the allocator
+/// - 2026/10/18 (4.20.0) - Added `nk_memory_stats` with command and page memory peaks, a
+///                        suggested `nk_init_fixed` size and overflow reporting
+/// - 2026/10/18 (4.19.0) - Add nk_double_buffer, nk_frame_previous and nk_convert_frame
+///                        to render the previous frame while the next one is built
+/// - 2026/10/18 (4.18.0) - Add nk_font_atlas_add_from_file_mapped behind
+///                        NK_INCLUDE_FILE_MAPPING to bake from read-only file mappings
+/// - 2026/10/18 (4.17.0) - Add skyline best-fit and MaxRects atlas packing that picks the
+///                        smallest power of two texture
+/// - 2026/10/18 (4.16.0) - Bump allocate rasterizer active edges per glyph and add an
+///                        SSE2 scanline accumulation pass
+/// - 2026/10/18 (4.15.0) - Add `NK_FONT_ATLAS_R8` and block compressed
+///                        `NK_FONT_ATLAS_BC4` atlas formats
+/// - 2026/10/18 (4.14.0) - Add `nk_font_config.kerning` to apply kerning pairs of the
+///                        `kern` table
+/// - 2026/10/18 (4.13.0) - Add `nk_font_config.sdf` to bake signed distance field fonts
+///                        usable at any scale
+/// - 2026/10/18 (4.12.0) - Add `nk_font_atlas_save` and `nk_font_atlas_load` to cache
+///                        baked font atlases
+/// - 2026/10/18 (4.11.0) - Add `nk_font_atlas_bake_parallel` to render glyphs of the
+///                        atlas with a user supplied `nk_plugin_parallel_for`
+/// - 2026/10/18 (4.10.0) - Add `nk_font_atlas_bake_dynamic` and `nk_font_atlas_dirty` to
+///                        rasterize glyphs on first use
+/// - 2026/10/18 (4.09.0) - Look up font glyphs by table and binary search instead of
+///                        walking all ranges
+/// - 2026/10/18 (4.08.0) - Split draw commands past 65535 vertices and add
+///                        `nk_draw_command.vertex_offset`
+/// - 2026/10/18 (4.07.0) - Added NK_INCLUDE_SIMD to compute AA line and shape normals
+///                        with SSE2
+/// - 2026/10/18 (4.06.1) - Write vertices of the common float/float/R8G8B8A8 layout
+///                        without walking the layout
+/// - 2026/10/18 (4.06.0) - Added nk_convert_config.parallel_for to tessellate windows on
+///                        multiple threads
+/// - 2026/10/18 (4.05.0) - Added NK_CONVERT_CACHE_WINDOWS to reuse vertex output of
+///                        unchanged windows in nk_convert
+/// - 2026/10/18 (4.04.0) - Added `nk_frame_damage` returning changed screen areas for
+///                        partial redraws
+/// - 2026/10/18 (4.03.0) - Added `nk_frame_is_dirty` and `nk_window_is_dirty` to skip
+///                        rendering unchanged frames
+/// - 2026/10/18 (4.02.0) - Added optional nk_user_font advance callback which
+///                        nk_text_clamp uses to sum up glyph advances in linear time.
+///                        Make sure to zero unused nk_user_font callbacks.
+/// - 2026/10/18 (4.01.5) - Use a hash index over the window list in nk_find_window and
+///                        nk_insert_window.
+/// - 2026/10/18 (4.01.4) - Use a hash index over window state tables in nk_find_value for
+///                        windows with more than one table page.
 /// - 2019/09/20 (4.01.3) - Fixed a bug wherein combobox cannot be closed by clicking the header
 ///                        when NK_BUTTON_TRIGGER_ON_RELEASE is defined.
 /// - 2019/09/10 (4.01.2) - Fixed the nk_cos function, which deviated significantly.
@@ -20,6 +20,12 @@ extern "C" {
 #ifndef NK_MAX_NUMBER_BUFFER
   #define NK_MAX_NUMBER_BUFFER 64
 #endif
+#ifndef NK_DAMAGE_MAX
+  #define NK_DAMAGE_MAX 16
+#endif
+#ifndef NK_FONT_LOOKUP_MAX
+  #define NK_FONT_LOOKUP_MAX 256
+#endif
 #ifndef NK_SCROLLBAR_HIDING_TIMEOUT
   #define NK_SCROLLBAR_HIDING_TIMEOUT 4.0f
 #endif
@@ -265,6 +271,8 @@ typedef void (*nk_plugin_free)(nk_handle, void *old);
 typedef int(*nk_plugin_filter)(const struct nk_text_edit*, nk_rune unicode);
 typedef void(*nk_plugin_paste)(nk_handle, struct nk_text_edit*);
 typedef void(*nk_plugin_copy)(nk_handle, const char*, int len);
+typedef void(*nk_plugin_job)(void *job, int index);
+typedef void(*nk_plugin_parallel_for)(nk_handle, nk_plugin_job, void *job, int count);
 
 struct nk_allocator {
     nk_handle userdata;
@@ -323,6 +331,12 @@ enum nk_symbol_type {
 /// __nk_init_custom__  | Initializes context from two buffers. One for draw commands the other for window/panel/table allocations
 /// __nk_clear__        | Called at the end of the frame to reset and prepare the context for the next frame
 /// __nk_free__         | Shutdown and free all memory allocated inside the context
+/// __nk_shrink__       | Gives memory of unused windows, panels and tables back to the allocator
+/// __nk_double_buffer__| Keeps the previous frame readable while the next one is built
+/// __nk_chunked_commands__| Lets the command buffer grow without copying commands
+/// __nk_memory_stats__ | Returns command and page memory statistics collected over the last frames
+/// __nk_memory_stats_reset__| Restarts collecting memory statistics
+/// __nk_memory_assert_on_overflow__| Asserts as soon as a window runs out of memory
 /// __nk_set_user_data__| Utility function to pass user data to draw command
  */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -432,6 +446,146 @@ NK_API void nk_clear(struct nk_context*);
 /// __ctx__     | Must point to a previously initialized `nk_context` struct
 */
 NK_API void nk_free(struct nk_context*);
+/*/// #### nk_shrink
+/// Windows, panels and tables are allocated in pages which start small and
+/// double in size up to `NK_POOL_MAX_CAPACITY`. Freed elements are reused
+/// most recently freed first but are otherwise kept for the lifetime of the
+/// context. This call gives every page without any element in use back to
+/// the allocator, for example after a burst of popups or combo boxes has been
+/// closed. Window and table lookup indices that grew during such a burst and
+/// are less than a quarter full are rebuilt at a fitting size, so they do not
+/// keep their pages alive. Best called after `nk_clear`.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_size nk_shrink(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+///
+/// Returns the number of bytes released. Always 0 for contexts with fixed
+/// memory from `nk_init_fixed` or a fixed pool passed to `nk_init_custom`
+*/
+NK_API nk_size nk_shrink(struct nk_context*);
+/*/// #### nk_double_buffer
+/// Lets the context alternate between two command buffers. `nk_clear` then
+/// keeps the commands of the finished frame untouched in one buffer while the
+/// next frame is built into the other one. The finished frame is returned by
+/// `nk_frame_previous` and can be iterated with `nk_frame_foreach` or converted
+/// with `nk_convert_frame` on a render thread without any locks, as long as
+/// the render thread is done with it before the next call to `nk_clear` and
+/// the fonts used are thread-safe (see `nk_convert_frame`).
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_double_buffer(struct nk_context *ctx, struct nk_buffer *memory);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a context initialized by `nk_init_default`, `nk_init` or `nk_init_custom`
+/// __memory__  | Optional second command buffer owned by the context from now on. If NULL a dynamic buffer of the same size and allocator as the context command buffer is created
+///
+/// Returns `true(1)` on success or `false(0)` for contexts created by
+/// `nk_init_fixed`, which keep their window memory inside the command buffer
+*/
+NK_API int nk_double_buffer(struct nk_context*, struct nk_buffer *memory);
+/*/// #### nk_chunked_commands
+/// Turns the dynamic command buffer of a context into a chunked one (see
+/// `nk_buffer_init_chunked`). Once the buffer is full, draw commands continue in
+/// a newly allocated chunk instead of copying all commands of the frame into
+/// a bigger block. `nk__next` and all other command iteration follow chunks
+/// on their own. Contexts from `nk_init_custom` can pass a chunked buffer
+/// directly instead.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_chunked_commands(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a context initialized by `nk_init_default`, `nk_init` or `nk_init_custom`
+///
+/// Returns `true(1)` on success or `false(0)` if the command buffer is fixed
+/// or holds windows at its back as for `nk_init_fixed`
+*/
+NK_API int nk_chunked_commands(struct nk_context*);
+/*/// #### nk_memory_stats
+/// Returns how much memory the context used over all frames since it was
+/// initialized or `nk_memory_stats_reset` was called. Frames are recorded by
+/// `nk_clear`, so the numbers always describe finished frames. Especially useful
+/// to size the memory block passed to `nk_init_fixed`: run the UI through all
+/// its states with either a dynamic or a big fixed context and use
+/// `suggested_fixed_size` afterwards.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_stats(const struct nk_context *ctx, struct nk_memory_stats *stats);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+/// __stats__   | Must point to a `nk_memory_stats` struct to fill
+///
+/// Field                   | Description
+/// ------------------------|---------------------------------------------------
+/// __command_bytes__       | Draw command memory used by the last finished frame
+/// __command_peak__        | Most draw command memory used by any frame
+/// __command_needed__      | Most draw command memory asked for by any frame including allocations which failed
+/// __page_elements__       | Window, panel and table slots taken from the pool or the back of the command buffer
+/// __page_elements_free__  | Number of those slots currently on the free list
+/// __page_elements_peak__  | Most slots taken at the end of any frame
+/// __largest_window__      | Name of the window with the most draw commands in the last frame or NULL
+/// __largest_window_bytes__| Draw command memory of that window including its popups
+/// __suggested_fixed_size__| Smallest memory block for `nk_init_fixed` which would have held every frame so far
+/// __overflows__           | Number of times a window or the overlay ran out of memory
+/// __overflow_window__     | Name of the first window which ran out of memory or NULL
+/// __frames__              | Number of recorded frames
+*/
+struct nk_memory_stats {
+    nk_size command_bytes;
+    nk_size command_peak;
+    nk_size command_needed;
+    unsigned int page_elements;
+    unsigned int page_elements_free;
+    unsigned int page_elements_peak;
+    const char *largest_window;
+    nk_size largest_window_bytes;
+    nk_size suggested_fixed_size;
+    unsigned int overflows;
+    const char *overflow_window;
+    unsigned int frames;
+};
+NK_API void nk_memory_stats(const struct nk_context*, struct nk_memory_stats*);
+/*/// #### nk_memory_stats_reset
+/// Drops all peaks and overflows collected so far. Slots currently taken by
+/// windows, panels and tables stay counted.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_stats_reset(struct nk_context *ctx);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+*/
+NK_API void nk_memory_stats_reset(struct nk_context*);
+/*/// #### nk_memory_assert_on_overflow
+/// Running out of memory normally just drops the draw commands or widgets
+/// which did not fit. If enabled `NK_ASSERT` triggers at the end of the first
+/// window running out of memory instead. The window name is already stored
+/// in `nk_memory_stats` at that point.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// void nk_memory_assert_on_overflow(struct nk_context *ctx, int enable);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a previously initialized `nk_context` struct
+/// __enable__  | `true(1)` to assert on overflow, `false(0)` to silently drop
+*/
+NK_API void nk_memory_assert_on_overflow(struct nk_context*, int enable);
 #ifdef NK_INCLUDE_COMMAND_USERDATA
 /*/// #### nk_set_user_data
 /// Sets the currently passed userdata passed down into each draw command.
@@ -914,7 +1068,12 @@ NK_API void nk_input_end(struct nk_context*);
 /// __nk__begin__       | Returns the first draw command in the context draw command list to be drawn
 /// __nk__next__        | Increments the draw command iterator to the next command inside the context draw command list
 /// __nk_foreach__      | Iterates over each draw command inside the context draw command list
+/// __nk_frame_is_dirty__| Returns if the draw command list changed since the last frame
+/// __nk_frame_damage__ | Returns all screen areas which changed since the last frame
+/// __nk_frame_previous__| Returns a read-only view of the previous frame of a double buffered context
+/// __nk_frame_foreach__| Iterates over each draw command of such a frame
 /// __nk_convert__      | Converts from the abstract draw commands list into a hardware accessible vertex format
+/// __nk_convert_frame__| Converts the draw commands of such a frame into a caller owned draw list
 /// __nk_draw_begin__   | Returns the first vertex command in the context vertex draw list to be executed
 /// __nk__draw_next__   | Increments the vertex command iterator to the next command inside the context vertex command list
 /// __nk__draw_end__    | Returns the end of the vertex draw list
@@ -928,6 +1087,9 @@ enum nk_convert_result {
     NK_CONVERT_VERTEX_BUFFER_FULL = NK_FLAG(2),
     NK_CONVERT_ELEMENT_BUFFER_FULL = NK_FLAG(3)
 };
+enum nk_convert_flags {
+    NK_CONVERT_CACHE_WINDOWS = NK_FLAG(0) /* reuse vertices of windows whose draw commands did not change */
+};
 struct nk_draw_null_texture {
     nk_handle texture; /* texture handle to a texture with a white pixel */
     struct nk_vec2 uv; /* coordinates to a white pixel in the texture  */
@@ -943,6 +1105,9 @@ struct nk_convert_config {
     const struct nk_draw_vertex_layout_element *vertex_layout; /* describes the vertex output format and packing */
     nk_size vertex_size; /* sizeof one vertex for vertex packing */
     nk_size vertex_alignment; /* vertex alignment: Can be obtained by NK_ALIGNOF */
+    nk_flags flags; /* combination of nk_convert_flags: defaults to 0 */
+    nk_plugin_parallel_for parallel_for; /* optional: runs jobs on other threads and returns once all are done */
+    nk_handle parallel_userdata; /* userdata passed to `parallel_for` */
 };
 /*/// #### nk__begin
 /// Returns a draw command list iterator to iterate all draw
@@ -989,6 +1154,90 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
 /// Iterates over each draw command inside the context draw command list
 */
 #define nk_foreach(c, ctx) for((c) = nk__begin(ctx); (c) != 0; (c) = nk__next(ctx,c))
+/*/// #### nk_frame_previous
+/// Returns a read-only view of the draw commands of the frame finished by the
+/// last `nk_clear` of a double buffered context (see `nk_double_buffer`). The
+/// view stays valid until the next call to `nk_clear` and only refers to
+/// command memory, so it can be handed to another thread.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// struct nk_frame nk_frame_previous(const struct nk_context*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to a double buffered `nk_context` struct
+///
+/// Returns the previous frame or an empty frame if the context is not double buffered
+*/
+struct nk_frame {
+    const void *memory; /* command memory of the frame */
+    const struct nk_buffer_chunk *chunk; /* additional memory of a chunked command buffer */
+    nk_size begin; /* offset of the first command */
+    nk_size end; /* offset behind the last command */
+};
+NK_API struct nk_frame nk_frame_previous(const struct nk_context*);
+/*/// #### nk__frame_begin
+/// Returns the first draw command of a frame returned by `nk_frame_previous`
+/// or NULL if the frame is empty
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_command* nk__frame_begin(const struct nk_frame*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+NK_API const struct nk_command* nk__frame_begin(const struct nk_frame*);
+/*/// #### nk__frame_next
+/// Returns the draw command after `cmd` inside a frame or NULL at its end
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_command* nk__frame_next(const struct nk_frame*, const struct nk_command*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+NK_API const struct nk_command* nk__frame_next(const struct nk_frame*, const struct nk_command*);
+/*/// #### nk_frame_foreach
+/// Iterates over each draw command of a frame returned by `nk_frame_previous`
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// #define nk_frame_foreach(c, frame)
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+*/
+#define nk_frame_foreach(c, f) for((c) = nk__frame_begin(f); (c) != 0; (c) = nk__frame_next(f,c))
+/*/// #### nk_frame_is_dirty
+/// Returns if the draw command list of the current frame differs from the
+/// one of the last frame. Each command buffer keeps a running hash over its
+/// commands which is compared once the frame is built. Can be used to skip rendering
+/// completely while the UI is idle.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_frame_is_dirty(struct nk_context*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+///
+/// Returns `true(1)` if anything will be drawn differently than last frame or `false(0)` otherwise
+*/
+NK_API int nk_frame_is_dirty(struct nk_context*);
+/*/// #### nk_frame_damage
+/// Returns the screen areas which have to be redrawn to update the last frame
+/// into the current one. A window is damaged if its draw commands or its
+/// z-order changed, in which case both its old and new area are returned.
+/// Software renderers can clear and redraw the commands clipped to each
+/// rectangle instead of the whole screen.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// const struct nk_rect* nk_frame_damage(struct nk_context*, int *count);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+/// __count__   | Must point to an integer receiving the number of rectangles
+///
+/// Returns up to `NK_DAMAGE_MAX` damage rectangles
+*/
+NK_API const struct nk_rect* nk_frame_damage(struct nk_context*, int *count);
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 /*/// #### nk_convert
 /// Converts all internal draw commands into vertex draw commands and fills
@@ -1018,8 +1267,66 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
 /// NK_CONVERT_COMMAND_BUFFER_FULL  | The provided buffer for storing draw commands is full or failed to allocate more memory
 /// NK_CONVERT_VERTEX_BUFFER_FULL   | The provided buffer for storing vertices is full or failed to allocate more memory
 /// NK_CONVERT_ELEMENT_BUFFER_FULL  | The provided buffer for storing indicies is full or failed to allocate more memory
+///
+/// With the default 16-bit `nk_draw_index` a new draw command is started once the
+/// vertices of the current one cannot be addressed anymore. Its indices are relative
+/// to `nk_draw_command.vertex_offset`, so backends have to add it to each index,
+/// for example as base vertex of `glDrawElementsBaseVertex` or `DrawIndexed`. It
+/// stays zero as long as a frame has less than 65535 vertices and is always zero
+/// if `NK_UINT_DRAW_INDEX` is defined.
+///
+/// Setting `NK_CONVERT_CACHE_WINDOWS` in `nk_convert_config.flags` keeps a copy of
+/// the generated vertices, indices and draw commands for each window. Windows whose
+/// draw commands did not change since the last frame (see `nk_window_is_dirty`)
+/// are copied from that cache instead of being tessellated again. The output is
+/// identical to the uncached path. The cache is allocated with the context
+/// allocator, so it is not used for contexts created by `nk_init_fixed`. Images
+/// and fonts are compared by handle, so clear the flag for one frame if you
+/// update texture contents or font glyphs without changing the handle. Windows
+/// drawing text with a font of an atlas baked by `nk_font_atlas_bake_dynamic`
+/// are never cached, since its glyphs can move whenever the atlas is full.
+///
+/// If `nk_convert_config.parallel_for` is set, windows are tessellated on their
+/// own by jobs and then copied into the output buffers with rebased indices.
+/// The callback has to call the given job for every index from 0 to `count`-1,
+/// using any number of threads, and return after all jobs finished. Custom
+/// draw callbacks are still called on the calling thread. Jobs allocate from
+/// the context allocator and query fonts concurrently, so both have to be
+/// thread-safe. Looking up glyphs of a dynamic font atlas modifies the atlas,
+/// so windows drawing text with one are converted on the calling thread
+/// after all jobs finished. Like the window cache this requires a context
+/// with a dynamic command buffer and produces the same output as the serial
+/// path.
 */
 NK_API nk_flags nk_convert(struct nk_context*, struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
+/*/// #### nk_convert_frame
+/// Converts the draw commands of a frame returned by `nk_frame_previous` like
+/// `nk_convert` but into a caller owned draw list instead of the one inside the
+/// context. Nothing of the context is touched, so it can run on a render
+/// thread while the next frame is built. The window cache and
+/// `parallel_for` of the config are not used. Text commands still call the
+/// `query` callback of their font, so on a render thread it runs
+/// concurrently with text measuring on the thread building the next frame
+/// and has to be thread-safe against it. Fonts of an atlas baked by
+/// `nk_font_atlas_bake_dynamic` are not, and are rejected by an assert.
+///
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_flags nk_convert_frame(const struct nk_frame*, struct nk_draw_list*, struct nk_buffer *cmds,
+///     struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __frame__   | Must point to a frame returned by `nk_frame_previous`
+/// __list__    | Must point to a draw list initialized with `nk_draw_list_init`. Iterate the result with `nk_draw_list_foreach`
+/// __cmds__    | Must point to a previously initialized buffer to hold converted vertex draw commands
+/// __vertices__| Must point to a previously initialized buffer to hold all produced vertices
+/// __elements__| Must point to a previously initialized buffer to hold all produced vertex indices
+/// __config__  | Must point to a filled out `nk_config` struct to configure the conversion process
+///
+/// Returns one of enum nk_convert_result error codes
+*/
+NK_API nk_flags nk_convert_frame(const struct nk_frame*, struct nk_draw_list*, struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements, const struct nk_convert_config*);
 /*/// #### nk__draw_begin
 /// Returns a draw vertex command buffer iterator to iterate over the vertex draw command buffer
 ///
@@ -1188,6 +1495,8 @@ NK_API const struct nk_draw_command* nk__draw_next(const struct nk_draw_command*
 /// nk_window_is_collapsed              | Returns if the window with given name is currently minimized/collapsed
 /// nk_window_is_closed                 | Returns if the currently processed window was closed
 /// nk_window_is_hidden                 | Returns if the currently processed window was hidden
+/// nk_window_is_dirty                  | Returns if the draw commands of a window changed since the last frame
+/// nk_window_get_command_bytes         | Returns the draw command memory used by a window in its last finished frame
 /// nk_window_is_active                 | Same as nk_window_has_focus for some reason
 /// nk_window_is_hovered                | Returns if the currently processed window is currently being hovered by mouse
 /// nk_window_is_any_hovered            | Return if any window currently hovered
@@ -1590,6 +1899,38 @@ NK_API int nk_window_is_closed(struct nk_context*, const char*);
 /// Returns `true(1)` if current window is hidden or `false(0)` window not found or visible
 */
 NK_API int nk_window_is_hidden(struct nk_context*, const char*);
+/*/// #### nk_window_is_dirty
+/// Returns if the draw commands of the window with given name differ from
+/// the ones of the last frame. Has to be called after all windows have been
+/// processed, same as `nk__begin`. Commands are compared by content, so
+/// images and custom callbacks only compare their handles, not what they draw.
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// int nk_window_is_dirty(struct nk_context *ctx, const char *name);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct at the end of a frame
+/// __name__    | Identifier of window you want to check if it changed
+///
+/// Returns `true(1)` if window changed or was not found or `false(0)` if it draws the same as last frame
+*/
+NK_API int nk_window_is_dirty(struct nk_context*, const char*);
+/*/// #### nk_window_get_command_bytes
+/// Returns how much draw command memory the window with given name used the
+/// last time `nk_end` was called for it, including all its popups.
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
+/// nk_size nk_window_get_command_bytes(struct nk_context *ctx, const char *name);
+/// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// Parameter   | Description
+/// ------------|-----------------------------------------------------------
+/// __ctx__     | Must point to an previously initialized `nk_context` struct
+/// __name__    | Identifier of window you want the memory usage of
+///
+/// Returns the number of bytes or 0 if the window was not found or is hidden
+*/
+NK_API nk_size nk_window_get_command_bytes(struct nk_context*, const char*);
 /*/// #### nk_window_is_active
 /// Same as nk_window_has_focus for some reason
 /// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~c
@@ -3555,7 +3896,7 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
             return text_width;
         }
 
-        struct nk_user_font font;
+        struct nk_user_font font = {0};
         font.userdata.ptr = &your_font_class_or_struct;
         font.height = your_font_height;
         font.width = your_text_width_calculation;
@@ -3563,6 +3904,20 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
         struct nk_context ctx;
         nk_init_default(&ctx, &font);
 
+    If the width of a string is always the sum of the advances of its glyphs
+    and `NK_INCLUDE_GLYPH_ADVANCE` is defined, the font can also provide the
+    advance of a single glyph. Text clamping then adds up advances instead of
+    measuring every prefix of the text. The callback is used whenever it is
+    not NULL, so zero the struct as above before filling it in. Fonts baked
+    by the font atlas do this without the define unless they use kerning.
+
+        float your_glyph_advance(nk_handle handle, float height, nk_rune codepoint)
+        {
+            your_font_type *type = handle.ptr;
+            return ...;
+        }
+        font.advance = your_glyph_advance;
+
     2.) Using your own implementation with vertex buffer output
     --------------------------------------------------------------
     While the first approach works fine if you don't want to use the optional
@@ -3593,7 +3948,7 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
             glyph.offset.y = ...;
         }
 
-        struct nk_user_font font;
+        struct nk_user_font font = {0};
         font.userdata.ptr = &your_font_class_or_struct;
         font.height = your_font_height;
         font.width = your_text_width_calculation;
@@ -3672,9 +4027,134 @@ NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune
         cfg.coord_type = NK_COORD_PIXEL;
         nk_font *font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 13, &cfg);
 
+    Fonts with a lot of glyphs like `nk_font_chinese_glyph_ranges` take a long
+    time to bake and require a huge texture. Calling `nk_font_atlas_bake_dynamic`
+    instead of `nk_font_atlas_bake` creates an empty texture of fixed size and
+    rasterizes each glyph the first time it is looked up. If the texture is full
+    glyphs that were not used in the current frame get evicted. Since the image
+    keeps changing it is not freed by `nk_font_atlas_end` and the ttf memory
+    blocks are kept alive by `nk_font_atlas_cleanup`. After each `nk_convert`
+    (or your own text drawing) call `nk_font_atlas_dirty` to get the
+    region of the image that changed and upload it before drawing. This call
+    also marks the end of a frame for glyph eviction. Since every glyph lookup
+    can modify the atlas, all text of a dynamic atlas has to be measured and
+    converted on one thread. `nk_convert` does not hand windows using it to
+    `parallel_for` jobs and `nk_convert_frame` cannot be used with it.
+
+        const void* img = nk_font_atlas_bake_dynamic(&atlas, 1024, 1024, NK_FONT_ATLAS_ALPHA8);
+        nk_font_atlas_end(&atlas, nk_handle_id(texture), &null);
+        while (1) {
+            struct nk_recti dirty;
+            nk_convert(&ctx, &cmds, &vertices, &elements, &config);
+            img = nk_font_atlas_dirty(&atlas, &dirty);
+            if (dirty.w && dirty.h)
+                your_texture_update(texture, img, dirty.x, dirty.y, dirty.w, dirty.h);
+        }
+
+    Baking all glyphs up front can also be spread over multiple threads by
+    calling `nk_font_atlas_bake_parallel` with a `nk_plugin_parallel_for`
+    callback like the one in `nk_convert_config`. Glyphs are packed on the
+    calling thread and then rendered by jobs, each into its own rectangle, so
+    the image is identical to the one returned by `nk_font_atlas_bake`. The
+    callback has to call the given job for every index from 0 to `count`-1 and
+    return after all jobs finished. Jobs allocate from the temporary atlas
+    allocator so it has to be thread-safe.
+
+        const void* img = nk_font_atlas_bake_parallel(&atlas, &w, &h,
+            NK_FONT_ATLAS_RGBA32, your_parallel_for, nk_handle_ptr(your_pool));
+
+    To skip baking on the next start the result can be stored with
+    `nk_font_atlas_save` after baking and before `nk_font_atlas_end` or
+    `nk_font_atlas_cleanup`. The call returns the number of bytes required and
+    only writes the blob if `size` is big enough. The blob holds the image, font
+    metrics, glyphs and the custom cursor rectangle and is keyed by a hash of
+    all added ttf files and font configs. It is only valid for the same
+    version and build of nuklear.
+
+    After adding the same fonts again `nk_font_atlas_load` can be called
+    instead of `nk_font_atlas_bake`. It returns 0 if the blob does not match
+    the added fonts or format, in which case you have to bake again. Otherwise
+    the returned image points into the given memory, which therefore only has
+    to stay valid until it is uploaded, so a memory mapped file works fine.
+
+        nk_font_atlas_begin(&atlas);
+        font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 13, 0);
+        img = nk_font_atlas_load(&atlas, blob, blob_size, &w, &h, NK_FONT_ATLAS_RGBA32);
+        if (!img) {
+            img = nk_font_atlas_bake(&atlas, &w, &h, NK_FONT_ATLAS_RGBA32);
+            blob_size = nk_font_atlas_save(&atlas, 0, 0);
+            blob = malloc(blob_size);
+            nk_font_atlas_save(&atlas, blob, blob_size);
+            your_write_file(blob, blob_size);
+        }
+        your_upload_texture(img, w, h);
+        nk_font_atlas_end(&atlas, nk_handle_id(texture), 0);
+
+    Setting `nk_font_config.sdf` bakes a signed distance field of each glyph
+    instead of its coverage. The outline maps to alpha 0.5 and the field
+    reaches `nk_font_config.sdf_spread` pixels to both sides, which also grows
+    each glyph by that border. Oversampling is ignored for these fonts. Glyph
+    metrics are always scaled by the requested height, so a copy of
+    `font->handle` with another `height` draws the same glyphs at a different
+    size without baking again. The renderer has to turn the field back into
+    coverage, for example with `smoothstep(0.5 - w, 0.5 + w, alpha)` and `w`
+    taken from `fwidth(alpha)` in the fragment shader (see the glfw_opengl3
+    demo). Since the shader is usually picked by texture, all fonts inside
+    one atlas should use the same mode.
+
+        struct nk_font_config cfg = nk_font_config(32);
+        cfg.sdf = nk_true;
+        font = nk_font_atlas_add_from_file(&atlas, "Path/To/Your/TTF_Font.ttf", 32, &cfg);
+        ...
+        struct nk_user_font small = font->handle;
+        small.height = 12;
+        nk_style_set_font(ctx, &small);
+
+    Besides `NK_FONT_ATLAS_RGBA32` with white color and coverage in alpha,
+    the image can be baked with one byte per pixel for single channel
+    textures. `NK_FONT_ATLAS_ALPHA8` and `NK_FONT_ATLAS_R8` produce the same
+    bytes but R8 is meant to be uploaded as red channel texture and sampled
+    as (1,1,1,r), for example with a `GL_TEXTURE_SWIZZLE_RGBA` of
+    (`GL_ONE`,`GL_ONE`,`GL_ONE`,`GL_RED`), so the white pixel of the null
+    texture stays white. `NK_FONT_ATLAS_BC4` compresses the R8 image into
+    BC4/RGTC1 blocks of 8 bytes per 4x4 pixels, which can be uploaded with
+    `glCompressedTexImage2D` and `GL_COMPRESSED_RED_RGTC1` and sampled the same
+    way. Fully transparent and opaque pixels stay exact while anti-aliased
+    edges are quantized to 8 levels per block. BC4 is not supported by
+    `nk_font_atlas_bake_dynamic`.
+
+    `nk_font_atlas_add_from_file` reads the whole TTF file into memory of the
+    permanent allocator, which for large CJK fonts means several megabytes of
+    heap per font. With `NK_INCLUDE_FILE_MAPPING` defined
+    `nk_font_atlas_add_from_file_mapped` instead maps the file read-only and
+    bakes straight from the mapping, so only the pages of the glyphs actually
+    used are read. The file is unmapped by `nk_font_atlas_cleanup` or
+    `nk_font_atlas_clear` and has to stay unchanged until then.
+
+        font = nk_font_atlas_add_from_file_mapped(&atlas, "Path/To/Your/CJK_Font.ttf", 13, &cfg);
+
+    By default glyphs are packed font by font into a texture of 512 or 1024
+    pixels width, which for sets of fonts with very different sizes often ends
+    up taller than necessary. Setting `nk_font_atlas.packing` after
+    `nk_font_atlas_init` to `NK_FONT_ATLAS_PACK_SKYLINE`,
+    `NK_FONT_ATLAS_PACK_MAXRECTS` or `NK_FONT_ATLAS_PACK_BEST` instead packs
+    the glyphs of all fonts together, tries all power of two widths between
+    256 and 4096 and keeps the smallest power of two texture. MaxRects usually
+    packs tightest but takes longer for large glyph sets.
+
+        nk_font_atlas_init_default(&atlas);
+        atlas.packing = NK_FONT_ATLAS_PACK_BEST;
+
+    Setting `nk_font_config.kerning` reads the kerning pairs of all baked
+    glyphs from the font's `kern` table into a hash table of the font. Text
+    widths and the glyph advance returned to the draw list then include the
+    kerning to the next glyph. Fonts that only store kerning in their `GPOS`
+    table are not kerned.
+
 */
 struct nk_user_font_glyph;
 typedef float(*nk_text_width_f)(nk_handle, float h, const char*, int len);
+typedef float(*nk_glyph_advance_f)(nk_handle, float h, nk_rune codepoint);
 typedef void(*nk_query_font_glyph_f)(nk_handle handle, float font_height,
                                     struct nk_user_font_glyph *glyph,
                                     nk_rune codepoint, nk_rune next_codepoint);
@@ -3705,6 +4185,11 @@ struct nk_user_font {
     nk_handle texture;
     /* texture handle to the used font atlas or texture */
 #endif
+#ifdef NK_INCLUDE_GLYPH_ADVANCE
+    nk_glyph_advance_f advance;
+    /* optional single glyph advance in pixel callback. Used whenever it is
+     * not NULL, so the struct has to be zero initialized */
+#endif
 };
 
 #ifdef NK_INCLUDE_FONT_BAKING
@@ -3739,13 +4224,20 @@ struct nk_font_config {
 
     unsigned char ttf_data_owned_by_atlas;
     /* used inside font atlas: default to: 0*/
+    unsigned char ttf_data_mapped;
+    /* used inside font atlas: TTF blob is a read-only file mapping */
     unsigned char merge_mode;
     /* merges this font into the last font */
     unsigned char pixel_snap;
     /* align every character to pixel boundary (if true set oversample (1,1)) */
     unsigned char oversample_v, oversample_h;
     /* rasterize at hight quality for sub-pixel position */
-    unsigned char padding[3];
+    unsigned char sdf;
+    /* bake a signed distance field usable at any scale instead of coverage */
+    unsigned char sdf_spread;
+    /* pixels the distance field reaches outside of each glyph: default to: 4 */
+    unsigned char kerning;
+    /* apply kerning pairs of the font's `kern` table between baked glyphs */
 
     float size;
     /* baked pixel height of the font */
@@ -3770,6 +4262,19 @@ struct nk_font_glyph {
     float u0, v0, u1, v1;
 };
 
+struct nk_font_kerning {
+    nk_rune first, second;
+    float advance;
+};
+
+struct nk_font_glyph_range {
+    nk_rune first, last;
+    /* inclusive codepoint range */
+    nk_rune glyph;
+    /* index of the glyph of `first` inside the font glyph array */
+};
+
+struct nk_font_cache;
 struct nk_font {
     struct nk_font *next;
     struct nk_user_font handle;
@@ -3780,17 +4285,42 @@ struct nk_font {
     nk_rune fallback_codepoint;
     nk_handle texture;
     struct nk_font_config *config;
+    const struct nk_font_glyph *lookup[NK_FONT_LOOKUP_MAX];
+    /* glyphs of codepoints below NK_FONT_LOOKUP_MAX or 0 if not baked */
+    struct nk_font_glyph_range *ranges;
+    int range_count;
+    /* disjoint codepoint ranges of all configs sorted by codepoint */
+    struct nk_font_cache *cache;
+    /* glyph cache of atlases baked by `nk_font_atlas_bake_dynamic` */
+    struct nk_font_kerning *kerning;
+    nk_uint kerning_mask;
+    /* hash table of kerning pairs with `kerning_mask`+1 slots or 0 if none */
 };
 
 enum nk_font_atlas_format {
     NK_FONT_ATLAS_ALPHA8,
-    NK_FONT_ATLAS_RGBA32
+    NK_FONT_ATLAS_RGBA32,
+    NK_FONT_ATLAS_R8,
+    NK_FONT_ATLAS_BC4
+};
+
+enum nk_font_atlas_packing {
+    NK_FONT_ATLAS_PACK_DEFAULT,
+    /* skyline bottom-left font by font into a width of 512 or 1024 */
+    NK_FONT_ATLAS_PACK_SKYLINE,
+    /* skyline best-fit over the glyphs of all fonts */
+    NK_FONT_ATLAS_PACK_MAXRECTS,
+    /* maximal rectangles bottom-left over the glyphs of all fonts */
+    NK_FONT_ATLAS_PACK_BEST
+    /* tries both SKYLINE and MAXRECTS and keeps the smaller texture */
 };
 
 struct nk_font_atlas {
     void *pixel;
     int tex_width;
     int tex_height;
+    enum nk_font_atlas_format format;
+    enum nk_font_atlas_packing packing;
 
     struct nk_allocator permanent;
     struct nk_allocator temporary;
@@ -3800,6 +4330,10 @@ struct nk_font_atlas {
 
     int glyph_count;
     struct nk_font_glyph *glyphs;
+    struct nk_font_glyph_range *glyph_ranges;
+    struct nk_font_kerning *kerning;
+    int kerning_count;
+    struct nk_font_cache *cache;
     struct nk_font *default_font;
     struct nk_font *fonts;
     struct nk_font_config *config;
@@ -3827,9 +4361,17 @@ NK_API struct nk_font* nk_font_atlas_add_from_memory(struct nk_font_atlas *atlas
 #ifdef NK_INCLUDE_STANDARD_IO
 NK_API struct nk_font* nk_font_atlas_add_from_file(struct nk_font_atlas *atlas, const char *file_path, float height, const struct nk_font_config*);
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_API struct nk_font* nk_font_atlas_add_from_file_mapped(struct nk_font_atlas *atlas, const char *file_path, float height, const struct nk_font_config*);
+#endif
 NK_API struct nk_font *nk_font_atlas_add_compressed(struct nk_font_atlas*, void *memory, nk_size size, float height, const struct nk_font_config*);
 NK_API struct nk_font* nk_font_atlas_add_compressed_base85(struct nk_font_atlas*, const char *data, float height, const struct nk_font_config *config);
 NK_API const void* nk_font_atlas_bake(struct nk_font_atlas*, int *width, int *height, enum nk_font_atlas_format);
+NK_API const void* nk_font_atlas_bake_parallel(struct nk_font_atlas*, int *width, int *height, enum nk_font_atlas_format, nk_plugin_parallel_for, nk_handle userdata);
+NK_API const void* nk_font_atlas_bake_dynamic(struct nk_font_atlas*, int width, int height, enum nk_font_atlas_format);
+NK_API const void* nk_font_atlas_dirty(struct nk_font_atlas*, struct nk_recti *region);
+NK_API nk_size nk_font_atlas_save(const struct nk_font_atlas*, void *memory, nk_size size);
+NK_API const void* nk_font_atlas_load(struct nk_font_atlas*, const void *memory, nk_size size, int *width, int *height, enum nk_font_atlas_format);
 NK_API void nk_font_atlas_end(struct nk_font_atlas*, nk_handle tex, struct nk_draw_null_texture*);
 NK_API const struct nk_font_glyph* nk_font_find_glyph(struct nk_font*, nk_rune unicode);
 NK_API void nk_font_atlas_cleanup(struct nk_font_atlas *atlas);
@@ -3869,6 +4411,30 @@ NK_API void nk_font_atlas_clear(struct nk_font_atlas*);
     NK_INCLUDE_DEFAULT_ALLOCATOR which uses the standard library memory
     allocation functions malloc and free and takes over complete control over
     memory in this library.
+
+    Dynamic buffers only grow by default, so a single frame with a huge table
+    keeps its memory around for the lifetime of the buffer. `nk_buffer_trim_policy`
+    lets a buffer give memory back instead. Each `nk_buffer_clear` then marks the
+    end of a frame: the high-water mark of the frame is merged into one decaying
+    over `frames` frames, and once that mark stayed below `threshold` times the
+    buffer size for `frames` frames in a row the buffer is replaced by a smaller
+    one. Works for the context command buffer `ctx->memory` as well as for the
+    command, vertex and element buffers passed to `nk_convert`:
+
+        nk_buffer_init_default(&vertices);
+        nk_buffer_trim_policy(&vertices, 120, 0.25f);
+        nk_buffer_trim_policy(&ctx.memory, 120, 0.25f);
+
+    Growing a dynamic buffer copies everything allocated so far into the new
+    memory block, which shows up as a frame time spike the first time a heavy
+    view is opened. Chunked buffers from `nk_buffer_init_chunked` instead
+    continue in a newly allocated chunk and never move existing allocations.
+    Offsets keep counting across chunks, so only code resolving offsets into
+    pointers has to know about them. This only fits the context command buffer,
+    which is never read as one contiguous block: allocations have to fit into
+    a single chunk, only the front of the buffer is available and
+    `nk_buffer_memory` just returns the first chunk. `nk_buffer_clear` replaces
+    all chunks by one block big enough for all of them.
 */
 struct nk_memory_status {
     void *memory;
@@ -3881,7 +4447,8 @@ struct nk_memory_status {
 
 enum nk_allocation_type {
     NK_BUFFER_FIXED,
-    NK_BUFFER_DYNAMIC
+    NK_BUFFER_DYNAMIC,
+    NK_BUFFER_CHUNKED
 };
 
 enum nk_buffer_allocation_type {
@@ -3896,6 +4463,14 @@ struct nk_buffer_marker {
 };
 
 struct nk_memory {void *ptr;nk_size size;};
+struct nk_buffer_chunk {
+    struct nk_buffer_chunk *next;
+    /* previously allocated chunk */
+    nk_size offset;
+    /* buffer offset of the first byte inside the chunk */
+    nk_size size;
+    /* number of bytes following the chunk header */
+};
 struct nk_buffer {
     struct nk_buffer_marker marker[NK_BUFFER_MAX];
     /* buffer marker to free a buffer to a certain offset */
@@ -3915,6 +4490,16 @@ struct nk_buffer {
     /* number of allocation calls */
     nk_size size;
     /* current size of the buffer */
+    nk_size trim_peak;
+    /* high-water mark of used memory decaying each frame */
+    unsigned int trim_frames;
+    /* frames to decay over and to stay below the threshold, 0 disables trimming */
+    unsigned int trim_count;
+    /* frames the high-water mark has stayed below the threshold so far */
+    float trim_threshold;
+    /* fraction of the memory block the high-water mark has to stay below */
+    struct nk_buffer_chunk *chunk;
+    /* newest chunk a chunked buffer continued in after `memory` was full */
 };
 
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -3922,11 +4507,13 @@ NK_API void nk_buffer_init_default(struct nk_buffer*);
 #endif
 NK_API void nk_buffer_init(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_init_fixed(struct nk_buffer*, void *memory, nk_size size);
+NK_API void nk_buffer_init_chunked(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_info(struct nk_memory_status*, struct nk_buffer*);
 NK_API void nk_buffer_push(struct nk_buffer*, enum nk_buffer_allocation_type type, const void *memory, nk_size size, nk_size align);
 NK_API void nk_buffer_mark(struct nk_buffer*, enum nk_buffer_allocation_type type);
 NK_API void nk_buffer_reset(struct nk_buffer*, enum nk_buffer_allocation_type type);
 NK_API void nk_buffer_clear(struct nk_buffer*);
+NK_API void nk_buffer_trim_policy(struct nk_buffer*, unsigned int frames, float threshold);
 NK_API void nk_buffer_free(struct nk_buffer*);
 NK_API void *nk_buffer_memory(struct nk_buffer*);
 NK_API const void *nk_buffer_memory_const(const struct nk_buffer*);
@@ -4346,6 +4933,7 @@ struct nk_command_buffer {
     int use_clipping;
     nk_handle userdata;
     nk_size begin, end, last;
+    nk_hash hash; /* running hash over all finished commands */
 };
 
 /* shape outlines */
@@ -4504,6 +5092,8 @@ struct nk_draw_command {
     /* current screen clipping rectangle */
     nk_handle texture;
     /* current texture to set */
+    unsigned int vertex_offset;
+    /* vertex referenced by index 0 of this draw batch */
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     nk_handle userdata;
 #endif
@@ -4529,6 +5119,12 @@ struct nk_draw_list {
     enum nk_anti_aliasing line_AA;
     enum nk_anti_aliasing shape_AA;
 
+    /* offsets for layouts of float position, float uv and R8G8B8A8 color */
+    int vertex_packed;
+    nk_size position_offset;
+    nk_size uv_offset;
+    nk_size color_offset;
+
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     nk_handle userdata;
 #endif
@@ -5130,6 +5726,7 @@ struct nk_panel {
 #endif
 
 struct nk_table;
+struct nk_table_slot;
 enum nk_window_flags {
     NK_WINDOW_PRIVATE       = NK_FLAG(11),
     NK_WINDOW_DYNAMIC       = NK_WINDOW_PRIVATE,
@@ -5186,6 +5783,25 @@ struct nk_property_state {
     int state;
 };
 
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+struct nk_vertex_cache {
+    /* vertex output of a window for nk_convert */
+    struct nk_buffer commands;
+    struct nk_buffer vertices;
+    struct nk_buffer elements;
+    nk_hash key;
+    int valid;
+    struct nk_rect clip_rect;
+    nk_size cmd_offset;
+    unsigned int cmd_count, vertex_count, element_count;
+
+    /* draw list state in front of the window in the last frame */
+    struct nk_draw_command enter;
+    struct nk_rect enter_clip;
+    int enter_valid;
+};
+#endif
+
 struct nk_window {
     unsigned int seq;
     nk_hash name;
@@ -5197,6 +5813,11 @@ struct nk_window {
     struct nk_command_buffer buffer;
     struct nk_panel *layout;
     float scrollbar_hiding_timer;
+    nk_hash draw_hash;
+    int dirty;
+    struct nk_rect draw_bounds;
+    struct nk_rect damage_bounds;
+    unsigned int damage_order;
 
     /* persistent widget state */
     struct nk_property_state property;
@@ -5206,6 +5827,12 @@ struct nk_window {
 
     struct nk_table *tables;
     unsigned int table_count;
+    struct nk_table_slot *table_index;
+    unsigned int table_index_size;
+    unsigned int table_index_count;
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    struct nk_vertex_cache vertex_cache;
+#endif
 
     /* window list hooks */
     struct nk_window *next;
@@ -5318,6 +5945,15 @@ struct nk_table {
     struct nk_table *next, *prev;
 };
 
+/* open addressing hash index over all `nk_table` pages of a window. Each
+ * slot references a value by table page and offset inside the page and is
+ * empty if `tbl` is null. */
+struct nk_table_slot {
+    struct nk_table *tbl;
+    nk_hash key;
+    nk_uint index;
+};
+
 union nk_page_data {
     struct nk_table tbl;
     struct nk_panel pan;
@@ -5332,6 +5968,7 @@ struct nk_page_element {
 
 struct nk_page {
     unsigned int size;
+    unsigned int capacity;
     struct nk_page *next;
     struct nk_page_element win[1];
 };
@@ -5347,6 +5984,13 @@ struct nk_pool {
     nk_size cap;
 };
 
+/* open addressing hash index of all windows inside the window list
+ * by name hash. Slot is empty if `win` is null. */
+struct nk_window_slot {
+    struct nk_window *win;
+    nk_hash name;
+};
+
 struct nk_context {
 /* public: can be accessed freely */
     struct nk_input input;
@@ -5374,6 +6018,25 @@ struct nk_context {
     struct nk_text_edit text_edit;
     /* draw buffer used for overlay drawing operation like cursor */
     struct nk_command_buffer overlay;
+    /* hash over all draw commands of the last build frame */
+    nk_hash frame_hash;
+    int frame_dirty;
+    nk_hash overlay_hash;
+    struct nk_rect overlay_bounds;
+    struct nk_rect damage[NK_DAMAGE_MAX];
+    int damage_count;
+    /* second command buffer holding the previous frame if double buffered */
+    struct nk_buffer memory_prev;
+    struct nk_frame frame;
+    int double_buffered;
+    /* memory statistics, failed allocations are tracked per frame */
+    struct nk_memory_stats stats;
+    nk_size memory_failed;
+    nk_size memory_failed_base;
+    nk_size pool_failed;
+    int memory_assert;
+    char overflow_window[NK_WINDOW_MAX_NAME];
+    char largest_window[NK_WINDOW_MAX_NAME];
 
     /* windows */
     int build;
@@ -5386,6 +6049,9 @@ struct nk_context {
     struct nk_page_element *freelist;
     unsigned int count;
     unsigned int seq;
+    struct nk_window_slot *window_index;
+    unsigned int window_index_size;
+    unsigned int window_index_count;
 };
 
 /* ==============================================================
@@ -62,6 +62,43 @@ nk_buffer_init_fixed(struct nk_buffer *b, void *m, nk_size size)
     b->memory.size = size;
     b->size = size;
 }
+NK_API void
+nk_buffer_init_chunked(struct nk_buffer *b, const struct nk_allocator *a,
+    nk_size size)
+{
+    nk_buffer_init(b, a, size);
+    if (!b || !b->memory.ptr) return;
+    b->type = NK_BUFFER_CHUNKED;
+}
+NK_LIB const void*
+nk_buffer_chunk_at(const void *memory, const struct nk_buffer_chunk *chunk,
+    nk_size offset)
+{
+    /* chunks are linked newest first and each one continues the offsets
+     * of the one before, so the first chunk starting in front of the
+     * offset contains it */
+    while (chunk && offset < chunk->offset)
+        chunk = chunk->next;
+    if (!chunk) return nk_ptr_add_const(void, memory, offset);
+    return nk_ptr_add_const(void, chunk + 1, offset - chunk->offset);
+}
+NK_LIB void*
+nk_buffer_at(const struct nk_buffer *b, nk_size offset)
+{
+    NK_ASSERT(b);
+    if (!b->chunk) return nk_ptr_add(void, b->memory.ptr, offset);
+    return (void*)nk_buffer_chunk_at(b->memory.ptr, b->chunk, offset);
+}
+NK_INTERN void
+nk_buffer_free_chunks(struct nk_buffer *b, nk_size offset)
+{
+    /* frees all chunks starting at or behind the offset */
+    while (b->chunk && b->chunk->offset >= offset) {
+        struct nk_buffer_chunk *next = b->chunk->next;
+        b->pool.free(b->pool.userdata, b->chunk);
+        b->chunk = next;
+    }
+}
 NK_LIB void*
 nk_buffer_align(void *unaligned,
     nk_size align, nk_size *alignment,
@@ -130,6 +167,46 @@ nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size)
     }
     return temp;
 }
+NK_INTERN void*
+nk_buffer_alloc_chunked(struct nk_buffer *b, nk_size size, nk_size align)
+{
+    struct nk_buffer_chunk *chunk = b->chunk;
+    nk_size begin = (chunk) ? chunk->offset: 0;
+    nk_size capacity = (chunk) ? chunk->size: b->memory.size;
+    nk_size alignment;
+    void *unaligned;
+    void *memory;
+
+    unaligned = nk_buffer_at(b, b->allocated);
+    memory = nk_buffer_align(unaligned, align, &alignment, NK_BUFFER_FRONT);
+    if (b->allocated - begin + alignment + size > capacity) {
+        /* continue in a new chunk instead of moving everything allocated
+         * so far. Its offsets start where the next allocation would have
+         * been placed, so offsets computed up front by the caller hold */
+        struct nk_buffer_chunk *iter;
+        nk_size total = b->memory.size;
+        NK_ASSERT(b->pool.alloc && b->pool.free);
+        if (!b->pool.alloc || !b->pool.free) return 0;
+        for (iter = b->chunk; iter; iter = iter->next)
+            total += iter->size;
+        capacity = (nk_size)((float)total * (b->grow_factor - 1.0f));
+        capacity = NK_MAX(capacity, size + align);
+        chunk = (struct nk_buffer_chunk*)b->pool.alloc(b->pool.userdata, 0,
+            sizeof(struct nk_buffer_chunk) + capacity);
+        NK_ASSERT(chunk);
+        if (!chunk) return 0;
+        chunk->next = b->chunk;
+        chunk->offset = b->allocated + alignment;
+        chunk->size = capacity;
+        b->chunk = chunk;
+        memory = chunk + 1;
+        NK_ASSERT(!align || NK_ALIGN_PTR(memory, align) == memory);
+    }
+    b->allocated += size + alignment;
+    b->needed += alignment;
+    b->calls++;
+    return memory;
+}
 NK_LIB void*
 nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     nk_size size, nk_size align)
@@ -143,6 +220,12 @@ nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     NK_ASSERT(size);
     if (!b || !size) return 0;
     b->needed += size;
+    if (b->type == NK_BUFFER_CHUNKED) {
+        /* back allocations would have to move on every new chunk */
+        NK_ASSERT(type == NK_BUFFER_FRONT);
+        if (type != NK_BUFFER_FRONT) return 0;
+        return nk_buffer_alloc_chunked(b, size, align);
+    }
 
     /* calculate total size with needed alignment + size */
     if (type == NK_BUFFER_FRONT)
@@ -205,6 +288,11 @@ nk_buffer_reset(struct nk_buffer *buffer, enum nk_buffer_allocation_type type)
 {
     NK_ASSERT(buffer);
     if (!buffer) return;
+    if (buffer->trim_frames) {
+        /* memory released before the end of the frame still counts */
+        nk_size used = buffer->allocated + (buffer->memory.size - buffer->size);
+        buffer->trim_peak = NK_MAX(buffer->trim_peak, used);
+    }
     if (type == NK_BUFFER_BACK) {
         /* reset back buffer either back to marker or empty */
         buffer->needed -= (buffer->memory.size - buffer->marker[type].offset);
@@ -219,13 +307,77 @@ nk_buffer_reset(struct nk_buffer *buffer, enum nk_buffer_allocation_type type)
             buffer->allocated = buffer->marker[type].offset;
         else buffer->allocated = 0;
         buffer->marker[type].active = nk_false;
+        if (buffer->type == NK_BUFFER_CHUNKED)
+            nk_buffer_free_chunks(buffer, buffer->allocated);
     }
 }
+NK_INTERN void
+nk_buffer_trim(struct nk_buffer *b)
+{
+    nk_size used = b->allocated + (b->memory.size - b->size);
+    nk_size capacity;
+    void *memory;
+
+    b->trim_peak -= b->trim_peak / b->trim_frames;
+    b->trim_peak = NK_MAX(b->trim_peak, used);
+    if ((float)b->trim_peak >= (float)b->memory.size * b->trim_threshold) {
+        b->trim_count = 0;
+        return;
+    }
+    if (++b->trim_count < b->trim_frames) return;
+    b->trim_count = 0;
+
+    /* buffer is about to be cleared so nothing has to be copied. Twice the
+     * high-water mark leaves room to grow back without reallocating */
+    capacity = (nk_size)nk_round_up_pow2((nk_uint)b->trim_peak) * 2;
+    capacity = NK_MAX(capacity, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    if (capacity >= b->memory.size) return;
+    memory = b->pool.alloc(b->pool.userdata, 0, capacity);
+    if (!memory) return;
+    b->pool.free(b->pool.userdata, b->memory.ptr);
+    b->memory.ptr = memory;
+    b->memory.size = capacity;
+}
+NK_API void
+nk_buffer_trim_policy(struct nk_buffer *b, unsigned int frames,
+    float threshold)
+{
+    NK_ASSERT(b);
+    NK_ASSERT(threshold > 0.0f && threshold <= 1.0f);
+    if (!b) return;
+    b->trim_frames = frames;
+    b->trim_threshold = NK_CLAMP(0.0f, threshold, 1.0f);
+    b->trim_count = 0;
+    b->trim_peak = b->allocated + (b->memory.size - b->size);
+}
+NK_INTERN void
+nk_buffer_merge_chunks(struct nk_buffer *b)
+{
+    /* buffer is about to be cleared so nothing has to be copied and the
+     * next frame of the same size fits into a single block again */
+    struct nk_buffer_chunk *iter;
+    nk_size capacity = b->memory.size;
+    void *memory;
+    for (iter = b->chunk; iter; iter = iter->next)
+        capacity += iter->size;
+    nk_buffer_free_chunks(b, 0);
+    memory = b->pool.alloc(b->pool.userdata, 0, capacity);
+    if (!memory) return;
+    b->pool.free(b->pool.userdata, b->memory.ptr);
+    b->memory.ptr = memory;
+    b->memory.size = capacity;
+    b->size = capacity;
+}
 NK_API void
 nk_buffer_clear(struct nk_buffer *b)
 {
     NK_ASSERT(b);
     if (!b) return;
+    if (b->chunk)
+        nk_buffer_merge_chunks(b);
+    if (b->trim_frames && b->type != NK_BUFFER_FIXED &&
+        b->pool.alloc && b->pool.free)
+        nk_buffer_trim(b);
     b->allocated = 0;
     b->size = b->memory.size;
     b->calls = 0;
@@ -239,6 +391,7 @@ nk_buffer_free(struct nk_buffer *b)
     if (b->type == NK_BUFFER_FIXED) return;
     if (!b->pool.free) return;
     NK_ASSERT(b->pool.free);
+    nk_buffer_free_chunks(b, 0);
     b->pool.free(b->pool.userdata, b->memory.ptr);
 }
 NK_API void
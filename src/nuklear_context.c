@@ -87,15 +87,27 @@ nk_set_user_data(struct nk_context *ctx, nk_handle handle)
 NK_API void
 nk_free(struct nk_context *ctx)
 {
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    struct nk_window *iter;
+#endif
     NK_ASSERT(ctx);
     if (!ctx) return;
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    for (iter = ctx->begin; iter; iter = iter->next)
+        nk_vertex_cache_free(&iter->vertex_cache);
+#endif
     nk_buffer_free(&ctx->memory);
+    if (ctx->double_buffered)
+        nk_buffer_free(&ctx->memory_prev);
     if (ctx->use_pool)
         nk_pool_free(&ctx->pool);
 
     nk_zero(&ctx->input, sizeof(ctx->input));
     nk_zero(&ctx->style, sizeof(ctx->style));
     nk_zero(&ctx->memory, sizeof(ctx->memory));
+    nk_zero(&ctx->memory_prev, sizeof(ctx->memory_prev));
+    nk_zero(&ctx->frame, sizeof(ctx->frame));
+    ctx->double_buffered = 0;
 
     ctx->seq = 0;
     ctx->build = 0;
@@ -105,6 +117,174 @@ nk_free(struct nk_context *ctx)
     ctx->current = 0;
     ctx->freelist = 0;
     ctx->count = 0;
+    ctx->window_index = 0;
+    ctx->window_index_size = 0;
+    ctx->window_index_count = 0;
+}
+NK_API nk_size
+nk_shrink(struct nk_context *ctx)
+{
+    unsigned int released = 0;
+    int window_index;
+    struct nk_window *iter;
+    nk_size bytes;
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return 0;
+    if (ctx->pool.type == NK_BUFFER_FIXED) return 0;
+
+    /* indices sized for a burst of windows or tables keep the pages they
+     * were carved from alive, so free them if less than a quarter full
+     * and rebuild them at a fitting size after empty pages are gone */
+    window_index = ctx->window_index && ctx->window_index_size > 32 &&
+        ctx->window_index_count * 4 < ctx->window_index_size;
+    if (window_index)
+        nk_window_index_free(ctx);
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->table_index && iter->table_index_size > 64 &&
+            iter->table_index_count * 4 < iter->table_index_size)
+            nk_table_index_free(ctx, iter);
+    }
+    bytes = nk_pool_shrink(&ctx->pool, &ctx->freelist, &released);
+    ctx->stats.page_elements -= released;
+    if (window_index)
+        nk_window_index_rebuild(ctx);
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (!iter->table_index)
+            nk_table_index_rebuild(ctx, iter);
+    }
+    return bytes;
+}
+NK_API int
+nk_double_buffer(struct nk_context *ctx, struct nk_buffer *memory)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || ctx->double_buffered) return 0;
+    /* fixed contexts keep their pages at the back of the command buffer */
+    if (!ctx->use_pool) return 0;
+    if (memory) {
+        ctx->memory_prev = *memory;
+    } else if (ctx->memory.type != NK_BUFFER_FIXED && ctx->memory.memory.size) {
+        nk_buffer_init(&ctx->memory_prev, &ctx->memory.pool, ctx->memory.memory.size);
+        if (!ctx->memory_prev.memory.ptr) return 0;
+        ctx->memory_prev.type = ctx->memory.type;
+    } else return 0;
+    ctx->double_buffered = nk_true;
+    return 1;
+}
+NK_INTERN nk_size
+nk_memory_failed(const struct nk_context *ctx)
+{
+    /* `needed` also counts requests the buffer could not serve */
+    const struct nk_buffer *b = &ctx->memory;
+    nk_size used = b->allocated + (b->memory.size - b->size);
+    nk_size failed = (b->needed > used) ? b->needed - used: 0;
+    failed = (failed > ctx->memory_failed_base) ? failed - ctx->memory_failed_base: 0;
+    return failed + ctx->pool_failed;
+}
+NK_LIB void
+nk_memory_check(struct nk_context *ctx, const char *name)
+{
+    nk_size failed;
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    failed = nk_memory_failed(ctx);
+    if (failed <= ctx->memory_failed) return;
+    ctx->memory_failed = failed;
+    if (!ctx->stats.overflows++ && name) {
+        nk_size len = NK_MIN((nk_size)nk_strlen(name), NK_WINDOW_MAX_NAME-1);
+        NK_MEMCPY(ctx->overflow_window, name, len);
+        ctx->overflow_window[len] = 0;
+    }
+    NK_ASSERT(!ctx->memory_assert && "out of memory, see `overflow_window` of `nk_memory_stats`");
+}
+NK_INTERN void
+nk_memory_record(struct nk_context *ctx)
+{
+    struct nk_memory_stats *s = &ctx->stats;
+    const struct nk_window *iter;
+    nk_size needed;
+
+    /* catch anything that ran out of memory outside of windows */
+    nk_memory_check(ctx, 0);
+    s->frames++;
+    s->command_bytes = ctx->memory.allocated;
+    s->command_peak = NK_MAX(s->command_peak, s->command_bytes);
+    needed = ctx->memory.allocated + ctx->memory_failed;
+    s->command_needed = NK_MAX(s->command_needed, needed);
+    s->page_elements_peak = NK_MAX(s->page_elements_peak, s->page_elements);
+
+    s->largest_window_bytes = 0;
+    ctx->largest_window[0] = 0;
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        nk_size bytes = iter->buffer.end - iter->buffer.begin;
+        if (iter->seq != ctx->seq || (iter->flags & NK_WINDOW_HIDDEN) ||
+            bytes <= s->largest_window_bytes) continue;
+        s->largest_window_bytes = bytes;
+        NK_MEMCPY(ctx->largest_window, iter->name_string, NK_WINDOW_MAX_NAME);
+    }
+}
+NK_API void
+nk_memory_stats(const struct nk_context *ctx, struct nk_memory_stats *stats)
+{
+    const struct nk_page_element *iter;
+    NK_ASSERT(ctx);
+    NK_ASSERT(stats);
+    if (!ctx || !stats) return;
+
+    *stats = ctx->stats;
+    stats->page_elements_peak = NK_MAX(stats->page_elements_peak, stats->page_elements);
+    for (iter = ctx->freelist; iter; iter = iter->next)
+        stats->page_elements_free++;
+    stats->largest_window = (ctx->largest_window[0]) ? ctx->largest_window: 0;
+    stats->overflow_window = (ctx->overflow_window[0]) ? ctx->overflow_window: 0;
+    /* fixed contexts allocate commands from the front and page elements from
+     * the back of the same block, which might need one extra alignment step */
+    if (stats->frames) {
+        stats->suggested_fixed_size = stats->command_needed +
+            stats->page_elements_peak * sizeof(struct nk_page_element) +
+            NK_ALIGNOF(struct nk_page_element);
+    }
+}
+NK_API void
+nk_memory_stats_reset(struct nk_context *ctx)
+{
+    unsigned int page_elements;
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    page_elements = ctx->stats.page_elements;
+    nk_zero_struct(ctx->stats);
+    ctx->stats.page_elements = page_elements;
+    ctx->stats.page_elements_peak = page_elements;
+    ctx->overflow_window[0] = 0;
+    ctx->largest_window[0] = 0;
+}
+NK_API void
+nk_memory_assert_on_overflow(struct nk_context *ctx, int enable)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    ctx->memory_assert = enable;
+}
+NK_API int
+nk_chunked_commands(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return 0;
+    if (ctx->memory.type == NK_BUFFER_FIXED) return 0;
+    /* existing memory simply becomes the first chunk */
+    ctx->memory.type = NK_BUFFER_CHUNKED;
+    if (ctx->double_buffered)
+        ctx->memory_prev.type = NK_BUFFER_CHUNKED;
+    return 1;
+}
+NK_INTERN struct nk_window*
+nk_first_drawn_window(struct nk_context *ctx)
+{
+    struct nk_window *iter = ctx->begin;
+    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
+        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
+        iter = iter->next;
+    return iter;
 }
 NK_API void
 nk_clear(struct nk_context *ctx)
@@ -114,9 +294,30 @@ nk_clear(struct nk_context *ctx)
     NK_ASSERT(ctx);
 
     if (!ctx) return;
+    nk_memory_record(ctx);
+    if (ctx->double_buffered) {
+        /* keep the finished frame untouched for `nk_frame_previous` and
+         * build the next frame into the other buffer */
+        const struct nk_command *cmd = nk__begin(ctx);
+        struct nk_buffer memory = ctx->memory;
+        ctx->frame.memory = memory.memory.ptr;
+        ctx->frame.chunk = memory.chunk;
+        ctx->frame.end = memory.allocated;
+        ctx->frame.begin = (cmd) ? nk_first_drawn_window(ctx)->buffer.begin: memory.allocated;
+        ctx->memory = ctx->memory_prev;
+        ctx->memory_prev = memory;
+        /* both buffers follow the trim policy set on `ctx->memory` */
+        ctx->memory.trim_frames = memory.trim_frames;
+        ctx->memory.trim_threshold = memory.trim_threshold;
+    }
     if (ctx->use_pool)
         nk_buffer_clear(&ctx->memory);
     else nk_buffer_reset(&ctx->memory, NK_BUFFER_FRONT);
+    /* failed requests of a fixed buffer stay in `needed` after a reset */
+    ctx->memory_failed = 0;
+    ctx->memory_failed_base = 0;
+    ctx->pool_failed = 0;
+    ctx->memory_failed_base = nk_memory_failed(ctx);
 
     ctx->build = 0;
     ctx->memory.calls = 0;
@@ -140,8 +341,10 @@ nk_clear(struct nk_context *ctx)
             iter == ctx->active) {
             ctx->active = iter->prev;
             ctx->end = iter->prev;
-            if (!ctx->end)
+            if (!ctx->end) {
                 ctx->begin = 0;
+                nk_window_index_free(ctx);
+            }
             if (ctx->active)
                 ctx->active->flags &= ~(unsigned)NK_WINDOW_ROM;
         }
@@ -152,6 +355,7 @@ nk_clear(struct nk_context *ctx)
         }
         /* remove unused window state tables */
         {struct nk_table *n, *it = iter->tables;
+        int removed = nk_false;
         while (it) {
             n = it->next;
             if (it->seq != ctx->seq) {
@@ -160,8 +364,11 @@ nk_clear(struct nk_context *ctx)
                 nk_free_table(ctx, it);
                 if (it == iter->tables)
                     iter->tables = n;
+                removed = nk_true;
             } it = n;
-        }}
+        }
+        if (removed && iter->table_index)
+            nk_table_index_rebuild(ctx, iter);}
         /* window itself is not used anymore so free */
         if (iter->seq != ctx->seq || iter->flags & NK_WINDOW_CLOSED) {
             next = iter->next;
@@ -182,6 +389,7 @@ nk_start_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
     buffer->end = buffer->begin;
     buffer->last = buffer->begin;
     buffer->clip = nk_null_rect;
+    buffer->hash = 0;
 }
 NK_LIB void
 nk_start(struct nk_context *ctx, struct nk_window *win)
@@ -189,6 +397,7 @@ nk_start(struct nk_context *ctx, struct nk_window *win)
     NK_ASSERT(ctx);
     NK_ASSERT(win);
     nk_start_buffer(ctx, &win->buffer);
+    win->draw_bounds = win->bounds;
 }
 NK_LIB void
 nk_start_popup(struct nk_context *ctx, struct nk_window *win)
@@ -224,6 +433,8 @@ nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
     NK_ASSERT(ctx);
     NK_ASSERT(buffer);
     if (!ctx || !buffer) return;
+    if (buffer->end != buffer->begin)
+        nk_command_buffer_hash(buffer, ctx->memory.allocated);
     buffer->end = ctx->memory.allocated;
 }
 NK_LIB void
@@ -231,7 +442,6 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
 {
     struct nk_popup_buffer *buf;
     struct nk_command *parent_last;
-    void *memory;
 
     NK_ASSERT(ctx);
     NK_ASSERT(win);
@@ -240,22 +450,98 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
     if (!win->popup.buf.active) return;
 
     buf = &win->popup.buf;
-    memory = ctx->memory.memory.ptr;
-    parent_last = nk_ptr_add(struct nk_command, memory, buf->parent);
+    parent_last = (struct nk_command*)nk_buffer_at(&ctx->memory, buf->parent);
     parent_last->next = buf->end;
 }
+NK_INTERN void
+nk_damage_add(struct nk_context *ctx, struct nk_rect r)
+{
+    int i;
+    float pad = ctx->style.window.border + 1.0f;
+    if (r.w <= 0 || r.h <= 0) return;
+    r.x -= pad; r.y -= pad;
+    r.w += 2 * pad; r.h += 2 * pad;
+
+    /* merge with every overlapping damage rectangle */
+    for (i = 0; i < ctx->damage_count;) {
+        struct nk_rect *d = &ctx->damage[i];
+        if (NK_INTERSECT(r.x, r.y, r.w, r.h, d->x, d->y, d->w, d->h)) {
+            r = nk_merge_rect(r, *d);
+            *d = ctx->damage[--ctx->damage_count];
+            i = 0;
+        } else i++;
+    }
+    if (ctx->damage_count < NK_DAMAGE_MAX) {
+        ctx->damage[ctx->damage_count++] = r;
+    } else {
+        /* out of rectangles so grow the one which grows the least */
+        int best = 0;
+        float best_growth = 0;
+        for (i = 0; i < ctx->damage_count; ++i) {
+            struct nk_rect *d = &ctx->damage[i];
+            struct nk_rect m = nk_merge_rect(r, *d);
+            float growth = m.w * m.h - d->w * d->h;
+            if (!i || growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        ctx->damage[best] = nk_merge_rect(r, ctx->damage[best]);
+    }
+}
+NK_INTERN void
+nk_build_hash(struct nk_context *ctx, struct nk_rect cursor)
+{
+    struct nk_window *it;
+    unsigned int order = 0;
+    nk_hash frame = 0;
+    nk_hash overlay = 0;
+
+    /* compare each window's draw commands against the last frame */
+    ctx->damage_count = 0;
+    for (it = ctx->begin; it; it = it->next) {
+        nk_hash hash = 0;
+        if (!(it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
+            it->seq != ctx->seq)) {
+            hash = it->buffer.hash;
+            frame = nk_command_hash(frame, &it->name, sizeof(it->name));
+            frame = nk_command_hash(frame, &hash, sizeof(hash));
+            order++;
+        }
+        it->dirty = (it->draw_hash != hash);
+        if (it->dirty || (hash && it->damage_order != order)) {
+            /* redraw old and new area on content or z-order change */
+            if (it->draw_hash) nk_damage_add(ctx, it->damage_bounds);
+            if (hash) nk_damage_add(ctx, it->draw_bounds);
+        }
+        it->draw_hash = hash;
+        it->damage_bounds = it->draw_bounds;
+        it->damage_order = order;
+    }
+    if (ctx->overlay.end != ctx->overlay.begin) {
+        overlay = ctx->overlay.hash;
+        frame = nk_command_hash(frame, &overlay, sizeof(overlay));
+    }
+    if (ctx->overlay_hash != overlay) {
+        if (ctx->overlay_hash) nk_damage_add(ctx, ctx->overlay_bounds);
+        if (overlay) nk_damage_add(ctx, cursor);
+    }
+    ctx->overlay_hash = overlay;
+    ctx->overlay_bounds = cursor;
+    ctx->frame_dirty = (ctx->frame_hash != frame);
+    ctx->frame_hash = frame;
+}
 NK_LIB void
 nk_build(struct nk_context *ctx)
 {
     struct nk_window *it = 0;
     struct nk_command *cmd = 0;
-    nk_byte *buffer = 0;
+    struct nk_rect mouse_bounds = {0,0,0,0};
 
     /* draw cursor overlay */
     if (!ctx->style.cursor_active)
         ctx->style.cursor_active = ctx->style.cursors[NK_CURSOR_ARROW];
     if (ctx->style.cursor_active && !ctx->input.mouse.grabbed && ctx->style.cursor_visible) {
-        struct nk_rect mouse_bounds;
         const struct nk_cursor *cursor = ctx->style.cursor_active;
         nk_command_buffer_init(&ctx->overlay, &ctx->memory, NK_CLIPPING_OFF);
         nk_start_buffer(ctx, &ctx->overlay);
@@ -268,16 +554,17 @@ nk_build(struct nk_context *ctx)
         nk_draw_image(&ctx->overlay, mouse_bounds, &cursor->img, nk_white);
         nk_finish_buffer(ctx, &ctx->overlay);
     }
+    nk_build_hash(ctx, mouse_bounds);
+
     /* build one big draw command list out of all window buffers */
     it = ctx->begin;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     while (it != 0) {
         struct nk_window *next = it->next;
         if (it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
             it->seq != ctx->seq)
             goto cont;
 
-        cmd = nk_ptr_add(struct nk_command, buffer, it->buffer.last);
+        cmd = (struct nk_command*)nk_buffer_at(&ctx->memory, it->buffer.last);
         while (next && ((next->buffer.last == next->buffer.begin) ||
             (next->flags & NK_WINDOW_HIDDEN) || next->seq != ctx->seq))
             next = next->next; /* skip empty command buffers */
@@ -295,7 +582,7 @@ nk_build(struct nk_context *ctx)
 
         buf = &it->popup.buf;
         cmd->next = buf->begin;
-        cmd = nk_ptr_add(struct nk_command, buffer, buf->last);
+        cmd = (struct nk_command*)nk_buffer_at(&ctx->memory, buf->last);
         buf->active = nk_false;
         skip: it = next;
     }
@@ -310,35 +597,75 @@ NK_API const struct nk_command*
 nk__begin(struct nk_context *ctx)
 {
     struct nk_window *iter;
-    nk_byte *buffer;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
     if (!ctx->count) return 0;
 
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     if (!ctx->build) {
         nk_build(ctx);
         ctx->build = nk_true;
     }
-    iter = ctx->begin;
-    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
-        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
-        iter = iter->next;
+    iter = nk_first_drawn_window(ctx);
     if (!iter) return 0;
-    return nk_ptr_add_const(struct nk_command, buffer, iter->buffer.begin);
+    return (const struct nk_command*)nk_buffer_at(&ctx->memory, iter->buffer.begin);
 }
 
+NK_API int
+nk_frame_is_dirty(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return 1;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    return ctx->frame_dirty;
+}
+NK_API const struct nk_rect*
+nk_frame_damage(struct nk_context *ctx, int *count)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(count);
+    if (!ctx || !count) return 0;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    *count = ctx->damage_count;
+    return ctx->damage;
+}
 NK_API const struct nk_command*
 nk__next(struct nk_context *ctx, const struct nk_command *cmd)
 {
-    nk_byte *buffer;
     const struct nk_command *next;
     NK_ASSERT(ctx);
     if (!ctx || !cmd || !ctx->count) return 0;
     if (cmd->next >= ctx->memory.allocated) return 0;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
-    next = nk_ptr_add_const(struct nk_command, buffer, cmd->next);
+    next = (const struct nk_command*)nk_buffer_at(&ctx->memory, cmd->next);
     return next;
 }
+NK_API struct nk_frame
+nk_frame_previous(const struct nk_context *ctx)
+{
+    struct nk_frame frame;
+    NK_ASSERT(ctx);
+    nk_zero_struct(frame);
+    if (!ctx || !ctx->double_buffered) return frame;
+    return ctx->frame;
+}
+NK_API const struct nk_command*
+nk__frame_begin(const struct nk_frame *frame)
+{
+    NK_ASSERT(frame);
+    if (!frame || !frame->memory || frame->begin >= frame->end) return 0;
+    return (const struct nk_command*)nk_buffer_chunk_at(frame->memory, frame->chunk, frame->begin);
+}
+NK_API const struct nk_command*
+nk__frame_next(const struct nk_frame *frame, const struct nk_command *cmd)
+{
+    NK_ASSERT(frame);
+    if (!frame || !cmd || cmd->next >= frame->end) return 0;
+    return (const struct nk_command*)nk_buffer_chunk_at(frame->memory, frame->chunk, cmd->next);
+}
 
 
@@ -18,6 +18,7 @@ nk_command_buffer_init(struct nk_command_buffer *cb,
     cb->begin = b->allocated;
     cb->end = b->allocated;
     cb->last = b->allocated;
+    cb->hash = 0;
 }
 NK_LIB void
 nk_command_buffer_reset(struct nk_command_buffer *b)
@@ -27,11 +28,46 @@ nk_command_buffer_reset(struct nk_command_buffer *b)
     b->begin = 0;
     b->end = 0;
     b->last = 0;
+    b->hash = 0;
     b->clip = nk_null_rect;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     b->userdata.ptr = 0;
 #endif
 }
+NK_LIB nk_hash
+nk_command_hash(nk_hash hash, const void *ptr, nk_size size)
+{
+    const nk_byte *data = (const nk_byte*)ptr;
+    nk_uint word;
+    while (size >= sizeof(word)) {
+        NK_MEMCPY(&word, data, sizeof(word));
+        hash = (hash ^ word) * 16777619u;
+        hash ^= hash >> 16;
+        data += sizeof(word);
+        size -= sizeof(word);
+    }
+    while (size--) {
+        hash = (hash ^ *data++) * 16777619u;
+        hash ^= hash >> 16;
+    }
+    return hash;
+}
+NK_LIB void
+nk_command_buffer_hash(struct nk_command_buffer *b, nk_size end)
+{
+    /* folds the last command into the buffer hash. The `next` offset
+     * is skipped since it depends on everything drawn before. */
+    const struct nk_command *cmd;
+    NK_ASSERT(b);
+    NK_ASSERT(b->base);
+    NK_ASSERT(end >= b->last + sizeof(*cmd));
+    cmd = (const struct nk_command*)nk_buffer_at(b->base, b->last);
+    b->hash = nk_command_hash(b->hash, &cmd->type, sizeof(cmd->type));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    b->hash = nk_command_hash(b->hash, &cmd->userdata, sizeof(cmd->userdata));
+#endif
+    b->hash = nk_command_hash(b->hash, cmd + 1, end - b->last - sizeof(*cmd));
+}
 NK_LIB void*
 nk_command_buffer_push(struct nk_command_buffer* b,
     enum nk_command_type t, nk_size size)
@@ -39,22 +75,31 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_command);
     struct nk_command *cmd;
     nk_size alignment;
+    nk_size prev_end;
     void *unaligned;
     void *memory;
 
     NK_ASSERT(b);
     NK_ASSERT(b->base);
     if (!b) return 0;
+    prev_end = b->base->allocated;
     cmd = (struct nk_command*)nk_buffer_alloc(b->base,NK_BUFFER_FRONT,size,align);
     if (!cmd) return 0;
 
+    /* previous command is complete so add it to the buffer hash */
+    if (b->end != b->begin)
+        nk_command_buffer_hash(b, prev_end);
+
     /* make sure the offset to the next command is aligned */
-    b->last = (nk_size)((nk_byte*)cmd - (nk_byte*)b->base->memory.ptr);
+    b->last = b->base->allocated - size;
     unaligned = (nk_byte*)cmd + size;
     memory = NK_ALIGN_PTR(unaligned, align);
     alignment = (nk_size)((nk_byte*)memory - (nk_byte*)unaligned);
 #ifdef NK_ZERO_COMMAND_MEMORY
     NK_MEMSET(cmd, 0, size + alignment);
+#else
+    /* padding is hashed as well so it has to be deterministic */
+    NK_MEMSET(cmd, 0, size);
 #endif
 
     cmd->type = t;
@@ -369,6 +369,142 @@ nk_rp_pack_rects(struct nk_rp_context *context, struct nk_rp_rect *rects, int nu
         rects[i].was_packed = !(rects[i].x == NK_RP__MAXVAL && rects[i].y == NK_RP__MAXVAL);
 }
 
+/* maximal rectangles packer keeping a list of all maximal free rectangles
+ * and placing each rect bottom-left into one of them (Jukka Jylanki 2010) */
+struct nk_rp_free_rect {
+    int x, y, w, h;
+};
+struct nk_rp_maxrects {
+    struct nk_allocator alloc;
+    struct nk_rp_free_rect *free_rects;
+    int count, capacity;
+};
+NK_INTERN int
+nk_rp_maxrects_init(struct nk_rp_maxrects *mr, int width, int height,
+    struct nk_allocator *alloc)
+{
+    nk_zero_struct(*mr);
+    mr->alloc = *alloc;
+    mr->capacity = 256;
+    mr->free_rects = (struct nk_rp_free_rect*)alloc->alloc(alloc->userdata, 0,
+        sizeof(struct nk_rp_free_rect) * (nk_size)mr->capacity);
+    if (!mr->free_rects) return nk_false;
+    mr->free_rects[0].x = mr->free_rects[0].y = 0;
+    mr->free_rects[0].w = width;
+    mr->free_rects[0].h = height;
+    mr->count = 1;
+    return nk_true;
+}
+NK_INTERN void
+nk_rp_maxrects_cleanup(struct nk_rp_maxrects *mr)
+{
+    if (mr->free_rects)
+        mr->alloc.free(mr->alloc.userdata, mr->free_rects);
+    mr->free_rects = 0;
+}
+NK_INTERN int
+nk_rp_maxrects_push(struct nk_rp_maxrects *mr, int x, int y, int w, int h)
+{
+    struct nk_rp_free_rect *r;
+    if (mr->count == mr->capacity) {
+        struct nk_rp_free_rect *rects = (struct nk_rp_free_rect*)
+            mr->alloc.alloc(mr->alloc.userdata, 0, sizeof(struct nk_rp_free_rect) *
+                (nk_size)mr->capacity * 2);
+        if (!rects) return nk_false;
+        NK_MEMCPY(rects, mr->free_rects, sizeof(struct nk_rp_free_rect) * (nk_size)mr->count);
+        mr->alloc.free(mr->alloc.userdata, mr->free_rects);
+        mr->free_rects = rects;
+        mr->capacity *= 2;
+    }
+    r = &mr->free_rects[mr->count++];
+    r->x = x; r->y = y;
+    r->w = w; r->h = h;
+    return nk_true;
+}
+NK_INTERN int
+nk_rp_maxrects_contains(const struct nk_rp_free_rect *a, const struct nk_rp_free_rect *b)
+{
+    return b->x >= a->x && b->y >= a->y &&
+        b->x + b->w <= a->x + a->w && b->y + b->h <= a->y + a->h;
+}
+NK_INTERN int
+nk_rp_maxrects_insert(struct nk_rp_maxrects *mr, int w, int h, int *x, int *y)
+{
+    int i, j, n, best = -1;
+    int best_top = 0, best_x = 0;
+
+    /* bottom-left: lowest resulting top edge, then leftmost position */
+    for (i = 0; i < mr->count; ++i) {
+        const struct nk_rp_free_rect *f = &mr->free_rects[i];
+        if (f->w < w || f->h < h) continue;
+        if (best < 0 || f->y + h < best_top || (f->y + h == best_top && f->x < best_x)) {
+            best = i;
+            best_top = f->y + h;
+            best_x = f->x;
+        }
+    }
+    if (best < 0) return nk_false;
+    *x = mr->free_rects[best].x;
+    *y = mr->free_rects[best].y;
+
+    /* split all free rects overlapping the placed rect into the up to four
+     * maximal rects around it. Removed rects are marked by a zero width */
+    n = mr->count;
+    for (i = 0; i < n; ++i) {
+        struct nk_rp_free_rect f = mr->free_rects[i];
+        if (!f.w || *x >= f.x + f.w || *x + w <= f.x || *y >= f.y + f.h || *y + h <= f.y)
+            continue;
+        mr->free_rects[i].w = 0;
+        if (*x > f.x && !nk_rp_maxrects_push(mr, f.x, f.y, *x - f.x, f.h))
+            return nk_false;
+        if (*x + w < f.x + f.w && !nk_rp_maxrects_push(mr, *x + w, f.y, f.x + f.w - (*x + w), f.h))
+            return nk_false;
+        if (*y > f.y && !nk_rp_maxrects_push(mr, f.x, f.y, f.w, *y - f.y))
+            return nk_false;
+        if (*y + h < f.y + f.h && !nk_rp_maxrects_push(mr, f.x, *y + h, f.w, f.y + f.h - (*y + h)))
+            return nk_false;
+    }
+    /* only new rects can be contained in another one since the old ones
+     * were maximal before and new rects are parts of removed old ones */
+    for (i = n; i < mr->count; ++i) {
+        for (j = 0; j < mr->count; ++j) {
+            if (i == j || !mr->free_rects[j].w) continue;
+            if (nk_rp_maxrects_contains(&mr->free_rects[j], &mr->free_rects[i])) {
+                mr->free_rects[i].w = 0;
+                break;
+            }
+        }
+    }
+    for (i = 0, j = 0; i < mr->count; ++i) {
+        if (mr->free_rects[i].w)
+            mr->free_rects[j++] = mr->free_rects[i];
+    }
+    mr->count = j;
+    return nk_true;
+}
+NK_INTERN int
+nk_rp_maxrects_pack_rects(struct nk_rp_maxrects *mr, struct nk_rp_rect *rects, int num_rects)
+{
+    int i, all_packed = nk_true;
+    for (i=0; i < num_rects; ++i)
+        rects[i].was_packed = i;
+    nk_rp_qsort(rects, (unsigned)num_rects, nk_rect_height_compare);
+    for (i=0; i < num_rects; ++i) {
+        int x, y;
+        if (all_packed && nk_rp_maxrects_insert(mr, rects[i].w, rects[i].h, &x, &y)) {
+            rects[i].x = (nk_rp_coord)x;
+            rects[i].y = (nk_rp_coord)y;
+        } else {
+            rects[i].x = rects[i].y = NK_RP__MAXVAL;
+            all_packed = nk_false;
+        }
+    }
+    nk_rp_qsort(rects, (unsigned)num_rects, nk_rect_original_order);
+    for (i=0; i < num_rects; ++i)
+        rects[i].was_packed = !(rects[i].x == NK_RP__MAXVAL && rects[i].y == NK_RP__MAXVAL);
+    return all_packed;
+}
+
 /*
  * ==============================================================
  *
@@ -408,6 +544,8 @@ struct nk_tt_pack_range {
     struct nk_tt_packedchar *chardata_for_range; /* output */
     unsigned char h_oversample, v_oversample;
     /* don't set these, they're used internally */
+    unsigned char sdf_spread;
+    /* if non-zero, glyphs are rendered as distance fields with this border */
 };
 
 struct nk_tt_pack_context {
@@ -446,16 +584,6 @@ struct nk_tt__bitmap{
    unsigned char *pixels;
 };
 
-struct nk_tt__hheap_chunk {
-    struct nk_tt__hheap_chunk *next;
-};
-struct nk_tt__hheap {
-    struct nk_allocator alloc;
-    struct nk_tt__hheap_chunk *head;
-    void   *first_free;
-    int    num_remaining_in_head_chunk;
-};
-
 struct nk_tt__edge {
     float x0,y0, x1,y1;
     int invert;
@@ -1004,6 +1132,19 @@ nk_tt_GetGlyphHMetrics(const struct nk_tt_fontinfo *info, int glyph_index,
             *leftSideBearing = nk_ttSHORT(info->data + info->hmtx + 4*numOfLongHorMetrics + 2*(glyph_index - numOfLongHorMetrics));
     }
 }
+NK_INTERN int
+nk_tt_GetKerningPairs(const struct nk_tt_fontinfo *info, const nk_byte **pairs)
+{
+    /* returns the number of 6 byte (left, right, value) glyph pairs of the
+     * first `kern` subtable. Only horizontal format 0 tables are supported */
+    const nk_byte *data = info->data + info->kern;
+    *pairs = 0;
+    if (!info->kern) return 0;
+    if (nk_ttUSHORT(data+2) < 1) return 0; /* number of tables */
+    if (nk_ttUSHORT(data+8) != 1) return 0; /* horizontal flag, format 0 */
+    *pairs = data + 18;
+    return nk_ttUSHORT(data+10);
+}
 NK_INTERN void
 nk_tt_GetFontVMetrics(const struct nk_tt_fontinfo *info,
     int *ascent, int *descent, int *lineGap)
@@ -1058,53 +1199,12 @@ nk_tt_GetGlyphBitmapBox(const struct nk_tt_fontinfo *font, int glyph,
 /*-------------------------------------------------------------
  *                          Rasterizer
  * --------------------------------------------------------------*/
-NK_INTERN void*
-nk_tt__hheap_alloc(struct nk_tt__hheap *hh, nk_size size)
-{
-    if (hh->first_free) {
-        void *p = hh->first_free;
-        hh->first_free = * (void **) p;
-        return p;
-    } else {
-        if (hh->num_remaining_in_head_chunk == 0) {
-            int count = (size < 32 ? 2000 : size < 128 ? 800 : 100);
-            struct nk_tt__hheap_chunk *c = (struct nk_tt__hheap_chunk *)
-                hh->alloc.alloc(hh->alloc.userdata, 0,
-                sizeof(struct nk_tt__hheap_chunk) + size * (nk_size)count);
-            if (c == 0) return 0;
-            c->next = hh->head;
-            hh->head = c;
-            hh->num_remaining_in_head_chunk = count;
-        }
-        --hh->num_remaining_in_head_chunk;
-        return (char *) (hh->head) + size * (nk_size)hh->num_remaining_in_head_chunk;
-    }
-}
-NK_INTERN void
-nk_tt__hheap_free(struct nk_tt__hheap *hh, void *p)
-{
-    *(void **) p = hh->first_free;
-    hh->first_free = p;
-}
-NK_INTERN void
-nk_tt__hheap_cleanup(struct nk_tt__hheap *hh)
-{
-    struct nk_tt__hheap_chunk *c = hh->head;
-    while (c) {
-        struct nk_tt__hheap_chunk *n = c->next;
-        hh->alloc.free(hh->alloc.userdata, c);
-        c = n;
-    }
-}
 NK_INTERN struct nk_tt__active_edge*
-nk_tt__new_active(struct nk_tt__hheap *hh, struct nk_tt__edge *e,
+nk_tt__new_active(struct nk_tt__active_edge *z, struct nk_tt__edge *e,
     int off_x, float start_point)
 {
-    struct nk_tt__active_edge *z = (struct nk_tt__active_edge *)
-        nk_tt__hheap_alloc(hh, sizeof(*z));
     float dxdy = (e->x1 - e->x0) / (e->y1 - e->y0);
     /*STBTT_assert(e->y0 <= start_point); */
-    if (!z) return z;
     z->fdx = dxdy;
     z->fdy = (dxdy != 0) ? (1/dxdy): 0;
     z->fx = e->x0 + dxdy * (start_point - e->y0);
@@ -1309,24 +1409,76 @@ nk_tt__fill_active_edges_new(float *scanline, float *scanline_fill, int len,
     }
 }
 NK_INTERN void
+nk_tt__accumulate_scanline(unsigned char *pixels, float *scanline,
+    float *scanline2, int w)
+{
+    /* prefix sum the fill deltas, add the partial coverage and convert to
+     * 8-bit coverage. Both buffers are cleared on the way for the next row */
+    float sum = 0;
+    int i = 0;
+#ifdef NK_SSE2
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 carry = _mm_setzero_ps();
+    for (; i + 4 <= w; i += 4) {
+        __m128 s = _mm_loadu_ps(scanline2 + i);
+        __m128 k;
+        __m128i m;
+        int packed;
+        s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 4)));
+        s = _mm_add_ps(s, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(s), 8)));
+        s = _mm_add_ps(s, carry);
+        carry = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3,3,3,3));
+
+        k = _mm_andnot_ps(sign, _mm_add_ps(_mm_loadu_ps(scanline + i), s));
+        k = _mm_add_ps(_mm_mul_ps(k, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+        m = _mm_cvttps_epi32(k);
+        m = _mm_packs_epi32(m, m);
+        m = _mm_packus_epi16(m, m);
+        packed = _mm_cvtsi128_si32(m);
+        pixels[i+0] = (unsigned char)(packed & 0xFF);
+        pixels[i+1] = (unsigned char)((packed >> 8) & 0xFF);
+        pixels[i+2] = (unsigned char)((packed >> 16) & 0xFF);
+        pixels[i+3] = (unsigned char)((packed >> 24) & 0xFF);
+        _mm_storeu_ps(scanline + i, zero);
+        _mm_storeu_ps(scanline2 + i, zero);
+    }
+    _mm_store_ss(&sum, carry);
+#endif
+    for (; i < w; ++i) {
+        float k;
+        int m;
+        sum += scanline2[i];
+        k = scanline[i] + sum;
+        k = (float) NK_ABS(k) * 255.0f + 0.5f;
+        m = (int) k;
+        if (m > 255) m = 255;
+        pixels[i] = (unsigned char) m;
+        scanline[i] = 0;
+        scanline2[i] = 0;
+    }
+    scanline2[w] = 0;
+}
+NK_INTERN void
 nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *e,
-    int n, int vsubsample, int off_x, int off_y, struct nk_allocator *alloc)
+    int n, struct nk_tt__active_edge *pool, int vsubsample, int off_x, int off_y,
+    struct nk_allocator *alloc)
 {
-    /* directly AA rasterize edges w/o supersampling */
-    struct nk_tt__hheap hh;
+    /* directly AA rasterize edges w/o supersampling. Every edge becomes
+     * active at most once, so `pool` holds room for all `n` of them and
+     * active edges are bump allocated from it instead of freed one by one */
     struct nk_tt__active_edge *active = 0;
-    int y,j=0, i;
+    int y,j=0;
     float scanline_data[129], *scanline, *scanline2;
 
     NK_UNUSED(vsubsample);
-    nk_zero_struct(hh);
-    hh.alloc = *alloc;
-
     if (result->w > 64)
         scanline = (float *) alloc->alloc(alloc->userdata,0, (nk_size)(result->w*2+1) * sizeof(float));
     else scanline = scanline_data;
+    if (!scanline) return;
 
     scanline2 = scanline + result->w;
+    NK_MEMSET(scanline, 0, (nk_size)(result->w*2+1)*sizeof(scanline[0]));
     y = off_y;
     e[n].y0 = (float) (off_y + result->h) + 1;
 
@@ -1337,9 +1489,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         float scan_y_bottom = (float)y + 1.0f;
         struct nk_tt__active_edge **step = &active;
 
-        NK_MEMSET(scanline , 0, (nk_size)result->w*sizeof(scanline[0]));
-        NK_MEMSET(scanline2, 0, (nk_size)(result->w+1)*sizeof(scanline[0]));
-
         /* update all active edges; */
         /* remove all active edges that terminate before the top of this scanline */
         while (*step) {
@@ -1348,7 +1497,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
                 *step = z->next; /* delete from list */
                 NK_ASSERT(z->direction);
                 z->direction = 0;
-                nk_tt__hheap_free(&hh, z);
             } else {
                 step = &((*step)->next); /* advance through list */
             }
@@ -1357,13 +1505,11 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         /* insert all edges that start before the bottom of this scanline */
         while (e->y0 <= scan_y_bottom) {
             if (e->y0 != e->y1) {
-                struct nk_tt__active_edge *z = nk_tt__new_active(&hh, e, off_x, scan_y_top);
-                if (z != 0) {
-                    NK_ASSERT(z->ey >= scan_y_top);
-                    /* insert at front */
-                    z->next = active;
-                    active = z;
-                }
+                struct nk_tt__active_edge *z = nk_tt__new_active(pool++, e, off_x, scan_y_top);
+                NK_ASSERT(z->ey >= scan_y_top);
+                /* insert at front */
+                z->next = active;
+                active = z;
             }
             ++e;
         }
@@ -1371,20 +1517,9 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         /* now process all active edges */
         if (active)
             nk_tt__fill_active_edges_new(scanline, scanline2+1, result->w, active, scan_y_top);
+        nk_tt__accumulate_scanline(result->pixels + j*result->stride,
+            scanline, scanline2, result->w);
 
-        {
-            float sum = 0;
-            for (i=0; i < result->w; ++i) {
-                float k;
-                int m;
-                sum += scanline2[i];
-                k = scanline[i] + sum;
-                k = (float) NK_ABS(k) * 255.0f + 0.5f;
-                m = (int) k;
-                if (m > 255) m = 255;
-                result->pixels[j*result->stride + i] = (unsigned char) m;
-            }
-        }
         /* advance all the edges */
         step = &active;
         while (*step) {
@@ -1395,7 +1530,6 @@ nk_tt__rasterize_sorted_edges(struct nk_tt__bitmap *result, struct nk_tt__edge *
         ++y;
         ++j;
     }
-    nk_tt__hheap_cleanup(&hh);
     if (scanline != scanline_data)
         alloc->free(alloc->userdata, scanline);
 }
@@ -1498,6 +1632,7 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     struct nk_allocator *alloc)
 {
     float y_scale_inv = invert ? -scale_y : scale_y;
+    struct nk_tt__active_edge *pool;
     struct nk_tt__edge *e;
     int n,i,j,k,m;
     int vsubsample = 1;
@@ -1508,9 +1643,12 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     for (i=0; i < windings; ++i)
         n += wcount[i];
 
-    e = (struct nk_tt__edge*)
-       alloc->alloc(alloc->userdata, 0,(sizeof(*e) * (nk_size)(n+1)));
-    if (e == 0) return;
+    /* active edges for the rasterizer share the allocation, ahead of the
+     * edge list to keep their pointers aligned */
+    pool = (struct nk_tt__active_edge*)
+       alloc->alloc(alloc->userdata, 0, sizeof(*pool) * (nk_size)n + sizeof(*e) * (nk_size)(n+1));
+    if (pool == 0) return;
+    e = (struct nk_tt__edge*)(void*)(pool + n);
     n = 0;
 
     m=0;
@@ -1543,8 +1681,8 @@ nk_tt__rasterize(struct nk_tt__bitmap *result, struct nk_tt__point *pts,
     /*STBTT_sort(e, n, sizeof(e[0]), nk_tt__edge_compare); */
     nk_tt__sort_edges(e, n);
     /* now, traverse the scanlines and find the intersections on each scanline, use xor winding rule */
-    nk_tt__rasterize_sorted_edges(result, e, n, vsubsample, off_x, off_y, alloc);
-    alloc->free(alloc->userdata, e);
+    nk_tt__rasterize_sorted_edges(result, e, n, pool, vsubsample, off_x, off_y, alloc);
+    alloc->free(alloc->userdata, pool);
 }
 NK_INTERN void
 nk_tt__add_point(struct nk_tt__point *points, int n, float x, float y)
@@ -1700,6 +1838,87 @@ nk_tt_MakeGlyphBitmapSubpixel(const struct nk_tt_fontinfo *info, unsigned char *
             shift_x, shift_y, ix0,iy0, 1, alloc);
     alloc->free(alloc->userdata, vertices);
 }
+NK_INTERN void
+nk_tt_MakeGlyphSDF(const struct nk_tt_fontinfo *info, unsigned char *output,
+    int out_w, int out_h, int out_stride, float scale, int spread, int glyph,
+    struct nk_allocator *alloc)
+{
+    /* signed distance to the flattened glyph outline. The outline itself
+     * maps to 127.5 and values grow by 127.5/spread per pixel towards the
+     * inside of the glyph. The bitmap has a border of `spread` pixels
+     * around the glyph box. */
+    int ix0,iy0;
+    int x, y, i, c;
+    int contour_count = 0;
+    int *contour_lengths = 0;
+    struct nk_tt__point *points = 0;
+    struct nk_tt_vertex *vertices;
+    int num_verts = nk_tt_GetGlyphShape(info, alloc, glyph, &vertices);
+    float max_dist = (float)spread + 1.0f;
+    float dist_scale = 127.5f / (float)spread;
+
+    nk_tt_GetGlyphBitmapBox(info, glyph, scale, scale, &ix0,&iy0,0,0);
+    if (num_verts > 0)
+        points = nk_tt_FlattenCurves(vertices, num_verts, 0.35f / scale,
+            &contour_lengths, &contour_count, alloc);
+    if (points) {
+        /* move outline into bitmap space */
+        int n = 0;
+        for (c = 0; c < contour_count; ++c)
+            n += contour_lengths[c];
+        for (i = 0; i < n; ++i) {
+            points[i].x = points[i].x * scale - (float)(ix0 - spread);
+            points[i].y = -points[i].y * scale - (float)(iy0 - spread);
+        }
+    }
+    for (y = 0; y < out_h; ++y) {
+        unsigned char *row = output + y * out_stride;
+        for (x = 0; x < out_w; ++x) {
+            float px = (float)x + 0.5f;
+            float py = (float)y + 0.5f;
+            float min_dist = max_dist * max_dist;
+            float dist, value;
+            int winding = 0;
+            int start = 0;
+
+            for (c = 0; points && c < contour_count; ++c) {
+                const struct nk_tt__point *p = points + start;
+                int n = contour_lengths[c];
+                for (i = 0; i < n; ++i) {
+                    const struct nk_tt__point *a = &p[(i) ? i-1: n-1];
+                    const struct nk_tt__point *b = &p[i];
+                    float dx = b->x - a->x, dy = b->y - a->y;
+                    float len = dx*dx + dy*dy;
+                    float t = 0, ex, ey;
+
+                    /* non-zero winding rule for the inside test */
+                    if ((a->y <= py) != (b->y <= py)) {
+                        float cx = a->x + (py - a->y) / dy * dx;
+                        if (cx > px) winding += (dy > 0) ? 1: -1;
+                    }
+                    /* squared distance to the closest point on the edge */
+                    if (len > 0) {
+                        t = ((px - a->x) * dx + (py - a->y) * dy) / len;
+                        t = NK_CLAMP(0.0f, t, 1.0f);
+                    }
+                    ex = a->x + t * dx - px;
+                    ey = a->y + t * dy - py;
+                    min_dist = NK_MIN(min_dist, ex*ex + ey*ey);
+                }
+                start += n;
+            }
+            dist = (min_dist > 0) ? NK_SQRT(min_dist): 0;
+            if (!winding) dist = -dist;
+            value = 127.5f + dist * dist_scale;
+            row[x] = (unsigned char)NK_CLAMP(0.0f, value + 0.5f, 255.0f);
+        }
+    }
+    if (points) {
+        alloc->free(alloc->userdata, contour_lengths);
+        alloc->free(alloc->userdata, points);
+    }
+    alloc->free(alloc->userdata, vertices);
+}
 
 /*-------------------------------------------------------------
  *                          Bitmap baking
@@ -1916,92 +2135,97 @@ nk_tt_PackFontRangesGatherRects(struct nk_tt_pack_context *spc,
                 scale * (float)spc->v_oversample, 0,0, &x0,&y0,&x1,&y1);
             rects[k].w = (nk_rp_coord) (x1-x0 + spc->padding + (int)spc->h_oversample-1);
             rects[k].h = (nk_rp_coord) (y1-y0 + spc->padding + (int)spc->v_oversample-1);
+            rects[k].w = (nk_rp_coord) (rects[k].w + 2 * ranges[i].sdf_spread);
+            rects[k].h = (nk_rp_coord) (rects[k].h + 2 * ranges[i].sdf_spread);
             ++k;
         }
     }
     return k;
 }
+NK_INTERN void
+nk_tt_PackFontRangeRenderGlyph(struct nk_tt_pack_context *spc,
+    struct nk_tt_fontinfo *info, struct nk_tt_pack_range *range, int j,
+    float scale, struct nk_rp_rect *r, struct nk_allocator *alloc)
+{
+    /* renders a single packed glyph of a range into its own rectangle.
+     * Only the rectangle and the packed char of the glyph are written
+     * so different glyphs can be rendered concurrently. */
+    struct nk_tt_packedchar *bc = &range->chardata_for_range[j];
+    int h_oversample = (int)range->h_oversample;
+    int v_oversample = (int)range->v_oversample;
+    float recip_h = 1.0f / (float)h_oversample;
+    float recip_v = 1.0f / (float)v_oversample;
+    float sub_x = nk_tt__oversample_shift(h_oversample);
+    float sub_y = nk_tt__oversample_shift(v_oversample);
+    int advance, lsb, x0,y0,x1,y1;
+    int codepoint = range->first_unicode_codepoint_in_range ?
+        range->first_unicode_codepoint_in_range + j :
+        range->array_of_unicode_codepoints[j];
+    int glyph = nk_tt_FindGlyphIndex(info, codepoint);
+    nk_rp_coord pad = (nk_rp_coord) spc->padding;
+
+    /* pad on left and top */
+    r->x = (nk_rp_coord)((int)r->x + (int)pad);
+    r->y = (nk_rp_coord)((int)r->y + (int)pad);
+    r->w = (nk_rp_coord)((int)r->w - (int)pad);
+    r->h = (nk_rp_coord)((int)r->h - (int)pad);
+
+    nk_tt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
+    nk_tt_GetGlyphBitmapBox(info, glyph, scale * (float)h_oversample,
+            (scale * (float)v_oversample), &x0,&y0,&x1,&y1);
+    if (range->sdf_spread) {
+        /* distance fields are never oversampled */
+        nk_tt_MakeGlyphSDF(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, scale, range->sdf_spread, glyph, alloc);
+        x0 -= range->sdf_spread;
+        y0 -= range->sdf_spread;
+    } else nk_tt_MakeGlyphBitmapSubpixel(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
+        (int)(r->w - h_oversample+1), (int)(r->h - v_oversample+1),
+        spc->stride_in_bytes, scale * (float)h_oversample,
+        scale * (float)v_oversample, 0,0, glyph, alloc);
+
+    if (h_oversample > 1)
+       nk_tt__h_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, h_oversample);
+
+    if (v_oversample > 1)
+       nk_tt__v_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
+            r->w, r->h, spc->stride_in_bytes, v_oversample);
+
+    bc->x0       = (nk_ushort)  r->x;
+    bc->y0       = (nk_ushort)  r->y;
+    bc->x1       = (nk_ushort) (r->x + r->w);
+    bc->y1       = (nk_ushort) (r->y + r->h);
+    bc->xadvance = scale * (float)advance;
+    bc->xoff     = (float)  x0 * recip_h + sub_x;
+    bc->yoff     = (float)  y0 * recip_v + sub_y;
+    bc->xoff2    = ((float)x0 + r->w) * recip_h + sub_x;
+    bc->yoff2    = ((float)y0 + r->h) * recip_v + sub_y;
+}
 NK_INTERN int
 nk_tt_PackFontRangesRenderIntoRects(struct nk_tt_pack_context *spc,
     struct nk_tt_fontinfo *info, struct nk_tt_pack_range *ranges,
     int num_ranges, struct nk_rp_rect *rects, struct nk_allocator *alloc)
 {
     int i,j,k, return_value = 1;
-    /* save current values */
-    int old_h_over = (int)spc->h_oversample;
-    int old_v_over = (int)spc->v_oversample;
     /* rects array must be big enough to accommodate all characters in the given ranges */
 
     k = 0;
     for (i=0; i < num_ranges; ++i)
     {
         float fh = ranges[i].font_size;
-        float recip_h,recip_v,sub_x,sub_y;
         float scale = fh > 0 ? nk_tt_ScaleForPixelHeight(info, fh):
             nk_tt_ScaleForMappingEmToPixels(info, -fh);
 
-        spc->h_oversample = ranges[i].h_oversample;
-        spc->v_oversample = ranges[i].v_oversample;
-
-        recip_h = 1.0f / (float)spc->h_oversample;
-        recip_v = 1.0f / (float)spc->v_oversample;
-
-        sub_x = nk_tt__oversample_shift((int)spc->h_oversample);
-        sub_y = nk_tt__oversample_shift((int)spc->v_oversample);
-
         for (j=0; j < ranges[i].num_chars; ++j)
         {
             struct nk_rp_rect *r = &rects[k];
             if (r->was_packed)
-            {
-                struct nk_tt_packedchar *bc = &ranges[i].chardata_for_range[j];
-                int advance, lsb, x0,y0,x1,y1;
-                int codepoint = ranges[i].first_unicode_codepoint_in_range ?
-                    ranges[i].first_unicode_codepoint_in_range + j :
-                    ranges[i].array_of_unicode_codepoints[j];
-                int glyph = nk_tt_FindGlyphIndex(info, codepoint);
-                nk_rp_coord pad = (nk_rp_coord) spc->padding;
-
-                /* pad on left and top */
-                r->x = (nk_rp_coord)((int)r->x + (int)pad);
-                r->y = (nk_rp_coord)((int)r->y + (int)pad);
-                r->w = (nk_rp_coord)((int)r->w - (int)pad);
-                r->h = (nk_rp_coord)((int)r->h - (int)pad);
-
-                nk_tt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
-                nk_tt_GetGlyphBitmapBox(info, glyph, scale * (float)spc->h_oversample,
-                        (scale * (float)spc->v_oversample), &x0,&y0,&x1,&y1);
-                nk_tt_MakeGlyphBitmapSubpixel(info, spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                    (int)(r->w - spc->h_oversample+1), (int)(r->h - spc->v_oversample+1),
-                    spc->stride_in_bytes, scale * (float)spc->h_oversample,
-                    scale * (float)spc->v_oversample, 0,0, glyph, alloc);
-
-                if (spc->h_oversample > 1)
-                   nk_tt__h_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                        r->w, r->h, spc->stride_in_bytes, (int)spc->h_oversample);
-
-                if (spc->v_oversample > 1)
-                   nk_tt__v_prefilter(spc->pixels + r->x + r->y*spc->stride_in_bytes,
-                        r->w, r->h, spc->stride_in_bytes, (int)spc->v_oversample);
-
-                bc->x0       = (nk_ushort)  r->x;
-                bc->y0       = (nk_ushort)  r->y;
-                bc->x1       = (nk_ushort) (r->x + r->w);
-                bc->y1       = (nk_ushort) (r->y + r->h);
-                bc->xadvance = scale * (float)advance;
-                bc->xoff     = (float)  x0 * recip_h + sub_x;
-                bc->yoff     = (float)  y0 * recip_v + sub_y;
-                bc->xoff2    = ((float)x0 + r->w) * recip_h + sub_x;
-                bc->yoff2    = ((float)y0 + r->h) * recip_v + sub_y;
-            } else {
-                return_value = 0; /* if any fail, report failure */
-            }
+                nk_tt_PackFontRangeRenderGlyph(spc, info, &ranges[i], j, scale, r, alloc);
+            else return_value = 0; /* if any fail, report failure */
             ++k;
         }
     }
-    /* restore original values */
-    spc->h_oversample = (unsigned int)old_h_over;
-    spc->v_oversample = (unsigned int)old_v_over;
     return return_value;
 }
 NK_INTERN void
@@ -2045,6 +2269,7 @@ struct nk_font_bake_data {
     struct nk_rp_rect *rects;
     struct nk_tt_pack_range *ranges;
     nk_rune range_count;
+    int rect_count;
 };
 
 struct nk_font_baker {
@@ -2174,11 +2399,47 @@ nk_font_baker(void *memory, int glyph_count, int count, struct nk_allocator *all
     baker->alloc = *alloc;
     return baker;
 }
+#define NK_FONT_ATLAS_PACK_MIN_WIDTH 256
+#define NK_FONT_ATLAS_PACK_MAX_WIDTH 4096
+NK_INTERN int
+nk_font_bake_pack_rects(struct nk_rp_rect *custom, struct nk_rp_rect *rects,
+    int count, int width, int height, enum nk_font_atlas_packing packing,
+    struct nk_allocator *alloc)
+{
+    /* packs the custom rect and then all glyph rects of all fonts at once
+     * into a `width` wide area and returns the used height or -1 if not
+     * everything fits */
+    int i, used = 0, packed;
+    if (packing == NK_FONT_ATLAS_PACK_MAXRECTS) {
+        struct nk_rp_maxrects mr;
+        if (!nk_rp_maxrects_init(&mr, width-1, height-1, alloc)) return -1;
+        packed = !custom || nk_rp_maxrects_pack_rects(&mr, custom, 1);
+        packed = packed && nk_rp_maxrects_pack_rects(&mr, rects, count);
+        nk_rp_maxrects_cleanup(&mr);
+    } else {
+        struct nk_tt_pack_context spc;
+        struct nk_rp_context *context;
+        if (!nk_tt_PackBegin(&spc, 0, width, height, 0, 1, alloc)) return -1;
+        context = (struct nk_rp_context*)spc.pack_info;
+        context->heuristic = NK_RP_HEURISTIC_Skyline_BF_sortHeight;
+        if (custom) nk_rp_pack_rects(context, custom, 1);
+        nk_rp_pack_rects(context, rects, count);
+        nk_tt_PackEnd(&spc, alloc);
+        packed = !custom || custom->was_packed;
+        for (i = 0; i < count && packed; ++i)
+            packed = rects[i].was_packed;
+    }
+    if (!packed) return -1;
+    if (custom) used = custom->y + custom->h;
+    for (i = 0; i < count; ++i)
+        used = NK_MAX(used, rects[i].y + rects[i].h);
+    return used;
+}
 NK_INTERN int
 nk_font_bake_pack(struct nk_font_baker *baker,
     nk_size *image_memory, int *width, int *height, struct nk_recti *custom,
     const struct nk_font_config *config_list, int count,
-    struct nk_allocator *alloc)
+    enum nk_font_atlas_packing packing, struct nk_allocator *alloc)
 {
     NK_STORAGE const nk_size max_height = 1024 * 32;
     const struct nk_font_config *config_iter, *it;
@@ -2217,25 +2478,9 @@ nk_font_bake_pack(struct nk_font_baker *baker,
         int range_n = 0;
         int rect_n = 0;
         int char_n = 0;
+        struct nk_rp_rect custom_space;
 
-        if (custom) {
-            /* pack custom user data first so it will be in the upper left corner*/
-            struct nk_rp_rect custom_space;
-            nk_zero(&custom_space, sizeof(custom_space));
-            custom_space.w = (nk_rp_coord)(custom->w);
-            custom_space.h = (nk_rp_coord)(custom->h);
-
-            nk_tt_PackSetOversampling(&baker->spc, 1, 1);
-            nk_rp_pack_rects((struct nk_rp_context*)baker->spc.pack_info, &custom_space, 1);
-            *height = NK_MAX(*height, (int)(custom_space.y + custom_space.h));
-
-            custom->x = (short)custom_space.x;
-            custom->y = (short)custom_space.y;
-            custom->w = (short)custom_space.w;
-            custom->h = (short)custom_space.h;
-        }
-
-        /* first font pass: pack all glyphs */
+        /* first font pass: gather the rects of all glyphs */
         for (input_i = 0, config_iter = config_list; input_i < count && config_iter;
             config_iter = config_iter->next) {
             it = config_iter;
@@ -2262,36 +2507,159 @@ nk_font_bake_pack(struct nk_font_baker *baker,
                     tmp->ranges[i].first_unicode_codepoint_in_range = (int)in_range[0];
                     tmp->ranges[i].num_chars = (int)(in_range[1]- in_range[0]) + 1;
                     tmp->ranges[i].chardata_for_range = baker->packed_chars + char_n;
+                    tmp->ranges[i].sdf_spread = (unsigned char)(cfg->sdf ? NK_MAX(cfg->sdf_spread, 1): 0);
                     char_n += tmp->ranges[i].num_chars;
                 }
 
                 /* pack */
                 tmp->rects = baker->rects + rect_n;
                 rect_n += glyph_count;
-                nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
+                if (cfg->sdf) nk_tt_PackSetOversampling(&baker->spc, 1, 1);
+                else nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
                 n = nk_tt_PackFontRangesGatherRects(&baker->spc, &tmp->info,
                     tmp->ranges, (int)tmp->range_count, tmp->rects);
-                nk_rp_pack_rects((struct nk_rp_context*)baker->spc.pack_info, tmp->rects, (int)n);
-
-                /* texture height */
-                for (i = 0; i < n; ++i) {
-                    if (tmp->rects[i].was_packed)
-                        *height = NK_MAX(*height, tmp->rects[i].y + tmp->rects[i].h);
-                }
+                tmp->rect_count = n;
             } while ((it = it->n) != config_iter);
         }
         NK_ASSERT(rect_n == total_glyph_count);
         NK_ASSERT(char_n == total_glyph_count);
         NK_ASSERT(range_n == total_range_count);
+
+        /* pack custom user data first so it will be in the upper left corner*/
+        nk_zero(&custom_space, sizeof(custom_space));
+        if (custom) {
+            custom_space.w = (nk_rp_coord)(custom->w);
+            custom_space.h = (nk_rp_coord)(custom->h);
+        }
+        if (packing == NK_FONT_ATLAS_PACK_DEFAULT) {
+            /* skyline bottom-left font by font into a fixed width */
+            struct nk_rp_context *context = (struct nk_rp_context*)baker->spc.pack_info;
+            if (custom) {
+                nk_rp_pack_rects(context, &custom_space, 1);
+                *height = NK_MAX(*height, (int)(custom_space.y + custom_space.h));
+            }
+            for (input_i = 0; input_i < count; ++input_i) {
+                struct nk_font_bake_data *tmp = &baker->build[input_i];
+                nk_rp_pack_rects(context, tmp->rects, tmp->rect_count);
+                for (i = 0; i < tmp->rect_count; ++i) {
+                    if (tmp->rects[i].was_packed)
+                        *height = NK_MAX(*height, tmp->rects[i].y + tmp->rects[i].h);
+                }
+            }
+        } else {
+            /* try every heuristic and power of two width and keep the one
+             * with the smallest power of two texture, preferring squares */
+            NK_STORAGE const enum nk_font_atlas_packing heuristics[] = {
+                NK_FONT_ATLAS_PACK_SKYLINE, NK_FONT_ATLAS_PACK_MAXRECTS
+            };
+            struct nk_rp_rect *custom_rect = (custom) ? &custom_space: 0;
+            enum nk_font_atlas_packing best = NK_FONT_ATLAS_PACK_DEFAULT;
+            nk_size best_area = 0, best_used = 0, rect_area;
+            int best_width = 0, best_height = 0;
+            int h, w, j;
+
+            rect_area = (nk_size)custom_space.w * (nk_size)custom_space.h;
+            for (i = 0; i < total_glyph_count; ++i)
+                rect_area += (nk_size)baker->rects[i].w * (nk_size)baker->rects[i].h;
+            for (i = 0; i < (int)NK_LEN(heuristics); ++i) {
+                if (packing != NK_FONT_ATLAS_PACK_BEST && packing != heuristics[i])
+                    continue;
+                for (w = NK_FONT_ATLAS_PACK_MIN_WIDTH; w <= NK_FONT_ATLAS_PACK_MAX_WIDTH; w *= 2) {
+                    nk_size area, used;
+                    /* skip widths that cannot beat the best texture even
+                     * if packed without any gaps */
+                    j = (int)((rect_area + (nk_size)w - 1) / (nk_size)w);
+                    if (j > (int)max_height || (best_width &&
+                        (nk_size)w * nk_round_up_pow2((nk_uint)j) > best_area))
+                        continue;
+                    h = nk_font_bake_pack_rects(custom_rect, baker->rects,
+                        total_glyph_count, w, (int)max_height, heuristics[i], alloc);
+                    if (h < 0) continue;
+                    used = (nk_size)w * (nk_size)h;
+                    h = (int)nk_round_up_pow2((nk_uint)h);
+                    area = (nk_size)w * (nk_size)h;
+                    if (!best_width || area < best_area || (area == best_area &&
+                        (w + h < best_width + best_height ||
+                        (w + h == best_width + best_height && used < best_used)))) {
+                        best = heuristics[i];
+                        best_area = area;
+                        best_used = used;
+                        best_width = w;
+                        best_height = h;
+                    }
+                }
+            }
+            if (!best_width) {
+                nk_tt_PackEnd(&baker->spc, alloc);
+                return nk_false;
+            }
+            *width = best_width;
+            baker->spc.width = best_width;
+            baker->spc.stride_in_bytes = best_width;
+            *height = nk_font_bake_pack_rects(custom_rect, baker->rects,
+                total_glyph_count, best_width, (int)max_height, best, alloc);
+            if (*height < 0) {
+                nk_tt_PackEnd(&baker->spc, alloc);
+                return nk_false;
+            }
+        }
+        if (custom) {
+            custom->x = (short)custom_space.x;
+            custom->y = (short)custom_space.y;
+            custom->w = (short)custom_space.w;
+            custom->h = (short)custom_space.h;
+        }
     }
     *height = (int)nk_round_up_pow2((nk_uint)*height);
     *image_memory = (nk_size)(*width) * (nk_size)(*height);
     return nk_true;
 }
+#define NK_FONT_BAKE_JOB_GLYPHS 64
+struct nk_font_bake_jobs {
+    struct nk_font_baker *baker;
+    int font_count;
+};
+NK_INTERN void
+nk_font_bake_job(void *data, int index)
+{
+    /* renders the packed glyphs `index * NK_FONT_BAKE_JOB_GLYPHS` up to
+     * the next job. Rects and packed chars of all fonts are stored one
+     * after another in the order of fonts and ranges. */
+    struct nk_font_bake_jobs *jobs = (struct nk_font_bake_jobs*)data;
+    struct nk_font_baker *baker = jobs->baker;
+    int begin = index * NK_FONT_BAKE_JOB_GLYPHS;
+    int end = begin + NK_FONT_BAKE_JOB_GLYPHS;
+    int font_i, range_i, k = 0;
+
+    for (font_i = 0; font_i < jobs->font_count && k < end; ++font_i) {
+        struct nk_font_bake_data *tmp = &baker->build[font_i];
+        for (range_i = 0; range_i < (int)tmp->range_count && k < end; ++range_i) {
+            struct nk_tt_pack_range *range = &tmp->ranges[range_i];
+            float fh = range->font_size;
+            float scale;
+            int j;
+
+            if (k + range->num_chars <= begin) {
+                k += range->num_chars;
+                continue;
+            }
+            scale = fh > 0 ? nk_tt_ScaleForPixelHeight(&tmp->info, fh):
+                nk_tt_ScaleForMappingEmToPixels(&tmp->info, -fh);
+            for (j = NK_MAX(begin - k, 0); j < range->num_chars && k + j < end; ++j) {
+                struct nk_rp_rect *r = &baker->rects[k + j];
+                if (!r->was_packed) continue;
+                nk_tt_PackFontRangeRenderGlyph(&baker->spc, &tmp->info,
+                    range, j, scale, r, &baker->alloc);
+            }
+            k += range->num_chars;
+        }
+    }
+}
 NK_INTERN void
 nk_font_bake(struct nk_font_baker *baker, void *image_memory, int width, int height,
     struct nk_font_glyph *glyphs, int glyphs_count,
-    const struct nk_font_config *config_list, int font_count)
+    const struct nk_font_config *config_list, int font_count,
+    nk_plugin_parallel_for parallel_for, nk_handle parallel_userdata)
 {
     int input_i = 0;
     nk_rune glyph_n = 0;
@@ -2313,15 +2681,22 @@ nk_font_bake(struct nk_font_baker *baker, void *image_memory, int width, int hei
     nk_zero(image_memory, (nk_size)((nk_size)width * (nk_size)height));
     baker->spc.pixels = (unsigned char*)image_memory;
     baker->spc.height = (int)height;
-    for (input_i = 0, config_iter = config_list; input_i < font_count && config_iter;
-        config_iter = config_iter->next) {
-        it = config_iter;
-        do {const struct nk_font_config *cfg = it;
-            struct nk_font_bake_data *tmp = &baker->build[input_i++];
-            nk_tt_PackSetOversampling(&baker->spc, cfg->oversample_h, cfg->oversample_v);
-            nk_tt_PackFontRangesRenderIntoRects(&baker->spc, &tmp->info, tmp->ranges,
-                (int)tmp->range_count, tmp->rects, &baker->alloc);
-        } while ((it = it->n) != config_iter);
+    if (parallel_for && glyphs_count > NK_FONT_BAKE_JOB_GLYPHS) {
+        /* every glyph is rendered into its own packed rect */
+        struct nk_font_bake_jobs jobs;
+        jobs.baker = baker;
+        jobs.font_count = font_count;
+        parallel_for(parallel_userdata, nk_font_bake_job, &jobs,
+            (glyphs_count + NK_FONT_BAKE_JOB_GLYPHS - 1) / NK_FONT_BAKE_JOB_GLYPHS);
+    } else {
+        for (input_i = 0, config_iter = config_list; input_i < font_count && config_iter;
+            config_iter = config_iter->next) {
+            it = config_iter;
+            do {struct nk_font_bake_data *tmp = &baker->build[input_i++];
+                nk_tt_PackFontRangesRenderIntoRects(&baker->spc, &tmp->info, tmp->ranges,
+                    (int)tmp->range_count, tmp->rects, &baker->alloc);
+            } while ((it = it->n) != config_iter);
+        }
     } nk_tt_PackEnd(&baker->spc, &baker->alloc);
 
     /* third pass: setup font and glyphs */
@@ -2448,16 +2823,107 @@ nk_font_bake_convert(void *out_memory, int img_width, int img_height,
     for (n = (int)(img_width * img_height); n > 0; n--)
         *dst++ = ((nk_rune)(*src++) << 24) | 0x00FFFFFF;
 }
+NK_INTERN void
+nk_font_bake_compress(void *out_memory, int img_width, int img_height,
+    const void *in_memory)
+{
+    /* BC4 (RGTC1) compression of an alpha8 image into 8 byte blocks of 4x4
+     * pixels. Each block uses its minimum and maximum as endpoints so fully
+     * transparent and opaque pixels, like the white pixel, stay exact. */
+    int bx, by, x, y;
+    nk_byte *dst;
+    const nk_byte *src;
+
+    NK_ASSERT(out_memory);
+    NK_ASSERT(in_memory);
+    NK_ASSERT(img_width % 4 == 0);
+    NK_ASSERT(img_height % 4 == 0);
+    if (!out_memory || !in_memory || !img_height || !img_width) return;
+
+    dst = (nk_byte*)out_memory;
+    src = (const nk_byte*)in_memory;
+    for (by = 0; by < img_height; by += 4) {
+        for (bx = 0; bx < img_width; bx += 4) {
+            nk_byte lo = 255, hi = 0;
+            nk_uint bits[2] = {0,0};
+            for (y = 0; y < 4; ++y) {
+                const nk_byte *row = src + (by + y) * img_width + bx;
+                for (x = 0; x < 4; ++x) {
+                    lo = NK_MIN(lo, row[x]);
+                    hi = NK_MAX(hi, row[x]);
+                }
+            }
+            for (y = 0; y < 4; ++y) {
+                const nk_byte *row = src + (by + y) * img_width + bx;
+                for (x = 0; x < 4; ++x) {
+                    /* level 0 is `lo` and 7 is `hi`. Index 0 and 1 are the
+                     * endpoints and index 2-7 are levels 6 down to 1 */
+                    int bit = (y * 4 + x) * 3;
+                    nk_uint index = 0;
+                    if (hi > lo) {
+                        int level = ((row[x] - lo) * 14 + (hi - lo)) / ((hi - lo) * 2);
+                        index = (level == 7) ? 0: (level == 0) ? 1: (nk_uint)(8 - level);
+                    }
+                    bits[bit / 24] |= index << (bit % 24);
+                }
+            }
+            dst[0] = hi;
+            dst[1] = lo;
+            dst[2] = (nk_byte)(bits[0] & 0xFF);
+            dst[3] = (nk_byte)((bits[0] >> 8) & 0xFF);
+            dst[4] = (nk_byte)((bits[0] >> 16) & 0xFF);
+            dst[5] = (nk_byte)(bits[1] & 0xFF);
+            dst[6] = (nk_byte)((bits[1] >> 8) & 0xFF);
+            dst[7] = (nk_byte)((bits[1] >> 16) & 0xFF);
+            dst += 8;
+        }
+    }
+}
+NK_INTERN nk_size
+nk_font_bake_image_size(int img_width, int img_height, enum nk_font_atlas_format fmt)
+{
+    nk_size pixels = (nk_size)img_width * (nk_size)img_height;
+    switch (fmt) {
+    case NK_FONT_ATLAS_RGBA32: return pixels * 4;
+    case NK_FONT_ATLAS_BC4: return pixels / 2;
+    default: return pixels;
+    }
+}
 
 /* -------------------------------------------------------------
  *
  *                          FONT
  *
  * --------------------------------------------------------------*/
+NK_INTERN const struct nk_font_glyph *nk_font_cache_glyph(struct nk_font_cache*, const struct nk_font_glyph*);
+
+NK_INTERN nk_uint
+nk_font_kerning_hash(nk_rune first, nk_rune second)
+{
+    nk_uint hash = first * 0x9E3779B1u + second;
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+NK_INTERN float
+nk_font_find_kerning(const struct nk_font *font, nk_rune first, nk_rune second)
+{
+    nk_uint i;
+    if (!font->kerning || !first || !second) return 0;
+    i = nk_font_kerning_hash(first, second) & font->kerning_mask;
+    while (font->kerning[i].first) {
+        if (font->kerning[i].first == first && font->kerning[i].second == second)
+            return font->kerning[i].advance;
+        i = (i + 1) & font->kerning_mask;
+    }
+    return 0;
+}
 NK_INTERN float
 nk_font_text_width(nk_handle handle, float height, const char *text, int len)
 {
     nk_rune unicode;
+    nk_rune prev;
     int text_len  = 0;
     float text_width = 0;
     int glyph_len = 0;
@@ -2481,11 +2947,37 @@ nk_font_text_width(nk_handle handle, float height, const char *text, int len)
         text_width += g->xadvance * scale;
 
         /* offset next glyph */
+        prev = unicode;
         glyph_len = nk_utf_decode(text + text_len, &unicode, (int)len - text_len);
         text_len += glyph_len;
+        if (font->kerning && glyph_len && unicode != NK_UTF_INVALID)
+            text_width += nk_font_find_kerning(font, prev, unicode) * scale;
     }
     return text_width;
 }
+NK_INTERN float
+nk_font_glyph_advance(nk_handle handle, float height, nk_rune codepoint)
+{
+    const struct nk_font_glyph *g;
+    struct nk_font *font = (struct nk_font*)handle.ptr;
+    NK_ASSERT(font);
+    NK_ASSERT(font->glyphs);
+    if (!font || !font->glyphs)
+        return 0;
+    g = nk_font_find_glyph(font, codepoint);
+    return g->xadvance * (height/font->info.height);
+}
+NK_LIB nk_glyph_advance_f
+nk_font_baked_advance(const struct nk_user_font *font)
+{
+    /* glyph advances of a baked font add up to its text width unless
+     * kerning pairs are added in between */
+    const struct nk_font *f;
+    if (!font || font->width != nk_font_text_width)
+        return 0;
+    f = (const struct nk_font*)font->userdata.ptr;
+    return (f && !f->kerning) ? nk_font_glyph_advance: 0;
+}
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 NK_INTERN void
 nk_font_query_font_glyph(nk_handle handle, float height,
@@ -2496,7 +2988,6 @@ nk_font_query_font_glyph(nk_handle handle, float height,
     struct nk_font *font;
 
     NK_ASSERT(glyph);
-    NK_UNUSED(next_codepoint);
 
     font = (struct nk_font*)handle.ptr;
     NK_ASSERT(font);
@@ -2510,42 +3001,132 @@ nk_font_query_font_glyph(nk_handle handle, float height,
     glyph->height = (g->y1 - g->y0) * scale;
     glyph->offset = nk_vec2(g->x0 * scale, g->y0 * scale);
     glyph->xadvance = (g->xadvance * scale);
+    if (font->kerning)
+        glyph->xadvance += nk_font_find_kerning(font, codepoint, next_codepoint) * scale;
     glyph->uv[0] = nk_vec2(g->u0, g->v0);
     glyph->uv[1] = nk_vec2(g->u1, g->v1);
 }
 #endif
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+NK_LIB int
+nk_user_font_is_dynamic(const struct nk_user_font *font)
+{
+    /* looking up glyphs of a dynamic atlas rasterizes them into the shared
+     * cache, so it must not run concurrently with anything else */
+    const struct nk_font *f;
+    if (!font || font->width != nk_font_text_width)
+        return nk_false;
+    f = (const struct nk_font*)font->userdata.ptr;
+    return f && f->cache;
+}
+#endif
 NK_API const struct nk_font_glyph*
 nk_font_find_glyph(struct nk_font *font, nk_rune unicode)
 {
-    int i = 0;
-    int count;
-    int total_glyphs = 0;
     const struct nk_font_glyph *glyph = 0;
-    const struct nk_font_config *iter = 0;
+    const struct nk_font_glyph_range *range;
+    int begin, end;
 
     NK_ASSERT(font);
     NK_ASSERT(font->glyphs);
     NK_ASSERT(font->info.ranges);
     if (!font || !font->glyphs) return 0;
 
-    glyph = font->fallback;
+    if (unicode < NK_FONT_LOOKUP_MAX) {
+        glyph = font->lookup[unicode];
+    } else {
+        /* find last range starting in front of or at the codepoint */
+        begin = 0;
+        end = font->range_count;
+        while (begin < end) {
+            int mid = begin + (end - begin) / 2;
+            if (font->ranges[mid].first <= unicode)
+                begin = mid + 1;
+            else end = mid;
+        }
+        if (begin) {
+            range = &font->ranges[begin-1];
+            if (unicode <= range->last)
+                glyph = &font->glyphs[range->glyph + (unicode - range->first)];
+        }
+    }
+    if (!glyph)
+        glyph = font->fallback;
+    if (font->cache && glyph)
+        glyph = nk_font_cache_glyph(font->cache, glyph);
+    return glyph;
+}
+NK_INTERN int
+nk_font_range_total(const struct nk_font_config *config)
+{
+    /* clipping overlapping ranges splits them at most at the bounds of
+     * the other ranges, so n ranges never end up as more than 2n */
+    int total = 0;
+    const struct nk_font_config *iter, *i;
+    for (iter = config; iter; iter = iter->next) {
+        i = iter;
+        do {total += nk_range_count(i->range);
+        } while ((i = i->n) != iter);
+    }
+    return total * 2;
+}
+NK_INTERN void
+nk_font_init_lookup(struct nk_font *font, struct nk_font_glyph_range *ranges)
+{
+    int i, j, count;
+    nk_rune glyph = 0;
+    const struct nk_font_config *iter;
+
+    NK_MEMSET(font->lookup, 0, sizeof(font->lookup));
+    font->ranges = ranges;
+    font->range_count = 0;
+
+    /* insert ranges in config order into a sorted list of disjoint ranges.
+     * Codepoints already covered by an earlier range keep its glyph, so only
+     * the uncovered parts of each range are added */
     iter = font->config;
     do {count = nk_range_count(iter->range);
         for (i = 0; i < count; ++i) {
-            nk_rune f = iter->range[(i*2)+0];
-            nk_rune t = iter->range[(i*2)+1];
-            int diff = (int)((t - f) + 1);
-            if (unicode >= f && unicode <= t)
-                return &font->glyphs[((nk_rune)total_glyphs + (unicode - f))];
-            total_glyphs += diff;
+            nk_rune first = iter->range[(i*2)+0];
+            nk_rune last = iter->range[(i*2)+1];
+            nk_rune c = first;
+            j = 0;
+            while (c <= last) {
+                nk_rune end = last;
+                int k;
+                while (j < font->range_count && ranges[j].last < c) ++j;
+                if (j < font->range_count && ranges[j].first <= c) {
+                    if (ranges[j].last >= last) break;
+                    c = ranges[j].last + 1;
+                    continue;
+                }
+                if (j < font->range_count && ranges[j].first <= last)
+                    end = ranges[j].first - 1;
+                for (k = font->range_count; k > j; --k)
+                    ranges[k] = ranges[k-1];
+                ranges[j].first = c;
+                ranges[j].last = end;
+                ranges[j].glyph = glyph + (c - first);
+                font->range_count++;
+                if (end == last) break;
+                c = end + 1;
+            }
+            glyph += (last - first) + 1;
         }
     } while ((iter = iter->n) != font->config);
-    return glyph;
+
+    for (i = 0; i < font->range_count; ++i) {
+        const struct nk_font_glyph_range *range = &ranges[i];
+        nk_rune c;
+        for (c = range->first; c <= range->last && c < NK_FONT_LOOKUP_MAX; ++c)
+            font->lookup[c] = &font->glyphs[range->glyph + (c - range->first)];
+    }
 }
 NK_INTERN void
 nk_font_init(struct nk_font *font, float pixel_height,
     nk_rune fallback_codepoint, struct nk_font_glyph *glyphs,
-    const struct nk_baked_font *baked_font, nk_handle atlas)
+    struct nk_font_glyph_range *ranges, const struct nk_baked_font *baked_font,
+    nk_handle atlas)
 {
     struct nk_baked_font baked;
     NK_ASSERT(font);
@@ -2561,6 +3142,9 @@ nk_font_init(struct nk_font *font, float pixel_height,
     font->glyphs = &glyphs[baked_font->glyph_offset];
     font->texture = atlas;
     font->fallback_codepoint = fallback_codepoint;
+    font->kerning = 0;
+    font->kerning_mask = 0;
+    nk_font_init_lookup(font, ranges);
     font->fallback = nk_font_find_glyph(font, fallback_codepoint);
 
     font->handle.height = font->info.height * font->scale;
@@ -2867,8 +3451,290 @@ nk_decode_85(unsigned char* dst, const unsigned char* src)
  *                          FONT ATLAS
  *
  * --------------------------------------------------------------*/
-NK_API struct nk_font_config
-nk_font_config(float pixel_height)
+/*-------------------------------------------------------------
+ *                          Glyph cache
+ * --------------------------------------------------------------*/
+#define NK_FONT_CACHE_BANDS 4
+
+struct nk_font_cache_band {
+    struct nk_rp_context pack;
+    struct nk_rp_node *nodes;
+    int y, h;
+    unsigned int frame;
+    /* last frame a glyph inside the band was looked up */
+};
+struct nk_font_cache_font {
+    struct nk_tt_fontinfo info;
+    const struct nk_font_config *config;
+    int glyph_offset;
+};
+struct nk_font_cache {
+    struct nk_allocator alloc;
+    struct nk_font_cache_band bands[NK_FONT_CACHE_BANDS];
+    struct nk_font_cache_font *fonts;
+    int font_count;
+    struct nk_font_glyph *glyphs;
+    signed char *glyph_band;
+    /* band containing each glyph or -1 if it is not rasterized */
+    int glyph_count;
+    nk_byte *alpha;
+    nk_rune *rgba;
+    int width, height;
+    struct nk_recti custom;
+    struct nk_recti dirty;
+    unsigned int frame;
+};
+
+NK_INTERN void
+nk_font_cache_update(struct nk_font_cache *cache, int x, int y, int w, int h)
+{
+    struct nk_recti *dirty = &cache->dirty;
+    if (w <= 0 || h <= 0) return;
+    if (cache->rgba) {
+        /* keep the RGBA32 image in sync with the alpha image */
+        int i, j;
+        for (j = y; j < y + h; ++j) {
+            const nk_byte *src = cache->alpha + j * cache->width + x;
+            nk_rune *dst = cache->rgba + j * cache->width + x;
+            for (i = 0; i < w; ++i)
+                *dst++ = ((nk_rune)(*src++) << 24) | 0x00FFFFFF;
+        }
+    }
+    if (dirty->w && dirty->h) {
+        int x1 = NK_MAX(dirty->x + dirty->w, x + w);
+        int y1 = NK_MAX(dirty->y + dirty->h, y + h);
+        x = NK_MIN(dirty->x, x);
+        y = NK_MIN(dirty->y, y);
+        w = x1 - x;
+        h = y1 - y;
+    }
+    dirty->x = (short)x;
+    dirty->y = (short)y;
+    dirty->w = (short)w;
+    dirty->h = (short)h;
+}
+NK_INTERN void
+nk_font_cache_reset(struct nk_font_cache *cache, int index)
+{
+    int i = 0;
+    struct nk_font_cache_band *band = &cache->bands[index];
+
+    /* evict all glyphs inside the band */
+    nk_rp_init_target(&band->pack, cache->width-1, band->h-1, band->nodes, cache->width-1);
+    NK_MEMSET(cache->alpha + band->y * cache->width, 0, (nk_size)(cache->width * band->h));
+    for (i = 0; i < cache->glyph_count; ++i) {
+        if (cache->glyph_band[i] == index)
+            cache->glyph_band[i] = -1;
+    }
+    if (!index) {
+        /* custom data always stays in the upper left corner */
+        struct nk_rp_rect custom_space;
+        nk_zero(&custom_space, sizeof(custom_space));
+        custom_space.w = (nk_rp_coord)cache->custom.w;
+        custom_space.h = (nk_rp_coord)cache->custom.h;
+        nk_rp_pack_rects(&band->pack, &custom_space, 1);
+        cache->custom.x = (short)custom_space.x;
+        cache->custom.y = (short)custom_space.y;
+        nk_font_bake_custom_data(cache->alpha, cache->width, cache->height, cache->custom,
+            nk_custom_cursor_data, NK_CURSOR_DATA_W, NK_CURSOR_DATA_H, '.', 'X');
+    }
+    nk_font_cache_update(cache, 0, band->y, cache->width, band->h);
+}
+NK_INTERN int
+nk_font_cache_pack(struct nk_font_cache *cache, struct nk_rp_rect *rect)
+{
+    int i = 0;
+    int lru = -1;
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i) {
+        struct nk_font_cache_band *band = &cache->bands[i];
+        nk_rp_pack_rects(&band->pack, rect, 1);
+        if (rect->was_packed) return i;
+        if (band->frame != cache->frame && (lru < 0 || band->frame < cache->bands[lru].frame))
+            lru = i;
+    }
+    /* evict least recently used band not needed by the current frame */
+    if (lru < 0) return -1;
+    nk_font_cache_reset(cache, lru);
+    nk_rp_pack_rects(&cache->bands[lru].pack, rect, 1);
+    return (rect->was_packed) ? lru: -1;
+}
+NK_INTERN const struct nk_font_glyph*
+nk_font_cache_glyph(struct nk_font_cache *cache, const struct nk_font_glyph *glyph)
+{
+    int index, begin, end, band;
+    int advance, lsb, x0, y0, x1, y1;
+    int glyph_index, h_oversample, v_oversample, spread;
+    const struct nk_font_cache_font *font;
+    const struct nk_font_config *cfg;
+    struct nk_tt_packedchar pc;
+    struct nk_tt_aligned_quad q;
+    struct nk_rp_rect r;
+    struct nk_font_glyph *g;
+    float scale, recip_h, recip_v, dummy_x = 0, dummy_y = 0;
+
+    index = (int)(glyph - cache->glyphs);
+    NK_ASSERT(index >= 0 && index < cache->glyph_count);
+    if (cache->glyph_band[index] >= 0) {
+        cache->bands[cache->glyph_band[index]].frame = cache->frame;
+        return glyph;
+    }
+
+    /* find font config the glyph belongs to */
+    begin = 0;
+    end = cache->font_count;
+    while (end - begin > 1) {
+        int mid = begin + (end - begin) / 2;
+        if (cache->fonts[mid].glyph_offset <= index)
+            begin = mid;
+        else end = mid;
+    }
+    font = &cache->fonts[begin];
+    cfg = font->config;
+    g = &cache->glyphs[index];
+    h_oversample = NK_CLAMP(1, cfg->oversample_h, NK_TT_MAX_OVERSAMPLE);
+    v_oversample = NK_CLAMP(1, cfg->oversample_v, NK_TT_MAX_OVERSAMPLE);
+    spread = (cfg->sdf) ? NK_MAX(cfg->sdf_spread, 1): 0;
+    if (spread) h_oversample = v_oversample = 1;
+
+    /* allocate atlas space the same way `nk_font_bake_pack` does */
+    scale = nk_tt_ScaleForPixelHeight(&font->info, cfg->size);
+    glyph_index = nk_tt_FindGlyphIndex(&font->info, (int)g->codepoint);
+    nk_tt_GetGlyphHMetrics(&font->info, glyph_index, &advance, &lsb);
+    nk_tt_GetGlyphBitmapBoxSubpixel(&font->info, glyph_index, scale * (float)h_oversample,
+        scale * (float)v_oversample, 0,0, &x0,&y0,&x1,&y1);
+    nk_zero(&r, sizeof(r));
+    r.w = (nk_rp_coord)(x1-x0 + 1 + h_oversample-1 + 2*spread);
+    r.h = (nk_rp_coord)(y1-y0 + 1 + v_oversample-1 + 2*spread);
+    band = nk_font_cache_pack(cache, &r);
+    if (band < 0) {
+        /* atlas is full: keep metrics but do not draw anything */
+        g->xadvance = scale * (float)advance + cfg->spacing.x;
+        g->x0 = g->y0 = g->x1 = g->y1 = g->w = g->h = 0;
+        g->u0 = g->v0 = g->u1 = g->v1 = 0;
+        return g;
+    }
+
+    /* rasterize glyph like `nk_tt_PackFontRangesRenderIntoRects` */
+    r.x = (nk_rp_coord)(r.x + 1);
+    r.y = (nk_rp_coord)(r.y + 1 + cache->bands[band].y);
+    r.w = (nk_rp_coord)(r.w - 1);
+    r.h = (nk_rp_coord)(r.h - 1);
+    if (spread) {
+        nk_tt_MakeGlyphSDF(&font->info, cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, scale, spread, glyph_index, &cache->alloc);
+        x0 -= spread;
+        y0 -= spread;
+    } else nk_tt_MakeGlyphBitmapSubpixel(&font->info, cache->alpha + r.x + r.y * cache->width,
+        (int)(r.w - h_oversample + 1), (int)(r.h - v_oversample + 1), cache->width,
+        scale * (float)h_oversample, scale * (float)v_oversample, 0,0, glyph_index, &cache->alloc);
+    if (h_oversample > 1)
+        nk_tt__h_prefilter(cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, h_oversample);
+    if (v_oversample > 1)
+        nk_tt__v_prefilter(cache->alpha + r.x + r.y * cache->width,
+            r.w, r.h, cache->width, v_oversample);
+    nk_font_cache_update(cache, r.x, r.y, r.w, r.h);
+
+    pc.x0 = (nk_ushort)r.x;
+    pc.y0 = (nk_ushort)r.y;
+    pc.x1 = (nk_ushort)(r.x + r.w);
+    pc.y1 = (nk_ushort)(r.y + r.h);
+    pc.xadvance = scale * (float)advance;
+    recip_h = 1.0f / (float)h_oversample;
+    recip_v = 1.0f / (float)v_oversample;
+    pc.xoff = (float)x0 * recip_h + nk_tt__oversample_shift(h_oversample);
+    pc.yoff = (float)y0 * recip_v + nk_tt__oversample_shift(v_oversample);
+    pc.xoff2 = ((float)x0 + r.w) * recip_h + nk_tt__oversample_shift(h_oversample);
+    pc.yoff2 = ((float)y0 + r.h) * recip_v + nk_tt__oversample_shift(v_oversample);
+    nk_tt_GetPackedQuad(&pc, cache->width, cache->height, 0, &dummy_x, &dummy_y, &q, 0);
+
+    /* fill glyph like `nk_font_bake` */
+    g->x0 = q.x0; g->y0 = q.y0;
+    g->x1 = q.x1; g->y1 = q.y1;
+    g->y0 += (cfg->font->ascent + 0.5f);
+    g->y1 += (cfg->font->ascent + 0.5f);
+    g->w = g->x1 - g->x0 + 0.5f;
+    g->h = g->y1 - g->y0;
+    if (cfg->coord_type == NK_COORD_PIXEL) {
+        g->u0 = q.s0 * (float)cache->width;
+        g->v0 = q.t0 * (float)cache->height;
+        g->u1 = q.s1 * (float)cache->width;
+        g->v1 = q.t1 * (float)cache->height;
+    } else {
+        g->u0 = q.s0;
+        g->v0 = q.t0;
+        g->u1 = q.s1;
+        g->v1 = q.t1;
+    }
+    g->xadvance = (pc.xadvance + cfg->spacing.x);
+    if (cfg->pixel_snap)
+        g->xadvance = (float)(int)(g->xadvance + 0.5f);
+
+    cache->glyph_band[index] = (signed char)band;
+    cache->bands[band].frame = cache->frame;
+    return g;
+}
+NK_INTERN void
+nk_font_cache_free(struct nk_font_atlas *atlas)
+{
+    struct nk_font_cache *cache = atlas->cache;
+    if (!cache) return;
+    if (atlas->pixel && (atlas->pixel == cache->alpha || atlas->pixel == cache->rgba))
+        atlas->pixel = 0;
+    if (cache->fonts) atlas->permanent.free(atlas->permanent.userdata, cache->fonts);
+    if (cache->glyph_band) atlas->permanent.free(atlas->permanent.userdata, cache->glyph_band);
+    if (cache->bands[0].nodes) atlas->permanent.free(atlas->permanent.userdata, cache->bands[0].nodes);
+    if (cache->alpha) atlas->permanent.free(atlas->permanent.userdata, cache->alpha);
+    if (cache->rgba) atlas->permanent.free(atlas->permanent.userdata, cache->rgba);
+    atlas->permanent.free(atlas->permanent.userdata, cache);
+    atlas->cache = 0;
+}
+NK_INTERN struct nk_font_cache*
+nk_font_cache_alloc(struct nk_font_atlas *atlas, int width, int height,
+    enum nk_font_atlas_format fmt)
+{
+    int i = 0;
+    nk_size size;
+    struct nk_font_cache *cache;
+    struct nk_allocator *alloc = &atlas->permanent;
+
+    cache = (struct nk_font_cache*)alloc->alloc(alloc->userdata,0, sizeof(struct nk_font_cache));
+    NK_ASSERT(cache);
+    if (!cache) return 0;
+    nk_zero(cache, sizeof(*cache));
+    atlas->cache = cache;
+    cache->alloc = atlas->temporary;
+    cache->width = width;
+    cache->height = height;
+    cache->frame = 1;
+    cache->font_count = atlas->font_num;
+    cache->glyph_count = atlas->glyph_count;
+
+    size = (nk_size)width * (nk_size)height;
+    cache->fonts = (struct nk_font_cache_font*)alloc->alloc(alloc->userdata,0,
+        sizeof(struct nk_font_cache_font) * (nk_size)atlas->font_num);
+    cache->glyph_band = (signed char*)alloc->alloc(alloc->userdata,0, (nk_size)atlas->glyph_count);
+    cache->bands[0].nodes = (struct nk_rp_node*)alloc->alloc(alloc->userdata,0,
+        sizeof(struct nk_rp_node) * (nk_size)(width-1) * NK_FONT_CACHE_BANDS);
+    cache->alpha = (nk_byte*)alloc->alloc(alloc->userdata,0, size);
+    if (fmt == NK_FONT_ATLAS_RGBA32)
+        cache->rgba = (nk_rune*)alloc->alloc(alloc->userdata,0, size * 4);
+    if (!cache->fonts || !cache->glyph_band || !cache->bands[0].nodes ||
+        !cache->alpha || (fmt == NK_FONT_ATLAS_RGBA32 && !cache->rgba)) {
+        nk_font_cache_free(atlas);
+        return 0;
+    }
+    /* split the image into horizontal bands which are evicted as a whole */
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i) {
+        struct nk_font_cache_band *band = &cache->bands[i];
+        band->nodes = cache->bands[0].nodes + (width-1) * i;
+        band->y = (height / NK_FONT_CACHE_BANDS) * i;
+        band->h = (i == NK_FONT_CACHE_BANDS-1) ? height - band->y: height / NK_FONT_CACHE_BANDS;
+    }
+    return cache;
+}
+NK_API struct nk_font_config
+nk_font_config(float pixel_height)
 {
     struct nk_font_config cfg;
     nk_zero_struct(cfg);
@@ -2879,6 +3745,8 @@ nk_font_config(float pixel_height)
     cfg.oversample_h = 3;
     cfg.oversample_v = 1;
     cfg.pixel_snap = 0;
+    cfg.sdf = 0;
+    cfg.sdf_spread = 4;
     cfg.coord_type = NK_COORD_UV;
     cfg.spacing = nk_vec2(0,0);
     cfg.range = nk_font_default_glyph_ranges();
@@ -2933,10 +3801,20 @@ nk_font_atlas_begin(struct nk_font_atlas *atlas)
     NK_ASSERT(atlas->permanent.alloc && atlas->permanent.free);
     if (!atlas || !atlas->permanent.alloc || !atlas->permanent.free ||
         !atlas->temporary.alloc || !atlas->temporary.free) return;
+    nk_font_cache_free(atlas);
     if (atlas->glyphs) {
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
         atlas->glyphs = 0;
     }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
     if (atlas->pixel) {
         atlas->permanent.free(atlas->permanent.userdata, atlas->pixel);
         atlas->pixel = 0;
@@ -3025,6 +3903,7 @@ nk_font_atlas_add(struct nk_font_atlas *atlas, const struct nk_font_config *conf
         }
         NK_MEMCPY(cfg->ttf_blob, config->ttf_blob, cfg->ttf_size);
         cfg->ttf_data_owned_by_atlas = 1;
+        cfg->ttf_data_mapped = 0;
     }
     atlas->font_num++;
     return font;
@@ -3077,6 +3956,39 @@ nk_font_atlas_add_from_file(struct nk_font_atlas *atlas, const char *file_path,
     cfg.ttf_size = size;
     cfg.size = height;
     cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 0;
+    return nk_font_atlas_add(atlas, &cfg);
+}
+#endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_API struct nk_font*
+nk_font_atlas_add_from_file_mapped(struct nk_font_atlas *atlas, const char *file_path,
+    float height, const struct nk_font_config *config)
+{
+    nk_size size;
+    void *memory;
+    struct nk_font_config cfg;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+
+    /* the mapping is only unmapped by the atlas once its config is stored */
+    if (!atlas || !file_path || height <= 0.0f ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+    memory = nk_file_map(file_path, &size);
+    if (!memory) return 0;
+
+    cfg = (config) ? *config: nk_font_config(height);
+    cfg.ttf_blob = memory;
+    cfg.ttf_size = size;
+    cfg.size = height;
+    cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 1;
     return nk_font_atlas_add(atlas, &cfg);
 }
 #endif
@@ -3113,6 +4025,7 @@ nk_font_atlas_add_compressed(struct nk_font_atlas *atlas,
     cfg.ttf_size = decompressed_size;
     cfg.size = height;
     cfg.ttf_data_owned_by_atlas = 1;
+    cfg.ttf_data_mapped = 0;
     return nk_font_atlas_add(atlas, &cfg);
 }
 NK_API struct nk_font*
@@ -3159,15 +4072,169 @@ nk_font_atlas_add_default(struct nk_font_atlas *atlas,
         nk_proggy_clean_ttf_compressed_data_base85, pixel_height, config);
 }
 #endif
+NK_INTERN void
+nk_font_atlas_init_cursors(struct nk_font_atlas *atlas, int width, int height)
+{
+    int i = 0;
+    NK_STORAGE const struct nk_vec2 nk_cursor_data[NK_CURSOR_COUNT][3] = {
+        /* Pos      Size        Offset */
+        {{ 0, 3},   {12,19},    { 0, 0}},
+        {{13, 0},   { 7,16},    { 4, 8}},
+        {{31, 0},   {23,23},    {11,11}},
+        {{21, 0},   { 9, 23},   { 5,11}},
+        {{55,18},   {23, 9},    {11, 5}},
+        {{73, 0},   {17,17},    { 9, 9}},
+        {{55, 0},   {17,17},    { 9, 9}}
+    };
+    for (i = 0; i < NK_CURSOR_COUNT; ++i) {
+        struct nk_cursor *cursor = &atlas->cursors[i];
+        cursor->img.w = (unsigned short)width;
+        cursor->img.h = (unsigned short)height;
+        cursor->img.region[0] = (unsigned short)(atlas->custom.x + nk_cursor_data[i][0].x);
+        cursor->img.region[1] = (unsigned short)(atlas->custom.y + nk_cursor_data[i][0].y);
+        cursor->img.region[2] = (unsigned short)nk_cursor_data[i][1].x;
+        cursor->img.region[3] = (unsigned short)nk_cursor_data[i][1].y;
+        cursor->size = nk_cursor_data[i][1];
+        cursor->offset = nk_cursor_data[i][2];
+    }
+}
+NK_INTERN int
+nk_font_kerning_collect(struct nk_font_atlas *atlas, const struct nk_font_config *cfg,
+    struct nk_font_kerning *table, nk_uint mask)
+{
+    /* counts or inserts all kerning pairs between codepoints of a config.
+     * Glyph indices of the `kern` table are mapped back to codepoints
+     * through a list of codepoints for each glyph index. */
+    struct nk_tt_fontinfo info;
+    const nk_rune *in_range;
+    const nk_byte *pairs;
+    int *glyph_first, *next;
+    nk_rune *codepoints;
+    int i, pair_count, count = 0, n = 0;
+    float scale;
+
+    if (!nk_tt_InitFont(&info, (const unsigned char*)cfg->ttf_blob, 0))
+        return 0;
+    pair_count = nk_tt_GetKerningPairs(&info, &pairs);
+    if (!pair_count || info.numGlyphs <= 0) return 0;
+    for (in_range = cfg->range; in_range[0] && in_range[1]; in_range += 2)
+        n += (int)(in_range[1] - in_range[0]) + 1;
+
+    glyph_first = (int*)atlas->temporary.alloc(atlas->temporary.userdata, 0,
+        sizeof(int) * (nk_size)info.numGlyphs + (sizeof(int) + sizeof(nk_rune)) * (nk_size)n);
+    if (!glyph_first) return -1;
+    next = glyph_first + info.numGlyphs;
+    codepoints = (nk_rune*)(next + n);
+    for (i = 0; i < info.numGlyphs; ++i)
+        glyph_first[i] = -1;
+
+    n = 0;
+    for (in_range = cfg->range; in_range[0] && in_range[1]; in_range += 2) {
+        nk_rune codepoint;
+        for (codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) {
+            int glyph = nk_tt_FindGlyphIndex(&info, (int)codepoint);
+            if (glyph <= 0 || glyph >= info.numGlyphs) continue;
+            codepoints[n] = codepoint;
+            next[n] = glyph_first[glyph];
+            glyph_first[glyph] = n++;
+        }
+    }
+
+    scale = nk_tt_ScaleForPixelHeight(&info, cfg->size);
+    for (i = 0; i < pair_count; ++i) {
+        const nk_byte *pair = pairs + i * 6;
+        int left = nk_ttUSHORT(pair);
+        int right = nk_ttUSHORT(pair+2);
+        float advance = scale * (float)nk_ttSHORT(pair+4);
+        int l, r;
+
+        if (left >= info.numGlyphs || right >= info.numGlyphs) continue;
+        if (cfg->pixel_snap) advance = (float)nk_ifloorf(advance + 0.5f);
+        if (advance == 0) continue;
+        for (l = glyph_first[left]; l >= 0; l = next[l]) {
+            for (r = glyph_first[right]; r >= 0; r = next[r]) {
+                nk_uint slot;
+                if (!table) {
+                    count++;
+                    continue;
+                }
+                /* first pair for a codepoint pair wins */
+                slot = nk_font_kerning_hash(codepoints[l], codepoints[r]) & mask;
+                while (table[slot].first && (table[slot].first != codepoints[l] ||
+                    table[slot].second != codepoints[r]))
+                    slot = (slot + 1) & mask;
+                if (table[slot].first) continue;
+                table[slot].first = codepoints[l];
+                table[slot].second = codepoints[r];
+                table[slot].advance = advance;
+                count++;
+            }
+        }
+    }
+    atlas->temporary.free(atlas->temporary.userdata, glyph_first);
+    return count;
+}
+NK_INTERN int
+nk_font_atlas_init_kerning(struct nk_font_atlas *atlas)
+{
+    /* builds one kerning table with twice as many slots as pairs for
+     * each font. Pairs of merged configs are added to their font. */
+    struct nk_font_config *config_iter, *it;
+    struct nk_font *font;
+    int pass, total = 0;
+
+    for (pass = 0; pass < 2; ++pass) {
+        struct nk_font_kerning *table = atlas->kerning;
+        for (font = atlas->fonts, config_iter = atlas->config; font && config_iter;
+            font = font->next, config_iter = config_iter->next) {
+            int count = 0;
+            nk_uint size = 1;
+            it = config_iter;
+            do {int n = 0;
+                if (it->kerning && it->ttf_blob) {
+                    n = nk_font_kerning_collect(atlas, it, (pass) ? table: 0,
+                        (pass) ? (nk_uint)font->kerning_mask: 0);
+                    if (n < 0) return nk_false;
+                }
+                count += n;
+            } while ((it = it->n) != config_iter);
+            if (!count) continue;
+            if (pass) {
+                font->kerning = table;
+                table += font->kerning_mask + 1;
+                continue;
+            }
+            /* size is a power of two for masking */
+            while (size < (nk_uint)count * 2) size <<= 1;
+            font->kerning_mask = size - 1;
+            total += (int)size;
+        }
+        if (pass || !total) break;
+        atlas->kerning = (struct nk_font_kerning*)atlas->permanent.alloc(
+            atlas->permanent.userdata, 0, sizeof(struct nk_font_kerning) * (nk_size)total);
+        NK_ASSERT(atlas->kerning);
+        if (!atlas->kerning) return nk_false;
+        nk_zero(atlas->kerning, sizeof(struct nk_font_kerning) * (nk_size)total);
+        atlas->kerning_count = total;
+    }
+    return nk_true;
+}
 NK_API const void*
 nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
     enum nk_font_atlas_format fmt)
 {
-    int i = 0;
+    return nk_font_atlas_bake_parallel(atlas, width, height, fmt, 0, nk_handle_ptr(0));
+}
+NK_API const void*
+nk_font_atlas_bake_parallel(struct nk_font_atlas *atlas, int *width, int *height,
+    enum nk_font_atlas_format fmt, nk_plugin_parallel_for parallel_for,
+    nk_handle parallel_userdata)
+{
     void *tmp = 0;
     nk_size tmp_size, img_size;
     struct nk_font *font_iter;
     struct nk_font_baker *baker;
+    struct nk_font_glyph_range *ranges;
 
     NK_ASSERT(atlas);
     NK_ASSERT(atlas->temporary.alloc);
@@ -3203,12 +4270,18 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
     NK_ASSERT(atlas->glyphs);
     if (!atlas->glyphs)
         goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
 
     /* pack all glyphs into a tight fit space */
     atlas->custom.w = (NK_CURSOR_DATA_W*2)+1;
     atlas->custom.h = NK_CURSOR_DATA_H + 1;
     if (!nk_font_bake_pack(baker, &img_size, width, height, &atlas->custom,
-        atlas->config, atlas->font_num, &atlas->temporary))
+        atlas->config, atlas->font_num, atlas->packing, &atlas->temporary))
         goto failed;
 
     /* allocate memory for the baked image font atlas */
@@ -3219,7 +4292,8 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
 
     /* bake glyphs and custom white pixel into image */
     nk_font_bake(baker, atlas->pixel, *width, *height,
-        atlas->glyphs, atlas->glyph_count, atlas->config, atlas->font_num);
+        atlas->glyphs, atlas->glyph_count, atlas->config, atlas->font_num,
+        parallel_for, parallel_userdata);
     nk_font_bake_custom_data(atlas->pixel, *width, *height, atlas->custom,
             nk_custom_cursor_data, NK_CURSOR_DATA_W, NK_CURSOR_DATA_H, '.', 'X');
 
@@ -3232,40 +4306,34 @@ nk_font_atlas_bake(struct nk_font_atlas *atlas, int *width, int *height,
         nk_font_bake_convert(img_rgba, *width, *height, atlas->pixel);
         atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
         atlas->pixel = img_rgba;
+    } else if (fmt == NK_FONT_ATLAS_BC4) {
+        /* compress alpha8 image into 4x4 blocks */
+        void *img_bc4 = atlas->temporary.alloc(atlas->temporary.userdata,0,
+                            nk_font_bake_image_size(*width, *height, fmt));
+        NK_ASSERT(img_bc4);
+        if (!img_bc4) goto failed;
+        nk_font_bake_compress(img_bc4, *width, *height, atlas->pixel);
+        atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
+        atlas->pixel = img_bc4;
     }
     atlas->tex_width = *width;
     atlas->tex_height = *height;
+    atlas->format = fmt;
 
     /* initialize each font */
+    ranges = atlas->glyph_ranges;
     for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
         struct nk_font *font = font_iter;
         struct nk_font_config *config = font->config;
+        font->cache = 0;
         nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
-            config->font, nk_handle_ptr(0));
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
     }
+    if (!nk_font_atlas_init_kerning(atlas))
+        goto failed;
+    nk_font_atlas_init_cursors(atlas, *width, *height);
 
-    /* initialize each cursor */
-    {NK_STORAGE const struct nk_vec2 nk_cursor_data[NK_CURSOR_COUNT][3] = {
-        /* Pos      Size        Offset */
-        {{ 0, 3},   {12,19},    { 0, 0}},
-        {{13, 0},   { 7,16},    { 4, 8}},
-        {{31, 0},   {23,23},    {11,11}},
-        {{21, 0},   { 9, 23},   { 5,11}},
-        {{55,18},   {23, 9},    {11, 5}},
-        {{73, 0},   {17,17},    { 9, 9}},
-        {{55, 0},   {17,17},    { 9, 9}}
-    };
-    for (i = 0; i < NK_CURSOR_COUNT; ++i) {
-        struct nk_cursor *cursor = &atlas->cursors[i];
-        cursor->img.w = (unsigned short)*width;
-        cursor->img.h = (unsigned short)*height;
-        cursor->img.region[0] = (unsigned short)(atlas->custom.x + nk_cursor_data[i][0].x);
-        cursor->img.region[1] = (unsigned short)(atlas->custom.y + nk_cursor_data[i][0].y);
-        cursor->img.region[2] = (unsigned short)nk_cursor_data[i][1].x;
-        cursor->img.region[3] = (unsigned short)nk_cursor_data[i][1].y;
-        cursor->size = nk_cursor_data[i][1];
-        cursor->offset = nk_cursor_data[i][2];
-    }}
     /* free temporary memory */
     atlas->temporary.free(atlas->temporary.userdata, tmp);
     return atlas->pixel;
@@ -3277,12 +4345,448 @@ failed:
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
         atlas->glyphs = 0;
     }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
     if (atlas->pixel) {
         atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
         atlas->pixel = 0;
     }
     return 0;
 }
+NK_API const void*
+nk_font_atlas_bake_dynamic(struct nk_font_atlas *atlas, int width, int height,
+    enum nk_font_atlas_format fmt)
+{
+    int i = 0;
+    int glyph_n = 0;
+    nk_size tmp_size;
+    struct nk_font *font_iter;
+    struct nk_font_config *config_iter, *it;
+    struct nk_font_glyph_range *ranges;
+    struct nk_font_cache *cache;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+    NK_ASSERT(width > (NK_CURSOR_DATA_W*2)+2);
+    NK_ASSERT(height / NK_FONT_CACHE_BANDS > NK_CURSOR_DATA_H+2);
+    NK_ASSERT(fmt != NK_FONT_ATLAS_BC4);
+    if (!atlas || width <= (NK_CURSOR_DATA_W*2)+2 ||
+        height / NK_FONT_CACHE_BANDS <= NK_CURSOR_DATA_H+2 ||
+        fmt == NK_FONT_ATLAS_BC4 ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+
+#ifdef NK_INCLUDE_DEFAULT_FONT
+    /* no font added so just use default font */
+    if (!atlas->font_num)
+        atlas->default_font = nk_font_atlas_add_default(atlas, 13.0f, 0);
+#endif
+    NK_ASSERT(atlas->font_num);
+    if (!atlas->font_num) return 0;
+
+    /* allocate glyph memory for all fonts and the glyph cache */
+    nk_font_baker_memory(&tmp_size, &atlas->glyph_count, atlas->config, atlas->font_num);
+    atlas->glyphs = (struct nk_font_glyph*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph)*(nk_size)atlas->glyph_count);
+    NK_ASSERT(atlas->glyphs);
+    if (!atlas->glyphs)
+        goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
+    cache = nk_font_cache_alloc(atlas, width, height, fmt);
+    if (!cache)
+        goto failed;
+    cache->glyphs = atlas->glyphs;
+
+    /* setup fonts and glyph codepoints without rasterizing anything */
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {struct nk_font_cache_font *f = &cache->fonts[i++];
+            struct nk_baked_font *dst_font = it->font;
+            int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+            const nk_rune *in_range;
+            float font_scale;
+
+            if (!nk_tt_InitFont(&f->info, (const unsigned char*)it->ttf_blob, 0))
+                goto failed;
+            f->config = it;
+            f->glyph_offset = glyph_n;
+            if (!it->merge_mode) {
+                font_scale = nk_tt_ScaleForPixelHeight(&f->info, it->size);
+                nk_tt_GetFontVMetrics(&f->info, &unscaled_ascent, &unscaled_descent,
+                    &unscaled_line_gap);
+                dst_font->ranges = it->range;
+                dst_font->height = it->size;
+                dst_font->ascent = ((float)unscaled_ascent * font_scale);
+                dst_font->descent = ((float)unscaled_descent * font_scale);
+                dst_font->glyph_offset = (nk_rune)glyph_n;
+                dst_font->glyph_count = 0;
+            }
+            for (in_range = it->range; in_range[0] && in_range[1]; in_range += 2) {
+                nk_rune codepoint;
+                for (codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) {
+                    nk_zero(&atlas->glyphs[glyph_n], sizeof(struct nk_font_glyph));
+                    atlas->glyphs[glyph_n++].codepoint = codepoint;
+                }
+            }
+            dst_font->glyph_count += (nk_rune)(glyph_n - f->glyph_offset);
+        } while ((it = it->n) != config_iter);
+    }
+    NK_ASSERT(glyph_n == atlas->glyph_count);
+    for (i = 0; i < cache->glyph_count; ++i)
+        cache->glyph_band[i] = -1;
+
+    /* clear image and place custom data */
+    cache->custom.w = (NK_CURSOR_DATA_W*2)+1;
+    cache->custom.h = NK_CURSOR_DATA_H + 1;
+    for (i = 0; i < NK_FONT_CACHE_BANDS; ++i)
+        nk_font_cache_reset(cache, i);
+    atlas->custom = cache->custom;
+    atlas->pixel = (cache->rgba) ? (void*)cache->rgba: (void*)cache->alpha;
+    atlas->tex_width = width;
+    atlas->tex_height = height;
+    atlas->format = fmt;
+
+    /* initialize each font */
+    ranges = atlas->glyph_ranges;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font *font = font_iter;
+        struct nk_font_config *config = font->config;
+        font->cache = cache;
+        nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
+    }
+    if (!nk_font_atlas_init_kerning(atlas))
+        goto failed;
+    nk_font_atlas_init_cursors(atlas, width, height);
+    return atlas->pixel;
+
+failed:
+    /* error so cleanup all memory */
+    nk_font_cache_free(atlas);
+    if (atlas->glyphs) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+        atlas->glyphs = 0;
+    }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
+    return 0;
+}
+NK_API const void*
+nk_font_atlas_dirty(struct nk_font_atlas *atlas, struct nk_recti *region)
+{
+    struct nk_font_cache *cache;
+    NK_ASSERT(atlas);
+    NK_ASSERT(region);
+    if (!atlas || !region) return 0;
+
+    nk_zero(region, sizeof(*region));
+    cache = atlas->cache;
+    if (!cache) return 0;
+
+    /* hand out changes and start a new frame */
+    *region = cache->dirty;
+    nk_zero(&cache->dirty, sizeof(cache->dirty));
+    cache->frame++;
+    return (cache->rgba) ? (const void*)cache->rgba: (const void*)cache->alpha;
+}
+#define NK_FONT_ATLAS_BLOB_MAGIC 0x41464B4E /* 'NKFA' */
+#define NK_FONT_ATLAS_BLOB_VERSION 2
+struct nk_font_atlas_blob {
+    nk_uint magic;
+    nk_uint version;
+    nk_hash key;
+    nk_uint format;
+    nk_uint glyph_size;
+    int width, height;
+    int font_count;
+    int glyph_count;
+    int kerning_count;
+    short custom[4];
+};
+struct nk_font_atlas_blob_font {
+    float height;
+    float ascent, descent;
+    nk_rune glyph_offset;
+    nk_rune glyph_count;
+    nk_uint kerning_size;
+};
+NK_INTERN int
+nk_font_atlas_key(const struct nk_font_atlas *atlas, nk_hash *key)
+{
+    const struct nk_font_config *config_iter, *it;
+    *key = NK_FONT_ATLAS_BLOB_VERSION;
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {int flags[8];
+            float values[3];
+            const nk_rune *range = it->range;
+
+            if (!it->ttf_blob || !range) return nk_false;
+            flags[0] = (int)it->merge_mode;
+            flags[1] = (int)it->pixel_snap;
+            flags[2] = (int)it->oversample_h;
+            flags[3] = (int)it->oversample_v;
+            flags[4] = (int)it->coord_type;
+            flags[5] = (int)it->sdf;
+            flags[6] = (int)it->sdf_spread;
+            flags[7] = (int)it->kerning;
+            values[0] = it->size;
+            values[1] = it->spacing.x;
+            values[2] = it->spacing.y;
+            while (range[0] && range[1]) range += 2;
+
+            *key = nk_murmur_hash(flags, (int)sizeof(flags), *key);
+            *key = nk_murmur_hash(values, (int)sizeof(values), *key);
+            *key = nk_murmur_hash(it->range, (int)((nk_size)(range - it->range) * sizeof(nk_rune)), *key);
+            *key = nk_murmur_hash(it->ttf_blob, (int)it->ttf_size, *key);
+        } while ((it = it->n) != config_iter);
+    }
+    return nk_true;
+}
+NK_INTERN nk_size
+nk_font_atlas_blob_size(const struct nk_font_atlas_blob *blob)
+{
+    nk_size size = sizeof(struct nk_font_atlas_blob);
+    size += (nk_size)blob->font_count * sizeof(struct nk_font_atlas_blob_font);
+    size += (nk_size)blob->glyph_count * sizeof(struct nk_font_glyph);
+    size += (nk_size)blob->kerning_count * sizeof(struct nk_font_kerning);
+    size += nk_font_bake_image_size(blob->width, blob->height,
+        (enum nk_font_atlas_format)blob->format);
+    return size;
+}
+NK_API nk_size
+nk_font_atlas_save(const struct nk_font_atlas *atlas, void *memory, nk_size size)
+{
+    struct nk_font_atlas_blob blob;
+    const struct nk_font *font_iter;
+    nk_byte *dst = (nk_byte*)memory;
+    nk_size blob_size;
+
+    NK_ASSERT(atlas);
+    if (!atlas || !atlas->pixel || atlas->cache || !atlas->glyphs)
+        return 0;
+
+    /* header */
+    nk_zero_struct(blob);
+    if (!nk_font_atlas_key(atlas, &blob.key))
+        return 0;
+    blob.magic = NK_FONT_ATLAS_BLOB_MAGIC;
+    blob.version = NK_FONT_ATLAS_BLOB_VERSION;
+    blob.format = (nk_uint)atlas->format;
+    blob.glyph_size = sizeof(struct nk_font_glyph);
+    blob.width = atlas->tex_width;
+    blob.height = atlas->tex_height;
+    blob.kerning_count = atlas->kerning_count;
+    blob.custom[0] = atlas->custom.x;
+    blob.custom[1] = atlas->custom.y;
+    blob.custom[2] = atlas->custom.w;
+    blob.custom[3] = atlas->custom.h;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        /* glyphs which are not inside the font are never filled out */
+        blob.font_count++;
+        blob.glyph_count = NK_MAX(blob.glyph_count,
+            (int)(font_iter->info.glyph_offset + font_iter->info.glyph_count));
+    }
+    blob_size = nk_font_atlas_blob_size(&blob);
+    if (!memory || size < blob_size)
+        return blob_size;
+
+    NK_MEMCPY(dst, &blob, sizeof(blob));
+    dst += sizeof(blob);
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        nk_zero_struct(font);
+        font.height = font_iter->info.height;
+        font.ascent = font_iter->info.ascent;
+        font.descent = font_iter->info.descent;
+        font.glyph_offset = font_iter->info.glyph_offset;
+        font.glyph_count = font_iter->info.glyph_count;
+        font.kerning_size = (font_iter->kerning) ? font_iter->kerning_mask + 1: 0;
+        NK_MEMCPY(dst, &font, sizeof(font));
+        dst += sizeof(font);
+    }
+    NK_MEMCPY(dst, atlas->glyphs, (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph));
+    dst += (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph);
+    NK_MEMCPY(dst, atlas->kerning, (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning));
+    dst += (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning);
+    NK_MEMCPY(dst, atlas->pixel, blob_size - (nk_size)(dst - (nk_byte*)memory));
+    return blob_size;
+}
+NK_API const void*
+nk_font_atlas_load(struct nk_font_atlas *atlas, const void *memory, nk_size size,
+    int *width, int *height, enum nk_font_atlas_format fmt)
+{
+    struct nk_font_atlas_blob blob;
+    struct nk_font_config *config_iter, *it;
+    struct nk_font_glyph_range *ranges;
+    struct nk_font *font_iter;
+    const nk_byte *src = (const nk_byte*)memory;
+    const nk_byte *fonts;
+    struct nk_font_kerning *kerning;
+    nk_hash key;
+    int font_count = 0;
+    int kerning_count = 0;
+
+    NK_ASSERT(atlas);
+    NK_ASSERT(atlas->temporary.alloc);
+    NK_ASSERT(atlas->temporary.free);
+    NK_ASSERT(atlas->permanent.alloc);
+    NK_ASSERT(atlas->permanent.free);
+    NK_ASSERT(width);
+    NK_ASSERT(height);
+    if (!atlas || !width || !height ||
+        !atlas->temporary.alloc || !atlas->temporary.free ||
+        !atlas->permanent.alloc || !atlas->permanent.free)
+        return 0;
+    if (!memory || size < sizeof(blob))
+        return 0;
+
+#ifdef NK_INCLUDE_DEFAULT_FONT
+    /* no font added so just use default font */
+    if (!atlas->font_num)
+        atlas->default_font = nk_font_atlas_add_default(atlas, 13.0f, 0);
+#endif
+    NK_ASSERT(atlas->font_num);
+    if (!atlas->font_num) return 0;
+    for (config_iter = atlas->config; config_iter; config_iter = config_iter->next) {
+        it = config_iter;
+        do {if (!it->range) it->range = nk_font_default_glyph_ranges();
+        } while ((it = it->n) != config_iter);
+    }
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next)
+        font_count++;
+
+    /* make sure the blob was saved for the same fonts */
+    NK_MEMCPY(&blob, src, sizeof(blob));
+    src += sizeof(blob);
+    if (blob.magic != NK_FONT_ATLAS_BLOB_MAGIC ||
+        blob.version != NK_FONT_ATLAS_BLOB_VERSION ||
+        blob.format != (nk_uint)fmt ||
+        blob.glyph_size != sizeof(struct nk_font_glyph) ||
+        blob.font_count != font_count || blob.glyph_count < 0 ||
+        blob.kerning_count < 0 ||
+        blob.width <= 0 || blob.height <= 0 ||
+        size < nk_font_atlas_blob_size(&blob))
+        return 0;
+    if (!nk_font_atlas_key(atlas, &key) || key != blob.key)
+        return 0;
+
+    /* copy glyphs and font metrics */
+    atlas->glyph_count = blob.glyph_count;
+    atlas->glyphs = (struct nk_font_glyph*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph)*(nk_size)NK_MAX(atlas->glyph_count, 1));
+    NK_ASSERT(atlas->glyphs);
+    if (!atlas->glyphs)
+        goto failed;
+    atlas->glyph_ranges = (struct nk_font_glyph_range*)atlas->permanent.alloc(
+        atlas->permanent.userdata,0, sizeof(struct nk_font_glyph_range)*
+        (nk_size)nk_font_range_total(atlas->config));
+    NK_ASSERT(atlas->glyph_ranges);
+    if (!atlas->glyph_ranges)
+        goto failed;
+    if (blob.kerning_count > 0) {
+        atlas->kerning = (struct nk_font_kerning*)atlas->permanent.alloc(
+            atlas->permanent.userdata,0, sizeof(struct nk_font_kerning)*(nk_size)blob.kerning_count);
+        NK_ASSERT(atlas->kerning);
+        if (!atlas->kerning)
+            goto failed;
+        atlas->kerning_count = blob.kerning_count;
+    }
+    fonts = src;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        struct nk_baked_font *dst_font = &font_iter->info;
+        NK_MEMCPY(&font, src, sizeof(font));
+        src += sizeof(font);
+        kerning_count += (int)font.kerning_size;
+        if ((int)(font.glyph_offset + font.glyph_count) > blob.glyph_count ||
+            (font.kerning_size & (font.kerning_size - 1)) || kerning_count > blob.kerning_count)
+            goto failed;
+        dst_font->ranges = font_iter->config->range;
+        dst_font->height = font.height;
+        dst_font->ascent = font.ascent;
+        dst_font->descent = font.descent;
+        dst_font->glyph_offset = font.glyph_offset;
+        dst_font->glyph_count = font.glyph_count;
+    }
+    NK_MEMCPY(atlas->glyphs, src, (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph));
+    src += (nk_size)blob.glyph_count * sizeof(struct nk_font_glyph);
+    NK_MEMCPY(atlas->kerning, src, (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning));
+    src += (nk_size)blob.kerning_count * sizeof(struct nk_font_kerning);
+
+    /* image is used directly from the blob */
+    atlas->pixel = 0;
+    atlas->tex_width = *width = blob.width;
+    atlas->tex_height = *height = blob.height;
+    atlas->format = fmt;
+    atlas->custom.x = blob.custom[0];
+    atlas->custom.y = blob.custom[1];
+    atlas->custom.w = blob.custom[2];
+    atlas->custom.h = blob.custom[3];
+
+    /* initialize each font */
+    ranges = atlas->glyph_ranges;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font *font = font_iter;
+        struct nk_font_config *config = font->config;
+        font->cache = 0;
+        nk_font_init(font, config->size, config->fallback_glyph, atlas->glyphs,
+            ranges, config->font, nk_handle_ptr(0));
+        ranges += font->range_count;
+    }
+    kerning = atlas->kerning;
+    for (font_iter = atlas->fonts; font_iter; font_iter = font_iter->next) {
+        struct nk_font_atlas_blob_font font;
+        NK_MEMCPY(&font, fonts, sizeof(font));
+        fonts += sizeof(font);
+        if (!font.kerning_size) continue;
+        font_iter->kerning = kerning;
+        font_iter->kerning_mask = font.kerning_size - 1;
+        kerning += font.kerning_size;
+    }
+    nk_font_atlas_init_cursors(atlas, *width, *height);
+    return src;
+
+failed:
+    if (atlas->glyphs) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+        atlas->glyphs = 0;
+    }
+    if (atlas->glyph_ranges) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+        atlas->glyph_ranges = 0;
+    }
+    if (atlas->kerning) {
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
+        atlas->kerning = 0;
+        atlas->kerning_count = 0;
+    }
+    return 0;
+}
 NK_API void
 nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     struct nk_draw_null_texture *null)
@@ -3309,7 +4813,10 @@ nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     for (i = 0; i < NK_CURSOR_COUNT; ++i)
         atlas->cursors[i].img.handle = texture;
 
-    atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
+    /* image of a dynamic atlas is updated until `nk_font_atlas_clear` */
+    if (atlas->cache) return;
+    if (atlas->pixel)
+        atlas->temporary.free(atlas->temporary.userdata, atlas->pixel);
     atlas->pixel = 0;
     atlas->tex_width = 0;
     atlas->tex_height = 0;
@@ -3318,6 +4825,18 @@ nk_font_atlas_end(struct nk_font_atlas *atlas, nk_handle texture,
     atlas->custom.w = 0;
     atlas->custom.h = 0;
 }
+NK_INTERN void
+nk_font_config_free_ttf(struct nk_font_atlas *atlas, struct nk_font_config *config)
+{
+    if (!config->ttf_blob) return;
+#ifdef NK_INCLUDE_FILE_MAPPING
+    if (config->ttf_data_mapped)
+        nk_file_unmap(config->ttf_blob, config->ttf_size);
+    else
+#endif
+    atlas->permanent.free(atlas->permanent.userdata, config->ttf_blob);
+    config->ttf_blob = 0;
+}
 NK_API void
 nk_font_atlas_cleanup(struct nk_font_atlas *atlas)
 {
@@ -3327,16 +4846,15 @@ nk_font_atlas_cleanup(struct nk_font_atlas *atlas)
     NK_ASSERT(atlas->permanent.alloc);
     NK_ASSERT(atlas->permanent.free);
     if (!atlas || !atlas->permanent.alloc || !atlas->permanent.free) return;
+    /* dynamic atlas still needs the ttf data to rasterize glyphs */
+    if (atlas->cache) return;
     if (atlas->config) {
         struct nk_font_config *iter;
         for (iter = atlas->config; iter; iter = iter->next) {
             struct nk_font_config *i;
-            for (i = iter->n; i != iter; i = i->n) {
-                atlas->permanent.free(atlas->permanent.userdata, i->ttf_blob);
-                i->ttf_blob = 0;
-            }
-            atlas->permanent.free(atlas->permanent.userdata, iter->ttf_blob);
-            iter->ttf_blob = 0;
+            for (i = iter->n; i != iter; i = i->n)
+                nk_font_config_free_ttf(atlas, i);
+            nk_font_config_free_ttf(atlas, iter);
         }
     }
 }
@@ -3356,13 +4874,11 @@ nk_font_atlas_clear(struct nk_font_atlas *atlas)
             struct nk_font_config *i, *n;
             for (i = iter->n; i != iter; i = n) {
                 n = i->n;
-                if (i->ttf_blob)
-                    atlas->permanent.free(atlas->permanent.userdata, i->ttf_blob);
+                nk_font_config_free_ttf(atlas, i);
                 atlas->permanent.free(atlas->permanent.userdata, i);
             }
             next = iter->next;
-            if (i->ttf_blob)
-                atlas->permanent.free(atlas->permanent.userdata, iter->ttf_blob);
+            nk_font_config_free_ttf(atlas, iter);
             atlas->permanent.free(atlas->permanent.userdata, iter);
         }
         atlas->config = 0;
@@ -3375,8 +4891,13 @@ nk_font_atlas_clear(struct nk_font_atlas *atlas)
         }
         atlas->fonts = 0;
     }
+    nk_font_cache_free(atlas);
     if (atlas->glyphs)
         atlas->permanent.free(atlas->permanent.userdata, atlas->glyphs);
+    if (atlas->glyph_ranges)
+        atlas->permanent.free(atlas->permanent.userdata, atlas->glyph_ranges);
+    if (atlas->kerning)
+        atlas->permanent.free(atlas->permanent.userdata, atlas->kerning);
     nk_zero_struct(*atlas);
 }
 #endif
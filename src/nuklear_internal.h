@@ -5,6 +5,10 @@
 #define NK_POOL_DEFAULT_CAPACITY 16
 #endif
 
+#ifndef NK_POOL_MAX_CAPACITY
+#define NK_POOL_MAX_CAPACITY 256
+#endif
+
 #ifndef NK_DEFAULT_COMMAND_BUFFER_SIZE
 #define NK_DEFAULT_COMMAND_BUFFER_SIZE (4*1024)
 #endif
@@ -23,6 +27,21 @@
 #ifdef NK_INCLUDE_STANDARD_VARARGS
 #include <stdarg.h> /* valist, va_start, va_end, ... */
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+#ifdef _WIN32
+#include <windows.h> /* CreateFileMappingA, MapViewOfFile, ... */
+#else
+#include <sys/mman.h> /* mmap, munmap */
+#include <sys/stat.h> /* fstat */
+#include <fcntl.h> /* open */
+#include <unistd.h> /* close */
+#endif
+#endif
+#if defined(NK_INCLUDE_SIMD) && (defined(__SSE2__) || defined(_M_X64) ||\
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h> /* __m128, _mm_add_ps, ... */
+#define NK_SSE2
+#endif
 #ifndef NK_ASSERT
 #include <assert.h>
 #define NK_ASSERT(expr) assert(expr)
@@ -117,6 +136,7 @@ NK_LIB float nk_sin(float x);
 NK_LIB float nk_cos(float x);
 NK_LIB nk_uint nk_round_up_pow2(nk_uint v);
 NK_LIB struct nk_rect nk_shrink_rect(struct nk_rect r, float amount);
+NK_LIB struct nk_rect nk_merge_rect(struct nk_rect a, struct nk_rect b);
 NK_LIB struct nk_rect nk_pad_rect(struct nk_rect r, struct nk_vec2 pad);
 NK_LIB void nk_unify(struct nk_rect *clip, const struct nk_rect *a, float x0, float y0, float x1, float y1);
 NK_LIB double nk_pow(double x, int n);
@@ -145,6 +165,10 @@ NK_LIB int nk_strfmt(char *buf, int buf_size, const char *fmt, va_list args);
 #ifdef NK_INCLUDE_STANDARD_IO
 NK_LIB char *nk_file_load(const char* path, nk_size* siz, struct nk_allocator *alloc);
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_LIB void *nk_file_map(const char* path, nk_size* siz);
+NK_LIB void nk_file_unmap(void *memory, nk_size size);
+#endif
 
 /* buffer */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -154,11 +178,15 @@ NK_LIB void nk_mfree(nk_handle unused, void *ptr);
 NK_LIB void* nk_buffer_align(void *unaligned, nk_size align, nk_size *alignment, enum nk_buffer_allocation_type type);
 NK_LIB void* nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type, nk_size size, nk_size align);
 NK_LIB void* nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size);
+NK_LIB void* nk_buffer_at(const struct nk_buffer *b, nk_size offset);
+NK_LIB const void* nk_buffer_chunk_at(const void *memory, const struct nk_buffer_chunk *chunk, nk_size offset);
 
 /* draw */
 NK_LIB void nk_command_buffer_init(struct nk_command_buffer *cb, struct nk_buffer *b, enum nk_command_clipping clip);
 NK_LIB void nk_command_buffer_reset(struct nk_command_buffer *b);
 NK_LIB void* nk_command_buffer_push(struct nk_command_buffer* b, enum nk_command_type t, nk_size size);
+NK_LIB nk_hash nk_command_hash(nk_hash hash, const void *ptr, nk_size size);
+NK_LIB void nk_command_buffer_hash(struct nk_command_buffer *b, nk_size end);
 NK_LIB void nk_draw_symbol(struct nk_command_buffer *out, enum nk_symbol_type type, struct nk_rect content, struct nk_color background, struct nk_color foreground, float border_width, const struct nk_user_font *font);
 
 /* buffering */
@@ -170,6 +198,9 @@ NK_LIB void nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *b
 NK_LIB void nk_finish(struct nk_context *ctx, struct nk_window *w);
 NK_LIB void nk_build(struct nk_context *ctx);
 
+/* memory statistics */
+NK_LIB void nk_memory_check(struct nk_context *ctx, const char *name);
+
 /* text editor */
 NK_LIB void nk_textedit_clear_state(struct nk_text_edit *state, enum nk_text_edit_type type, nk_plugin_filter filter);
 NK_LIB void nk_textedit_click(struct nk_text_edit *state, float x, float y, const struct nk_user_font *font, float row_height);
@@ -186,17 +217,23 @@ NK_LIB void nk_remove_window(struct nk_context*, struct nk_window*);
 NK_LIB void nk_free_window(struct nk_context *ctx, struct nk_window *win);
 NK_LIB struct nk_window *nk_find_window(struct nk_context *ctx, nk_hash hash, const char *name);
 NK_LIB void nk_insert_window(struct nk_context *ctx, struct nk_window *win, enum nk_window_insert_location loc);
+NK_LIB void nk_window_index_free(struct nk_context *ctx);
+NK_LIB void nk_window_index_rebuild(struct nk_context *ctx);
 
 /* pool */
 NK_LIB void nk_pool_init(struct nk_pool *pool, struct nk_allocator *alloc, unsigned int capacity);
 NK_LIB void nk_pool_free(struct nk_pool *pool);
 NK_LIB void nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size);
 NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool);
+NK_LIB struct nk_page_element *nk_pool_alloc_range(struct nk_pool *pool, unsigned int count);
+NK_LIB nk_size nk_pool_shrink(struct nk_pool *pool, struct nk_page_element **freelist, unsigned int *released);
 
 /* page-element */
 NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx);
 NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem);
 NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem);
+NK_LIB struct nk_page_element* nk_create_page_elements(struct nk_context *ctx, unsigned int count);
+NK_LIB void nk_free_page_elements(struct nk_context *ctx, struct nk_page_element *elem, unsigned int count);
 
 /* table */
 NK_LIB struct nk_table* nk_create_table(struct nk_context *ctx);
@@ -205,6 +242,8 @@ NK_LIB void nk_free_table(struct nk_context *ctx, struct nk_table *tbl);
 NK_LIB void nk_push_table(struct nk_window *win, struct nk_table *tbl);
 NK_LIB nk_uint *nk_add_value(struct nk_context *ctx, struct nk_window *win, nk_hash name, nk_uint value);
 NK_LIB nk_uint *nk_find_value(struct nk_window *win, nk_hash name);
+NK_LIB void nk_table_index_rebuild(struct nk_context *ctx, struct nk_window *win);
+NK_LIB void nk_table_index_free(struct nk_context *ctx, struct nk_window *win);
 
 /* panel */
 NK_LIB void *nk_create_panel(struct nk_context *ctx);
@@ -331,5 +370,18 @@ NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_styl
 NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior);
 NK_LIB void nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant *variant, float inc_per_pixel, const enum nk_property_filter filter);
 
+#ifdef NK_INCLUDE_FONT_BAKING
+/* font */
+NK_LIB nk_glyph_advance_f nk_font_baked_advance(const struct nk_user_font *font);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+NK_LIB int nk_user_font_is_dynamic(const struct nk_user_font *font);
+#endif
+#endif
+
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+/* vertex */
+NK_LIB void nk_vertex_cache_free(struct nk_vertex_cache *cache);
+#endif
+
 #endif
 
@@ -220,6 +220,16 @@ nk_pad_rect(struct nk_rect r, struct nk_vec2 pad)
     r.h -= 2 * pad.y;
     return r;
 }
+NK_LIB struct nk_rect
+nk_merge_rect(struct nk_rect a, struct nk_rect b)
+{
+    struct nk_rect res;
+    res.x = NK_MIN(a.x, b.x);
+    res.y = NK_MIN(a.y, b.y);
+    res.w = NK_MAX(a.x + a.w, b.x + b.w) - res.x;
+    res.h = NK_MAX(a.y + a.h, b.y + b.h) - res.y;
+    return res;
+}
 NK_API struct nk_vec2
 nk_vec2(float x, float y)
 {
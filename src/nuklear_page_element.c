@@ -17,8 +17,10 @@ nk_create_page_element(struct nk_context *ctx)
     } else if (ctx->use_pool) {
         /* allocate page element from memory pool */
         elem = nk_pool_alloc(&ctx->pool);
+        if (!elem) ctx->pool_failed += sizeof(struct nk_page_element);
         NK_ASSERT(elem);
         if (!elem) return 0;
+        ctx->stats.page_elements++;
     } else {
         /* allocate new page element from back of fixed size memory buffer */
         NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
@@ -26,6 +28,7 @@ nk_create_page_element(struct nk_context *ctx)
         elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size, align);
         NK_ASSERT(elem);
         if (!elem) return 0;
+        ctx->stats.page_elements++;
     }
     nk_zero_struct(*elem);
     elem->next = 0;
@@ -55,8 +58,71 @@ nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem)
     /* if possible remove last element from back of fixed memory buffer */
     {void *elem_end = (void*)(elem + 1);
     void *buffer_end = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
-    if (elem_end == buffer_end)
+    if (elem_end == buffer_end) {
         ctx->memory.size -= sizeof(struct nk_page_element);
-    else nk_link_page_element_into_freelist(ctx, elem);}
+        ctx->stats.page_elements--;
+    } else nk_link_page_element_into_freelist(ctx, elem);}
+}
+NK_INTERN struct nk_page_element*
+nk_unlink_page_element_range(struct nk_context *ctx, unsigned int count)
+{
+    /* `nk_free_page_elements` returns a block from first to last element,
+     * so a freed block shows up as a run of adjacent elements in descending
+     * order inside the free list. Runs never cross pages since each page
+     * starts with its header. */
+    struct nk_page_element **link = &ctx->freelist;
+    while (*link) {
+        struct nk_page_element **begin = link;
+        struct nk_page_element *iter = *link;
+        unsigned int run = 1;
+        while (run < count && iter->next && iter->next + 1 == iter) {
+            iter = iter->next;
+            run++;
+        }
+        if (run == count) {
+            *begin = iter->next;
+            return iter;
+        }
+        link = &iter->next;
+    }
+    return 0;
+}
+NK_LIB struct nk_page_element*
+nk_create_page_elements(struct nk_context *ctx, unsigned int count)
+{
+    /* allocates `count` page elements in one contiguous block. A block
+     * freed earlier is reused before the pool or memory buffer grows */
+    struct nk_page_element *elem;
+    elem = nk_unlink_page_element_range(ctx, count);
+    if (elem) {
+        nk_zero(elem, sizeof(struct nk_page_element) * count);
+        return elem;
+    }
+    if (ctx->use_pool) {
+        elem = nk_pool_alloc_range(&ctx->pool, count);
+        if (!elem) ctx->pool_failed += sizeof(struct nk_page_element) * count;
+    } else {
+        NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
+        NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+        elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size * count, align);
+    }
+    if (!elem) return 0;
+    ctx->stats.page_elements += count;
+    nk_zero(elem, sizeof(struct nk_page_element) * count);
+    return elem;
+}
+NK_LIB void
+nk_free_page_elements(struct nk_context *ctx, struct nk_page_element *elem,
+    unsigned int count)
+{
+    /* each element of the block is returned separately and can be
+     * reused for windows, panels and tables */
+    unsigned int i;
+    for (i = 0; i < count; ++i) {
+        /* list hooks were overwritten by block content */
+        elem[i].next = 0;
+        elem[i].prev = 0;
+        nk_free_page_element(ctx, &elem[i]);
+    }
 }
 
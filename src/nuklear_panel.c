@@ -560,7 +560,16 @@ nk_panel_end(struct nk_context *ctx)
         if (layout->flags & NK_WINDOW_HIDDEN)
             nk_command_buffer_reset(&window->buffer);
         /* window is visible and not tab */
-        else nk_finish(ctx, window);
+        else {
+            window->draw_bounds = nk_merge_rect(window->draw_bounds, layout->bounds);
+            window->draw_bounds = nk_merge_rect(window->draw_bounds, window->bounds);
+            nk_finish(ctx, window);
+        }
+    } else if ((layout->type & NK_PANEL_SET_POPUP) && window->parent) {
+        /* popups are drawn into the parent's command buffer */
+        struct nk_window *parent = window->parent;
+        parent->draw_bounds = nk_merge_rect(parent->draw_bounds, layout->bounds);
+        parent->draw_bounds = nk_merge_rect(parent->draw_bounds, window->bounds);
     }
 
     /* NK_WINDOW_REMOVE_ROM flag was set so remove NK_WINDOW_ROM */
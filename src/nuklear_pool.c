@@ -36,28 +36,130 @@ nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size)
     if (size < sizeof(struct nk_page)) return;
     pool->capacity = (unsigned)(size - sizeof(struct nk_page)) / sizeof(struct nk_page_element);
     pool->pages = (struct nk_page*)memory;
+    pool->pages->size = 0;
+    pool->pages->capacity = pool->capacity;
+    pool->pages->next = 0;
     pool->type = NK_BUFFER_FIXED;
     pool->size = size;
 }
+NK_INTERN unsigned int
+nk_pool_page_capacity(const struct nk_pool *pool)
+{
+    /* each page doubles the last one so the number of allocations only
+     * grows logarithmically with the number of windows, panels and tables */
+    unsigned int capacity = pool->capacity;
+    if (pool->pages) {
+        unsigned int grown = NK_MIN(pool->pages->capacity, NK_POOL_MAX_CAPACITY/2) * 2;
+        capacity = NK_MAX(capacity, grown);
+    }
+    return capacity;
+}
+NK_INTERN struct nk_page*
+nk_pool_alloc_page(struct nk_pool *pool, unsigned int capacity)
+{
+    struct nk_page *page;
+    nk_size size = sizeof(struct nk_page);
+    size += capacity * sizeof(struct nk_page_element);
+    page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+    NK_ASSERT(page);
+    if (!page) return 0;
+    page->size = 0;
+    page->capacity = capacity;
+    page->next = 0;
+    pool->page_count++;
+    return page;
+}
 NK_LIB struct nk_page_element*
 nk_pool_alloc(struct nk_pool *pool)
 {
-    if (!pool->pages || pool->pages->size >= pool->capacity) {
+    if (!pool->pages || pool->pages->size >= pool->pages->capacity) {
         /* allocate new page */
         struct nk_page *page;
         if (pool->type == NK_BUFFER_FIXED) {
             NK_ASSERT(pool->pages);
             if (!pool->pages) return 0;
-            NK_ASSERT(pool->pages->size < pool->capacity);
+            NK_ASSERT(pool->pages->size < pool->pages->capacity);
             return 0;
         } else {
-            nk_size size = sizeof(struct nk_page);
-            size += NK_POOL_DEFAULT_CAPACITY * sizeof(union nk_page_data);
-            page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+            page = nk_pool_alloc_page(pool, nk_pool_page_capacity(pool));
+            if (!page) return 0;
             page->next = pool->pages;
             pool->pages = page;
-            page->size = 0;
         }
     } return &pool->pages->win[pool->pages->size++];
 }
+NK_LIB struct nk_page_element*
+nk_pool_alloc_range(struct nk_pool *pool, unsigned int count)
+{
+    struct nk_page_element *elem;
+    NK_ASSERT(count);
+    if (!count) return 0;
+    if (pool->pages && pool->pages->size + count <= pool->pages->capacity) {
+        /* enough space left inside current page */
+        elem = &pool->pages->win[pool->pages->size];
+        pool->pages->size += count;
+        return elem;
+    }
+    if (pool->type == NK_BUFFER_FIXED) {
+        return 0;
+    } else {
+        struct nk_page *page;
+        unsigned int capacity = nk_pool_page_capacity(pool);
+        page = nk_pool_alloc_page(pool, NK_MAX(count, capacity));
+        if (!page) return 0;
+        page->size = count;
+        if (pool->pages && count > capacity) {
+            /* oversized page is already full so link it behind the
+             * current page to keep using its remaining space */
+            page->next = pool->pages->next;
+            pool->pages->next = page;
+        } else {
+            page->next = pool->pages;
+            pool->pages = page;
+        }
+        return &page->win[0];
+    }
+}
+NK_LIB nk_size
+nk_pool_shrink(struct nk_pool *pool, struct nk_page_element **freelist,
+    unsigned int *released)
+{
+    struct nk_page **link;
+    nk_size bytes = 0;
+    NK_ASSERT(pool);
+    NK_ASSERT(freelist);
+    NK_ASSERT(released);
+    if (!pool || !freelist || !released) return 0;
+    if (pool->type == NK_BUFFER_FIXED) return 0;
+
+    link = &pool->pages;
+    while (*link) {
+        struct nk_page *page = *link;
+        const struct nk_page_element *begin = &page->win[0];
+        const struct nk_page_element *end = &page->win[page->size];
+        struct nk_page_element **it;
+        unsigned int unused = 0;
+
+        /* page can only be released if all its elements are free */
+        for (it = freelist; *it && unused < page->size; it = &(*it)->next)
+            if (*it >= begin && *it < end) unused++;
+        if (unused < page->size) {
+            link = &page->next;
+            continue;
+        }
+        /* unlink its elements without changing the order of the free list */
+        it = freelist;
+        while (*it) {
+            if (*it >= begin && *it < end)
+                *it = (*it)->next;
+            else it = &(*it)->next;
+        }
+        *link = page->next;
+        *released += page->size;
+        bytes += sizeof(struct nk_page) + page->capacity * sizeof(struct nk_page_element);
+        pool->page_count--;
+        pool->alloc.free(pool->alloc.userdata, page);
+    }
+    return bytes;
+}
 
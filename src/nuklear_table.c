@@ -52,6 +52,87 @@ nk_remove_table(struct nk_window *win, struct nk_table *tbl)
     tbl->next = 0;
     tbl->prev = 0;
 }
+NK_INTERN unsigned int
+nk_table_index_elements(unsigned int slots)
+{
+    nk_size size = slots * sizeof(struct nk_table_slot);
+    return (unsigned int)((size + sizeof(struct nk_page_element)-1) / sizeof(struct nk_page_element));
+}
+NK_INTERN nk_uint
+nk_table_index_probe(nk_hash key, unsigned int size)
+{
+    /* scramble keys since groups store consecutive keys for scroll offsets */
+    nk_hash h = key * 2654435769u;
+    return (nk_uint)(h ^ (h >> 16)) & (size-1);
+}
+NK_INTERN void
+nk_table_index_insert(struct nk_window *win, struct nk_table *tbl, nk_uint index)
+{
+    nk_hash key = tbl->keys[index];
+    nk_uint mask = win->table_index_size-1;
+    nk_uint i = nk_table_index_probe(key, win->table_index_size);
+    while (win->table_index[i].tbl)
+        i = (i + 1) & mask;
+    win->table_index[i].tbl = tbl;
+    win->table_index[i].key = key;
+    win->table_index[i].index = index;
+    win->table_index_count++;
+}
+NK_LIB void
+nk_table_index_free(struct nk_context *ctx, struct nk_window *win)
+{
+    if (!win->table_index) return;
+    nk_free_page_elements(ctx, (struct nk_page_element*)(void*)win->table_index,
+        nk_table_index_elements(win->table_index_size));
+    win->table_index = 0;
+    win->table_index_size = 0;
+    win->table_index_count = 0;
+}
+NK_INTERN int
+nk_table_index_alloc(struct nk_context *ctx, struct nk_window *win,
+    unsigned int values)
+{
+    /* keep load factor below 3/4. An index that is still big enough is
+     * only cleared so removing and adding tables does not churn memory */
+    struct nk_page_element *elem;
+    unsigned int size = nk_round_up_pow2(NK_MAX(values + values/3 + 1, 64));
+    if (win->table_index && win->table_index_size >= size) {
+        nk_zero(win->table_index, win->table_index_size * sizeof(struct nk_table_slot));
+        win->table_index_count = 0;
+        return 1;
+    }
+    nk_table_index_free(ctx, win);
+    elem = nk_create_page_elements(ctx, nk_table_index_elements(size));
+    if (!elem) return 0;
+    win->table_index = (struct nk_table_slot*)(void*)elem;
+    win->table_index_size = size;
+    win->table_index_count = 0;
+    return 1;
+}
+NK_LIB void
+nk_table_index_rebuild(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_table *iter;
+    unsigned int values = 0;
+    NK_ASSERT(ctx);
+    NK_ASSERT(win);
+    if (!ctx || !win) return;
+
+    /* a single table page is searched linearly same as any window
+     * whose index could not be allocated because of missing memory.
+     * Once allocated the index is kept until the window is freed */
+    for (iter = win->tables; iter; iter = iter->next)
+        values += iter->size;
+    if (!win->table_index && (!win->tables || !win->tables->next))
+        return;
+    if (!nk_table_index_alloc(ctx, win, values))
+        return;
+    for (iter = win->tables; iter; iter = iter->next) {
+        unsigned int i = 0;
+        for (i = 0; i < iter->size; ++i)
+            nk_table_index_insert(win, iter, i);
+    }
+}
 NK_LIB nk_uint*
 nk_add_value(struct nk_context *ctx, struct nk_window *win,
             nk_hash name, nk_uint value)
@@ -68,12 +149,33 @@ nk_add_value(struct nk_context *ctx, struct nk_window *win,
     win->tables->seq = win->seq;
     win->tables->keys[win->tables->size] = name;
     win->tables->values[win->tables->size] = value;
-    return &win->tables->values[win->tables->size++];
+    if (win->table_index && (win->table_index_count+1)*4 <= win->table_index_size*3)
+        nk_table_index_insert(win, win->tables, win->tables->size++);
+    else {
+        /* build new or grow index */
+        win->tables->size++;
+        if (win->tables->next || win->table_index)
+            nk_table_index_rebuild(ctx, win);
+    }
+    return &win->tables->values[win->tables->size-1];
 }
 NK_LIB nk_uint*
 nk_find_value(struct nk_window *win, nk_hash name)
 {
     struct nk_table *iter = win->tables;
+    if (win->table_index) {
+        nk_uint mask = win->table_index_size-1;
+        nk_uint i = nk_table_index_probe(name, win->table_index_size);
+        while (win->table_index[i].tbl) {
+            struct nk_table_slot *slot = &win->table_index[i];
+            if (slot->key == name) {
+                slot->tbl->seq = win->seq;
+                return &slot->tbl->values[slot->index];
+            }
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
     while (iter) {
         unsigned int i = 0;
         unsigned int size = iter->size;
@@ -1008,6 +1008,78 @@ nk_file_load(const char* path, nk_size* siz, struct nk_allocator *alloc)
     return buf;
 }
 #endif
+#ifdef NK_INCLUDE_FILE_MAPPING
+NK_LIB void*
+nk_file_map(const char* path, nk_size* siz)
+{
+    /* maps the whole file read-only into memory */
+    void *memory;
+#ifdef _WIN32
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+
+    NK_ASSERT(path);
+    NK_ASSERT(siz);
+    if (!path || !siz) return 0;
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) return 0;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+        (unsigned long long)size.QuadPart > (nk_size)-1) {
+        CloseHandle(file);
+        return 0;
+    }
+    mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    CloseHandle(file);
+    if (!mapping) return 0;
+    memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!memory) return 0;
+    *siz = (nk_size)size.QuadPart;
+#else
+    struct stat st;
+    int fd;
+
+    NK_ASSERT(path);
+    NK_ASSERT(siz);
+    if (!path || !siz) return 0;
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    memory = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return 0;
+    *siz = (nk_size)st.st_size;
+#endif
+    return memory;
+}
+NK_LIB void
+nk_file_unmap(void *memory, nk_size size)
+{
+    if (!memory) return;
+#ifdef _WIN32
+    NK_UNUSED(size);
+    UnmapViewOfFile(memory);
+#else
+    munmap(memory, (size_t)size);
+#endif
+}
+#endif
+NK_INTERN nk_glyph_advance_f
+nk_user_font_advance(const struct nk_user_font *font)
+{
+#ifdef NK_INCLUDE_GLYPH_ADVANCE
+    if (font->advance) return font->advance;
+#endif
+#ifdef NK_INCLUDE_FONT_BAKING
+    return nk_font_baked_advance(font);
+#else
+    return 0;
+#endif
+}
 NK_LIB int
 nk_text_clamp(const struct nk_user_font *font, const char *text,
     int text_len, float space, int *glyphs, float *text_width,
@@ -1025,12 +1097,20 @@ nk_text_clamp(const struct nk_user_font *font, const char *text,
     int sep_len = 0;
     int sep_g = 0;
     float sep_width = 0;
+    nk_glyph_advance_f advance = nk_user_font_advance(font);
     sep_count = NK_MAX(sep_count,0);
 
+    /* sum up glyph advances if provided instead of measuring each prefix.
+     * Invalid glyphs fall back to measuring since fonts may handle them
+     * differently than a single glyph */
     glyph_len = nk_utf_decode(text, &unicode, text_len);
     while (glyph_len && (width < space) && (len < text_len)) {
         len += glyph_len;
-        s = font->width(font->userdata, font->height, text, len);
+        if (advance && unicode == NK_UTF_INVALID)
+            advance = 0;
+        if (advance)
+            s = width + advance(font->userdata, font->height, unicode);
+        else s = font->width(font->userdata, font->height, text, len);
         for (i = 0; i < sep_count; ++i) {
             if (unicode != sep_list[i]) continue;
             sep_width = last_width = width;
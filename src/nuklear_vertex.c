@@ -20,6 +20,34 @@ nk_draw_list_init(struct nk_draw_list *list)
         list->circle_vtx[i].y = (float)NK_SIN(a);
     }
 }
+NK_INTERN void
+nk_draw_list_setup_layout(struct nk_draw_list *list)
+{
+    /* detect the layout used by most backends once instead of walking
+     * the layout description for every vertex */
+    const struct nk_draw_vertex_layout_element *it = list->config.vertex_layout;
+    int found = 0;
+    list->vertex_packed = nk_false;
+    if (!it) return;
+    for (; it->attribute != NK_VERTEX_ATTRIBUTE_COUNT && it->format != NK_FORMAT_COUNT; ++it) {
+        switch (it->attribute) {
+        case NK_VERTEX_POSITION:
+            if (it->format != NK_FORMAT_FLOAT || (found & 1)) return;
+            list->position_offset = it->offset;
+            found |= 1; break;
+        case NK_VERTEX_TEXCOORD:
+            if (it->format != NK_FORMAT_FLOAT || (found & 2)) return;
+            list->uv_offset = it->offset;
+            found |= 2; break;
+        case NK_VERTEX_COLOR:
+            if (it->format != NK_FORMAT_R8G8B8A8 || (found & 4)) return;
+            list->color_offset = it->offset;
+            found |= 4; break;
+        default: return;
+        }
+    }
+    list->vertex_packed = (found == 7);
+}
 NK_API void
 nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *config,
     struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements,
@@ -47,6 +75,7 @@ nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *
     canvas->cmd_offset = 0;
     canvas->cmd_count = 0;
     canvas->path_count = 0;
+    nk_draw_list_setup_layout(canvas);
 }
 NK_API const struct nk_draw_command*
 nk__draw_list_begin(const struct nk_draw_list *canvas, const struct nk_buffer *buffer)
@@ -128,14 +157,30 @@ nk_draw_list_path_last(struct nk_draw_list *list)
     return *point;
 }
 NK_INTERN struct nk_draw_command*
+nk_draw_list_command_last(struct nk_draw_list *list)
+{
+    void *memory;
+    nk_size size;
+    struct nk_draw_command *cmd;
+    NK_ASSERT(list->cmd_count);
+
+    memory = nk_buffer_memory(list->buffer);
+    size = nk_buffer_total(list->buffer);
+    cmd = nk_ptr_add(struct nk_draw_command, memory, size - list->cmd_offset);
+    return (cmd - (list->cmd_count-1));
+}
+NK_INTERN struct nk_draw_command*
 nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     nk_handle texture)
 {
     NK_STORAGE const nk_size cmd_align = NK_ALIGNOF(struct nk_draw_command);
     NK_STORAGE const nk_size cmd_size = sizeof(struct nk_draw_command);
     struct nk_draw_command *cmd;
+    unsigned int vertex_offset = 0;
 
     NK_ASSERT(list);
+    if (list->cmd_count)
+        vertex_offset = nk_draw_list_command_last(list)->vertex_offset;
     cmd = (struct nk_draw_command*)
         nk_buffer_alloc(list->buffer, NK_BUFFER_BACK, cmd_size, cmd_align);
 
@@ -150,6 +195,7 @@ nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     cmd->elem_count = 0;
     cmd->clip_rect = clip;
     cmd->texture = texture;
+    cmd->vertex_offset = vertex_offset;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     cmd->userdata = list->userdata;
 #endif
@@ -158,19 +204,6 @@ nk_draw_list_push_command(struct nk_draw_list *list, struct nk_rect clip,
     list->clip_rect = clip;
     return cmd;
 }
-NK_INTERN struct nk_draw_command*
-nk_draw_list_command_last(struct nk_draw_list *list)
-{
-    void *memory;
-    nk_size size;
-    struct nk_draw_command *cmd;
-    NK_ASSERT(list->cmd_count);
-
-    memory = nk_buffer_memory(list->buffer);
-    size = nk_buffer_total(list->buffer);
-    cmd = nk_ptr_add(struct nk_draw_command, memory, size - list->cmd_offset);
-    return (cmd - (list->cmd_count-1));
-}
 NK_INTERN void
 nk_draw_list_add_clip(struct nk_draw_list *list, struct nk_rect rect)
 {
@@ -219,24 +252,54 @@ nk_draw_list_alloc_vertices(struct nk_draw_list *list, nk_size count)
     void *vtx;
     NK_ASSERT(list);
     if (!list) return 0;
+    if (sizeof(nk_draw_index) == 2 && list->cmd_count) {
+        /* start a new draw command based at the current vertex if the new
+         * vertices cannot be reached by 16-bit indices from the last one */
+        struct nk_draw_command *cmd = nk_draw_list_command_last(list);
+        if (list->vertex_count + count - cmd->vertex_offset >= NK_USHORT_MAX) {
+            if (cmd->elem_count) {
+            #ifdef NK_INCLUDE_COMMAND_USERDATA
+                nk_handle userdata = list->userdata;
+                list->userdata = cmd->userdata;
+            #endif
+                cmd = nk_draw_list_push_command(list, cmd->clip_rect, cmd->texture);
+            #ifdef NK_INCLUDE_COMMAND_USERDATA
+                list->userdata = userdata;
+            #endif
+                if (!cmd) return 0;
+            }
+            cmd->vertex_offset = list->vertex_count;
+        }
+    }
     vtx = nk_buffer_alloc(list->vertices, NK_BUFFER_FRONT,
         list->config.vertex_size*count, list->config.vertex_alignment);
     if (!vtx) return 0;
     list->vertex_count += (unsigned int)count;
 
-    /* This assert triggers because your are drawing a lot of stuff and nuklear
-     * defined `nk_draw_index` as `nk_ushort` to safe space be default.
+    /* This assert triggers because a single primitive needs more vertices
+     * than can be addressed by `nk_draw_index`, which nuklear defines as
+     * `nk_ushort` to safe space by default. Larger frames are split into
+     * multiple draw commands automatically (see `nk_draw_command.vertex_offset`).
      *
-     * So you reached the maximum number of indicies or rather vertexes.
-     * To solve this issue please change typdef `nk_draw_index` to `nk_uint`
-     * and don't forget to specify the new element size in your drawing
-     * backend (OpenGL, DirectX, ...). For example in OpenGL for `glDrawElements`
-     * instead of specifing `GL_UNSIGNED_SHORT` you have to define `GL_UNSIGNED_INT`.
-     * Sorry for the inconvenience. */
-    if(sizeof(nk_draw_index)==2) NK_ASSERT((list->vertex_count < NK_USHORT_MAX &&
+     * To solve this issue please define `NK_UINT_DRAW_INDEX` and don't forget
+     * to specify the new element size in your drawing backend (OpenGL, DirectX, ...).
+     * For example in OpenGL for `glDrawElements` instead of specifing
+     * `GL_UNSIGNED_SHORT` you have to define `GL_UNSIGNED_INT`. */
+    if(sizeof(nk_draw_index)==2 && list->cmd_count) NK_ASSERT((list->vertex_count -
+        nk_draw_list_command_last(list)->vertex_offset < NK_USHORT_MAX &&
         "To many verticies for 16-bit vertex indicies. Please read comment above on how to solve this problem"));
     return vtx;
 }
+NK_INTERN nk_size
+nk_draw_list_vertex_index(struct nk_draw_list *list, nk_size count)
+{
+    /* index of the first of the last `count` allocated vertices
+     * relative to the vertex offset of the current draw command */
+    nk_size index = list->vertex_count - count;
+    if (list->cmd_count)
+        index -= nk_draw_list_command_last(list)->vertex_offset;
+    return index;
+}
 NK_INTERN nk_draw_index*
 nk_draw_list_alloc_elements(struct nk_draw_list *list, nk_size count)
 {
@@ -392,11 +455,24 @@ nk_draw_vertex_element(void *dst, const float *values, int value_count,
     }
 }
 NK_INTERN void*
-nk_draw_vertex(void *dst, const struct nk_convert_config *config,
+nk_draw_vertex(void *dst, const struct nk_draw_list *list,
     struct nk_vec2 pos, struct nk_vec2 uv, struct nk_colorf color)
 {
-    void *result = (void*)((char*)dst + config->vertex_size);
-    const struct nk_draw_vertex_layout_element *elem_iter = config->vertex_layout;
+    void *result = (void*)((char*)dst + list->config.vertex_size);
+    const struct nk_draw_vertex_layout_element *elem_iter = list->config.vertex_layout;
+    if (list->vertex_packed) {
+        struct nk_color col;
+        float val[4];
+        val[0] = NK_SATURATE(color.r);
+        val[1] = NK_SATURATE(color.g);
+        val[2] = NK_SATURATE(color.b);
+        val[3] = NK_SATURATE(color.a);
+        col = nk_rgba_fv(val);
+        NK_MEMCPY((char*)dst + list->position_offset, &pos, sizeof(pos));
+        NK_MEMCPY((char*)dst + list->uv_offset, &uv, sizeof(uv));
+        NK_MEMCPY((char*)dst + list->color_offset, &col, sizeof(col));
+        return result;
+    }
     while (!nk_draw_vertex_layout_element_is_end_of_layout(elem_iter)) {
         void *address = (void*)((char*)dst + elem_iter->offset);
         switch (elem_iter->attribute) {
@@ -410,6 +486,88 @@ nk_draw_vertex(void *dst, const struct nk_convert_config *config,
     }
     return result;
 }
+NK_INTERN void
+nk_draw_list_normals(struct nk_vec2 *normals, const struct nk_vec2 *points,
+    nk_size count, nk_size points_count)
+{
+    /* normal of the segment from point i to point i+1 (wrapping around) */
+    nk_size i1 = 0;
+#ifdef NK_SSE2
+    const __m128 sign = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    for (; i1 + 1 < count && i1 + 2 < points_count; i1 += 2) {
+        __m128 a = _mm_loadu_ps(&points[i1].x);
+        __m128 b = _mm_loadu_ps(&points[i1+1].x);
+        __m128 diff = _mm_sub_ps(b, a);
+        __m128 sqr = _mm_mul_ps(diff, diff);
+        __m128 len = _mm_add_ps(sqr, _mm_shuffle_ps(sqr, sqr, _MM_SHUFFLE(2,3,0,1)));
+        __m128 x2 = _mm_mul_ps(len, _mm_set1_ps(0.5f));
+        __m128 mask = _mm_cmpneq_ps(len, _mm_setzero_ps());
+        __m128 inv = _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(0x5f375A84),
+            _mm_srli_epi32(_mm_castps_si128(len), 1)));
+
+        /* same steps as nk_inv_sqrt */
+        inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(1.5f),
+            _mm_mul_ps(_mm_mul_ps(x2, inv), inv)));
+        inv = _mm_or_ps(_mm_and_ps(mask, inv), _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+        diff = _mm_mul_ps(diff, inv);
+        diff = _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2,3,0,1));
+        _mm_storeu_ps(&normals[i1].x, _mm_xor_ps(diff, sign));
+    }
+#endif
+    for (; i1 < count; ++i1) {
+        const nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
+        struct nk_vec2 diff = nk_vec2_sub(points[i2], points[i1]);
+        float len;
+
+        /* vec2 inverted length  */
+        len = nk_vec2_len_sqr(diff);
+        if (len != 0.0f)
+            len = nk_inv_sqrt(len);
+        else len = 1.0f;
+
+        diff = nk_vec2_muls(diff, len);
+        normals[i1].x = diff.y;
+        normals[i1].y = -diff.x;
+    }
+}
+NK_INTERN struct nk_vec2
+nk_draw_list_miter(struct nk_vec2 n0, struct nk_vec2 n1)
+{
+    /* average normals */
+    struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(n0, n1), 0.5f);
+    float dmr2 = dm.x * dm.x + dm.y * dm.y;
+    if (dmr2 > 0.000001f) {
+        float scale = 1.0f/dmr2;
+        scale = NK_MIN(100.0f, scale);
+        dm = nk_vec2_muls(dm, scale);
+    }
+    return dm;
+}
+NK_INTERN void
+nk_draw_list_miters(struct nk_vec2 *normals, nk_size points_count, int closed)
+{
+    /* replace each normal with the averaged normal of the point at the
+     * start of its segment. Runs backwards to work in place. */
+    nk_size i = points_count - 1;
+    struct nk_vec2 first = normals[0];
+    if (closed) first = nk_draw_list_miter(normals[points_count-1], normals[0]);
+#ifdef NK_SSE2
+    for (; i >= 2; i -= 2) {
+        __m128 n0 = _mm_loadu_ps(&normals[i-2].x);
+        __m128 n1 = _mm_loadu_ps(&normals[i-1].x);
+        __m128 dm = _mm_mul_ps(_mm_add_ps(n0, n1), _mm_set1_ps(0.5f));
+        __m128 sqr = _mm_mul_ps(dm, dm);
+        __m128 dmr2 = _mm_add_ps(sqr, _mm_shuffle_ps(sqr, sqr, _MM_SHUFFLE(2,3,0,1)));
+        __m128 mask = _mm_cmpgt_ps(dmr2, _mm_set1_ps(0.000001f));
+        __m128 scale = _mm_min_ps(_mm_set1_ps(100.0f), _mm_div_ps(_mm_set1_ps(1.0f), dmr2));
+        dm = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm, scale)), _mm_andnot_ps(mask, dm));
+        _mm_storeu_ps(&normals[i-1].x, dm);
+    }
+#endif
+    for (; i > 0; --i)
+        normals[i] = nk_draw_list_miter(normals[i-1], normals[i]);
+    normals[0] = first;
+}
 NK_API void
 nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *points,
     const unsigned int points_count, struct nk_color color, enum nk_draw_list_stroke closed,
@@ -445,7 +603,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         /* allocate vertices and elements  */
         nk_size i1 = 0;
         nk_size vertex_offset;
-        nk_size index = list->vertex_count;
+        nk_size index;
 
         const nk_size idx_count = (thick_line) ?  (count * 18) : (count * 12);
         const nk_size vtx_count = (thick_line) ? (points_count * 4): (points_count *3);
@@ -456,6 +614,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         nk_size size;
         struct nk_vec2 *normals, *temp;
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
 
         /* temporary allocate normals + points */
         vertex_offset = (nk_size)((nk_byte*)vtx - (nk_byte*)list->vertices->memory.ptr);
@@ -469,22 +628,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
         vtx = (void*)((nk_byte*)list->vertices->memory.ptr + vertex_offset);
 
         /* calculate normals */
-        for (i1 = 0; i1 < count; ++i1) {
-            const nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
-            struct nk_vec2 diff = nk_vec2_sub(points[i2], points[i1]);
-            float len;
-
-            /* vec2 inverted length  */
-            len = nk_vec2_len_sqr(diff);
-            if (len != 0.0f)
-                len = nk_inv_sqrt(len);
-            else len = 1.0f;
-
-            diff = nk_vec2_muls(diff, len);
-            normals[i1].x = diff.y;
-            normals[i1].y = -diff.x;
-        }
-
+        nk_draw_list_normals(normals, points, count, points_count);
         if (!closed)
             normals[points_count-1] = normals[points_count-2];
 
@@ -498,25 +642,16 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 temp[(points_count-1) * 2 + 0] = nk_vec2_add(points[points_count-1], d);
                 temp[(points_count-1) * 2 + 1] = nk_vec2_sub(points[points_count-1], d);
             }
+            nk_draw_list_miters(normals, points_count, closed);
 
             /* fill elements */
             idx1 = index;
             for (i1 = 0; i1 < count; i1++) {
                 struct nk_vec2 dm;
-                float dmr2;
                 nk_size i2 = ((i1 + 1) == points_count) ? 0 : (i1 + 1);
                 nk_size idx2 = ((i1+1) == points_count) ? index: (idx1 + 3);
 
-                /* average normals */
-                dm = nk_vec2_muls(nk_vec2_add(normals[i1], normals[i2]), 0.5f);
-                dmr2 = dm.x * dm.x + dm.y* dm.y;
-                if (dmr2 > 0.000001f) {
-                    float scale = 1.0f/dmr2;
-                    scale = NK_MIN(100.0f, scale);
-                    dm = nk_vec2_muls(dm, scale);
-                }
-
-                dm = nk_vec2_muls(dm, AA_SIZE);
+                dm = nk_vec2_muls(normals[i2], AA_SIZE);
                 temp[i2*2+0] = nk_vec2_add(points[i2], dm);
                 temp[i2*2+1] = nk_vec2_sub(points[i2], dm);
 
@@ -533,9 +668,9 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             /* fill vertices */
             for (i = 0; i < points_count; ++i) {
                 const struct nk_vec2 uv = list->config.null.uv;
-                vtx = nk_draw_vertex(vtx, &list->config, points[i], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*2+0], uv, col_trans);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*2+1], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, points[i], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*2+0], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*2+1], uv, col_trans);
             }
         } else {
             nk_size idx1, i;
@@ -557,6 +692,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 temp[(points_count-1)*4+2] = nk_vec2_sub(points[points_count-1], d2);
                 temp[(points_count-1)*4+3] = nk_vec2_sub(points[points_count-1], d1);
             }
+            nk_draw_list_miters(normals, points_count, closed);
 
             /* add all elements */
             idx1 = index;
@@ -564,15 +700,7 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
                 struct nk_vec2 dm_out, dm_in;
                 const nk_size i2 = ((i1+1) == points_count) ? 0: (i1 + 1);
                 nk_size idx2 = ((i1+1) == points_count) ? index: (idx1 + 4);
-
-                /* average normals */
-                struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(normals[i1], normals[i2]), 0.5f);
-                float dmr2 = dm.x * dm.x + dm.y* dm.y;
-                if (dmr2 > 0.000001f) {
-                    float scale = 1.0f/dmr2;
-                    scale = NK_MIN(100.0f, scale);
-                    dm = nk_vec2_muls(dm, scale);
-                }
+                const struct nk_vec2 dm = normals[i2];
 
                 dm_out = nk_vec2_muls(dm, ((half_inner_thickness) + AA_SIZE));
                 dm_in = nk_vec2_muls(dm, half_inner_thickness);
@@ -598,10 +726,10 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             /* add vertices */
             for (i = 0; i < points_count; ++i) {
                 const struct nk_vec2 uv = list->config.null.uv;
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+0], uv, col_trans);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+1], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+2], uv, col);
-                vtx = nk_draw_vertex(vtx, &list->config, temp[i*4+3], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+0], uv, col_trans);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+1], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+2], uv, col);
+                vtx = nk_draw_vertex(vtx, list, temp[i*4+3], uv, col_trans);
             }
         }
         /* free temporary normals + points */
@@ -609,12 +737,13 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
     } else {
         /* NON ANTI-ALIASED STROKE */
         nk_size i1 = 0;
-        nk_size idx = list->vertex_count;
+        nk_size idx;
         const nk_size idx_count = count * 6;
         const nk_size vtx_count = count * 4;
         void *vtx = nk_draw_list_alloc_vertices(list, vtx_count);
         nk_draw_index *ids = nk_draw_list_alloc_elements(list, idx_count);
         if (!vtx || !ids) return;
+        idx = nk_draw_list_vertex_index(list, vtx_count);
 
         for (i1 = 0; i1 < count; ++i1) {
             float dx, dy;
@@ -636,10 +765,10 @@ nk_draw_list_stroke_poly_line(struct nk_draw_list *list, const struct nk_vec2 *p
             dx = diff.x * (thickness * 0.5f);
             dy = diff.y * (thickness * 0.5f);
 
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p1.x + dy, p1.y - dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p2.x + dy, p2.y - dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p2.x - dy, p2.y + dx), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(p1.x - dy, p1.y + dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p1.x + dy, p1.y - dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p2.x + dy, p2.y - dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p2.x - dy, p2.y + dx), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2(p1.x - dy, p1.y + dx), uv, col);
 
             ids[0] = (nk_draw_index)(idx+0); ids[1] = (nk_draw_index)(idx+1);
             ids[2] = (nk_draw_index)(idx+2); ids[3] = (nk_draw_index)(idx+0);
@@ -679,7 +808,7 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
 
         const float AA_SIZE = 1.0f;
         nk_size vertex_offset = 0;
-        nk_size index = list->vertex_count;
+        nk_size index;
 
         const nk_size idx_count = (points_count-2)*3 + points_count*6;
         const nk_size vtx_count = (points_count*2);
@@ -689,9 +818,12 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
 
         nk_size size = 0;
         struct nk_vec2 *normals = 0;
-        unsigned int vtx_inner_idx = (unsigned int)(index + 0);
-        unsigned int vtx_outer_idx = (unsigned int)(index + 1);
+        unsigned int vtx_inner_idx;
+        unsigned int vtx_outer_idx;
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
+        vtx_inner_idx = (unsigned int)(index + 0);
+        vtx_outer_idx = (unsigned int)(index + 1);
 
         /* temporary allocate normals */
         vertex_offset = (nk_size)((nk_byte*)vtx - (nk_byte*)list->vertices->memory.ptr);
@@ -710,39 +842,17 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
         }
 
         /* compute normals */
-        for (i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++) {
-            struct nk_vec2 p0 = points[i0];
-            struct nk_vec2 p1 = points[i1];
-            struct nk_vec2 diff = nk_vec2_sub(p1, p0);
-
-            /* vec2 inverted length  */
-            float len = nk_vec2_len_sqr(diff);
-            if (len != 0.0f)
-                len = nk_inv_sqrt(len);
-            else len = 1.0f;
-            diff = nk_vec2_muls(diff, len);
-
-            normals[i0].x = diff.y;
-            normals[i0].y = -diff.x;
-        }
+        nk_draw_list_normals(normals, points, points_count, points_count);
+        nk_draw_list_miters(normals, points_count, nk_true);
 
         /* add vertices + indexes */
         for (i0 = points_count-1, i1 = 0; i1 < points_count; i0 = i1++) {
             const struct nk_vec2 uv = list->config.null.uv;
-            struct nk_vec2 n0 = normals[i0];
-            struct nk_vec2 n1 = normals[i1];
-            struct nk_vec2 dm = nk_vec2_muls(nk_vec2_add(n0, n1), 0.5f);
-            float dmr2 = dm.x*dm.x + dm.y*dm.y;
-            if (dmr2 > 0.000001f) {
-                float scale = 1.0f / dmr2;
-                scale = NK_MIN(scale, 100.0f);
-                dm = nk_vec2_muls(dm, scale);
-            }
-            dm = nk_vec2_muls(dm, AA_SIZE * 0.5f);
+            const struct nk_vec2 dm = nk_vec2_muls(normals[i1], AA_SIZE * 0.5f);
 
             /* add vertices */
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2_sub(points[i1], dm), uv, col);
-            vtx = nk_draw_vertex(vtx, &list->config, nk_vec2_add(points[i1], dm), uv, col_trans);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2_sub(points[i1], dm), uv, col);
+            vtx = nk_draw_vertex(vtx, list, nk_vec2_add(points[i1], dm), uv, col_trans);
 
             /* add indexes */
             ids[0] = (nk_draw_index)(vtx_inner_idx+(i1<<1));
@@ -757,15 +867,16 @@ nk_draw_list_fill_poly_convex(struct nk_draw_list *list,
         nk_buffer_reset(list->vertices, NK_BUFFER_FRONT);
     } else {
         nk_size i = 0;
-        nk_size index = list->vertex_count;
+        nk_size index;
         const nk_size idx_count = (points_count-2)*3;
         const nk_size vtx_count = points_count;
         void *vtx = nk_draw_list_alloc_vertices(list, vtx_count);
         nk_draw_index *ids = nk_draw_list_alloc_elements(list, idx_count);
 
         if (!vtx || !ids) return;
+        index = nk_draw_list_vertex_index(list, vtx_count);
         for (i = 0; i < vtx_count; ++i)
-            vtx = nk_draw_vertex(vtx, &list->config, points[i], list->config.null.uv, col);
+            vtx = nk_draw_vertex(vtx, list, points[i], list->config.null.uv, col);
         for (i = 2; i < points_count; ++i) {
             ids[0] = (nk_draw_index)index;
             ids[1] = (nk_draw_index)(index+ i - 1);
@@ -998,19 +1109,19 @@ nk_draw_list_fill_rect_multi_color(struct nk_draw_list *list, struct nk_rect rec
     if (!list) return;
 
     nk_draw_list_push_image(list, list->config.null.texture);
-    index = (nk_draw_index)list->vertex_count;
     vtx = nk_draw_list_alloc_vertices(list, 4);
     idx = nk_draw_list_alloc_elements(list, 6);
     if (!vtx || !idx) return;
+    index = (nk_draw_index)nk_draw_list_vertex_index(list, 4);
 
     idx[0] = (nk_draw_index)(index+0); idx[1] = (nk_draw_index)(index+1);
     idx[2] = (nk_draw_index)(index+2); idx[3] = (nk_draw_index)(index+0);
     idx[4] = (nk_draw_index)(index+2); idx[5] = (nk_draw_index)(index+3);
 
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x, rect.y), list->config.null.uv, col_left);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x + rect.w, rect.y), list->config.null.uv, col_top);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x + rect.w, rect.y + rect.h), list->config.null.uv, col_right);
-    vtx = nk_draw_vertex(vtx, &list->config, nk_vec2(rect.x, rect.y + rect.h), list->config.null.uv, col_bottom);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x, rect.y), list->config.null.uv, col_left);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x + rect.w, rect.y), list->config.null.uv, col_top);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x + rect.w, rect.y + rect.h), list->config.null.uv, col_right);
+    vtx = nk_draw_vertex(vtx, list, nk_vec2(rect.x, rect.y + rect.h), list->config.null.uv, col_bottom);
 }
 NK_API void
 nk_draw_list_fill_triangle(struct nk_draw_list *list, struct nk_vec2 a,
@@ -1090,19 +1201,19 @@ nk_draw_list_push_rect_uv(struct nk_draw_list *list, struct nk_vec2 a,
     b = nk_vec2(c.x, a.y);
     d = nk_vec2(a.x, c.y);
 
-    index = (nk_draw_index)list->vertex_count;
     vtx = nk_draw_list_alloc_vertices(list, 4);
     idx = nk_draw_list_alloc_elements(list, 6);
     if (!vtx || !idx) return;
+    index = (nk_draw_index)nk_draw_list_vertex_index(list, 4);
 
     idx[0] = (nk_draw_index)(index+0); idx[1] = (nk_draw_index)(index+1);
     idx[2] = (nk_draw_index)(index+2); idx[3] = (nk_draw_index)(index+0);
     idx[4] = (nk_draw_index)(index+2); idx[5] = (nk_draw_index)(index+3);
 
-    vtx = nk_draw_vertex(vtx, &list->config, a, uva, col);
-    vtx = nk_draw_vertex(vtx, &list->config, b, uvb, col);
-    vtx = nk_draw_vertex(vtx, &list->config, c, uvc, col);
-    vtx = nk_draw_vertex(vtx, &list->config, d, uvd, col);
+    vtx = nk_draw_vertex(vtx, list, a, uva, col);
+    vtx = nk_draw_vertex(vtx, list, b, uvb, col);
+    vtx = nk_draw_vertex(vtx, list, c, uvc, col);
+    vtx = nk_draw_vertex(vtx, list, d, uvd, col);
 }
 NK_API void
 nk_draw_list_add_image(struct nk_draw_list *list, struct nk_image texture,
@@ -1175,6 +1286,536 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
         unicode = next;
     }
 }
+NK_INTERN void
+nk_convert_command(struct nk_draw_list *list, const struct nk_command *cmd,
+    const struct nk_convert_config *config)
+{
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    list->userdata = cmd->userdata;
+#endif
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        nk_draw_list_add_clip(list, nk_rect(s->x, s->y, s->w, s->h));
+    } break;
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        nk_draw_list_stroke_line(list, nk_vec2(l->begin.x, l->begin.y),
+            nk_vec2(l->end.x, l->end.y), l->color, l->line_thickness);
+    } break;
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        nk_draw_list_stroke_curve(list, nk_vec2(q->begin.x, q->begin.y),
+            nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
+            q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
+            config->curve_segment_count, q->line_thickness);
+    } break;
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        nk_draw_list_stroke_rect(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->color, (float)r->rounding, r->line_thickness);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        nk_draw_list_fill_rect(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->color, (float)r->rounding);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        nk_draw_list_fill_rect_multi_color(list, nk_rect(r->x, r->y, r->w, r->h),
+            r->left, r->top, r->right, r->bottom);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        nk_draw_list_stroke_circle(list, nk_vec2((float)c->x + (float)c->w/2,
+            (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
+            config->circle_segment_count, c->line_thickness);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
+        nk_draw_list_fill_circle(list, nk_vec2((float)c->x + (float)c->w/2,
+            (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
+            config->circle_segment_count);
+    } break;
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
+        nk_draw_list_path_line_to(list, nk_vec2(c->cx, c->cy));
+        nk_draw_list_path_arc_to(list, nk_vec2(c->cx, c->cy), c->r,
+            c->a[0], c->a[1], config->arc_segment_count);
+        nk_draw_list_path_stroke(list, c->color, NK_STROKE_CLOSED, c->line_thickness);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
+        nk_draw_list_path_line_to(list, nk_vec2(c->cx, c->cy));
+        nk_draw_list_path_arc_to(list, nk_vec2(c->cx, c->cy), c->r,
+            c->a[0], c->a[1], config->arc_segment_count);
+        nk_draw_list_path_fill(list, c->color);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        nk_draw_list_stroke_triangle(list, nk_vec2(t->a.x, t->a.y),
+            nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color,
+            t->line_thickness);
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        nk_draw_list_fill_triangle(list, nk_vec2(t->a.x, t->a.y),
+            nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color);
+    } break;
+    case NK_COMMAND_POLYGON: {
+        int i;
+        const struct nk_command_polygon*p = (const struct nk_command_polygon*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_stroke(list, p->color, NK_STROKE_CLOSED, p->line_thickness);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        int i;
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_fill(list, p->color);
+    } break;
+    case NK_COMMAND_POLYLINE: {
+        int i;
+        const struct nk_command_polyline *p = (const struct nk_command_polyline*)cmd;
+        for (i = 0; i < p->point_count; ++i) {
+            struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
+            nk_draw_list_path_line_to(list, pnt);
+        }
+        nk_draw_list_path_stroke(list, p->color, NK_STROKE_OPEN, p->line_thickness);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        nk_draw_list_add_text(list, t->font, nk_rect(t->x, t->y, t->w, t->h),
+            t->string, t->length, t->height, t->foreground);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        nk_draw_list_add_image(list, i->img, nk_rect(i->x, i->y, i->w, i->h), i->col);
+    } break;
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        c->callback(list, c->x, c->y, c->w, c->h, c->callback_data);
+    } break;
+    default: break;
+    }
+}
+NK_INTERN nk_hash
+nk_convert_config_hash(const struct nk_convert_config *config)
+{
+    const struct nk_draw_vertex_layout_element *it;
+    nk_hash hash = 0;
+    hash = nk_command_hash(hash, &config->global_alpha, sizeof(config->global_alpha));
+    hash = nk_command_hash(hash, &config->line_AA, sizeof(config->line_AA));
+    hash = nk_command_hash(hash, &config->shape_AA, sizeof(config->shape_AA));
+    hash = nk_command_hash(hash, &config->circle_segment_count, sizeof(config->circle_segment_count));
+    hash = nk_command_hash(hash, &config->arc_segment_count, sizeof(config->arc_segment_count));
+    hash = nk_command_hash(hash, &config->curve_segment_count, sizeof(config->curve_segment_count));
+    hash = nk_command_hash(hash, &config->null.texture, sizeof(config->null.texture));
+    hash = nk_command_hash(hash, &config->null.uv, sizeof(config->null.uv));
+    hash = nk_command_hash(hash, &config->vertex_size, sizeof(config->vertex_size));
+    hash = nk_command_hash(hash, &config->vertex_alignment, sizeof(config->vertex_alignment));
+    for (it = config->vertex_layout; !nk_draw_vertex_layout_element_is_end_of_layout(it); ++it) {
+        hash = nk_command_hash(hash, &it->attribute, sizeof(it->attribute));
+        hash = nk_command_hash(hash, &it->format, sizeof(it->format));
+        hash = nk_command_hash(hash, &it->offset, sizeof(it->offset));
+    }
+    return hash;
+}
+NK_LIB void
+nk_vertex_cache_free(struct nk_vertex_cache *cache)
+{
+    NK_ASSERT(cache);
+    if (!cache) return;
+    nk_buffer_free(&cache->commands);
+    nk_buffer_free(&cache->vertices);
+    nk_buffer_free(&cache->elements);
+    nk_zero(cache, sizeof(*cache));
+}
+NK_INTERN void
+nk_vertex_cache_begin(struct nk_vertex_cache *cache, const struct nk_allocator *alloc)
+{
+    cache->valid = nk_false;
+    if (!cache->commands.memory.ptr) {
+        nk_buffer_init(&cache->commands, alloc, 1024);
+        nk_buffer_init(&cache->vertices, alloc, 4*1024);
+        nk_buffer_init(&cache->elements, alloc, 1024);
+    } else {
+        nk_buffer_clear(&cache->commands);
+        nk_buffer_clear(&cache->vertices);
+        nk_buffer_clear(&cache->elements);
+    }
+}
+NK_INTERN nk_hash
+nk_vertex_cache_key(const struct nk_window *win, nk_hash config_hash,
+    const struct nk_draw_command *last, struct nk_rect clip)
+{
+    /* converting a window continues the last draw command if possible,
+     * so the state of the draw list is part of the key */
+    nk_size size = win->buffer.last - win->buffer.begin;
+    int empty = last ? (last->elem_count == 0): -1;
+    nk_hash hash = nk_command_hash(win->buffer.hash, &config_hash, sizeof(config_hash));
+    hash = nk_command_hash(hash, &size, sizeof(size));
+    hash = nk_command_hash(hash, &clip, sizeof(clip));
+    hash = nk_command_hash(hash, &empty, sizeof(empty));
+    if (last) {
+        hash = nk_command_hash(hash, &last->clip_rect, sizeof(last->clip_rect));
+        hash = nk_command_hash(hash, &last->texture, sizeof(last->texture));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+        hash = nk_command_hash(hash, &last->userdata, sizeof(last->userdata));
+#endif
+    }
+    return hash;
+}
+NK_INTERN int
+nk_vertex_cache_skip(const struct nk_context *ctx, const struct nk_window *win)
+{
+    /* same windows `nk_build` links into the draw command list */
+    return win->buffer.last == win->buffer.begin || (win->flags & NK_WINDOW_HIDDEN) ||
+        win->seq != ctx->seq;
+}
+NK_INTERN int
+nk_convert_dynamic_text(const struct nk_command *cmd)
+{
+    /* text of a dynamic font atlas rasterizes glyphs into the shared atlas
+     * cache and may evict glyphs other windows were converted with */
+#ifdef NK_INCLUDE_FONT_BAKING
+    return cmd->type == NK_COMMAND_TEXT &&
+        nk_user_font_is_dynamic(((const struct nk_command_text*)cmd)->font);
+#else
+    NK_UNUSED(cmd);
+    return nk_false;
+#endif
+}
+NK_INTERN int
+nk_vertex_cache_serial(struct nk_context *ctx, const struct nk_window *win)
+{
+    /* visits the same commands as `nk_vertex_cache_convert` */
+    const struct nk_command *cmd, *first, *last;
+    first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+    last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+    for (cmd = first; cmd != last; cmd = nk__next(ctx, cmd)) {
+        if (!cmd || cmd->type == NK_COMMAND_CUSTOM) return nk_false;
+        if (nk_convert_dynamic_text(cmd)) return nk_true;
+        if (cmd->next < win->buffer.begin || cmd->next > win->buffer.last)
+            return nk_false;
+    }
+    return nk_convert_dynamic_text(cmd);
+}
+NK_INTERN void
+nk_vertex_cache_end(struct nk_vertex_cache *cache, struct nk_draw_list *list,
+    unsigned int cmd_count, unsigned int elem_count, unsigned int vertex_count,
+    unsigned int element_count)
+{
+    struct nk_draw_command *cmds;
+    struct nk_buffer *buffer = list->buffer;
+    nk_size vertex_size;
+
+    cache->cmd_count = list->cmd_count - cmd_count + (cmd_count ? 1: 0);
+    cache->vertex_count = list->vertex_count - vertex_count;
+    cache->element_count = list->element_count - element_count;
+    cache->clip_rect = list->clip_rect;
+    if (!cache->cmd_count) return;
+
+    /* only keep complete output */
+    vertex_size = cache->vertex_count * list->config.vertex_size;
+    if (buffer->needed > buffer->allocated + (buffer->memory.size - buffer->size) ||
+        list->vertices->needed > list->vertices->allocated ||
+        list->elements->needed > list->elements->allocated ||
+        list->vertices->allocated < vertex_size)
+        return;
+
+    /* indices have to be relative to the first cached vertex */
+    cmds = nk_draw_list_command_last(list) + (cache->cmd_count - 1);
+    if (cmds->vertex_offset || nk_draw_list_command_last(list)->vertex_offset)
+        return;
+
+    /* the continued draw command only stores the number of added elements */
+    if (cmd_count) cmds->elem_count -= elem_count;
+    cache->cmd_offset = (nk_size)((nk_byte*)cmds - (nk_byte*)buffer->memory.ptr);
+    cache->valid = nk_true;
+}
+NK_INTERN void
+nk_vertex_cache_replay(struct nk_draw_list *list, const struct nk_vertex_cache *cache)
+{
+    const struct nk_draw_command *cmds;
+    const nk_draw_index *ids;
+    struct nk_draw_command *dst;
+    nk_draw_index *elements;
+    unsigned int i = 0, base, vertex_offset = 0;
+    nk_size size;
+    void *vtx;
+
+    /* draw commands are stored back to front like in the draw list */
+    cmds = nk_ptr_add_const(struct nk_draw_command, cache->commands.memory.ptr, cache->cmd_offset);
+    if (list->cmd_count) {
+        unsigned int count;
+        dst = nk_draw_list_command_last(list);
+        count = dst->elem_count;
+        vertex_offset = dst->vertex_offset;
+        *dst = cmds[0];
+        dst->elem_count += count;
+        dst->vertex_offset = vertex_offset;
+        i = 1;
+    }
+    for (; i < cache->cmd_count; ++i) {
+        const struct nk_draw_command *src = cmds - i;
+        dst = nk_draw_list_push_command(list, src->clip_rect, src->texture);
+        if (!dst) return;
+        *dst = *src;
+        dst->vertex_offset = vertex_offset;
+    }
+    list->clip_rect = cache->clip_rect;
+
+    base = list->vertex_count - vertex_offset;
+    if (cache->vertex_count) {
+        size = cache->vertex_count * list->config.vertex_size;
+        vtx = nk_draw_list_alloc_vertices(list, cache->vertex_count);
+        if (!vtx) return;
+        NK_MEMCPY(vtx, nk_ptr_add_const(nk_byte, cache->vertices.memory.ptr,
+            cache->vertices.allocated - size), size);
+    }
+    if (cache->element_count) {
+        /* rebase indices onto the first vertex of this frame's copy */
+        size = cache->element_count * sizeof(nk_draw_index);
+        elements = (nk_draw_index*)nk_buffer_alloc(list->elements, NK_BUFFER_FRONT,
+            size, NK_ALIGNOF(nk_draw_index));
+        if (!elements) return;
+        ids = nk_ptr_add_const(nk_draw_index, cache->elements.memory.ptr,
+            cache->elements.allocated - size);
+        for (i = 0; i < cache->element_count; ++i)
+            elements[i] = (nk_draw_index)(ids[i] + base);
+        list->element_count += cache->element_count;
+    }
+}
+NK_INTERN int
+nk_vertex_cache_fits(struct nk_draw_list *list, const struct nk_vertex_cache *cache)
+{
+    /* replayed vertices have to be reachable from the current draw command */
+    unsigned int vertex_offset = 0;
+    if (sizeof(nk_draw_index) != 2) return nk_true;
+    if (list->cmd_count)
+        vertex_offset = nk_draw_list_command_last(list)->vertex_offset;
+    return list->vertex_count - vertex_offset + cache->vertex_count < NK_USHORT_MAX;
+}
+NK_INTERN void
+nk_vertex_cache_store(struct nk_vertex_cache *cache, struct nk_draw_list *list,
+    const struct nk_allocator *alloc, unsigned int cmd_count, unsigned int elem_count,
+    unsigned int vertex_count, unsigned int element_count)
+{
+    struct nk_draw_list copy;
+    struct nk_draw_command *cmds;
+    const nk_draw_index *ids;
+    nk_draw_index *elements;
+    unsigned int i, n, base = 0;
+    nk_size size;
+    void *memory;
+
+    /* copy the window's part of the draw list into the cache buffers */
+    nk_vertex_cache_begin(cache, alloc);
+    copy = *list;
+    copy.buffer = &cache->commands;
+    copy.vertices = &cache->vertices;
+    copy.elements = &cache->elements;
+    copy.cmd_count = 0;
+    copy.vertex_count = 0;
+    copy.element_count = 0;
+
+    n = list->cmd_count - cmd_count + (cmd_count ? 1: 0);
+    if (n) {
+        memory = nk_buffer_alloc(copy.buffer, NK_BUFFER_BACK,
+            sizeof(struct nk_draw_command) * n, NK_ALIGNOF(struct nk_draw_command));
+        if (!memory) return;
+        NK_MEMCPY(memory, nk_draw_list_command_last(list), sizeof(struct nk_draw_command) * n);
+        copy.cmd_count = n;
+
+        /* windows split into multiple vertex ranges are not cached */
+        cmds = (struct nk_draw_command*)memory;
+        base = cmds[n-1].vertex_offset;
+        for (i = 0; i < n; ++i) {
+            if (cmds[i].vertex_offset != base) return;
+            cmds[i].vertex_offset = 0;
+        }
+        copy.cmd_offset = (nk_size)(nk_buffer_total(copy.buffer) -
+            (nk_size)((nk_byte*)memory - (nk_byte*)nk_buffer_memory(copy.buffer)));
+        copy.cmd_offset -= sizeof(struct nk_draw_command) * (n - 1);
+    }
+    if (list->vertex_count - vertex_count) {
+        n = list->vertex_count - vertex_count;
+        size = n * list->config.vertex_size;
+        memory = nk_draw_list_alloc_vertices(&copy, n);
+        if (!memory) return;
+        NK_MEMCPY(memory, nk_ptr_add_const(nk_byte, list->vertices->memory.ptr,
+            list->vertices->allocated - size), size);
+    }
+    if (list->element_count - element_count) {
+        n = list->element_count - element_count;
+        size = n * sizeof(nk_draw_index);
+        elements = (nk_draw_index*)nk_buffer_alloc(copy.elements, NK_BUFFER_FRONT,
+            size, NK_ALIGNOF(nk_draw_index));
+        if (!elements) return;
+        ids = nk_ptr_add_const(nk_draw_index, list->elements->memory.ptr,
+            list->elements->allocated - size);
+        for (i = 0; i < n; ++i)
+            elements[i] = (nk_draw_index)(ids[i] - (vertex_count - base));
+        copy.element_count = n;
+    }
+    if (list->vertices->needed > list->vertices->allocated ||
+        list->elements->needed > list->elements->allocated) return;
+    nk_vertex_cache_end(cache, &copy, cmd_count ? 1: 0, elem_count, 0, 0);
+}
+NK_INTERN void
+nk_vertex_cache_convert(struct nk_context *ctx, struct nk_window *win,
+    const struct nk_convert_config *config, nk_hash config_hash)
+{
+    struct nk_vertex_cache *cache = &win->vertex_cache;
+    const struct nk_command *cmd, *first, *last;
+    struct nk_draw_command *head = 0;
+    unsigned int elem_count = 0;
+    struct nk_draw_list list;
+
+    nk_vertex_cache_begin(cache, &ctx->memory.pool);
+    nk_draw_list_init(&list);
+    nk_draw_list_setup(&list, config, &cache->commands, &cache->vertices,
+        &cache->elements, config->line_AA, config->shape_AA);
+
+    /* start from the draw list state in front of the window last frame */
+    if (cache->enter_valid) {
+        head = nk_draw_list_push_command(&list, cache->enter.clip_rect, cache->enter.texture);
+        if (!head) return;
+        *head = cache->enter;
+        head->vertex_offset = 0;
+        elem_count = head->elem_count;
+    }
+    list.clip_rect = cache->enter_clip;
+    cache->key = nk_vertex_cache_key(win, config_hash, head, list.clip_rect);
+
+    first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+    last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+    for (cmd = first; cmd != last; cmd = nk__next(ctx, cmd)) {
+        /* custom callbacks are only ever called from `nk_convert` itself */
+        if (!cmd || cmd->type == NK_COMMAND_CUSTOM) return;
+        nk_convert_command(&list, cmd, config);
+        if (cmd->next < win->buffer.begin || cmd->next > win->buffer.last)
+            return;
+    }
+    if (cmd->type == NK_COMMAND_CUSTOM) return;
+    nk_convert_command(&list, cmd, config);
+    nk_vertex_cache_end(cache, &list, head ? 1: 0, elem_count, 0, 0);
+}
+struct nk_convert_jobs {
+    struct nk_context *ctx;
+    const struct nk_convert_config *config;
+    struct nk_window **windows;
+    nk_hash config_hash;
+};
+NK_INTERN void
+nk_convert_job(void *data, int index)
+{
+    struct nk_convert_jobs *jobs = (struct nk_convert_jobs*)data;
+    NK_ASSERT(jobs);
+    nk_vertex_cache_convert(jobs->ctx, jobs->windows[index],
+        jobs->config, jobs->config_hash);
+}
+NK_INTERN void
+nk_convert_parallel(struct nk_context *ctx, const struct nk_convert_config *config,
+    nk_hash config_hash)
+{
+    struct nk_convert_jobs jobs;
+    struct nk_window *win;
+    int count = 0;
+
+    /* convert windows into their cache with the draw list state they saw
+     * last frame. Windows with a different state are converted again
+     * while the output is assembled in `nk_convert_cached`. */
+    jobs.windows = (struct nk_window**)ctx->memory.pool.alloc(
+        ctx->memory.pool.userdata, 0, sizeof(struct nk_window*) * ctx->count);
+    if (!jobs.windows) return;
+    for (win = ctx->begin; win; win = win->next) {
+        struct nk_vertex_cache *cache = &win->vertex_cache;
+        if (nk_vertex_cache_skip(ctx, win)) continue;
+        if (cache->valid && cache->key == nk_vertex_cache_key(win, config_hash,
+            cache->enter_valid ? &cache->enter: 0, cache->enter_clip))
+            continue;
+        /* left to the serial pass in `nk_convert_cached` */
+        if (nk_vertex_cache_serial(ctx, win)) continue;
+        jobs.windows[count++] = win;
+    }
+    jobs.ctx = ctx;
+    jobs.config = config;
+    jobs.config_hash = config_hash;
+    if (count > 1)
+        config->parallel_for(config->parallel_userdata, nk_convert_job, &jobs, count);
+    ctx->memory.pool.free(ctx->memory.pool.userdata, jobs.windows);
+}
+NK_INTERN void
+nk_convert_cached(struct nk_context *ctx, const struct nk_convert_config *config,
+    nk_hash config_hash, int store)
+{
+    struct nk_draw_list *list = &ctx->draw_list;
+    const struct nk_command *cmd;
+    struct nk_window *win;
+
+    cmd = nk__begin(ctx);
+    for (win = ctx->begin; win && cmd; win = win->next) {
+        struct nk_vertex_cache *cache = &win->vertex_cache;
+        unsigned int cmd_count, elem_count, vertex_count, element_count;
+        const struct nk_command *first, *last;
+        struct nk_draw_command *prev;
+        int cacheable = nk_true;
+        nk_hash key;
+
+        if (nk_vertex_cache_skip(ctx, win)) continue;
+        /* draw command list has to visit windows in list order */
+        first = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.begin);
+        last = (const struct nk_command*)nk_buffer_at(&ctx->memory, win->buffer.last);
+        if (cmd != first) break;
+
+        prev = list->cmd_count ? nk_draw_list_command_last(list): 0;
+        key = nk_vertex_cache_key(win, config_hash, prev, list->clip_rect);
+        cache->enter_valid = (prev != 0);
+        if (prev) cache->enter = *prev;
+        cache->enter_clip = list->clip_rect;
+        if (cache->valid && cache->key == key && nk_vertex_cache_fits(list, cache)) {
+            nk_vertex_cache_replay(list, cache);
+            cmd = nk__next(ctx, last);
+            continue;
+        }
+
+        /* convert window and keep the result for the next frame */
+        cache->valid = nk_false;
+        cmd_count = list->cmd_count;
+        elem_count = prev ? prev->elem_count: 0;
+        vertex_count = list->vertex_count;
+        element_count = list->element_count;
+        while (cmd) {
+            nk_size next = cmd->next;
+            cacheable = cacheable && (cmd->type != NK_COMMAND_CUSTOM) &&
+                !nk_convert_dynamic_text(cmd);
+            nk_convert_command(list, cmd, config);
+            if (cmd == last) break;
+            cmd = nk__next(ctx, cmd);
+            /* a popup closing the window leaves the window's range */
+            if (cmd && (next < win->buffer.begin || next > win->buffer.last)) break;
+        }
+        if (cmd != last) break;
+        cmd = nk__next(ctx, cmd);
+        if (store && cacheable) {
+            nk_vertex_cache_store(cache, list, &ctx->memory.pool,
+                cmd_count, elem_count, vertex_count, element_count);
+            cache->key = key;
+        }
+    }
+    /* popups and overlay are always converted */
+    for (; cmd; cmd = nk__next(ctx, cmd))
+        nk_convert_command(list, cmd, config);
+}
 NK_API nk_flags
 nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
     struct nk_buffer *vertices, struct nk_buffer *elements,
@@ -1194,123 +1835,53 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 
     nk_draw_list_setup(&ctx->draw_list, config, cmds, vertices, elements,
         config->line_AA, config->shape_AA);
-    nk_foreach(cmd, ctx)
-    {
-#ifdef NK_INCLUDE_COMMAND_USERDATA
-        ctx->draw_list.userdata = cmd->userdata;
-#endif
-        switch (cmd->type) {
-        case NK_COMMAND_NOP: break;
-        case NK_COMMAND_SCISSOR: {
-            const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
-            nk_draw_list_add_clip(&ctx->draw_list, nk_rect(s->x, s->y, s->w, s->h));
-        } break;
-        case NK_COMMAND_LINE: {
-            const struct nk_command_line *l = (const struct nk_command_line*)cmd;
-            nk_draw_list_stroke_line(&ctx->draw_list, nk_vec2(l->begin.x, l->begin.y),
-                nk_vec2(l->end.x, l->end.y), l->color, l->line_thickness);
-        } break;
-        case NK_COMMAND_CURVE: {
-            const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
-            nk_draw_list_stroke_curve(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
-                nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
-                q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
-                config->curve_segment_count, q->line_thickness);
-        } break;
-        case NK_COMMAND_RECT: {
-            const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
-            nk_draw_list_stroke_rect(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->color, (float)r->rounding, r->line_thickness);
-        } break;
-        case NK_COMMAND_RECT_FILLED: {
-            const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
-            nk_draw_list_fill_rect(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->color, (float)r->rounding);
-        } break;
-        case NK_COMMAND_RECT_MULTI_COLOR: {
-            const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
-            nk_draw_list_fill_rect_multi_color(&ctx->draw_list, nk_rect(r->x, r->y, r->w, r->h),
-                r->left, r->top, r->right, r->bottom);
-        } break;
-        case NK_COMMAND_CIRCLE: {
-            const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
-            nk_draw_list_stroke_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
-                (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count, c->line_thickness);
-        } break;
-        case NK_COMMAND_CIRCLE_FILLED: {
-            const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
-            nk_draw_list_fill_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
-                (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count);
-        } break;
-        case NK_COMMAND_ARC: {
-            const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
-            nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
-            nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
-            nk_draw_list_path_stroke(&ctx->draw_list, c->color, NK_STROKE_CLOSED, c->line_thickness);
-        } break;
-        case NK_COMMAND_ARC_FILLED: {
-            const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
-            nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
-            nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
-            nk_draw_list_path_fill(&ctx->draw_list, c->color);
-        } break;
-        case NK_COMMAND_TRIANGLE: {
-            const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
-            nk_draw_list_stroke_triangle(&ctx->draw_list, nk_vec2(t->a.x, t->a.y),
-                nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color,
-                t->line_thickness);
-        } break;
-        case NK_COMMAND_TRIANGLE_FILLED: {
-            const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
-            nk_draw_list_fill_triangle(&ctx->draw_list, nk_vec2(t->a.x, t->a.y),
-                nk_vec2(t->b.x, t->b.y), nk_vec2(t->c.x, t->c.y), t->color);
-        } break;
-        case NK_COMMAND_POLYGON: {
-            int i;
-            const struct nk_command_polygon*p = (const struct nk_command_polygon*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_stroke(&ctx->draw_list, p->color, NK_STROKE_CLOSED, p->line_thickness);
-        } break;
-        case NK_COMMAND_POLYGON_FILLED: {
-            int i;
-            const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_fill(&ctx->draw_list, p->color);
-        } break;
-        case NK_COMMAND_POLYLINE: {
-            int i;
-            const struct nk_command_polyline *p = (const struct nk_command_polyline*)cmd;
-            for (i = 0; i < p->point_count; ++i) {
-                struct nk_vec2 pnt = nk_vec2((float)p->points[i].x, (float)p->points[i].y);
-                nk_draw_list_path_line_to(&ctx->draw_list, pnt);
-            }
-            nk_draw_list_path_stroke(&ctx->draw_list, p->color, NK_STROKE_OPEN, p->line_thickness);
-        } break;
-        case NK_COMMAND_TEXT: {
-            const struct nk_command_text *t = (const struct nk_command_text*)cmd;
-            nk_draw_list_add_text(&ctx->draw_list, t->font, nk_rect(t->x, t->y, t->w, t->h),
-                t->string, t->length, t->height, t->foreground);
-        } break;
-        case NK_COMMAND_IMAGE: {
-            const struct nk_command_image *i = (const struct nk_command_image*)cmd;
-            nk_draw_list_add_image(&ctx->draw_list, i->img, nk_rect(i->x, i->y, i->w, i->h), i->col);
-        } break;
-        case NK_COMMAND_CUSTOM: {
-            const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
-            c->callback(&ctx->draw_list, c->x, c->y, c->w, c->h, c->callback_data);
-        } break;
-        default: break;
+    if (((config->flags & NK_CONVERT_CACHE_WINDOWS) || config->parallel_for) &&
+        ctx->memory.type != NK_BUFFER_FIXED && (!config->vertex_alignment ||
+        !(config->vertex_size % config->vertex_alignment)) && nk__begin(ctx)) {
+        /* per window output requires tightly packed vertices */
+        nk_hash config_hash = nk_convert_config_hash(config);
+        if (!(config->flags & NK_CONVERT_CACHE_WINDOWS)) {
+            struct nk_window *win;
+            for (win = ctx->begin; win; win = win->next)
+                win->vertex_cache.valid = nk_false;
         }
+        if (config->parallel_for)
+            nk_convert_parallel(ctx, config, config_hash);
+        nk_convert_cached(ctx, config, config_hash,
+            config->flags & NK_CONVERT_CACHE_WINDOWS);
+    } else nk_foreach(cmd, ctx)
+        nk_convert_command(&ctx->draw_list, cmd, config);
+    res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
+    res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
+    res |= (elements->needed > elements->allocated) ? NK_CONVERT_ELEMENT_BUFFER_FULL: 0;
+    return res;
+}
+NK_API nk_flags
+nk_convert_frame(const struct nk_frame *frame, struct nk_draw_list *list,
+    struct nk_buffer *cmds, struct nk_buffer *vertices, struct nk_buffer *elements,
+    const struct nk_convert_config *config)
+{
+    /* only touches the frame and the given draw list and buffers, so it can
+     * run on another thread while the context builds the next frame */
+    nk_flags res = NK_CONVERT_SUCCESS;
+    const struct nk_command *cmd;
+    NK_ASSERT(frame);
+    NK_ASSERT(list);
+    NK_ASSERT(cmds);
+    NK_ASSERT(vertices);
+    NK_ASSERT(elements);
+    NK_ASSERT(config);
+    NK_ASSERT(config->vertex_layout);
+    NK_ASSERT(config->vertex_size);
+    if (!frame || !list || !cmds || !vertices || !elements || !config || !config->vertex_layout)
+        return NK_CONVERT_INVALID_PARAM;
+
+    nk_draw_list_setup(list, config, cmds, vertices, elements,
+        config->line_AA, config->shape_AA);
+    nk_frame_foreach(cmd, frame) {
+        /* dynamic font atlases are modified by the context's thread */
+        NK_ASSERT(!nk_convert_dynamic_text(cmd));
+        nk_convert_command(list, cmd, config);
     }
     res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
     res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
@@ -27,6 +27,10 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
     win->next = 0;
     win->prev = 0;
 
+    nk_table_index_free(ctx, win);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    nk_vertex_cache_free(&win->vertex_cache);
+#endif
     while (it) {
         /*free window state tables */
         struct nk_table *n = it->next;
@@ -42,10 +46,104 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
     nk_free_page_element(ctx, pe);}
 }
+NK_INTERN unsigned int
+nk_window_index_elements(unsigned int slots)
+{
+    nk_size size = slots * sizeof(struct nk_window_slot);
+    return (unsigned int)((size + sizeof(struct nk_page_element)-1) / sizeof(struct nk_page_element));
+}
+NK_INTERN void
+nk_window_index_insert(struct nk_context *ctx, struct nk_window *win)
+{
+    nk_uint mask = ctx->window_index_size-1;
+    nk_uint i = win->name & mask;
+    while (ctx->window_index[i].win)
+        i = (i + 1) & mask;
+    ctx->window_index[i].win = win;
+    ctx->window_index[i].name = win->name;
+    ctx->window_index_count++;
+}
+NK_INTERN int
+nk_window_index_slot(const struct nk_context *ctx, const struct nk_window *win)
+{
+    nk_uint mask = ctx->window_index_size-1;
+    nk_uint i = win->name & mask;
+    while (ctx->window_index[i].win) {
+        if (ctx->window_index[i].win == win)
+            return (int)i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+NK_LIB void
+nk_window_index_free(struct nk_context *ctx)
+{
+    if (!ctx->window_index) return;
+    nk_free_page_elements(ctx, (struct nk_page_element*)(void*)ctx->window_index,
+        nk_window_index_elements(ctx->window_index_size));
+    ctx->window_index = 0;
+    ctx->window_index_size = 0;
+    ctx->window_index_count = 0;
+}
+NK_LIB void
+nk_window_index_rebuild(struct nk_context *ctx)
+{
+    /* (re)allocates index with load factor below 3/4 and links all windows of
+     * the window list. Without memory windows are searched linearly. */
+    struct nk_page_element *elem;
+    struct nk_window *iter;
+    unsigned int size;
+
+    nk_window_index_free(ctx);
+    size = nk_round_up_pow2(NK_MAX(ctx->count + ctx->count/3 + 1, 32));
+    elem = nk_create_page_elements(ctx, nk_window_index_elements(size));
+    if (!elem) return;
+
+    ctx->window_index = (struct nk_window_slot*)(void*)elem;
+    ctx->window_index_size = size;
+    for (iter = ctx->begin; iter; iter = iter->next)
+        nk_window_index_insert(ctx, iter);
+}
+NK_INTERN void
+nk_window_index_remove(struct nk_context *ctx, struct nk_window *win)
+{
+    nk_uint i, j, k, mask;
+    int slot = nk_window_index_slot(ctx, win);
+    if (slot < 0) return;
+
+    /* backward shift deletion to keep probe sequences intact */
+    mask = ctx->window_index_size-1;
+    i = j = (nk_uint)slot;
+    ctx->window_index_count--;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!ctx->window_index[j].win) break;
+        k = ctx->window_index[j].name & mask;
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        ctx->window_index[i] = ctx->window_index[j];
+        i = j;
+    }
+    ctx->window_index[i].win = 0;
+    ctx->window_index[i].name = 0;
+}
 NK_LIB struct nk_window*
 nk_find_window(struct nk_context *ctx, nk_hash hash, const char *name)
 {
     struct nk_window *iter;
+    if (ctx->window_index) {
+        nk_uint mask = ctx->window_index_size-1;
+        nk_uint i = hash & mask;
+        while (ctx->window_index[i].win) {
+            if (ctx->window_index[i].name == hash) {
+                iter = ctx->window_index[i].win;
+                if (!nk_stricmpn(iter->name_string, name, nk_strlen(iter->name_string)))
+                    return iter;
+            }
+            i = (i + 1) & mask;
+        }
+        return 0;
+    }
     iter = ctx->begin;
     while (iter) {
         NK_ASSERT(iter != iter->next);
@@ -67,12 +165,17 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
     NK_ASSERT(win);
     if (!win || !ctx) return;
 
-    iter = ctx->begin;
-    while (iter) {
-        NK_ASSERT(iter != iter->next);
-        NK_ASSERT(iter != win);
-        if (iter == win) return;
-        iter = iter->next;
+    if (ctx->window_index) {
+        NK_ASSERT(nk_window_index_slot(ctx, win) < 0);
+        if (nk_window_index_slot(ctx, win) >= 0) return;
+    } else {
+        iter = ctx->begin;
+        while (iter) {
+            NK_ASSERT(iter != iter->next);
+            NK_ASSERT(iter != win);
+            if (iter == win) return;
+            iter = iter->next;
+        }
     }
 
     if (!ctx->begin) {
@@ -81,11 +184,20 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
         ctx->begin = win;
         ctx->end = win;
         ctx->count = 1;
+        if (ctx->window_index)
+            nk_window_index_insert(ctx, win);
+        else nk_window_index_rebuild(ctx);
         return;
     }
     if (loc == NK_INSERT_BACK) {
         struct nk_window *end;
         end = ctx->end;
+        if (ctx->window_index) {
+            /* windows behind a stale end get unlinked from the list */
+            struct nk_window *it;
+            for (it = end->next; it; it = it->next)
+                nk_window_index_remove(ctx, it);
+        }
         end->flags |= NK_WINDOW_ROM;
         end->next = win;
         win->prev = ctx->end;
@@ -102,6 +214,9 @@ nk_insert_window(struct nk_context *ctx, struct nk_window *win,
         ctx->begin->flags &= ~(nk_flags)NK_WINDOW_ROM;
     }
     ctx->count++;
+    if (ctx->window_index && (ctx->window_index_count+1)*4 <= ctx->window_index_size*3)
+        nk_window_index_insert(ctx, win);
+    else nk_window_index_rebuild(ctx);
 }
 NK_LIB void
 nk_remove_window(struct nk_context *ctx, struct nk_window *win)
@@ -131,6 +246,8 @@ nk_remove_window(struct nk_context *ctx, struct nk_window *win)
     win->next = 0;
     win->prev = 0;
     ctx->count--;
+    if (ctx->window_index)
+        nk_window_index_remove(ctx, win);
 }
 NK_API int
 nk_begin(struct nk_context *ctx, const char *title,
@@ -165,9 +282,14 @@ nk_begin_titled(struct nk_context *ctx, const char *name, const char *title,
         /* create new window */
         nk_size name_length = (nk_size)name_len;
         win = (struct nk_window*)nk_create_window(ctx);
+        if (!win) nk_memory_check(ctx, name);
         NK_ASSERT(win);
         if (!win) return 0;
 
+        win->name = name_hash;
+        name_length = NK_MIN(name_length, NK_WINDOW_MAX_NAME-1);
+        NK_MEMCPY(win->name_string, name, name_length);
+        win->name_string[name_length] = 0;
         if (flags & NK_WINDOW_BACKGROUND)
             nk_insert_window(ctx, win, NK_INSERT_FRONT);
         else nk_insert_window(ctx, win, NK_INSERT_BACK);
@@ -175,10 +297,6 @@ nk_begin_titled(struct nk_context *ctx, const char *name, const char *title,
 
         win->flags = flags;
         win->bounds = bounds;
-        win->name = name_hash;
-        name_length = NK_MIN(name_length, NK_WINDOW_MAX_NAME-1);
-        NK_MEMCPY(win->name_string, name, name_length);
-        win->name_string[name_length] = 0;
         win->popup.win = 0;
         if (!ctx->active)
             ctx->active = win;
@@ -296,18 +414,21 @@ NK_API void
 nk_end(struct nk_context *ctx)
 {
     struct nk_panel *layout;
+    const struct nk_window *win;
     NK_ASSERT(ctx);
     NK_ASSERT(ctx->current && "if this triggers you forgot to call `nk_begin`");
     if (!ctx || !ctx->current)
         return;
 
     layout = ctx->current->layout;
-    if (!layout || (layout->type == NK_PANEL_WINDOW && (ctx->current->flags & NK_WINDOW_HIDDEN))) {
-        ctx->current = 0;
-        return;
+    if (layout && (layout->type != NK_PANEL_WINDOW || !(ctx->current->flags & NK_WINDOW_HIDDEN))) {
+        nk_panel_end(ctx);
+        nk_free_panel(ctx, ctx->current->layout);
     }
-    nk_panel_end(ctx);
-    nk_free_panel(ctx, ctx->current->layout);
+    /* popups have no name and draw into their parent's command buffer */
+    win = ctx->current;
+    while (win->parent) win = win->parent;
+    nk_memory_check(ctx, win->name_string);
     ctx->current = 0;
 }
 NK_API struct nk_rect
@@ -516,6 +637,40 @@ nk_window_is_hidden(struct nk_context *ctx, const char *name)
     return (win->flags & NK_WINDOW_HIDDEN);
 }
 NK_API int
+nk_window_is_dirty(struct nk_context *ctx, const char *name)
+{
+    int title_len;
+    nk_hash title_hash;
+    struct nk_window *win;
+    NK_ASSERT(ctx);
+    if (!ctx) return 1;
+
+    title_len = (int)nk_strlen(name);
+    title_hash = nk_murmur_hash(name, (int)title_len, NK_WINDOW_TITLE);
+    win = nk_find_window(ctx, title_hash, name);
+    if (!win) return 1;
+    if (!ctx->build) {
+        nk_build(ctx);
+        ctx->build = nk_true;
+    }
+    return win->dirty;
+}
+NK_API nk_size
+nk_window_get_command_bytes(struct nk_context *ctx, const char *name)
+{
+    int title_len;
+    nk_hash title_hash;
+    struct nk_window *win;
+    NK_ASSERT(ctx);
+    if (!ctx) return 0;
+
+    title_len = (int)nk_strlen(name);
+    title_hash = nk_murmur_hash(name, (int)title_len, NK_WINDOW_TITLE);
+    win = nk_find_window(ctx, title_hash, name);
+    if (!win || (win->flags & NK_WINDOW_HIDDEN)) return 0;
+    return win->buffer.end - win->buffer.begin;
+}
+NK_API int
 nk_window_is_active(struct nk_context *ctx, const char *name)
 {
     int title_len;